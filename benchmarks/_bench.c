@@ -0,0 +1,424 @@
+#define _POSIX_C_SOURCE 200809L // for clock_gettime()
+
+#include "_bench.h"
+
+#include "tensor/_tensor_simd.h"
+#include "utils/_parallel.h"
+
+#include <stdio.h>
+#include <stdint.h> // for uint64_t
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// 样本数的上下限；每个样本至少跑 BENCH_BATCH_TIME 秒，计时本身的开销才可以忽略
+#define BENCH_MIN_SAMPLES 3
+#define BENCH_MAX_SAMPLES 1000
+#define BENCH_BATCH_TIME 50e-6
+#define BENCH_MAX_BATCH ((size_t)1 << 20)
+#define BENCH_ROOFLINE_SIZES 64
+
+typedef struct
+{
+    char name[BENCH_NAME_MAX];
+    BenchWork work;
+    size_t runs;
+    double median;  // 秒/次
+    double min;
+    double memcpy;  // 同样字节数的 memcpy，秒/次；0 表示没有
+}
+BenchResult;
+
+typedef struct
+{
+    size_t bytes;
+    double seconds;
+}
+RooflineEntry;
+
+typedef struct
+{
+    char* dst;
+    const char* src;
+    size_t bytes;
+}
+CopyTask;
+
+static BenchOptions _options = { 0.2, NULL, false, false, "/tmp" };
+static BenchResult* _results = NULL;
+static size_t _result_count = 0;
+static size_t _result_capacity = 0;
+
+static RooflineEntry _roofline[BENCH_ROOFLINE_SIZES];
+static size_t _roofline_count = 0;
+static char* _copy_src = NULL;
+static char* _copy_dst = NULL;
+static size_t _copy_capacity = 0;
+
+static uint64_t _rng_state = 0x853c49e6748fea9bull;
+
+static double
+_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int
+_compare_double(const void* a, const void* b)
+{
+    const double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double
+_time_batch(BenchFn fn, void* ctx, size_t batch)
+{
+    const double start = _now();
+    for (size_t i = 0; i < batch; i++) fn(ctx);
+    return _now() - start;
+}
+
+// 先跑一次预热，再把 batch 加倍到一个样本至少 BENCH_BATCH_TIME 秒，然后采样到
+// 总时间够了为止。返回每次调用的中位数时间
+static double
+_measure(BenchFn fn, void* ctx, double* min, size_t* runs)
+{
+    static double samples[BENCH_MAX_SAMPLES];
+
+    fn(ctx);
+
+    size_t batch = 1;
+    double t = _time_batch(fn, ctx, batch);
+    while (t < BENCH_BATCH_TIME && batch < BENCH_MAX_BATCH)
+    {
+        batch *= 2;
+        t = _time_batch(fn, ctx, batch);
+    }
+
+    size_t n = 0;
+    double total = t;
+    samples[n++] = t / (double)batch;
+    while (n < BENCH_MAX_SAMPLES && (total < _options.min_time || n < BENCH_MIN_SAMPLES))
+    {
+        t = _time_batch(fn, ctx, batch);
+        samples[n++] = t / (double)batch;
+        total += t;
+    }
+
+    qsort(samples, n, sizeof(double), _compare_double);
+    *min = samples[0];
+    *runs = n * batch;
+    return (n % 2) ? samples[n / 2] : 0.5 * (samples[n / 2 - 1] + samples[n / 2]);
+}
+
+static void
+_copy_chunk(size_t begin, size_t end, void* ctx)
+{
+    CopyTask* task = ctx;
+    memcpy(task->dst + begin, task->src + begin, end - begin);
+}
+
+static void
+_copy_run(void* ctx)
+{
+    CopyTask* task = ctx;
+    // 每个字节读一次写一次
+    parallel_for(0, task->bytes, parallel_grain(2), _copy_chunk, task);
+}
+
+// 搬运 bytes 字节（读一半、写一半）的 memcpy 需要的时间，每种大小只量一次
+static double
+_memcpy_time(size_t bytes)
+{
+    const size_t half = (bytes / 2 + 63) & ~(size_t)63;
+    if (half == 0) return 0.0;
+
+    for (size_t i = 0; i < _roofline_count; i++)
+        if (_roofline[i].bytes == bytes) return _roofline[i].seconds;
+
+    if (half > _copy_capacity)
+    {
+        free(_copy_src);
+        free(_copy_dst);
+        _copy_src = aligned_alloc(64, half);
+        _copy_dst = aligned_alloc(64, half);
+        if (_copy_src == NULL || _copy_dst == NULL)
+        {
+            fprintf(stderr, "Error: snake_bench: cannot allocate %zu bytes for the memcpy roofline\n", 2 * half);
+            exit(1);
+        }
+        memset(_copy_src, 1, half);
+        memset(_copy_dst, 0, half);
+        _copy_capacity = half;
+    }
+
+    CopyTask task = { _copy_dst, _copy_src, half };
+    double min;
+    size_t runs;
+    const double seconds = _measure(_copy_run, &task, &min, &runs);
+
+    if (_roofline_count < BENCH_ROOFLINE_SIZES)
+        _roofline[_roofline_count++] = (RooflineEntry){ bytes, seconds };
+    return seconds;
+}
+
+void
+bench_init(const BenchOptions* options)
+{
+    _options = *options;
+    if (_options.min_time <= 0.0) _options.min_time = 0.2;
+    if (_options.tmpdir == NULL) _options.tmpdir = "/tmp";
+}
+
+const BenchOptions*
+bench_options(void)
+{
+    return &_options;
+}
+
+bool
+bench_selected(const char* name)
+{
+    if (_options.filter != NULL && strstr(name, _options.filter) == NULL) return false;
+
+    // 只列名字时什么都不跑，套件也就不会去准备输入
+    if (_options.list)
+    {
+        printf("%s\n", name);
+        return false;
+    }
+    return true;
+}
+
+void
+bench_run(const char* name, BenchWork work, BenchFn fn, void* ctx)
+{
+    if (!bench_selected(name)) return;
+
+    if (_result_count == _result_capacity)
+    {
+        const size_t capacity = _result_capacity ? 2 * _result_capacity : 64;
+        BenchResult* results = realloc(_results, capacity * sizeof(BenchResult));
+        if (results == NULL)
+        {
+            fprintf(stderr, "Error: snake_bench: out of memory\n");
+            exit(1);
+        }
+        _results = results;
+        _result_capacity = capacity;
+    }
+
+    BenchResult* r = &_results[_result_count++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->work = work;
+    r->median = _measure(fn, ctx, &r->min, &r->runs);
+    r->memcpy = (work.bytes > 0) ? _memcpy_time(work.bytes) : 0.0;
+
+    fprintf(stderr, "%-52s %11.3f us", r->name, r->median * 1e6);
+    if (work.bytes > 0)
+        fprintf(stderr, " %8.2f GB/s %5.0f%% of memcpy", (double)work.bytes / r->median * 1e-9, 100.0 * r->memcpy / r->median);
+    if (work.elements > 0)
+        fprintf(stderr, " %9.3f ns/elem", r->median * 1e9 / (double)work.elements);
+    if (work.flops > 0)
+        fprintf(stderr, " %8.2f GFLOP/s", work.flops / r->median * 1e-9);
+    fprintf(stderr, "\n");
+}
+
+static void
+_json_string(FILE* f, const char* s)
+{
+    fputc('"', f);
+    for (; *s != '\0'; s++)
+    {
+        if (*s == '"' || *s == '\\') fputc('\\', f);
+        if ((unsigned char)*s < 0x20)
+            fprintf(f, "\\u%04x", (unsigned char)*s);
+        else
+            fputc(*s, f);
+    }
+    fputc('"', f);
+}
+
+// 没有意义的量写成 null，方便跨提交比较时跳过
+static void
+_json_number(FILE* f, const char* key, double value, bool valid)
+{
+    if (valid)
+        fprintf(f, ", \"%s\": %.6g", key, value);
+    else
+        fprintf(f, ", \"%s\": null", key);
+}
+
+bool
+bench_write_json(const char* path, const char* label)
+{
+    FILE* f = (strcmp(path, "-") == 0) ? stdout : fopen(path, "w");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Error: snake_bench: cannot open %s for writing\n", path);
+        return false;
+    }
+
+    fprintf(f, "{\n  \"schema\": 1,\n  \"label\": ");
+    _json_string(f, label ? label : "");
+    fprintf(f, ",\n  \"simd\": ");
+    _json_string(f, simd_get_kernels()->name);
+    fprintf(f, ",\n  \"threads\": %d,\n  \"quick\": %s,\n  \"min_time_s\": %g,\n  \"results\": [",
+            parallel_get_num_threads(), _options.quick ? "true" : "false", _options.min_time);
+
+    for (size_t i = 0; i < _result_count; i++)
+    {
+        const BenchResult* r = &_results[i];
+        const BenchWork* w = &r->work;
+        fprintf(f, "%s\n    {\"name\": ", i ? "," : "");
+        _json_string(f, r->name);
+        fprintf(f, ", \"runs\": %zu, \"median_ns\": %.6g, \"min_ns\": %.6g, \"bytes\": %zu, \"elements\": %zu",
+                r->runs, r->median * 1e9, r->min * 1e9, w->bytes, w->elements);
+        _json_number(f, "flops", w->flops, w->flops > 0);
+        _json_number(f, "gb_per_s", (double)w->bytes / r->median * 1e-9, w->bytes > 0);
+        _json_number(f, "ns_per_element", r->median * 1e9 / (double)w->elements, w->elements > 0);
+        _json_number(f, "gflop_per_s", w->flops / r->median * 1e-9, w->flops > 0);
+        _json_number(f, "memcpy_gb_per_s", (double)w->bytes / r->memcpy * 1e-9, r->memcpy > 0);
+        _json_number(f, "roofline_fraction", r->memcpy / r->median, r->memcpy > 0);
+        fprintf(f, "}");
+    }
+    fprintf(f, "\n  ]\n}\n");
+
+    const bool ok = !ferror(f);
+    if (f != stdout) fclose(f);
+    else fflush(f);
+    return ok;
+}
+
+void
+bench_cleanup(void)
+{
+    free(_results);
+    _results = NULL;
+    _result_count = _result_capacity = 0;
+
+    free(_copy_src);
+    free(_copy_dst);
+    _copy_src = _copy_dst = NULL;
+    _copy_capacity = 0;
+    _roofline_count = 0;
+}
+
+// --- Input helpers ---
+
+int
+bench_pick(int full, int quick)
+{
+    return _options.quick ? quick : full;
+}
+
+static double
+_next_uniform(void)
+{
+    // xorshift64*，固定种子，每次运行的输入都一样
+    _rng_state ^= _rng_state >> 12;
+    _rng_state ^= _rng_state << 25;
+    _rng_state ^= _rng_state >> 27;
+    return (double)((_rng_state * 0x2545f4914f6cdd1dull) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+Tensor
+bench_random(const int* dims, int ndim, DataType dtype)
+{
+    Shape shape = shape_create(dims, ndim);
+    Tensor source = (shape != NULL) ? tensor_empty(shape, DTYPE_F64) : NULL;
+    shape_free(shape);
+    if (source == NULL)
+    {
+        fprintf(stderr, "Error: snake_bench: cannot allocate an input tensor\n");
+        exit(1);
+    }
+
+    double* data = tensor_get_data(source);
+    const size_t n = tensor_get_elements_count(source);
+    const bool integral = dtype == DTYPE_I32 || dtype == DTYPE_I8 || dtype == DTYPE_U8;
+    for (size_t i = 0; i < n; i++)
+    {
+        const double u = _next_uniform();
+        data[i] = integral ? (double)(int)(u * 100.0) - ((dtype == DTYPE_U8) ? 0.0 : 50.0) : 2.0 * u - 1.0;
+    }
+
+    if (dtype == DTYPE_F64) return source;
+
+    Tensor t = tensor_to_dtype(source, dtype);
+    tensor_free(source);
+    if (t == NULL)
+    {
+        fprintf(stderr, "Error: snake_bench: cannot convert an input tensor to %s\n", bench_dtype_name(dtype));
+        exit(1);
+    }
+    return t;
+}
+
+Tensor
+bench_random_indices(const int* dims, int ndim, int limit)
+{
+    Shape shape = shape_create(dims, ndim);
+    Tensor t = (shape != NULL) ? tensor_empty(shape, DTYPE_I32) : NULL;
+    shape_free(shape);
+    if (t == NULL)
+    {
+        fprintf(stderr, "Error: snake_bench: cannot allocate an index tensor\n");
+        exit(1);
+    }
+
+    int32_t* data = tensor_get_data(t);
+    const size_t n = tensor_get_elements_count(t);
+    for (size_t i = 0; i < n; i++)
+        data[i] = (int32_t)(_next_uniform() * (double)limit);
+    return t;
+}
+
+void
+bench_consume(Tensor t)
+{
+    bench_check(t != NULL, "an op returned NULL");
+    tensor_free(t);
+}
+
+void
+bench_check(bool ok, const char* what)
+{
+    if (ok) return;
+    fprintf(stderr, "Error: snake_bench: %s\n", what);
+    exit(1);
+}
+
+const char*
+bench_format_dims(char* buffer, size_t size, const int* dims, int ndim)
+{
+    if (ndim == 0)
+    {
+        snprintf(buffer, size, "scalar");
+        return buffer;
+    }
+
+    size_t used = 0;
+    buffer[0] = '\0';
+    for (int i = 0; i < ndim && used < size; i++)
+        used += (size_t)snprintf(buffer + used, size - used, i ? "x%d" : "%d", dims[i]);
+    return buffer;
+}
+
+const char*
+bench_dtype_name(DataType dtype)
+{
+    switch (dtype)
+    {
+        case DTYPE_I32:  return "i32";
+        case DTYPE_F32:  return "f32";
+        case DTYPE_F64:  return "f64";
+        case DTYPE_F16:  return "f16";
+        case DTYPE_BF16: return "bf16";
+        case DTYPE_I8:   return "i8";
+        case DTYPE_U8:   return "u8";
+        default:         return "unknown";
+    }
+}
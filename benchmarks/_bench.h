@@ -0,0 +1,124 @@
+#ifndef _BENCH_H
+#define _BENCH_H
+
+#include "tensor/tensor.h"
+
+#include <stdbool.h>
+#include <stddef.h> // For size_t
+
+// --- Microbenchmark harness for snake_bench ---
+//
+// Every benchmark times one call of a function, repeated until the sample collects
+// enough runs, and reports the median. Throughput is measured against a memcpy roofline:
+// a parallel memcpy that moves the same number of bytes on the same threads, measured
+// once per size. A roofline fraction near 1 means the op runs as fast as the memory
+// system allows; far below 1 means there is overhead left to remove.
+
+#define BENCH_NAME_MAX 128
+
+/**
+ * @brief The work done by one run of a benchmark.
+ */
+typedef struct
+{
+    size_t bytes;    // bytes read plus bytes written; 0 if memory traffic is not meaningful
+    size_t elements; // elements produced or visited; 0 if not meaningful
+    double flops;    // floating-point operations; 0 if not meaningful
+}
+BenchWork;
+
+typedef void (*BenchFn)(void* ctx);
+
+typedef struct
+{
+    double min_time;    // seconds to spend measuring each benchmark
+    const char* filter; // run only benchmarks whose name contains this, or NULL for all
+    bool quick;         // use small inputs, for smoke runs
+    bool list;          // print the selected names instead of running them
+    const char* tmpdir; // where the I/O benchmarks write their files
+}
+BenchOptions;
+
+/**
+ * @brief Sets the options used by every later call. Must be called before the first benchmark.
+ */
+void bench_init(const BenchOptions* options);
+
+/**
+ * @brief Gets the options passed to bench_init().
+ */
+const BenchOptions* bench_options(void);
+
+/**
+ * @brief Tells whether the benchmark `name` should run. Suites check this before
+ * allocating inputs, so filtered runs stay fast. In list mode it prints the name
+ * and returns false.
+ */
+bool bench_selected(const char* name);
+
+/**
+ * @brief Measures `fn(ctx)` and records the result under `name`.
+ * `fn` is called once untimed first to warm caches and page in its buffers.
+ */
+void bench_run(const char* name, BenchWork work, BenchFn fn, void* ctx);
+
+/**
+ * @brief Writes every recorded result as one JSON document to `path` ("-" for stdout).
+ * @return true on success.
+ */
+bool bench_write_json(const char* path, const char* label);
+
+/**
+ * @brief Frees the results and the roofline buffers.
+ */
+void bench_cleanup(void);
+
+// --- Input helpers ---
+
+/**
+ * @brief Returns `full`, or `quick` when the suite runs with small inputs.
+ */
+int bench_pick(int full, int quick);
+
+/**
+ * @brief Creates a contiguous tensor of `dtype` filled with uniform values in [-1, 1).
+ * Integer dtypes get small integers. Exits on allocation failure.
+ */
+Tensor bench_random(const int* dims, int ndim, DataType dtype);
+
+/**
+ * @brief Creates a contiguous DTYPE_I32 tensor of uniform random indices in [0, limit).
+ * Exits on allocation failure.
+ */
+Tensor bench_random_indices(const int* dims, int ndim, int limit);
+
+/**
+ * @brief Frees a tensor returned by a benchmarked op. Results are freed inside the timed
+ * function, so allocation churn is part of what op benchmarks measure.
+ * Exits if `t` is NULL: a failing op would otherwise be reported as very fast.
+ */
+void bench_consume(Tensor t);
+
+/**
+ * @brief Exits with an error naming `what` unless `ok`; for ops that report success as bool.
+ */
+void bench_check(bool ok, const char* what);
+
+/**
+ * @brief Writes dims as "4096x4096" into `buffer` (a scalar gives "scalar").
+ * @return `buffer`.
+ */
+const char* bench_format_dims(char* buffer, size_t size, const int* dims, int ndim);
+
+/**
+ * @brief Gets the short name of a dtype ("f32", "i8", ...).
+ */
+const char* bench_dtype_name(DataType dtype);
+
+// --- Suites ---
+
+void bench_suite_core(void);  // create/free, element access, printing
+void bench_suite_views(void); // tensor_contiguous, expand, cat/stack
+void bench_suite_ops(void);   // binary, lazy, reduce, norm, sort, index, cast, matmul, I/O
+
+#endif // _BENCH_H
@@ -0,0 +1,224 @@
+#include "_bench.h"
+
+#include "tensor/_tensor_print.h"
+
+#include <stdint.h> // for SIZE_MAX
+#include <stdio.h>
+#include <stdlib.h>
+
+// --- create/free churn ---
+
+typedef struct
+{
+    Shape shape;
+    DataType dtype;
+    Tensor t;
+    const int* axes;
+}
+CreateCtx;
+
+static void
+_run_empty(void* ctx)
+{
+    CreateCtx* c = ctx;
+    bench_consume(tensor_empty(c->shape, c->dtype));
+}
+
+static void
+_run_zeros(void* ctx)
+{
+    CreateCtx* c = ctx;
+    bench_consume(tensor_zeros(c->shape, c->dtype));
+}
+
+static void
+_run_permute_view(void* ctx)
+{
+    CreateCtx* c = ctx;
+    bench_consume(tensor_permute(c->t, c->axes));
+}
+
+static void
+_bench_create_free(void)
+{
+    const int sizes[][2] = { { 4, 4 }, { bench_pick(1024, 256), bench_pick(1024, 256) } };
+    char name[BENCH_NAME_MAX], dims_name[64];
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        const size_t n = (size_t)sizes[i][0] * (size_t)sizes[i][1];
+        CreateCtx ctx = { shape_create(sizes[i], 2), DTYPE_F32, NULL, NULL };
+        bench_check(ctx.shape != NULL, "shape_create failed");
+        bench_format_dims(dims_name, sizeof(dims_name), sizes[i], 2);
+
+        snprintf(name, sizeof(name), "create_free/empty/f32/%s", dims_name);
+        bench_run(name, (BenchWork){ 0, n, 0 }, _run_empty, &ctx);
+        snprintf(name, sizeof(name), "create_free/zeros/f32/%s", dims_name);
+        bench_run(name, (BenchWork){ n * sizeof(float), n, 0 }, _run_zeros, &ctx);
+        shape_free(ctx.shape);
+    }
+
+    // 视图只分配张量头和 Shape；分别在关闭和打开形状缓存时量一次
+    const int dims[] = { 8, 16, 32 };
+    const int axes[] = { 2, 0, 1 };
+    const bool cache_was_enabled = shape_cache_is_enabled();
+    CreateCtx ctx = { NULL, DTYPE_F32, bench_random(dims, 3, DTYPE_F32), axes };
+    for (int cached = 0; cached < 2; cached++)
+    {
+        shape_cache_set_enabled(cached);
+        snprintf(name, sizeof(name), "create_free/permute_view%s/f32/8x16x32", cached ? "_shape_cache" : "");
+        bench_run(name, (BenchWork){ 0, 0, 0 }, _run_permute_view, &ctx);
+    }
+    tensor_free(ctx.t);
+    shape_cache_set_enabled(cache_was_enabled);
+}
+
+// --- tensor_get_element_ptr vs. TensorAccessor loops ---
+
+typedef struct
+{
+    Tensor t;
+    int ndim;
+    const int* dims;
+    double sum;
+}
+ElementCtx;
+
+static void
+_run_element_ptr(void* ctx)
+{
+    ElementCtx* c = ctx;
+    int coords[8] = { 0 };
+    const size_t n = tensor_get_elements_count(c->t);
+
+    // 按行主序逐个坐标访问，最后一维变化最快
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++)
+    {
+        sum += *(const float*)tensor_get_element_ptr(c->t, coords);
+        for (int d = c->ndim - 1; d >= 0 && ++coords[d] == c->dims[d]; d--)
+            coords[d] = 0;
+    }
+    c->sum += sum;
+}
+
+static void
+_run_element_at(void* ctx)
+{
+    ElementCtx* c = ctx;
+    TensorAccessor a;
+    bench_check(tensor_accessor_init_const(&a, c->t, DTYPE_F32), "tensor_accessor_init_const failed");
+
+    float sum = 0.0f;
+    if (c->ndim == 2)
+        TENSOR_FOR_2D(a, i, j) sum += TENSOR_AT_F32(a, i, j);
+    else
+        TENSOR_FOR_4D(a, i, j, k, l) sum += TENSOR_AT_F32(a, i, j, k, l);
+    c->sum += sum;
+}
+
+static void
+_bench_element_ptr(void)
+{
+    const int dims2[] = { bench_pick(1024, 256), bench_pick(1024, 256) };
+    const int dims4[] = { bench_pick(32, 16), bench_pick(32, 16), bench_pick(32, 16), bench_pick(32, 16) };
+    const int axes4[] = { 3, 1, 2, 0 };
+    char name[BENCH_NAME_MAX], dims_name[64];
+
+    // 同样的访问顺序，分别经过 tensor_get_element_ptr() 和 TENSOR_AT_F32()
+    for (int index = 0; index < 6; index++)
+    {
+        const int variant = index % 3;
+        const bool accessor = index >= 3;
+        const int ndim = (variant == 0) ? 2 : 4;
+        const int* dims = (variant == 0) ? dims2 : dims4;
+        bench_format_dims(dims_name, sizeof(dims_name), dims, ndim);
+        snprintf(name, sizeof(name), "%s/f32/%s%s", accessor ? "element_at" : "element_ptr", dims_name,
+                 (variant == 2) ? "/permuted" : "");
+        if (!bench_selected(name)) continue;
+
+        Tensor base = bench_random(dims, ndim, DTYPE_F32);
+        Tensor t = (variant == 2) ? tensor_permute(base, axes4) : base;
+        bench_check(t != NULL, "tensor_permute failed");
+
+        // 置换后各维长度相同，dims 仍然适用
+        ElementCtx ctx = { t, ndim, dims, 0.0 };
+        const size_t n = tensor_get_elements_count(t);
+        bench_run(name, (BenchWork){ n * sizeof(float), n, 0 }, accessor ? _run_element_at : _run_element_ptr, &ctx);
+
+        if (t != base) tensor_free(t);
+        tensor_free(base);
+    }
+}
+
+// --- printing ---
+
+typedef struct
+{
+    Tensor t;
+    FILE* sink;
+    char* buffer;
+    size_t size;
+}
+PrintCtx;
+
+static void
+_run_fprint(void* ctx)
+{
+    PrintCtx* c = ctx;
+    tensor_fprint(c->sink, c->t);
+}
+
+static void
+_run_sprint(void* ctx)
+{
+    PrintCtx* c = ctx;
+    tensor_sprint(c->buffer, c->size, c->t);
+}
+
+static void
+_bench_print(void)
+{
+    char name[BENCH_NAME_MAX], dims_name[64];
+
+    // 大张量按默认设置打印摘要；输出写到 /dev/null，只量格式化本身
+    const int big[] = { bench_pick(4096, 512), bench_pick(4096, 512) };
+    bench_format_dims(dims_name, sizeof(dims_name), big, 2);
+    snprintf(name, sizeof(name), "print/summary/f32/%s", dims_name);
+    if (bench_selected(name))
+    {
+        PrintCtx ctx = { bench_random(big, 2, DTYPE_F32), fopen("/dev/null", "w"), NULL, 0 };
+        bench_check(ctx.sink != NULL, "cannot open /dev/null");
+        bench_run(name, (BenchWork){ 0, tensor_get_elements_count(ctx.t), 0 }, _run_fprint, &ctx);
+        fclose(ctx.sink);
+        tensor_free(ctx.t);
+    }
+
+    // 关闭摘要时每个元素都要格式化
+    const int full[] = { bench_pick(512, 128), bench_pick(512, 128) };
+    const DataType dtypes[] = { DTYPE_F32, DTYPE_F64, DTYPE_I32 };
+    bench_format_dims(dims_name, sizeof(dims_name), full, 2);
+    tensor_print_set_options(SIZE_MAX, TENSOR_PRINT_EDGE_ITEMS);
+    for (size_t i = 0; i < sizeof(dtypes) / sizeof(dtypes[0]); i++)
+    {
+        snprintf(name, sizeof(name), "print/full/%s/%s", bench_dtype_name(dtypes[i]), dims_name);
+        if (!bench_selected(name)) continue;
+
+        PrintCtx ctx = { bench_random(full, 2, dtypes[i]), NULL, NULL, 0 };
+        ctx.size = tensor_sprint(NULL, 0, ctx.t) + 1;
+        ctx.buffer = malloc(ctx.size);
+        bench_check(ctx.buffer != NULL, "out of memory");
+        bench_run(name, (BenchWork){ 0, tensor_get_elements_count(ctx.t), 0 }, _run_sprint, &ctx);
+        free(ctx.buffer);
+        tensor_free(ctx.t);
+    }
+    tensor_print_set_options(TENSOR_PRINT_THRESHOLD, TENSOR_PRINT_EDGE_ITEMS);
+}
+
+void
+bench_suite_core(void)
+{
+    _bench_create_free();
+    _bench_element_ptr();
+    _bench_print();
+}
@@ -0,0 +1,652 @@
+#include "_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// 大多数算子基准用同一个二维输入：默认 4096x4096（16M 个元素），--quick 时 512x512
+static void
+_matrix_dims(int* dims)
+{
+    dims[0] = bench_pick(4096, 512);
+    dims[1] = bench_pick(4096, 512);
+}
+
+// --- element-wise binary ops ---
+
+typedef struct
+{
+    Tensor out;
+    Tensor a;
+    Tensor b;
+    BinaryOp op;
+}
+BinaryCtx;
+
+static void
+_run_binary_out(void* ctx)
+{
+    BinaryCtx* c = ctx;
+    bench_check(tensor_binary_out(c->out, c->a, c->b, c->op), "tensor_binary_out failed");
+}
+
+static void
+_run_binary_inplace(void* ctx)
+{
+    BinaryCtx* c = ctx;
+    bench_check(tensor_binary_(c->a, c->b, c->op), "tensor_binary_ failed");
+}
+
+typedef struct
+{
+    const char* op_name;
+    BinaryOp op;
+    DataType dtype;
+    const char* layout; // "", "broadcast_row", "transposed_rhs" or "inplace"
+}
+BinaryCase;
+
+static const BinaryCase _binary_cases[] =
+{
+    { "add", BINARY_OP_ADD, DTYPE_F32, "" },
+    { "add", BINARY_OP_ADD, DTYPE_F64, "" },
+    { "add", BINARY_OP_ADD, DTYPE_I32, "" },
+    { "add", BINARY_OP_ADD, DTYPE_F16, "" },
+    { "div", BINARY_OP_DIV, DTYPE_I32, "" },
+    { "maximum", BINARY_OP_MAX, DTYPE_F32, "" },
+    { "mul", BINARY_OP_MUL, DTYPE_F32, "broadcast_row" },
+    { "add", BINARY_OP_ADD, DTYPE_F32, "transposed_rhs" },
+    { "add_", BINARY_OP_ADD, DTYPE_F32, "inplace" },
+};
+
+static void
+_bench_binary(void)
+{
+    char name[BENCH_NAME_MAX], dims_name[64];
+    int dims[2];
+    _matrix_dims(dims);
+    bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+
+    for (size_t i = 0; i < sizeof(_binary_cases) / sizeof(_binary_cases[0]); i++)
+    {
+        const BinaryCase* bc = &_binary_cases[i];
+        snprintf(name, sizeof(name), "binary/%s/%s/%s%s%s", bc->op_name, bench_dtype_name(bc->dtype),
+                 dims_name, bc->layout[0] ? "/" : "", bc->layout);
+        if (!bench_selected(name)) continue;
+
+        const bool broadcast = bc->layout[0] == 'b', transposed = bc->layout[0] == 't', inplace = bc->layout[0] == 'i';
+        const int row[] = { 1, dims[1] };
+        const int flipped[] = { dims[1], dims[0] };
+        const int transpose[] = { 1, 0 };
+
+        BinaryCtx ctx = { NULL, bench_random(dims, 2, bc->dtype), NULL, bc->op };
+        Tensor b_base = bench_random(broadcast ? row : transposed ? flipped : dims, 2, bc->dtype);
+        ctx.b = transposed ? tensor_permute(b_base, transpose) : b_base;
+        ctx.out = inplace ? NULL : tensor_binary(ctx.a, ctx.b, bc->op);
+        bench_check(ctx.b != NULL && (inplace || ctx.out != NULL), "creating binary operands failed");
+
+        const size_t n = tensor_get_elements_count(ctx.a), item = tensor_get_item_size(ctx.a);
+        const size_t bytes = (2 * n + tensor_get_elements_count(ctx.b)) * item;
+        bench_run(name, (BenchWork){ bytes, n, 0 }, inplace ? _run_binary_inplace : _run_binary_out, &ctx);
+
+        tensor_free(ctx.out);
+        if (ctx.b != b_base) tensor_free(ctx.b);
+        tensor_free(b_base);
+        tensor_free(ctx.a);
+    }
+}
+
+// --- lazy fusion vs. eager ops ---
+
+typedef struct
+{
+    Tensor out;
+    Tensor a;
+    Tensor b;
+    Tensor c;
+    LazyExpr expr;
+}
+FusionCtx;
+
+static void
+_run_lazy(void* ctx)
+{
+    FusionCtx* f = ctx;
+    bench_check(lazy_eval_out(f->out, f->expr), "lazy_eval_out failed");
+}
+
+static void
+_run_eager(void* ctx)
+{
+    FusionCtx* f = ctx;
+    bench_check(tensor_mul_out(f->out, f->a, f->b), "tensor_mul_out failed");
+    bench_check(tensor_add_(f->out, f->c), "tensor_add_ failed");
+}
+
+static void
+_bench_fusion(void)
+{
+    char name[BENCH_NAME_MAX], dims_name[64];
+    int dims[2];
+    _matrix_dims(dims);
+    bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+
+    char lazy_name[BENCH_NAME_MAX];
+    snprintf(name, sizeof(name), "eager/mul_add/f32/%s", dims_name);
+    snprintf(lazy_name, sizeof(lazy_name), "lazy/relu_mul_add/f32/%s", dims_name);
+    if (!bench_selected(name) && !bench_selected(lazy_name)) return;
+
+    FusionCtx ctx = { NULL, bench_random(dims, 2, DTYPE_F32), bench_random(dims, 2, DTYPE_F32),
+                      bench_random(dims, 2, DTYPE_F32), NULL };
+    LazyExpr a = lazy_tensor(ctx.a), b = lazy_tensor(ctx.b), c = lazy_tensor(ctx.c);
+    LazyExpr ab = lazy_mul(a, b), abc = lazy_add(ab, c);
+    ctx.expr = lazy_relu(abc);
+    ctx.out = tensor_copy(ctx.a);
+    bench_check(ctx.expr != NULL && ctx.out != NULL, "building the lazy expression failed");
+
+    const size_t n = tensor_get_elements_count(ctx.a);
+    // 融合后每个输入只读一次、结果只写一次；逐个算子执行还要多读写一遍中间结果
+    bench_run(lazy_name, (BenchWork){ 4 * n * sizeof(float), n, 0 }, _run_lazy, &ctx);
+    bench_run(name, (BenchWork){ 6 * n * sizeof(float), n, 0 }, _run_eager, &ctx);
+
+    lazy_free(ctx.expr);
+    lazy_free(abc);
+    lazy_free(ab);
+    lazy_free(c);
+    lazy_free(b);
+    lazy_free(a);
+    tensor_free(ctx.out);
+    tensor_free(ctx.c);
+    tensor_free(ctx.b);
+    tensor_free(ctx.a);
+}
+
+// --- reductions ---
+
+typedef enum
+{
+    REDUCE_SUM,
+    REDUCE_MEAN,
+    REDUCE_MAX,
+    REDUCE_ARGMAX,
+}
+ReduceKind;
+
+typedef struct
+{
+    const char* op_name;
+    ReduceKind kind;
+    DataType dtype;
+    int axis; // -1 reduces every axis
+}
+ReduceCase;
+
+static const ReduceCase _reduce_cases[] =
+{
+    { "sum", REDUCE_SUM, DTYPE_F32, -1 },
+    { "sum", REDUCE_SUM, DTYPE_F32, 0 },
+    { "sum", REDUCE_SUM, DTYPE_F32, 1 },
+    { "sum", REDUCE_SUM, DTYPE_F64, -1 },
+    { "sum", REDUCE_SUM, DTYPE_I32, -1 },
+    { "sum", REDUCE_SUM, DTYPE_F16, -1 },
+    { "mean", REDUCE_MEAN, DTYPE_F32, 1 },
+    { "max", REDUCE_MAX, DTYPE_F32, 1 },
+    { "argmax", REDUCE_ARGMAX, DTYPE_F32, 1 },
+};
+
+typedef struct
+{
+    Tensor t;
+    const ReduceCase* rc;
+}
+ReduceCtx;
+
+static void
+_run_reduce(void* ctx)
+{
+    ReduceCtx* c = ctx;
+    const int axis = c->rc->axis;
+    const int naxes = (axis < 0) ? 0 : 1;
+
+    switch (c->rc->kind)
+    {
+        case REDUCE_SUM:    bench_consume(tensor_sum(c->t, &axis, naxes, false)); break;
+        case REDUCE_MEAN:   bench_consume(tensor_mean(c->t, &axis, naxes, false)); break;
+        case REDUCE_MAX:    bench_consume(tensor_max(c->t, &axis, naxes, false)); break;
+        case REDUCE_ARGMAX: bench_consume(tensor_argmax(c->t, axis, false)); break;
+    }
+}
+
+static void
+_bench_reduce(void)
+{
+    char name[BENCH_NAME_MAX], dims_name[64];
+    int dims[2];
+    _matrix_dims(dims);
+    bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+
+    for (size_t i = 0; i < sizeof(_reduce_cases) / sizeof(_reduce_cases[0]); i++)
+    {
+        const ReduceCase* rc = &_reduce_cases[i];
+        char axis_name[16] = "all";
+        if (rc->axis >= 0) snprintf(axis_name, sizeof(axis_name), "axis%d", rc->axis);
+        snprintf(name, sizeof(name), "reduce/%s/%s/%s/%s", rc->op_name, bench_dtype_name(rc->dtype), dims_name, axis_name);
+        if (!bench_selected(name)) continue;
+
+        ReduceCtx ctx = { bench_random(dims, 2, rc->dtype), rc };
+        const size_t n = tensor_get_elements_count(ctx.t);
+        bench_run(name, (BenchWork){ n * tensor_get_item_size(ctx.t), n, 0 }, _run_reduce, &ctx);
+        tensor_free(ctx.t);
+    }
+}
+
+// --- softmax / log_softmax / layer_norm ---
+
+typedef enum
+{
+    NORM_SOFTMAX,
+    NORM_LOG_SOFTMAX,
+    NORM_LAYER_NORM,
+}
+NormKind;
+
+typedef struct
+{
+    Tensor out;
+    Tensor t;
+    Tensor weight;
+    Tensor bias;
+    NormKind kind;
+    int axis;
+}
+NormCtx;
+
+static void
+_run_norm(void* ctx)
+{
+    NormCtx* c = ctx;
+    bool ok = false;
+    switch (c->kind)
+    {
+        case NORM_SOFTMAX:     ok = tensor_softmax_out(c->out, c->t, c->axis); break;
+        case NORM_LOG_SOFTMAX: ok = tensor_log_softmax_out(c->out, c->t, c->axis); break;
+        case NORM_LAYER_NORM:  ok = tensor_layer_norm_out(c->out, c->t, c->axis, c->weight, c->bias, 1e-5); break;
+    }
+    bench_check(ok, "normalization op failed");
+}
+
+static void
+_bench_norm(void)
+{
+    static const struct { const char* op_name; NormKind kind; int axis; } cases[] =
+    {
+        { "softmax", NORM_SOFTMAX, 1 },
+        { "softmax", NORM_SOFTMAX, 0 },
+        { "log_softmax", NORM_LOG_SOFTMAX, 1 },
+        { "layer_norm", NORM_LAYER_NORM, 1 },
+    };
+    char name[BENCH_NAME_MAX], dims_name[64];
+    int dims[2];
+    _matrix_dims(dims);
+    bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        snprintf(name, sizeof(name), "norm/%s/f32/%s/axis%d", cases[i].op_name, dims_name, cases[i].axis);
+        if (!bench_selected(name)) continue;
+
+        NormCtx ctx = { NULL, bench_random(dims, 2, DTYPE_F32), NULL, NULL, cases[i].kind, cases[i].axis };
+        if (ctx.kind == NORM_LAYER_NORM)
+        {
+            ctx.weight = bench_random(&dims[ctx.axis], 1, DTYPE_F32);
+            ctx.bias = bench_random(&dims[ctx.axis], 1, DTYPE_F32);
+        }
+        ctx.out = tensor_copy(ctx.t);
+        bench_check(ctx.out != NULL, "tensor_copy failed");
+
+        const size_t n = tensor_get_elements_count(ctx.t);
+        bench_run(name, (BenchWork){ 2 * n * sizeof(float), n, 0 }, _run_norm, &ctx);
+
+        tensor_free(ctx.out);
+        tensor_free(ctx.bias);
+        tensor_free(ctx.weight);
+        tensor_free(ctx.t);
+    }
+}
+
+// --- topk / argsort ---
+
+typedef struct
+{
+    Tensor t;
+    int k; // 0 表示 argsort
+    int axis;
+}
+SortCtx;
+
+static void
+_run_sort(void* ctx)
+{
+    SortCtx* c = ctx;
+    if (c->k == 0)
+    {
+        bench_consume(tensor_argsort(c->t, c->axis, false));
+        return;
+    }
+
+    Tensor values = NULL, indices = NULL;
+    bench_check(tensor_topk(c->t, c->k, c->axis, true, &values, &indices), "tensor_topk failed");
+    tensor_free(values);
+    tensor_free(indices);
+}
+
+static void
+_bench_sort(void)
+{
+    const struct { int k; int axis; int dims[2]; int quick_dims[2]; } cases[] =
+    {
+        { 8, 1, { 512, 32768 }, { 64, 4096 } },
+        { 1024, 1, { 512, 32768 }, { 64, 4096 } },
+        { 8, 0, { 4096, 1024 }, { 1024, 256 } },
+        { 0, 1, { 1024, 4096 }, { 64, 1024 } },
+    };
+    char name[BENCH_NAME_MAX], dims_name[64];
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        const int* dims = bench_options()->quick ? cases[i].quick_dims : cases[i].dims;
+        bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+        if (cases[i].k == 0)
+            snprintf(name, sizeof(name), "sort/argsort/f32/%s/axis%d", dims_name, cases[i].axis);
+        else
+            snprintf(name, sizeof(name), "sort/topk%d/f32/%s/axis%d", cases[i].k, dims_name, cases[i].axis);
+        if (!bench_selected(name)) continue;
+
+        SortCtx ctx = { bench_random(dims, 2, DTYPE_F32), cases[i].k, cases[i].axis };
+        const size_t n = tensor_get_elements_count(ctx.t);
+        // argsort 还要写出每个元素的下标；topk 的输出可以忽略
+        const size_t bytes = n * sizeof(float) + ((ctx.k == 0) ? n * sizeof(int32_t) : 0);
+        bench_run(name, (BenchWork){ bytes, n, 0 }, _run_sort, &ctx);
+        tensor_free(ctx.t);
+    }
+}
+
+// --- index_select / gather / scatter_add ---
+
+typedef struct
+{
+    Tensor t;
+    Tensor indices;
+    Tensor src;
+    int axis;
+    int kind; // 0: index_select，1: gather，2: scatter_add_
+}
+IndexCtx;
+
+static void
+_run_index(void* ctx)
+{
+    IndexCtx* c = ctx;
+    switch (c->kind)
+    {
+        case 0: bench_consume(tensor_index_select(c->t, c->axis, c->indices)); break;
+        case 1: bench_consume(tensor_gather(c->t, c->axis, c->indices)); break;
+        default:
+            bench_check(tensor_scatter_add_(c->t, c->axis, c->indices, c->src, false), "tensor_scatter_add_ failed");
+            break;
+    }
+}
+
+static void
+_bench_index(void)
+{
+    char name[BENCH_NAME_MAX], dims_name[64];
+
+    // 嵌入查表：从大表里按随机下标取整行
+    const int table[] = { bench_pick(65536, 4096), 256 };
+    const int lookups[] = { bench_pick(16384, 1024) };
+    bench_format_dims(dims_name, sizeof(dims_name), table, 2);
+    snprintf(name, sizeof(name), "index/index_select/f32/%s/rows%d", dims_name, lookups[0]);
+    if (bench_selected(name))
+    {
+        IndexCtx ctx = { bench_random(table, 2, DTYPE_F32), bench_random_indices(lookups, 1, table[0]), NULL, 0, 0 };
+        const size_t n = (size_t)lookups[0] * (size_t)table[1];
+        bench_run(name, (BenchWork){ 2 * n * sizeof(float) + lookups[0] * sizeof(int32_t), n, 0 }, _run_index, &ctx);
+        tensor_free(ctx.indices);
+        tensor_free(ctx.t);
+    }
+
+    // gather / scatter_add：每行随机挑 picks 个位置
+    int dims[2];
+    _matrix_dims(dims);
+    const int picks[] = { dims[0], bench_pick(1024, 128) };
+    bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+    for (int kind = 1; kind <= 2; kind++)
+    {
+        snprintf(name, sizeof(name), "index/%s/f32/%s/picks%d", (kind == 1) ? "gather" : "scatter_add_", dims_name, picks[1]);
+        if (!bench_selected(name)) continue;
+
+        IndexCtx ctx = { bench_random(dims, 2, DTYPE_F32), bench_random_indices(picks, 2, dims[1]),
+                         (kind == 2) ? bench_random(picks, 2, DTYPE_F32) : NULL, 1, kind };
+        const size_t n = (size_t)picks[0] * (size_t)picks[1];
+        // gather：读下标、读源、写结果；scatter_add：读下标、读 src、读写目标
+        const size_t bytes = n * (sizeof(int32_t) + ((kind == 1) ? 2 : 3) * sizeof(float));
+        bench_run(name, (BenchWork){ bytes, n, 0 }, _run_index, &ctx);
+        tensor_free(ctx.src);
+        tensor_free(ctx.indices);
+        tensor_free(ctx.t);
+    }
+}
+
+// --- dtype conversion ---
+
+typedef struct
+{
+    Tensor t;
+    DataType dtype;
+    bool quantized;
+}
+CastCtx;
+
+static void
+_run_cast(void* ctx)
+{
+    CastCtx* c = ctx;
+    if (c->quantized)
+        bench_consume(tensor_to_dtype_quantized(c->t, c->dtype, 1.0f / 64.0f, 0));
+    else
+        bench_consume(tensor_to_dtype(c->t, c->dtype));
+}
+
+static void
+_bench_cast(void)
+{
+    static const struct { DataType from; DataType to; bool quantized; } cases[] =
+    {
+        { DTYPE_F32, DTYPE_F16, false },
+        { DTYPE_F16, DTYPE_F32, false },
+        { DTYPE_F32, DTYPE_BF16, false },
+        { DTYPE_BF16, DTYPE_F32, false },
+        { DTYPE_F32, DTYPE_F64, false },
+        { DTYPE_F64, DTYPE_F32, false },
+        { DTYPE_I32, DTYPE_F32, false },
+        { DTYPE_F32, DTYPE_I8, true },
+        { DTYPE_I8, DTYPE_F32, true },
+        { DTYPE_U8, DTYPE_F32, false },
+    };
+    char name[BENCH_NAME_MAX], dims_name[64];
+    int dims[2];
+    _matrix_dims(dims);
+    bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        snprintf(name, sizeof(name), "cast/%s_to_%s%s/%s", bench_dtype_name(cases[i].from), bench_dtype_name(cases[i].to),
+                 cases[i].quantized ? "_quantized" : "", dims_name);
+        if (!bench_selected(name)) continue;
+
+        CastCtx ctx = { bench_random(dims, 2, cases[i].from), cases[i].to, cases[i].quantized };
+        const size_t n = tensor_get_elements_count(ctx.t);
+        const size_t bytes = n * (tensor_dtype_size(cases[i].from) + tensor_dtype_size(cases[i].to));
+        bench_run(name, (BenchWork){ bytes, n, 0 }, _run_cast, &ctx);
+        tensor_free(ctx.t);
+    }
+}
+
+// --- matmul / bmm ---
+
+typedef struct
+{
+    Tensor a;
+    Tensor b;
+    bool batched;
+}
+MatmulCtx;
+
+static void
+_run_matmul(void* ctx)
+{
+    MatmulCtx* c = ctx;
+    bench_consume(c->batched ? tensor_bmm(c->a, c->b) : tensor_matmul(c->a, c->b));
+}
+
+static void
+_bench_matmul(void)
+{
+    char name[BENCH_NAME_MAX];
+    const int size = bench_pick(512, 128);
+    const DataType dtypes[] = { DTYPE_F32, DTYPE_F64 };
+
+    for (size_t i = 0; i < sizeof(dtypes) / sizeof(dtypes[0]); i++)
+    {
+        snprintf(name, sizeof(name), "matmul/%s/%dx%dx%d", bench_dtype_name(dtypes[i]), size, size, size);
+        if (!bench_selected(name)) continue;
+
+        const int dims[] = { size, size };
+        MatmulCtx ctx = { bench_random(dims, 2, dtypes[i]), bench_random(dims, 2, dtypes[i]), false };
+        const size_t n = (size_t)size * (size_t)size;
+        const double flops = 2.0 * (double)size * (double)n;
+        bench_run(name, (BenchWork){ 3 * n * tensor_dtype_size(dtypes[i]), n, flops }, _run_matmul, &ctx);
+        tensor_free(ctx.b);
+        tensor_free(ctx.a);
+    }
+
+    const int batch = bench_pick(32, 8), bsize = bench_pick(128, 64);
+    snprintf(name, sizeof(name), "bmm/f32/%dx%dx%dx%d", batch, bsize, bsize, bsize);
+    if (bench_selected(name))
+    {
+        const int dims[] = { batch, bsize, bsize };
+        MatmulCtx ctx = { bench_random(dims, 3, DTYPE_F32), bench_random(dims, 3, DTYPE_F32), true };
+        const size_t n = (size_t)batch * (size_t)bsize * (size_t)bsize;
+        const double flops = 2.0 * (double)bsize * (double)n;
+        bench_run(name, (BenchWork){ 3 * n * sizeof(float), n, flops }, _run_matmul, &ctx);
+        tensor_free(ctx.b);
+        tensor_free(ctx.a);
+    }
+}
+
+// --- .npy save / load ---
+
+typedef struct
+{
+    Tensor t;
+    const char* path;
+    const char* out_path;
+}
+IoCtx;
+
+static void
+_run_save(void* ctx)
+{
+    IoCtx* c = ctx;
+    bench_check(tensor_save_npy(c->t, c->path), "tensor_save_npy failed");
+}
+
+static void
+_run_load(void* ctx)
+{
+    IoCtx* c = ctx;
+    // 文件是映射进来的，求和才真正把数据读一遍
+    Tensor t = tensor_load_npy(c->path);
+    bench_check(t != NULL, "tensor_load_npy failed");
+    bench_consume(tensor_sum(t, NULL, 0, false));
+    tensor_free(t);
+}
+
+static bool
+_stream_double(const Tensor chunk, size_t first_row, Tensor* result, void* ctx)
+{
+    *result = tensor_add(chunk, chunk);
+    return *result != NULL;
+}
+
+static void
+_run_stream(void* ctx)
+{
+    IoCtx* c = ctx;
+    // 同样是加载、计算、保存，但按 8 块流水线进行，内存里只有几块
+    Tensor t = tensor_load_npy(c->path);
+    TensorWriter w = tensor_writer_open_npy(c->out_path);
+    bench_check(t != NULL && w != NULL, "opening the stream failed");
+    const size_t chunk_rows = (size_t)(tensor_get_dim(t, 0) + 7) / 8;
+    bench_check(tensor_stream(t, chunk_rows, _stream_double, NULL, w), "tensor_stream failed");
+    bench_check(tensor_writer_close(w), "tensor_writer_close failed");
+    tensor_free(t);
+}
+
+static void
+_run_load_save(void* ctx)
+{
+    IoCtx* c = ctx;
+    Tensor t = tensor_load_npy(c->path);
+    bench_check(t != NULL, "tensor_load_npy failed");
+    Tensor doubled = tensor_add(t, t);
+    bench_check(doubled != NULL && tensor_save_npy(doubled, c->out_path), "tensor_save_npy failed");
+    tensor_free(doubled);
+    tensor_free(t);
+}
+
+static void
+_bench_io(void)
+{
+    char name[BENCH_NAME_MAX], load_name[BENCH_NAME_MAX], dims_name[64], path[1024], out_path[1024];
+    char stream_name[BENCH_NAME_MAX], eager_name[BENCH_NAME_MAX];
+    const int dims[] = { bench_pick(2048, 256), 2048 };
+    bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+    snprintf(name, sizeof(name), "io/save_npy/f32/%s", dims_name);
+    snprintf(load_name, sizeof(load_name), "io/load_npy_sum/f32/%s", dims_name);
+    snprintf(stream_name, sizeof(stream_name), "io/stream_add/f32/%s", dims_name);
+    snprintf(eager_name, sizeof(eager_name), "io/load_add_save/f32/%s", dims_name);
+    const bool run_save = bench_selected(name), run_load = bench_selected(load_name);
+    const bool run_stream = bench_selected(stream_name), run_eager = bench_selected(eager_name);
+    if (!run_save && !run_load && !run_stream && !run_eager) return;
+
+    snprintf(path, sizeof(path), "%s/snake_bench_io.npy", bench_options()->tmpdir);
+    snprintf(out_path, sizeof(out_path), "%s/snake_bench_io_out.npy", bench_options()->tmpdir);
+    IoCtx ctx = { bench_random(dims, 2, DTYPE_F32), path, out_path };
+    const size_t n = tensor_get_elements_count(ctx.t);
+
+    // load 需要文件已经存在，所以先保存一次
+    _run_save(&ctx);
+    if (run_save) bench_run(name, (BenchWork){ n * sizeof(float), n, 0 }, _run_save, &ctx);
+    if (run_load) bench_run(load_name, (BenchWork){ n * sizeof(float), n, 0 }, _run_load, &ctx);
+    if (run_stream) bench_run(stream_name, (BenchWork){ 2 * n * sizeof(float), n, 0 }, _run_stream, &ctx);
+    if (run_eager) bench_run(eager_name, (BenchWork){ 2 * n * sizeof(float), n, 0 }, _run_load_save, &ctx);
+
+    remove(out_path);
+    remove(path);
+    tensor_free(ctx.t);
+}
+
+void
+bench_suite_ops(void)
+{
+    _bench_binary();
+    _bench_fusion();
+    _bench_reduce();
+    _bench_norm();
+    _bench_sort();
+    _bench_index();
+    _bench_cast();
+    _bench_matmul();
+    _bench_io();
+}
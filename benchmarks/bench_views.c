@@ -0,0 +1,198 @@
+#include "_bench.h"
+
+#include <stdio.h>
+
+// --- tensor_contiguous across permutations and ndim ---
+
+typedef struct
+{
+    int ndim;
+    int dims[6];
+    int quick_dims[6];
+    int axes[6];
+}
+PermuteCase;
+
+// 每种维数的元素个数都一样（默认 16M，--quick 时 256K 左右），只有访问模式不同
+static const PermuteCase _permute_cases[] =
+{
+    { 2, { 4096, 4096 }, { 512, 512 }, { 1, 0 } },
+    { 3, { 256, 256, 256 }, { 64, 64, 64 }, { 0, 2, 1 } },
+    { 3, { 256, 256, 256 }, { 64, 64, 64 }, { 1, 0, 2 } },
+    { 3, { 256, 256, 256 }, { 64, 64, 64 }, { 1, 2, 0 } },
+    { 3, { 256, 256, 256 }, { 64, 64, 64 }, { 2, 1, 0 } },
+    { 4, { 64, 64, 64, 64 }, { 24, 24, 24, 24 }, { 0, 1, 3, 2 } },
+    { 4, { 64, 64, 64, 64 }, { 24, 24, 24, 24 }, { 0, 2, 1, 3 } },
+    { 4, { 64, 64, 64, 64 }, { 24, 24, 24, 24 }, { 3, 2, 1, 0 } },
+    { 6, { 16, 16, 16, 16, 16, 16 }, { 8, 8, 8, 8, 8, 8 }, { 0, 2, 4, 1, 3, 5 } },
+    { 6, { 16, 16, 16, 16, 16, 16 }, { 8, 8, 8, 8, 8, 8 }, { 5, 4, 3, 2, 1, 0 } },
+};
+
+typedef struct
+{
+    Tensor view;
+}
+ViewCtx;
+
+static void
+_run_contiguous(void* ctx)
+{
+    ViewCtx* c = ctx;
+    bench_consume(tensor_contiguous(c->view));
+}
+
+// 对 t 的视图 view 量 tensor_contiguous()，然后释放两者
+static void
+_bench_contiguous_of(const char* name, Tensor t, Tensor view)
+{
+    bench_check(view != NULL, "creating a view failed");
+    const size_t n = tensor_get_elements_count(view);
+    ViewCtx ctx = { view };
+    bench_run(name, (BenchWork){ 2 * n * tensor_get_item_size(view), n, 0 }, _run_contiguous, &ctx);
+    tensor_free(view);
+    tensor_free(t);
+}
+
+static void
+_bench_contiguous(void)
+{
+    char name[BENCH_NAME_MAX], dims_name[64];
+
+    for (size_t i = 0; i < sizeof(_permute_cases) / sizeof(_permute_cases[0]); i++)
+    {
+        const PermuteCase* pc = &_permute_cases[i];
+        const int* dims = bench_options()->quick ? pc->quick_dims : pc->dims;
+        char axes_name[8];
+        for (int d = 0; d < pc->ndim; d++) axes_name[d] = (char)('0' + pc->axes[d]);
+        axes_name[pc->ndim] = '\0';
+
+        bench_format_dims(dims_name, sizeof(dims_name), dims, pc->ndim);
+        snprintf(name, sizeof(name), "contiguous/permute/f32/%s/%s", dims_name, axes_name);
+        if (!bench_selected(name)) continue;
+
+        Tensor t = bench_random(dims, pc->ndim, DTYPE_F32);
+        _bench_contiguous_of(name, t, tensor_permute(t, pc->axes));
+    }
+
+    // 转置在其他元素宽度上的表现
+    const int dims[] = { bench_pick(4096, 512), bench_pick(4096, 512) };
+    const int transpose[] = { 1, 0 };
+    const DataType dtypes[] = { DTYPE_F64, DTYPE_F16, DTYPE_I8 };
+    bench_format_dims(dims_name, sizeof(dims_name), dims, 2);
+    for (size_t i = 0; i < sizeof(dtypes) / sizeof(dtypes[0]); i++)
+    {
+        snprintf(name, sizeof(name), "contiguous/permute/%s/%s/10", bench_dtype_name(dtypes[i]), dims_name);
+        if (!bench_selected(name)) continue;
+
+        Tensor t = bench_random(dims, 2, dtypes[i]);
+        _bench_contiguous_of(name, t, tensor_permute(t, transpose));
+    }
+
+    // 隔列取值的切片：最内层 stride 为 2
+    const int wide[] = { dims[0], 2 * dims[1] };
+    bench_format_dims(dims_name, sizeof(dims_name), wide, 2);
+    snprintf(name, sizeof(name), "contiguous/slice_step2/f32/%s", dims_name);
+    if (bench_selected(name))
+    {
+        Tensor t = bench_random(wide, 2, DTYPE_F32);
+        _bench_contiguous_of(name, t, tensor_slice(t, 1, 0, wide[1], 2));
+    }
+}
+
+// --- broadcast via tensor_expand ---
+
+static void
+_bench_expand(void)
+{
+    char name[BENCH_NAME_MAX], dims_name[64];
+    const int out_dims[] = { bench_pick(4096, 512), bench_pick(4096, 512) };
+    bench_format_dims(dims_name, sizeof(dims_name), out_dims, 2);
+
+    // 0：一行广播成多行；1：一列广播成多列
+    for (int variant = 0; variant < 2; variant++)
+    {
+        snprintf(name, sizeof(name), "expand/%s/f32/%s", variant ? "column" : "row", dims_name);
+        if (!bench_selected(name)) continue;
+
+        const int in_dims[] = { variant ? out_dims[0] : 1, variant ? 1 : out_dims[1] };
+        Tensor t = bench_random(in_dims, 2, DTYPE_F32);
+        Shape target = shape_create(out_dims, 2);
+        bench_check(target != NULL, "shape_create failed");
+
+        ViewCtx ctx = { tensor_expand(t, target) };
+        bench_check(ctx.view != NULL, "tensor_expand failed");
+        const size_t n = tensor_get_elements_count(ctx.view);
+        const size_t bytes = (n + tensor_get_elements_count(t)) * sizeof(float);
+        bench_run(name, (BenchWork){ bytes, n, 0 }, _run_contiguous, &ctx);
+
+        tensor_free(ctx.view);
+        shape_free(target);
+        tensor_free(t);
+    }
+}
+
+// --- tensor_cat / tensor_stack ---
+
+#define BENCH_JOIN_INPUTS 4
+
+typedef struct
+{
+    Tensor out;
+    Tensor inputs[BENCH_JOIN_INPUTS];
+    int axis;
+}
+JoinCtx;
+
+static void
+_run_cat(void* ctx)
+{
+    JoinCtx* c = ctx;
+    bench_check(tensor_cat_out(c->out, c->inputs, BENCH_JOIN_INPUTS, c->axis), "tensor_cat_out failed");
+}
+
+static void
+_run_stack(void* ctx)
+{
+    JoinCtx* c = ctx;
+    bench_check(tensor_stack_out(c->out, c->inputs, BENCH_JOIN_INPUTS, c->axis), "tensor_stack_out failed");
+}
+
+static void
+_bench_join(void)
+{
+    char name[BENCH_NAME_MAX], dims_name[64];
+    const int rows = bench_pick(4096, 512), cols = bench_pick(4096, 512);
+
+    // cat 沿 axis 0 是整块复制，沿 axis 1 是逐行交错；stack 沿最后一个新轴是逐元素交错
+    for (int op = 0; op < 2; op++)
+    {
+        for (int axis = 0; axis < ((op == 0) ? 2 : 3); axis += (op == 0) ? 1 : 2)
+        {
+            const int in_dims[] = { (op == 0 && axis == 1) ? rows : rows / BENCH_JOIN_INPUTS,
+                                    (op == 0 && axis == 1) ? cols / BENCH_JOIN_INPUTS : cols };
+            bench_format_dims(dims_name, sizeof(dims_name), in_dims, 2);
+            snprintf(name, sizeof(name), "%s/axis%d/f32/%dx%s", op ? "stack" : "cat", axis, BENCH_JOIN_INPUTS, dims_name);
+            if (!bench_selected(name)) continue;
+
+            JoinCtx ctx = { NULL, { NULL }, axis };
+            for (int i = 0; i < BENCH_JOIN_INPUTS; i++) ctx.inputs[i] = bench_random(in_dims, 2, DTYPE_F32);
+            Tensor first = op ? tensor_stack(ctx.inputs, BENCH_JOIN_INPUTS, axis) : tensor_cat(ctx.inputs, BENCH_JOIN_INPUTS, axis);
+            bench_check(first != NULL, "tensor_cat/tensor_stack failed");
+            ctx.out = first;
+
+            const size_t n = tensor_get_elements_count(ctx.out);
+            bench_run(name, (BenchWork){ 2 * n * sizeof(float), n, 0 }, op ? _run_stack : _run_cat, &ctx);
+
+            tensor_free(ctx.out);
+            for (int i = 0; i < BENCH_JOIN_INPUTS; i++) tensor_free(ctx.inputs[i]);
+        }
+    }
+}
+
+void
+bench_suite_views(void)
+{
+    _bench_contiguous();
+    _bench_expand();
+    _bench_join();
+}
@@ -0,0 +1,78 @@
+// snake_bench: microbenchmarks for the hot paths of the tensor library.
+//
+// Every benchmark prints one line to stderr while it runs; the JSON report with all
+// results (stable names, median/min time, GB/s, ns/element and the fraction of a memcpy
+// moving the same bytes) is written to stdout, or to the file given with --json, so that
+// runs of different commits can be diffed directly:
+//
+//     snake_bench --label "$(git rev-parse --short HEAD)" --json bench.json
+//     snake_bench --filter contiguous/ --min-time 1
+//
+// Thread count and SIMD level follow SNAKE_NUM_THREADS and SNAKE_SIMD, like the library.
+
+#include "_bench.h"
+
+#include "utils/_parallel.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void
+_usage(FILE* f)
+{
+    fprintf(f,
+        "usage: snake_bench [options]\n"
+        "  --filter TEXT     run only benchmarks whose name contains TEXT\n"
+        "  --min-time SEC    time to spend measuring each benchmark (default 0.2)\n"
+        "  --json PATH       write the JSON report to PATH instead of stdout\n"
+        "  --label TEXT      label stored in the report, e.g. a commit id\n"
+        "  --threads N       number of threads (default: SNAKE_NUM_THREADS or all CPUs)\n"
+        "  --quick           small inputs, for smoke runs\n"
+        "  --tmpdir DIR      where the I/O benchmarks write their file (default /tmp)\n"
+        "  --list            print the selected benchmark names and exit\n");
+}
+
+int
+main(int argc, char** argv)
+{
+    BenchOptions options = { 0.2, NULL, false, false, "/tmp" };
+    const char* json_path = "-";
+    const char* label = "";
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        if (strcmp(arg, "--quick") == 0) options.quick = true;
+        else if (strcmp(arg, "--list") == 0) options.list = true;
+        else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            _usage(stdout);
+            return 0;
+        }
+        else if (has_value && strcmp(arg, "--filter") == 0) options.filter = argv[++i];
+        else if (has_value && strcmp(arg, "--min-time") == 0) options.min_time = strtod(argv[++i], NULL);
+        else if (has_value && strcmp(arg, "--json") == 0) json_path = argv[++i];
+        else if (has_value && strcmp(arg, "--label") == 0) label = argv[++i];
+        else if (has_value && strcmp(arg, "--tmpdir") == 0) options.tmpdir = argv[++i];
+        else if (has_value && strcmp(arg, "--threads") == 0) parallel_set_num_threads(atoi(argv[++i]));
+        else
+        {
+            fprintf(stderr, "Error: snake_bench: unknown or incomplete option '%s'\n", arg);
+            _usage(stderr);
+            return 2;
+        }
+    }
+
+    bench_init(&options);
+
+    bench_suite_core();
+    bench_suite_views();
+    bench_suite_ops();
+
+    const bool ok = options.list || bench_write_json(json_path, label);
+    bench_cleanup();
+    return ok ? 0 : 1;
+}
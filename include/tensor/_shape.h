@@ -19,8 +19,18 @@ typedef struct _shape* Shape;
  */
 Shape shape_create(const int* dims, int ndim);
 
+/**
+ * @brief Creates a new Shape object with explicit strides (in elements), e.g. for views.
+ * @param dims An array of `ndim` integers describing the dimensions.
+ * @param strides An array of `ndim` strides, in elements.
+ * @param ndim The number of dimensions.
+ * @return A new Shape object on success, or NULL if memory allocation fails.
+ */
+Shape shape_create_strided(const int* dims, const size_t* strides, int ndim);
+
 /**
  * @brief Creates a copy of an existing Shape object.
+ * For a cached shape (see shape_cache_set_enabled()) this only takes another reference.
  * @param other The Shape object to copy.
  * @return A new copy of the Shape object on success, or NULL on failure.
  */
@@ -28,11 +38,44 @@ Shape shape_copy(const Shape other);
 
 /**
  * @brief Frees all memory associated with a Shape object.
+ * For a cached shape this only drops one reference (see shape_cache_trim()).
  * @param shape The Shape object to free.
  */
 void shape_free(Shape shape);
 
 
+// --- Shape Cache ---
+//
+// Views and tensors of the same geometry would otherwise each carry their own copy of an
+// identical Shape. While the cache is enabled, every function here that returns a Shape
+// hands out a shared, immutable, reference-counted instance: identical dims and strides give
+// the same pointer, a hit costs no allocation, shape_copy()/shape_free() only adjust the
+// count, and shape_equals() on two cached shapes is a pointer compare.
+// Cached shapes live on the heap even inside an arena scope, so tensors holding them must
+// still be released with tensor_free().
+
+/**
+ * @brief Enables or disables the shape cache. It is disabled by default unless the
+ * SNAKE_SHAPE_CACHE environment variable is set to a non-zero value.
+ * Shapes created before the change stay valid either way.
+ * @param enabled Whether newly created shapes are taken from the cache.
+ */
+void shape_cache_set_enabled(bool enabled);
+
+/**
+ * @brief Tells whether newly created shapes are taken from the cache.
+ */
+bool shape_cache_is_enabled(void);
+
+/**
+ * @brief Frees the cached shapes that are no longer referenced. The cache keeps a bounded
+ * number of them around so that a shape created and freed in a loop is not reallocated
+ * every time; disabling the cache trims it as well.
+ * @return The number of distinct cached shapes still in use.
+ */
+size_t shape_cache_trim(void);
+
+
 // --- Accessor Functions ---
 
 /**
@@ -94,8 +137,40 @@ void shape_print(const Shape shape);
  */
 bool shape_is_contiguous(const Shape shape);
 
+/**
+ * @brief Checks that no two index positions of the shape map to the same element.
+ * The test is conservative: broadcast (stride 0) and sliding-window layouts are
+ * reported as overlapping, and so are a few unusual layouts that interleave without
+ * actually colliding. Shapes with no elements never overlap.
+ * @param shape The Shape to check.
+ * @return true if the layout is known to be free of self-overlap.
+ */
+bool shape_is_non_overlapping(const Shape shape);
+
 Shape shape_permute(const Shape source_shape, const int* axes);
 
 Shape shape_expand(const Shape source_shape, const Shape target_shape);
 
+/**
+ * @brief Computes the strides that view data laid out as `source_shape` with new dimensions.
+ * This works whenever every group of source dimensions that gets merged or split is
+ * contiguous with itself (e.g. flattening the trailing dims of a sliced tensor), even if
+ * the source as a whole is not contiguous.
+ * @param source_shape The current shape and strides.
+ * @param dims The requested dimensions; their product must equal the source element count.
+ * @param ndim The number of requested dimensions.
+ * @return A new Shape with `dims` and the view strides, or NULL if no such view exists
+ * (the data would have to be copied) or on allocation failure. Prints nothing.
+ */
+Shape shape_reshape(const Shape source_shape, const int* dims, int ndim);
+
+/**
+ * @brief Computes the broadcast result shape of two shapes (NumPy rules, aligned from the right).
+ * Each pair of dimensions must be equal, or one of them must be 1.
+ * @param a The first Shape object.
+ * @param b The second Shape object.
+ * @return A new contiguous Shape holding the broadcast dimensions, or NULL if the shapes are incompatible.
+ */
+Shape shape_broadcast(const Shape a, const Shape b);
+
 #endif // _SHAPE_H
\ No newline at end of file
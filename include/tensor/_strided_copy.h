@@ -0,0 +1,27 @@
+#ifndef _STRIDED_COPY_H
+#define _STRIDED_COPY_H
+
+#include <stdbool.h>
+#include <stddef.h> // For size_t
+
+/**
+ * @brief Copies an N-dimensional strided block of elements from `src` to `dst`.
+ * Adjacent dimensions whose strides line up in both operands are merged first,
+ * so most permuted layouts collapse into a few long runs. Contiguous runs are
+ * moved with memcpy, transpose-like layouts (as produced by tensor_permute) go
+ * through cache-blocked tiles, and everything else uses a typed strided loop.
+ *
+ * @param dst Base pointer of the destination block.
+ * @param dst_strides Destination strides, in elements.
+ * @param src Base pointer of the source block.
+ * @param src_strides Source strides, in elements. A stride of 0 (broadcast) is allowed.
+ * @param dims The logical dimensions shared by both blocks.
+ * @param ndim The number of dimensions.
+ * @param item_size The size of one element in bytes.
+ * @return true on success, false if the layout has too many dimensions to be handled.
+ */
+bool strided_copy(void* dst, const size_t* dst_strides,
+                  const void* src, const size_t* src_strides,
+                  const int* dims, int ndim, size_t item_size);
+
+#endif // _STRIDED_COPY_H
@@ -0,0 +1,252 @@
+#ifndef _TENSOR_ACCESS_H
+#define _TENSOR_ACCESS_H
+
+#include "tensor/_tensor_core.h"
+
+#include <stdbool.h>
+#include <stddef.h> // For size_t
+#include <stdint.h> // For int32_t, int8_t, uint8_t, uint16_t
+
+// --- Unchecked typed element access ---
+//
+// tensor_get_element_ptr() looks everything up again for every element and returns void*,
+// so loops built on it cannot be optimized. A TensorAccessor resolves the data pointer,
+// strides and dims of a tensor once; the macros below then reduce an element access to
+// pointer arithmetic the compiler can see through:
+//
+//     TensorAccessor x;
+//     if (!tensor_accessor_init_const(&x, t, DTYPE_F32)) return false;
+//     float sum = 0.0f;
+//     TENSOR_FOR_2D(x, i, j)
+//         sum += TENSOR_AT_F32(x, i, j);
+//
+// Nothing is checked per access: indices must be in range and exactly `ndim` of them
+// must be given. An accessor is a snapshot; it stays valid as long as the tensor (or any
+// view sharing its data) is alive.
+
+#define TENSOR_ACCESS_MAX_DIMS 4
+
+typedef struct
+{
+    char* data;                             // element (0, ..., 0)
+    size_t strides[TENSOR_ACCESS_MAX_DIMS]; // in bytes; 0 for broadcast dimensions
+    int dims[TENSOR_ACCESS_MAX_DIMS];
+    int ndim;
+    DataType dtype;
+}
+TensorAccessor;
+
+/**
+ * @brief Prepares writable access to `t`. Like tensor_get_data(), this un-shares
+ * copy-on-write data first and keeps later tensor_copy() calls from sharing it, so
+ * writes through the accessor only ever affect `t` and its views.
+ * @param a The accessor to fill.
+ * @param t The tensor (any layout, at most TENSOR_ACCESS_MAX_DIMS dimensions).
+ * @param dtype The dtype the caller will access; must be t's dtype.
+ * @return true on success, false if `t` is NULL, has another dtype or too many dimensions.
+ */
+bool tensor_accessor_init(TensorAccessor* a, Tensor t, DataType dtype);
+
+/**
+ * @brief Like tensor_accessor_init() for reading only; copy-on-write data stays shared,
+ * so the accessor must not be written through.
+ */
+bool tensor_accessor_init_const(TensorAccessor* a, const Tensor t, DataType dtype);
+
+#define _TENSOR_OFFSET_1(a, i) ((size_t)(i) * (a).strides[0])
+#define _TENSOR_OFFSET_2(a, i, j) (_TENSOR_OFFSET_1(a, i) + (size_t)(j) * (a).strides[1])
+#define _TENSOR_OFFSET_3(a, i, j, k) (_TENSOR_OFFSET_2(a, i, j) + (size_t)(k) * (a).strides[2])
+#define _TENSOR_OFFSET_4(a, i, j, k, l) (_TENSOR_OFFSET_3(a, i, j, k) + (size_t)(l) * (a).strides[3])
+#define _TENSOR_OFFSET_PICK(_1, _2, _3, _4, NAME, ...) NAME
+
+/**
+ * @brief Byte address (char*) of element (i, ...) of accessor `a`, for 1 to 4 indices.
+ */
+#define TENSOR_PTR(a, ...) \
+    ((a).data + _TENSOR_OFFSET_PICK(__VA_ARGS__, _TENSOR_OFFSET_4, _TENSOR_OFFSET_3, \
+                                    _TENSOR_OFFSET_2, _TENSOR_OFFSET_1, )(a, __VA_ARGS__))
+
+/**
+ * @brief Element (i, ...) of accessor `a` as an lvalue of C type `T`.
+ */
+#define TENSOR_AT(T, a, ...) (*(T*)(void*)TENSOR_PTR(a, __VA_ARGS__))
+
+#define TENSOR_AT_I32(a, ...) TENSOR_AT(int32_t, a, __VA_ARGS__)
+#define TENSOR_AT_F32(a, ...) TENSOR_AT(float, a, __VA_ARGS__)
+#define TENSOR_AT_F64(a, ...) TENSOR_AT(double, a, __VA_ARGS__)
+#define TENSOR_AT_F16(a, ...) TENSOR_AT(uint16_t, a, __VA_ARGS__)  // raw bits, see f16_to_f32()
+#define TENSOR_AT_BF16(a, ...) TENSOR_AT(uint16_t, a, __VA_ARGS__) // raw bits, see bf16_to_f32()
+#define TENSOR_AT_I8(a, ...) TENSOR_AT(int8_t, a, __VA_ARGS__)
+#define TENSOR_AT_U8(a, ...) TENSOR_AT(uint8_t, a, __VA_ARGS__)
+
+/**
+ * @brief Row-major loops over every index of a 1- to 4-dimensional accessor.
+ * The loop variables are ints declared by the macro; the body follows like a for loop.
+ */
+#define TENSOR_FOR_1D(a, i) \
+    for (int i = 0; i < (a).dims[0]; i++)
+#define TENSOR_FOR_2D(a, i, j) \
+    TENSOR_FOR_1D(a, i) for (int j = 0; j < (a).dims[1]; j++)
+#define TENSOR_FOR_3D(a, i, j, k) \
+    TENSOR_FOR_2D(a, i, j) for (int k = 0; k < (a).dims[2]; k++)
+#define TENSOR_FOR_4D(a, i, j, k, l) \
+    TENSOR_FOR_3D(a, i, j, k) for (int l = 0; l < (a).dims[3]; l++)
+
+// --- Kernel templates ---
+//
+// These macros stamp out element-wise kernels for fixed C types, so that op implementations
+// get one specialized, inlinable loop per dtype instead of a per-element switch. EXPR is an
+// expression of `x` (unary) or `x` and `y` (binary), the input values, converted to TO.
+//
+// The ROW variants define a function over one strided run; it matches the runs produced
+// by TensorIter:
+//
+//     TENSOR_DEFINE_UNARY_ROW(_halve_f32, float, float, x * 0.5f)
+//     ...
+//     while (tensor_iter_next(&it))
+//         _halve_f32(it.ptrs[0], it.ptrs[1], it.inner_size, it.inner_strides[0], it.inner_strides[1]);
+//
+// When every operand is contiguous the run is processed in blocks of TENSOR_KERNEL_BLOCK
+// elements, a fixed trip count the compiler vectorizes even at -O2. The binary template
+// also has a fast path for a broadcast (stride 0) right operand.
+//
+// The KERNEL variants additionally define NAME##_row as above and NAME(out, in...) over
+// whole accessors with the dims of `out` (broadcast operands have stride 0 there), walking
+// the outer dimensions and handing each innermost row to NAME##_row.
+
+#define TENSOR_KERNEL_BLOCK 16
+
+#define TENSOR_DEFINE_UNARY_ROW(NAME, TO, TI, EXPR)                                          \
+static void                                                                                  \
+NAME(char* out, const char* in, size_t n, size_t out_stride, size_t in_stride)               \
+{                                                                                            \
+    size_t e = 0;                                                                            \
+    if (out_stride == sizeof(TO) && in_stride == sizeof(TI))                                 \
+    {                                                                                        \
+        TO* o = (TO*)(void*)out;                                                             \
+        const TI* p = (const TI*)(const void*)in;                                            \
+        for (; e + TENSOR_KERNEL_BLOCK <= n; e += TENSOR_KERNEL_BLOCK)                       \
+            for (size_t b = 0; b < TENSOR_KERNEL_BLOCK; b++)                                 \
+            {                                                                                \
+                const TI x = p[e + b];                                                       \
+                o[e + b] = (TO)(EXPR);                                                       \
+            }                                                                                \
+        for (; e < n; e++)                                                                   \
+        {                                                                                    \
+            const TI x = p[e];                                                               \
+            o[e] = (TO)(EXPR);                                                               \
+        }                                                                                    \
+        return;                                                                              \
+    }                                                                                        \
+    for (; e < n; e++)                                                                       \
+    {                                                                                        \
+        const TI x = *(const TI*)(const void*)(in + e * in_stride);                          \
+        *(TO*)(void*)(out + e * out_stride) = (TO)(EXPR);                                    \
+    }                                                                                        \
+}
+
+#define TENSOR_DEFINE_BINARY_ROW(NAME, TO, TA, TB, EXPR)                                     \
+static void                                                                                  \
+NAME(char* out, const char* a, const char* b, size_t n,                                      \
+     size_t out_stride, size_t a_stride, size_t b_stride)                                    \
+{                                                                                            \
+    size_t e = 0;                                                                            \
+    if (out_stride == sizeof(TO) && a_stride == sizeof(TA) &&                                \
+        (b_stride == sizeof(TB) || b_stride == 0))                                           \
+    {                                                                                        \
+        TO* o = (TO*)(void*)out;                                                             \
+        const TA* p = (const TA*)(const void*)a;                                             \
+        const TB* q = (const TB*)(const void*)b;                                             \
+        if (b_stride == 0)                                                                   \
+        {                                                                                    \
+            const TB y = *q;                                                                 \
+            for (; e + TENSOR_KERNEL_BLOCK <= n; e += TENSOR_KERNEL_BLOCK)                   \
+                for (size_t k = 0; k < TENSOR_KERNEL_BLOCK; k++)                             \
+                {                                                                            \
+                    const TA x = p[e + k];                                                   \
+                    o[e + k] = (TO)(EXPR);                                                   \
+                }                                                                            \
+            for (; e < n; e++)                                                               \
+            {                                                                                \
+                const TA x = p[e];                                                           \
+                o[e] = (TO)(EXPR);                                                           \
+            }                                                                                \
+            return;                                                                          \
+        }                                                                                    \
+        for (; e + TENSOR_KERNEL_BLOCK <= n; e += TENSOR_KERNEL_BLOCK)                       \
+            for (size_t k = 0; k < TENSOR_KERNEL_BLOCK; k++)                                 \
+            {                                                                                \
+                const TA x = p[e + k];                                                       \
+                const TB y = q[e + k];                                                       \
+                o[e + k] = (TO)(EXPR);                                                       \
+            }                                                                                \
+        for (; e < n; e++)                                                                   \
+        {                                                                                    \
+            const TA x = p[e];                                                               \
+            const TB y = q[e];                                                               \
+            o[e] = (TO)(EXPR);                                                               \
+        }                                                                                    \
+        return;                                                                              \
+    }                                                                                        \
+    for (; e < n; e++)                                                                       \
+    {                                                                                        \
+        const TA x = *(const TA*)(const void*)(a + e * a_stride);                            \
+        const TB y = *(const TB*)(const void*)(b + e * b_stride);                            \
+        *(TO*)(void*)(out + e * out_stride) = (TO)(EXPR);                                    \
+    }                                                                                        \
+}
+
+// 最内层一维交给 ROW 函数，外层最多三维；不存在的外层维度按长度 1、stride 0 处理。
+// 循环体里 _o/_a/_b 是各操作数当前行的起点偏移（字节）
+#define _TENSOR_FOR_ROWS(nd, out, a, b, ...)                                                 \
+    {                                                                                        \
+        int _dims[3] = { 1, 1, 1 };                                                          \
+        size_t _so[3] = { 0, 0, 0 }, _sa[3] = { 0, 0, 0 }, _sb[3] = { 0, 0, 0 };             \
+        for (int _d = 0; _d < (nd) - 1; _d++)                                                \
+        {                                                                                    \
+            const int _s = 3 - ((nd) - 1) + _d;                                              \
+            _dims[_s] = (out)->dims[_d];                                                     \
+            _so[_s] = (out)->strides[_d];                                                    \
+            _sa[_s] = (a)->strides[_d];                                                      \
+            _sb[_s] = (b)->strides[_d];                                                      \
+        }                                                                                    \
+        for (int _i = 0; _i < _dims[0]; _i++)                                                \
+            for (int _j = 0; _j < _dims[1]; _j++)                                            \
+                for (int _k = 0; _k < _dims[2]; _k++)                                        \
+                {                                                                            \
+                    const size_t _o = _i * _so[0] + _j * _so[1] + _k * _so[2];               \
+                    const size_t _a = _i * _sa[0] + _j * _sa[1] + _k * _sa[2];               \
+                    const size_t _b = _i * _sb[0] + _j * _sb[1] + _k * _sb[2];               \
+                    (void)_b;                                                                \
+                    __VA_ARGS__;                                                             \
+                }                                                                            \
+    }
+
+#define TENSOR_DEFINE_UNARY_KERNEL(NAME, TO, TI, EXPR)                                       \
+TENSOR_DEFINE_UNARY_ROW(NAME##_row, TO, TI, EXPR)                                            \
+static void                                                                                  \
+NAME(const TensorAccessor* out, const TensorAccessor* in)                                    \
+{                                                                                            \
+    const int nd = out->ndim;                                                                \
+    const size_t n = (nd > 0) ? (size_t)out->dims[nd - 1] : 1;                               \
+    const size_t so = (nd > 0) ? out->strides[nd - 1] : sizeof(TO);                          \
+    const size_t si = (nd > 0) ? in->strides[nd - 1] : sizeof(TI);                           \
+    _TENSOR_FOR_ROWS(nd, out, in, in,                                                        \
+                     NAME##_row(out->data + _o, in->data + _a, n, so, si))                   \
+}
+
+#define TENSOR_DEFINE_BINARY_KERNEL(NAME, TO, TA, TB, EXPR)                                  \
+TENSOR_DEFINE_BINARY_ROW(NAME##_row, TO, TA, TB, EXPR)                                       \
+static void                                                                                  \
+NAME(const TensorAccessor* out, const TensorAccessor* a, const TensorAccessor* b)            \
+{                                                                                            \
+    const int nd = out->ndim;                                                                \
+    const size_t n = (nd > 0) ? (size_t)out->dims[nd - 1] : 1;                               \
+    const size_t so = (nd > 0) ? out->strides[nd - 1] : sizeof(TO);                          \
+    const size_t sa = (nd > 0) ? a->strides[nd - 1] : sizeof(TA);                            \
+    const size_t sb = (nd > 0) ? b->strides[nd - 1] : sizeof(TB);                            \
+    _TENSOR_FOR_ROWS(nd, out, a, b,                                                          \
+                     NAME##_row(out->data + _o, a->data + _a, b->data + _b, n, so, sa, sb))  \
+}
+
+#endif // _TENSOR_ACCESS_H
@@ -0,0 +1,143 @@
+#ifndef _TENSOR_CAST_H
+#define _TENSOR_CAST_H
+
+#include "tensor/_tensor_core.h"
+
+#include <stdint.h> // For uint16_t, uint32_t
+#include <string.h> // For memcpy
+
+// --- Converting between dtypes ---
+//
+// F16 and BF16 elements are stored as their uint16_t bit patterns. The helpers
+// below convert single values; tensor_to_dtype() converts whole tensors using the
+// CPU's conversion instructions where available (F16C, AVX-512 BF16, NEON fp16).
+// Float to F16/BF16 conversions round to nearest, ties to even, like the hardware.
+
+/**
+ * @brief Converts F16 bits to a float (exact; signaling NaNs become quiet, as in hardware).
+ */
+static inline float
+f16_to_f32(uint16_t h)
+{
+    const uint32_t sign = (uint32_t)(h & 0x8000) << 16;
+    const uint32_t exp = (h >> 10) & 0x1f;
+    uint32_t mant = h & 0x3ff;
+    uint32_t bits;
+
+    if (exp == 0x1f) // Inf / NaN
+    {
+        bits = sign | 0x7f800000 | (mant << 13) | (mant != 0 ? 0x400000 : 0);
+    }
+    else if (exp != 0) // normal
+    {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    }
+    else if (mant == 0) // +-0
+    {
+        bits = sign;
+    }
+    else // subnormal: normalize
+    {
+        uint32_t e = 113;
+        while ((mant & 0x400) == 0)
+        {
+            mant <<= 1;
+            e--;
+        }
+        bits = sign | (e << 23) | ((mant & 0x3ff) << 13);
+    }
+
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief Converts a float to F16 bits, rounding to nearest even (overflow gives Inf).
+ */
+static inline uint16_t
+f32_to_f16(float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    const uint32_t abs = bits & 0x7fffffff;
+
+    if (abs >= 0x7f800000) // Inf / NaN (NaNs stay quiet NaNs)
+        return sign | 0x7c00 | ((abs > 0x7f800000) ? (0x200 | ((abs >> 13) & 0x3ff)) : 0);
+    if (abs >= 0x477ff000) // rounds to a value beyond the F16 range
+        return sign | 0x7c00;
+    if (abs < 0x38800000) // result is subnormal or zero
+    {
+        if (abs < 0x33000000) return sign; // below half of the smallest subnormal
+        const uint32_t exp = abs >> 23;
+        const uint32_t mant = (abs & 0x7fffff) | 0x800000;
+        const uint32_t shift = 126 - exp; // 14..24
+        uint32_t result = mant >> shift;
+        const uint32_t rest = mant & ((1u << shift) - 1);
+        const uint32_t half = 1u << (shift - 1);
+        if (rest > half || (rest == half && (result & 1))) result++;
+        return sign | (uint16_t)result;
+    }
+
+    // normal: rebias the exponent and round the 13 dropped bits to nearest even
+    const uint32_t rounded = abs + 0xfff + ((abs >> 13) & 1);
+    return sign | (uint16_t)((rounded - (112u << 23)) >> 13);
+}
+
+/**
+ * @brief Converts BF16 bits to a float (exact).
+ */
+static inline float
+bf16_to_f32(uint16_t h)
+{
+    const uint32_t bits = (uint32_t)h << 16;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/**
+ * @brief Converts a float to BF16 bits, rounding to nearest even. Denormal inputs
+ * become zero, as with the AVX-512 BF16 instructions, so results match on every CPU.
+ */
+static inline uint16_t
+f32_to_bf16(float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    if ((bits & 0x7fffffff) > 0x7f800000) return (uint16_t)((bits >> 16) | 0x40); // quiet NaN
+    if ((bits & 0x7f800000) == 0) return (uint16_t)((bits >> 16) & 0x8000);        // +-0, denormals
+    return (uint16_t)((bits + 0x7fff + ((bits >> 16) & 1)) >> 16);
+}
+
+/**
+ * @brief Converts a tensor to another dtype.
+ * Integer to integer conversions wrap around, as in C. Float to integer conversions
+ * truncate toward zero and saturate at the limits of the target (NaN becomes 0).
+ * Converting to the tensor's own dtype makes a contiguous copy.
+ *
+ * @param t The tensor to convert (any layout).
+ * @param dtype The target dtype.
+ * @return A new contiguous tensor, or NULL on failure.
+ */
+Tensor tensor_to_dtype(const Tensor t, DataType dtype);
+
+/**
+ * @brief Quantizes to, or dequantizes from, DTYPE_I8 / DTYPE_U8 with an affine mapping
+ * real = (q - zero_point) * scale.
+ *
+ * With an integer target `dtype` (I8 or U8) and a floating-point `t`, each element
+ * becomes q = clamp(round(x * (1 / scale)) + zero_point) (round to nearest, ties to
+ * even; NaN saturates to the top of the range). With an I8/U8 `t` and a floating-point
+ * `dtype`, each element becomes (q - zero_point) * scale.
+ *
+ * @param t The tensor to convert (any layout).
+ * @param dtype The target dtype.
+ * @param scale The quantization step; must be positive and finite.
+ * @param zero_point The integer that represents 0.0; must fit in the I8/U8 dtype.
+ * @return A new contiguous tensor, or NULL on failure (e.g. for other dtype pairs).
+ */
+Tensor tensor_to_dtype_quantized(const Tensor t, DataType dtype, float scale, int zero_point);
+
+#endif // _TENSOR_CAST_H
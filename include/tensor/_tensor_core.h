@@ -2,6 +2,7 @@
 #define _TENSOR_CORE_H
 
 #include "tensor/_shape.h" 
+#include "tensor/_tensor_storage.h"
 
 struct _tensor;
 typedef struct _tensor* Tensor;
@@ -10,18 +11,60 @@ typedef enum
 {
     DTYPE_I32,
     DTYPE_F32,
-    DTYPE_F64
+    DTYPE_F64,
+    DTYPE_F16,  // IEEE 754 half precision (uint16_t bits, see _tensor_cast.h)
+    DTYPE_BF16, // bfloat16: the upper half of an F32 (uint16_t bits)
+    DTYPE_I8,
+    DTYPE_U8,
+    DTYPE_COUNT
 } 
 DataType;
 
+// The narrow dtypes (F16, BF16, I8, U8) are storage formats: element-wise ops and
+// reductions read them, compute in F32 (F16, BF16) or I32 (I8, U8), and round the
+// results back. Integer results wrap around as in C. Matrix products and lazy
+// expressions need I32/F32/F64; convert with tensor_to_dtype() first.
+
+/**
+ * @brief Size of one element of `dtype` in bytes, or 0 if `dtype` is not valid.
+ */
+size_t tensor_dtype_size(DataType dtype);
+
 
 Tensor tensor_create(const Shape shape, DataType dtype);
+
+/**
+ * @brief Creates a contiguous tensor whose contents are left uninitialized.
+ * Use it when every element is about to be overwritten; it skips the zero-fill
+ * that tensor_create() does.
+ *
+ * @param shape The shape of the tensor (only its dims are used).
+ * @param dtype The data type of the elements.
+ * @return A new Tensor object on success, or NULL on failure.
+ */
+Tensor tensor_empty(const Shape shape, DataType dtype);
+
+/**
+ * @brief Creates a contiguous tensor filled with zeros.
+ * Unlike tensor_create(), the fill is done in parallel, so each page is first
+ * touched (and, on NUMA systems, placed) by the thread that later processes it.
+ */
+Tensor tensor_zeros(const Shape shape, DataType dtype);
+
+/**
+ * @brief Creates a contiguous tensor with every element set to `value`
+ * (converted to `dtype` as tensor_to_dtype() would: integer dtypes saturate and NaN
+ * becomes 0). The fill is done in parallel, like tensor_zeros().
+ */
+Tensor tensor_full(const Shape shape, DataType dtype, double value);
+
 void tensor_free(Tensor tensor);
 Tensor tensor_copy(const Tensor tensor);
 /**
  * @brief Creates a new tensor and initializes it with data from a provided buffer.
  * The function creates a new tensor that OWNS its data. It allocates new memory
- * and copies the content from the `data` buffer.
+ * and copies the content from the `data` buffer. To wrap a buffer without copying
+ * it, see tensor_from_buffer().
  *
  * @param data A const pointer to the buffer containing the data to copy.
  * @param shape The shape of the tensor to be created.
@@ -32,7 +75,24 @@ Tensor tensor_from_data(const void* data, const Shape shape, DataType dtype);
 
 
 Shape tensor_get_shape(const Tensor tensor);
+/**
+ * @brief Gets a writable pointer to the tensor's first element.
+ * If the data is still shared copy-on-write with a tensor_copy() of it, this call
+ * makes the private copy first, so only take it when you are going to write.
+ * Returns NULL if that copy cannot be allocated.
+ *
+ * The pointer stays valid and writable for the life of the tensor's data. Because
+ * writes through it cannot be seen, the data is never shared copy-on-write again:
+ * a later tensor_copy() (or tensor_contiguous() of a contiguous tensor) copies it
+ * right away, in O(n), so that writing through the pointer never reaches the copy.
+ * Use tensor_get_data_const() when only reading, to keep copies O(1).
+ */
 void* tensor_get_data(const Tensor tensor);
+
+/**
+ * @brief Gets a read-only pointer to the tensor's first element. Never copies.
+ */
+const void* tensor_get_data_const(const Tensor tensor);
 DataType tensor_get_dtype(const Tensor tensor);
 int tensor_get_ndim(const Tensor tensor);
 int tensor_get_dim(const Tensor tensor, int axis);
@@ -41,17 +101,121 @@ size_t tensor_get_elements_count(const Tensor tensor);
 size_t tensor_get_item_size(const Tensor tensor);
 
 /**
- * @brief (Internal) Creates a new Tensor that is a "view" on existing data.
- * This new tensor does NOT own the data. The caller is responsible for providing
- * a new Shape object, which the created view WILL take ownership of.
+ * @brief Gets the position of the tensor's first element in its storage, in elements.
+ * It is 0 for tensors that own a fresh allocation, and non-zero for views such as
+ * tensor_slice() results.
+ */
+size_t tensor_get_offset(const Tensor tensor);
+
+/**
+ * @brief Checks whether the elements of `a` and `b` could occupy the same memory.
+ * This compares the address ranges the two tensors can reach, so it may report
+ * interleaved but disjoint views (e.g. the even and odd columns of one matrix) as
+ * sharing. Tensors that share a buffer only copy-on-write (see tensor_copy()) do
+ * share memory until one of them is written.
+ * @return true if the ranges intersect, false if they are disjoint or either is empty.
+ */
+bool tensor_may_share_memory(const Tensor a, const Tensor b);
+
+/**
+ * @brief Releases a buffer handed to tensor_from_buffer().
+ * @param data The pointer that was passed to tensor_from_buffer().
+ * @param ctx The context that was passed to tensor_from_buffer().
+ */
+typedef void (*TensorDeleter)(void* data, void* ctx);
+
+/**
+ * @brief Creates a tensor over a caller-owned buffer, without copying it.
+ * The tensor and every view made from it read and write `data` directly. Once the
+ * last of them is freed, `deleter(data, ctx)` is called, so the buffer can be handed
+ * back to whoever owns it (a network receive ring, pinned staging memory, another
+ * library's array, ...). With a NULL deleter the buffer is merely borrowed: it must
+ * outlive the tensor and all of its views, and is left alone afterwards.
+ *
+ * The buffer is never shared copy-on-write: tensor_copy() and tensor_contiguous()
+ * of the tensor copy the elements into a new buffer right away. Writes through the
+ * tensor and its views (including pointers from tensor_get_data()) therefore always
+ * reach `data`, and writes to `data` are always seen by them, but never by copies.
+ *
+ * @param data The elements, aligned to the element size. Every element reachable
+ *             through `shape`'s dims and strides must lie within the buffer.
+ * @param shape The dims and strides (in elements) of the data. The shape is copied.
+ * @param dtype The data type of the elements.
+ * @param deleter Called once the buffer is no longer used, or NULL.
+ * @param ctx Passed to `deleter`.
+ * @return A new Tensor, or NULL on failure. On failure `deleter` is not called and
+ *         the caller still owns `data`.
+ */
+Tensor tensor_from_buffer(void* data, const Shape shape, DataType dtype, TensorDeleter deleter, void* ctx);
+
+/**
+ * @brief Creates a tensor that borrows existing data, like tensor_from_buffer()
+ * with a NULL deleter: the data must outlive the tensor and all of its views.
  *
  * @param data A pointer to the existing data to be shared.
- * @param shape The new shape for the view. The view takes ownership of this shape object.
+ * @param shape The shape for the view. The view takes ownership of this shape object,
+ *              also on failure.
  * @param dtype The data type of the elements.
  * @return A new Tensor view, or NULL on failure.
  */
 Tensor tensor_create_view(void* data, Shape shape, DataType dtype);
 
+/**
+ * @brief (Internal) The view factory used by the view functions in _tensor_view.c.
+ * The view shares `base`'s storage (keeping it alive) and has the same dtype.
+ *
+ * @param base The tensor whose storage is shared.
+ * @param offset Position of the view's first element in the storage, in elements.
+ * @param new_shape The view's shape. The view takes ownership of it, also on failure.
+ * @return A new Tensor view, or NULL on failure.
+ */
+Tensor _tensor_create_view(const Tensor base, size_t offset, Shape new_shape);
+
+/**
+ * @brief (Internal) Creates a tensor over an existing Storage (e.g. from storage_wrap()).
+ * The tensor takes over the caller's reference to `storage` and ownership of `shape`,
+ * also on failure. Every element reachable through `shape` and `offset` must lie
+ * within the storage.
+ *
+ * @param storage The storage to use.
+ * @param offset Position of the first element in the storage, in elements.
+ * @param shape The tensor's dims and strides.
+ * @param dtype The data type of the elements.
+ * @return A new Tensor, or NULL on failure.
+ */
+Tensor _tensor_wrap_storage(Storage storage, size_t offset, Shape shape, DataType dtype);
+
+/**
+ * @brief (Internal) Size of the storage behind the tensor, in elements of its dtype.
+ * Every element a view can reach must lie below this bound.
+ */
+size_t _tensor_get_storage_elements(const Tensor tensor);
+
+/**
+ * @brief (Internal) Like tensor_get_data() for kernels that finish writing before they
+ * return: it un-shares copy-on-write data, but does not mark it as exported, so later
+ * tensor_copy() calls stay O(1). The pointer must not outlive the operation.
+ */
+void* _tensor_get_data(const Tensor tensor);
+
+/**
+ * @brief (Internal) Validates a caller-provided output tensor for the `_out` ops.
+ * The output must have exactly `dims` and `dtype`, and must not map two positions to
+ * the same element (e.g. a tensor_expand() view). Prints an error naming `name` on failure.
+ */
+bool _tensor_check_out(const Tensor out, const int* dims, int ndim, DataType dtype, const char* name);
+
+/**
+ * @brief (Internal) Checks that an element-wise op may read `in` while writing `out`.
+ * Sharing memory is only safe when `in`, seen through `in_shape` (its strides broadcast
+ * to `out`'s dims), lines up with `out` element for element, so every output element
+ * reads nothing but its own old value.
+ * @param out_data `out`'s writable data pointer, taken before the check (it may have
+ * moved `out` to a private copy-on-write buffer).
+ */
+bool _tensor_out_alias_ok(const Tensor out, const void* out_data, const Tensor in, const Shape in_shape);
+
+
 /**
  * @brief Gets a pointer to the element at the specified logical coordinates.
  * WARNING: This can be slow if used in a tight loop. It's intended for
@@ -0,0 +1,67 @@
+#ifndef _TENSOR_INDEX_H
+#define _TENSOR_INDEX_H
+
+#include "tensor/_tensor_core.h"
+
+#include <stdbool.h>
+
+// --- Indexing with index tensors ---
+//
+// Indices are DTYPE_I32 tensors (any layout) and must lie in [0, size) of the indexed
+// axis; negative indices are not supported. These are random-access patterns, so the
+// kernels prefetch the rows or elements the next few indices point at, copy whole rows
+// with memcpy where the layout allows it, and split the work across the thread pool.
+
+/**
+ * @brief Selects entries along one axis: out[..., j, ...] = t[..., indices[j], ...].
+ * The typical use is an embedding lookup, t[indices] with axis 0. Whenever everything
+ * after `axis` is contiguous in `t`, each selected entry is copied as one block.
+ *
+ * @param t The source tensor (any layout and dtype).
+ * @param axis The axis to index.
+ * @param indices A 1-D DTYPE_I32 tensor of k indices.
+ * @return A new contiguous tensor shaped like `t` with `axis` of size k, or NULL on failure.
+ */
+Tensor tensor_index_select(const Tensor t, int axis, const Tensor indices);
+
+/**
+ * @brief Gathers along one axis, like torch.gather: for every position c of `indices`,
+ * out[c] = t[c with c[axis] replaced by indices[c]].
+ *
+ * @param t The source tensor (any layout and dtype).
+ * @param axis The axis to index.
+ * @param indices A DTYPE_I32 tensor with as many dimensions as `t`, no larger than `t`
+ *                in any dimension other than `axis`.
+ * @return A new contiguous tensor shaped like `indices`, or NULL on failure.
+ */
+Tensor tensor_gather(const Tensor t, int axis, const Tensor indices);
+
+/**
+ * @brief Scatter-add along one axis, the reverse of tensor_gather(): for every position c
+ * of `indices`, t[c with c[axis] replaced by indices[c]] += src[c].
+ *
+ * Positions that differ only along `axis` may hit the same element of `t`, so by default
+ * the work is partitioned such that every element of `t` is updated by one thread, in
+ * the order of the positions; results are deterministic. When the caller knows that no
+ * two positions target the same element (e.g. a permutation), `unique_indices` lifts that
+ * restriction and every position may be processed independently.
+ * All indices are checked before `t` is modified.
+ *
+ * @param t The tensor to update in place (DTYPE_I32, DTYPE_F32 or DTYPE_F64).
+ * @param axis The axis to index.
+ * @param indices A DTYPE_I32 tensor with as many dimensions as `t`, no larger than `t`
+ *                in any dimension other than `axis`.
+ * @param src The values to add; same dtype as `t`, at least as large as `indices` in
+ *            every dimension (only the part covered by `indices` is read).
+ * @param unique_indices true if no two positions of `indices` target the same element.
+ * @return true on success, false on failure (`t` is then unchanged).
+ */
+bool tensor_scatter_add_(Tensor t, int axis, const Tensor indices, const Tensor src, bool unique_indices);
+
+/**
+ * @brief Like tensor_scatter_add_(), on a copy of `t`.
+ * @return A new contiguous tensor, or NULL on failure.
+ */
+Tensor tensor_scatter_add(const Tensor t, int axis, const Tensor indices, const Tensor src, bool unique_indices);
+
+#endif // _TENSOR_INDEX_H
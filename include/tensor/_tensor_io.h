@@ -0,0 +1,102 @@
+#ifndef _TENSOR_IO_H
+#define _TENSOR_IO_H
+
+#include "tensor/_tensor_core.h"
+
+// --- Loading and saving tensors ---
+//
+// Loads memory-map the file and return a tensor whose storage is the mapping: nothing
+// is copied or read up front, pages are brought in by the kernel on first access, and
+// several processes loading the same file share its pages through the page cache.
+// The mapping is private: writing to a loaded tensor changes only this process's
+// copy of the touched pages, never the file. The file may be deleted or replaced after
+// loading; the mapping keeps the old contents alive until the tensor and all of its
+// views are freed. On systems without mmap the file is read into memory instead.
+//
+// Saves stream the elements straight from the tensor's strides, so views (slices,
+// transposes, broadcasts) are written without being materialized first.
+//
+// Both formats store little-endian data and are only supported on little-endian hosts.
+
+/**
+ * @brief Loads a NumPy .npy file (format versions 1 to 3).
+ * Supported dtypes are '<i4', '<f4', '<f8', '<f2' (F16), '|i1' (I8) and '|u1' (U8). Fortran-ordered arrays are loaded
+ * without a copy too, as a tensor with column-major strides.
+ *
+ * @param path The file to load.
+ * @return A new tensor backed by the file mapping, or NULL on failure.
+ */
+Tensor tensor_load_npy(const char* path);
+
+/**
+ * @brief Saves a tensor as a NumPy .npy file (C order). BF16 tensors cannot be saved
+ * as .npy, which has no such dtype; use tensor_save_raw() for them.
+ * @return true on success, false on failure (a partially written file may remain).
+ */
+bool tensor_save_npy(const Tensor t, const char* path);
+
+/**
+ * @brief Loads a tensor saved with tensor_save_raw().
+ *
+ * The raw format is a small little-endian header followed by the row-major data:
+ *
+ *     offset  size         field
+ *     0       8            magic "SNAKETNS"
+ *     8       4            format version (1)
+ *     12      4            dtype (the DataType value)
+ *     16      4            ndim
+ *     20      4            data offset, a multiple of 64
+ *     24      8 * ndim     dims, as signed 64-bit integers
+ *
+ * The data starts on a 64-byte boundary, so loaded tensors are as aligned as
+ * freshly allocated ones.
+ *
+ * @param path The file to load.
+ * @return A new tensor backed by the file mapping, or NULL on failure.
+ */
+Tensor tensor_load_raw(const char* path);
+
+/**
+ * @brief Saves a tensor in the raw format described at tensor_load_raw().
+ * @return true on success, false on failure (a partially written file may remain).
+ */
+bool tensor_save_raw(const Tensor t, const char* path);
+
+// --- Streaming saves ---
+//
+// A TensorWriter builds a file from blocks of rows appended along axis 0, so a result
+// that never exists in memory as a whole can still be saved. The first block fixes the
+// dtype and the shape of a row; every later block must match them. The files are the
+// same as tensor_save_npy() / tensor_save_raw() would write for the concatenation of
+// all blocks: the header is written with room to spare and completed on close.
+
+struct _tensor_writer;
+typedef struct _tensor_writer* TensorWriter;
+
+/**
+ * @brief Creates (or truncates) `path` for streaming a .npy file.
+ * @return A new writer, or NULL on failure. Close it with tensor_writer_close().
+ */
+TensorWriter tensor_writer_open_npy(const char* path);
+
+/**
+ * @brief Creates (or truncates) `path` for streaming a file in the raw format.
+ * @return A new writer, or NULL on failure. Close it with tensor_writer_close().
+ */
+TensorWriter tensor_writer_open_raw(const char* path);
+
+/**
+ * @brief Appends the rows of `rows` (any layout, at least one dimension) to the file.
+ * @return true on success. A block that doesn't match the earlier ones is rejected and
+ * leaves the file as it was; after a write error every further call fails.
+ */
+bool tensor_writer_append(TensorWriter w, const Tensor rows);
+
+/**
+ * @brief Completes the header, closes the file and frees the writer.
+ * @return true if the file is complete, false if nothing was appended or any write
+ * failed (a partially written file may remain).
+ */
+bool tensor_writer_close(TensorWriter w);
+
+#endif // _TENSOR_IO_H
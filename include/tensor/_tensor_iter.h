@@ -0,0 +1,125 @@
+#ifndef _TENSOR_ITER_H
+#define _TENSOR_ITER_H
+
+#include "tensor/_tensor_core.h"
+
+#include <stdbool.h>
+#include <stddef.h> // For size_t
+
+#define TENSOR_ITER_MAX_OPERANDS 8
+#define TENSOR_ITER_MAX_DIMS 32
+
+/**
+ * @brief Walks one or more equally-shaped strided operands in lockstep.
+ * Size-1 dimensions are dropped and neighbouring dimensions whose strides line up
+ * in every operand are merged, so the walk is split into as few "runs" as possible.
+ * Each call to tensor_iter_next() yields one run: `inner_size` elements starting at
+ * `ptrs[op]`, spaced `inner_strides[op]` bytes apart. Broadcast operands (stride 0,
+ * e.g. from tensor_expand) are handled naturally: their pointer simply does not move.
+ * `inner_size` is the same for every run unless tensor_iter_set_range() was used.
+ *
+ * All fields are read-only for callers. A typical loop looks like:
+ *
+ *     TensorIter it;
+ *     if (!tensor_iter_init(&it, operands, 2)) return NULL;
+ *     while (tensor_iter_next(&it))
+ *         for (size_t i = 0; i < it.inner_size; i++)
+ *             ... it.ptrs[0] + i * it.inner_strides[0] ...
+ */
+typedef struct
+{
+    int nops;
+    int ndim;                                                    // number of dimensions after merging
+    size_t dims[TENSOR_ITER_MAX_DIMS];
+    size_t strides[TENSOR_ITER_MAX_OPERANDS][TENSOR_ITER_MAX_DIMS]; // in bytes
+    char* base[TENSOR_ITER_MAX_OPERANDS];
+
+    size_t size;       // total number of elements visited
+    size_t num_runs;   // number of runs the walk is split into
+    size_t run_index;  // index of the next run to be produced
+
+    // --- The current run, valid after tensor_iter_next() returned true ---
+    char* ptrs[TENSOR_ITER_MAX_OPERANDS];
+    size_t inner_size;
+    size_t inner_strides[TENSOR_ITER_MAX_OPERANDS];
+
+    // --- Internal odometer state ---
+    size_t _coords[TENSOR_ITER_MAX_DIMS];
+    size_t _offsets[TENSOR_ITER_MAX_OPERANDS];
+    size_t _run_length; // length of a full run
+    size_t _pos;        // element index of the next element to be produced
+    size_t _end;        // one past the last element to be produced
+}
+TensorIter;
+
+/**
+ * @brief Initializes an iterator over tensors that all have the same dimensions.
+ * The first operand is the output: its pointer is writable, so copy-on-write data is
+ * un-shared for it. The other operands are inputs and are only read; their data stays
+ * shared. Finish writing before the output is copied. Walks without an output should
+ * use tensor_iter_init_strided() with tensor_get_data_const().
+ * @param it The iterator to initialize.
+ * @param operands An array of `nops` tensors. Use tensor_expand() first to broadcast.
+ * @param nops The number of operands (1 <= nops <= TENSOR_ITER_MAX_OPERANDS).
+ * @return true on success, false if the operands are invalid or their dimensions differ.
+ */
+bool tensor_iter_init(TensorIter* it, const Tensor* operands, int nops);
+
+/**
+ * @brief Initializes an iterator directly from raw pointers and element strides.
+ * This is the building block used by kernels that compute broadcast strides
+ * themselves (e.g. via shape_expand) and do not want to create view tensors.
+ *
+ * @param it The iterator to initialize.
+ * @param nops The number of operands.
+ * @param data Base pointer of each operand.
+ * @param strides Strides of each operand, in elements, `ndim` entries per operand.
+ * @param item_sizes Element size of each operand, in bytes.
+ * @param dims The logical dimensions shared by all operands.
+ * @param ndim The number of dimensions.
+ * @return true on success, false on invalid arguments.
+ */
+bool tensor_iter_init_strided(TensorIter* it, int nops, void* const* data,
+                              const size_t* const* strides, const size_t* item_sizes,
+                              const int* dims, int ndim);
+
+/**
+ * @brief Advances to the next run.
+ * @return true if a run was produced (see `ptrs`, `inner_size`, `inner_strides`),
+ * false once the walk is finished.
+ */
+bool tensor_iter_next(TensorIter* it);
+
+/**
+ * @brief Positions the iterator so that the next call to tensor_iter_next()
+ * produces run `run_index`. Lets several workers split one walk by run ranges.
+ */
+void tensor_iter_seek(TensorIter* it, size_t run_index);
+
+/**
+ * @brief Restricts the walk to the elements [begin, end) in row-major order.
+ * The first and last runs may be partial (shorter `inner_size`). This is how
+ * parallel workers split a single walk, even when it has merged into one run.
+ */
+void tensor_iter_set_range(TensorIter* it, size_t begin, size_t end);
+
+/**
+ * @brief Points the operands at new base pointers (same layout) and rewinds the walk.
+ * Lets a kernel reuse one iterator, e.g. for every output element of a reduction.
+ */
+void tensor_iter_reset(TensorIter* it, void* const* data);
+
+/**
+ * @brief Removes a (merged) dimension from the walk so the caller can handle it
+ * inside its own kernel, e.g. as the second axis of a 2-D tile. Must be called
+ * before iteration starts; the iterator is rewound to the first run.
+ *
+ * @param it The iterator.
+ * @param axis Index into `it->dims`, must be < it->ndim - 1 (the run axis cannot be removed).
+ * @param size Receives the size of the removed dimension.
+ * @param strides Receives the removed dimension's byte stride for each operand.
+ * @return true on success, false if `axis` is invalid.
+ */
+bool tensor_iter_remove_axis(TensorIter* it, int axis, size_t* size, size_t* strides);
+
+#endif // _TENSOR_ITER_H
@@ -0,0 +1,107 @@
+#ifndef _TENSOR_LAZY_H
+#define _TENSOR_LAZY_H
+
+#include "tensor/_tensor_core.h"
+#include "tensor/_tensor_ops.h"
+
+// --- Lazy element-wise expressions ---
+//
+// Building an expression records nodes instead of computing anything:
+//
+//     LazyExpr x = lazy_tensor(a), y = lazy_tensor(b), z = lazy_tensor(c);
+//     LazyExpr e = lazy_relu(lazy_add(lazy_mul(x, y), z));   // relu(a * b + c)
+//     Tensor out = lazy_eval(e);
+//
+// When the result is forced, the whole graph of element-wise and broadcast ops is
+// fused into a single strided pass over the inputs. No intermediate tensor is
+// allocated, and every input is read once. Large graphs that do not fit into one pass
+// (more than LAZY_MAX_INPUTS distinct inputs, or too deep) are split automatically,
+// materializing as few intermediates as needed.
+//
+// Semantics match the eager ops in _tensor_ops.h: NumPy broadcasting, all tensor
+// operands in one expression share a dtype, I32 division truncates toward zero
+// (dividing by zero yields 0), and results are bitwise identical to running the
+// same ops one by one.
+//
+// A node keeps a view of its tensor and reads its data at evaluation time, so later
+// writes to the tensor are seen by the expression. Every builder returns a new
+// reference and leaves its arguments untouched; release each expression with
+// lazy_free() (nodes shared by a larger expression stay alive as long as it does).
+// Expressions are not thread-safe to build or free concurrently, but evaluation
+// runs in parallel on the shared thread pool.
+
+#define LAZY_MAX_INPUTS 7 // distinct tensor inputs per fused pass
+
+typedef struct _lazy_expr* LazyExpr;
+
+typedef enum
+{
+    LAZY_UNARY_NEG,
+    LAZY_UNARY_ABS,
+    LAZY_UNARY_RELU,  // maximum(x, 0), exactly as tensor_maximum() computes it
+    LAZY_UNARY_EXP,   // floating-point dtypes only
+    LAZY_UNARY_LOG,   // floating-point dtypes only
+    LAZY_UNARY_SQRT,  // floating-point dtypes only
+    LAZY_UNARY_RSQRT, // 1 / sqrt(x); floating-point dtypes only
+    LAZY_UNARY_COUNT
+}
+LazyUnaryOp;
+
+/**
+ * @brief Wraps a tensor as a leaf of an expression.
+ * @return A new expression, or NULL on failure.
+ */
+LazyExpr lazy_tensor(const Tensor t);
+
+/**
+ * @brief A scalar constant. It takes the dtype of the tensors it is combined with
+ * (an expression made of scalars only evaluates to DTYPE_F64).
+ */
+LazyExpr lazy_scalar(double value);
+
+/**
+ * @brief Records a op b with broadcasting. See tensor_binary().
+ * @return A new expression, or NULL if the shapes do not broadcast or the dtypes differ.
+ */
+LazyExpr lazy_binary(LazyExpr a, LazyExpr b, BinaryOp op);
+
+/**
+ * @brief Records an element-wise unary op.
+ * @return A new expression, or NULL on failure (e.g. LAZY_UNARY_EXP on DTYPE_I32).
+ */
+LazyExpr lazy_unary(LazyExpr a, LazyUnaryOp op);
+
+LazyExpr lazy_add(LazyExpr a, LazyExpr b);
+LazyExpr lazy_sub(LazyExpr a, LazyExpr b);
+LazyExpr lazy_mul(LazyExpr a, LazyExpr b);
+LazyExpr lazy_div(LazyExpr a, LazyExpr b);
+LazyExpr lazy_maximum(LazyExpr a, LazyExpr b);
+LazyExpr lazy_minimum(LazyExpr a, LazyExpr b);
+LazyExpr lazy_neg(LazyExpr a);
+LazyExpr lazy_relu(LazyExpr a);
+
+/**
+ * @brief Releases a reference to an expression. NULL is a no-op.
+ */
+void lazy_free(LazyExpr e);
+
+/**
+ * @brief The shape the expression evaluates to (owned by the expression).
+ */
+Shape lazy_get_shape(const LazyExpr e);
+
+/**
+ * @brief Evaluates the expression in a fused pass.
+ * @return A new contiguous tensor, or NULL on failure.
+ */
+Tensor lazy_eval(const LazyExpr e);
+
+/**
+ * @brief Evaluates the expression into `out`, with the same rules as the `_out` ops
+ * (see tensor_binary_out()). In particular `out` may be one of the expression's
+ * inputs, as in a = relu(a * b + c), when it is read element for element.
+ * @return true on success, false otherwise.
+ */
+bool lazy_eval_out(Tensor out, const LazyExpr e);
+
+#endif // _TENSOR_LAZY_H
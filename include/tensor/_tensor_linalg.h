@@ -0,0 +1,31 @@
+#ifndef _TENSOR_LINALG_H
+#define _TENSOR_LINALG_H
+
+#include "tensor/_tensor_core.h"
+
+/**
+ * @brief Matrix product of two 2-D tensors: [M, K] x [K, N] -> [M, N].
+ * Both operands must be DTYPE_F32 or both DTYPE_F64. Inputs are read through
+ * their strides, so transposed views from tensor_permute() need no copy.
+ * The product is computed with packed, cache-blocked panels and a register-blocked
+ * microkernel, and output tiles are spread across threads.
+ *
+ * @param a The left matrix.
+ * @param b The right matrix.
+ * @return A new contiguous [M, N] tensor, or NULL on failure.
+ */
+Tensor tensor_matmul(const Tensor a, const Tensor b);
+
+/**
+ * @brief Batched matrix product: [..., M, K] x [..., K, N] -> [..., M, N].
+ * The leading (batch) dimensions broadcast against each other like element-wise
+ * ops do (see shape_broadcast), through stride-0 views, so a single matrix can be
+ * applied to a whole batch without being copied. See tensor_matmul().
+ *
+ * @param a The left operand, with at least 2 dimensions.
+ * @param b The right operand, with at least 2 dimensions.
+ * @return A new contiguous tensor, or NULL on failure.
+ */
+Tensor tensor_bmm(const Tensor a, const Tensor b);
+
+#endif // _TENSOR_LINALG_H
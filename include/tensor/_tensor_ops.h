@@ -0,0 +1,248 @@
+#ifndef _TENSOR_OPS_H
+#define _TENSOR_OPS_H
+
+#include "tensor/_tensor_core.h"
+
+// --- Element-wise Binary Operations ---
+
+typedef enum
+{
+    BINARY_OP_ADD,
+    BINARY_OP_SUB,
+    BINARY_OP_MUL,
+    BINARY_OP_DIV,
+    BINARY_OP_MAX,
+    BINARY_OP_MIN,
+    BINARY_OP_COUNT
+}
+BinaryOp;
+
+/**
+ * @brief Applies an element-wise binary operation with NumPy-style broadcasting.
+ * Operands are broadcast through stride-0 views (see shape_expand) and are never
+ * materialized at the broadcast size. Both operands must have the same dtype.
+ * Integer division truncates toward zero; dividing by zero yields 0.
+ *
+ * @param a The left operand.
+ * @param b The right operand.
+ * @param op The operation to apply.
+ * @return A new contiguous tensor with the broadcast shape, or NULL on failure.
+ */
+Tensor tensor_binary(const Tensor a, const Tensor b, BinaryOp op);
+
+/**
+ * @brief Element-wise a + b, with broadcasting. See tensor_binary().
+ */
+Tensor tensor_add(const Tensor a, const Tensor b);
+
+/**
+ * @brief Element-wise a - b, with broadcasting. See tensor_binary().
+ */
+Tensor tensor_sub(const Tensor a, const Tensor b);
+
+/**
+ * @brief Element-wise a * b, with broadcasting. See tensor_binary().
+ */
+Tensor tensor_mul(const Tensor a, const Tensor b);
+
+/**
+ * @brief Element-wise a / b, with broadcasting. See tensor_binary().
+ */
+Tensor tensor_div(const Tensor a, const Tensor b);
+
+/**
+ * @brief Element-wise maximum of a and b, with broadcasting. See tensor_binary().
+ * (tensor_max/tensor_min are the reductions; this follows NumPy's maximum/max split.)
+ */
+Tensor tensor_maximum(const Tensor a, const Tensor b);
+
+/**
+ * @brief Element-wise minimum of a and b, with broadcasting. See tensor_binary().
+ */
+Tensor tensor_minimum(const Tensor a, const Tensor b);
+
+// --- Output-parameter and in-place variants ---
+//
+// The `_out` variants write the result into a caller-provided tensor instead of
+// allocating one, and return true on success. `out` must already have the result's
+// shape and dtype; it may be a strided view (e.g. a slice or a transpose), but not one
+// that maps several positions to one element (a tensor_expand() view). An input may
+// share memory with `out` only if it lines up with it element for element (as in
+// a = a + b); any other overlap is rejected, because the op would read elements it
+// has already overwritten. On failure `out` is left untouched.
+//
+// The in-place variants (trailing underscore) compute a = a op b; `b` must broadcast
+// to `a`'s shape.
+
+/**
+ * @brief Computes a op b into `out`. See tensor_binary() and the notes above.
+ * @return true on success, false on invalid arguments, mismatched `out` or unsafe aliasing.
+ */
+bool tensor_binary_out(Tensor out, const Tensor a, const Tensor b, BinaryOp op);
+
+/**
+ * @brief Computes a = a op b in place. See tensor_binary_out().
+ */
+bool tensor_binary_(Tensor a, const Tensor b, BinaryOp op);
+
+bool tensor_add_out(Tensor out, const Tensor a, const Tensor b);
+bool tensor_sub_out(Tensor out, const Tensor a, const Tensor b);
+bool tensor_mul_out(Tensor out, const Tensor a, const Tensor b);
+bool tensor_div_out(Tensor out, const Tensor a, const Tensor b);
+bool tensor_maximum_out(Tensor out, const Tensor a, const Tensor b);
+bool tensor_minimum_out(Tensor out, const Tensor a, const Tensor b);
+
+bool tensor_add_(Tensor a, const Tensor b);
+bool tensor_sub_(Tensor a, const Tensor b);
+bool tensor_mul_(Tensor a, const Tensor b);
+bool tensor_div_(Tensor a, const Tensor b);
+bool tensor_maximum_(Tensor a, const Tensor b);
+bool tensor_minimum_(Tensor a, const Tensor b);
+
+// --- Reductions ---
+
+/**
+ * @brief Sums a tensor over the given axes.
+ * Contiguous runs are reduced with vectorized, blocked accumulators; F32 partial
+ * sums are carried in double, and I32 sums in 64-bit before narrowing back to I32.
+ * F16/BF16 inputs are summed like F32 and rounded back to their dtype; I8/U8 inputs
+ * are summed like I32 and produce an I32 result. Whether a reduction is split into
+ * partial sums, and where, depends only on the sizes involved, never on the number of
+ * threads, so results are the same for every SNAKE_NUM_THREADS.
+ *
+ * @param t The input tensor.
+ * @param axes The axes to reduce (non-negative, no duplicates). NULL or naxes == 0 reduces all axes.
+ * @param naxes The number of entries in `axes`.
+ * @param keepdim If true, reduced axes are kept with size 1.
+ * @return A new contiguous tensor with the same dtype as `t` (I32 for I8/U8), or NULL on failure.
+ */
+Tensor tensor_sum(const Tensor t, const int* axes, int naxes, bool keepdim);
+
+/**
+ * @brief Mean over the given axes. See tensor_sum().
+ * I32, I8 and U8 inputs produce an F64 result; other dtypes keep their dtype.
+ */
+Tensor tensor_mean(const Tensor t, const int* axes, int naxes, bool keepdim);
+
+/**
+ * @brief Maximum over the given axes. See tensor_sum().
+ * NaN propagates: the result is NaN wherever any reduced element is NaN, like NumPy's
+ * max. Reducing over a zero-size axis is an error.
+ */
+Tensor tensor_max(const Tensor t, const int* axes, int naxes, bool keepdim);
+
+/**
+ * @brief Minimum over the given axes. See tensor_sum(); NaN propagates as in tensor_max().
+ * Reducing over a zero-size axis is an error.
+ */
+Tensor tensor_min(const Tensor t, const int* axes, int naxes, bool keepdim);
+
+/**
+ * @brief Index of the maximum along one axis (the first one on ties). As in tensor_max(),
+ * NaN counts as the maximum: a lane containing NaN yields the index of its first NaN.
+ *
+ * @param t The input tensor.
+ * @param axis The axis to reduce.
+ * @param keepdim If true, the reduced axis is kept with size 1.
+ * @return A new DTYPE_I32 tensor of indices, or NULL on failure.
+ */
+Tensor tensor_argmax(const Tensor t, int axis, bool keepdim);
+
+/**
+ * @brief Output-parameter variants of the reductions: the result is written into
+ * `out`, which must have the result's shape and dtype (see tensor_binary_out() for
+ * the layout rules). `out` must not share memory with `t` at all.
+ * @return true on success, false otherwise (`out` is then left untouched).
+ */
+bool tensor_sum_out(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim);
+bool tensor_mean_out(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim);
+bool tensor_max_out(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim);
+bool tensor_min_out(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim);
+bool tensor_argmax_out(Tensor out, const Tensor t, int axis, bool keepdim);
+
+// --- Softmax and normalization along an axis ---
+
+/**
+ * @brief Softmax along one axis: exp(x - max) / sum(exp(x - max)).
+ * Fused into two passes without temporaries: the first finds the maximum and the sum
+ * of exponentials together (online: the running sum is rescaled whenever a block raises
+ * the maximum), the second writes the result. Rows are read through their strides, so
+ * permuted views need no copy. DTYPE_F32 uses a vectorized exp approximation (within
+ * 2 ulp of expf); F16/BF16 are computed in F32 and rounded back.
+ *
+ * @param t The input tensor (DTYPE_F32, DTYPE_F64, DTYPE_F16 or DTYPE_BF16).
+ * @param axis The axis to normalize over.
+ * @return A new contiguous tensor with the shape and dtype of `t`, or NULL on failure.
+ */
+Tensor tensor_softmax(const Tensor t, int axis);
+
+/**
+ * @brief log(softmax(x)) along one axis, computed as x - max - log(sum(exp(x - max))),
+ * which stays finite where softmax underflows. See tensor_softmax().
+ */
+Tensor tensor_log_softmax(const Tensor t, int axis);
+
+/**
+ * @brief Layer normalization along one axis: (x - mean) / sqrt(var + eps) * weight + bias,
+ * with the biased variance. Mean and variance come from a single blocked pass (each
+ * block is centered on its own mean and the blocks are merged in double), a second
+ * pass writes the result. See tensor_softmax() for dtypes and layouts.
+ *
+ * @param t The input tensor.
+ * @param axis The axis to normalize over.
+ * @param weight NULL, or a 1-D tensor with t's dtype and as many elements as `axis`.
+ * @param bias NULL, or like `weight`.
+ * @param eps Added to the variance; must be non-negative.
+ * @return A new contiguous tensor with the shape and dtype of `t`, or NULL on failure.
+ */
+Tensor tensor_layer_norm(const Tensor t, int axis, const Tensor weight, const Tensor bias, double eps);
+
+/**
+ * @brief Output-parameter variants: `out` must have t's shape and dtype. It may be `t`
+ * itself, or any tensor with exactly t's layout over the same memory, which normalizes
+ * in place; other overlaps are an error.
+ * @return true on success, false otherwise (`out` is then left untouched).
+ */
+bool tensor_softmax_out(Tensor out, const Tensor t, int axis);
+bool tensor_log_softmax_out(Tensor out, const Tensor t, int axis);
+bool tensor_layer_norm_out(Tensor out, const Tensor t, int axis, const Tensor weight, const Tensor bias, double eps);
+
+// --- Sorting and selection along an axis ---
+//
+// Every dtype is ordered by mapping its values to unsigned integer keys that compare
+// like the values (-0.0 equals 0.0; NaN compares greater than every number, +Inf
+// included). Rows along the axis are independent and are processed in parallel.
+
+/**
+ * @brief The k largest (or smallest) entries along one axis, best first; equal entries
+ * come in the order of their positions. For small k (up to 64, or up to 1/128 of the
+ * axis) each row feeds a k-entry heap, and a vectorized scan skips the elements that do
+ * not beat the heap's worst entry, so wide rows are mostly just read once. Larger k use
+ * a radix select on the keys and sort only the k selected entries.
+ *
+ * @param t The input tensor (any layout and dtype).
+ * @param k The number of entries to keep; 1 <= k <= the size of `axis`.
+ * @param axis The axis to select along.
+ * @param largest true for the k largest entries, false for the k smallest.
+ * @param values Receives a new contiguous tensor with t's dtype, shaped like `t` with
+ *               `axis` of size k; may be NULL if only the indices are needed.
+ * @param indices Receives a new contiguous DTYPE_I32 tensor of the same shape with the
+ *                positions of the entries along `axis`; may be NULL.
+ * @return true on success; on failure nothing is stored.
+ */
+bool tensor_topk(const Tensor t, int k, int axis, bool largest, Tensor* values, Tensor* indices);
+
+/**
+ * @brief The positions that sort `t` along one axis. The sort is stable: equal entries
+ * keep their order, in both directions. Rows are sorted with an LSD radix sort on the
+ * keys, one pass per key byte (passes in which the whole row has the same byte are
+ * skipped); short rows use insertion sort.
+ *
+ * @param t The input tensor (any layout and dtype).
+ * @param axis The axis to sort along.
+ * @param descending true to sort from the largest entry.
+ * @return A new contiguous DTYPE_I32 tensor shaped like `t`, or NULL on failure.
+ */
+Tensor tensor_argsort(const Tensor t, int axis, bool descending);
+
+#endif // _TENSOR_OPS_H
@@ -1,17 +1,52 @@
 #ifndef _TENSOR_PRINT_H
 #define _TENSOR_PRINT_H
 
-#include "tensor/_tensor_core.h" 
+#include "tensor/_tensor_core.h"
+
+#include <stdio.h> // For FILE
+
+// Tensors with more elements than the threshold are summarized: along every axis
+// longer than 2 * edge items, only the first and last edge items are printed and the
+// rest is replaced by "...". This keeps printing a huge tensor (e.g. in a debug log)
+// cheap: the work and the output are bounded by the printed elements, and no
+// temporary buffer is allocated.
+#define TENSOR_PRINT_THRESHOLD 1000 // the NumPy defaults
+#define TENSOR_PRINT_EDGE_ITEMS 3
 
 /**
  * @brief Prints a human-readable representation of the tensor to stdout.
  * This function intelligently formats the output for readability, similar
  * to how libraries like PyTorch and NumPy display tensors. It correctly
-* handles tensors with non-contiguous memory layouts (e.g., views from
-* permute operations).
+ * handles tensors with non-contiguous memory layouts (e.g., views from
+ * permute operations). Large tensors are summarized (see above).
  *
  * @param t The tensor to be printed.
  */
 void tensor_print(const Tensor t);
 
-#endif // _TENSOR_PRINT_H
\ No newline at end of file
+/**
+ * @brief Like tensor_print(), writing to `stream`. The output is buffered and
+ * written in large chunks.
+ */
+void tensor_fprint(FILE* stream, const Tensor t);
+
+/**
+ * @brief Like tensor_print(), writing into a string, with snprintf() semantics:
+ * at most `size - 1` characters are stored, followed by a terminating NUL.
+ *
+ * @param buffer The destination (may be NULL if `size` is 0).
+ * @param size The capacity of `buffer`, in bytes.
+ * @param t The tensor to be printed.
+ * @return The length of the full output, which is `size` or more if it was truncated.
+ */
+size_t tensor_sprint(char* buffer, size_t size, const Tensor t);
+
+/**
+ * @brief Sets the summarization threshold (in elements; SIZE_MAX disables
+ * summarization) and the number of edge items shown per axis, for all threads.
+ * Defaults to TENSOR_PRINT_THRESHOLD and TENSOR_PRINT_EDGE_ITEMS.
+ */
+void tensor_print_set_options(size_t threshold, int edge_items);
+void tensor_print_get_options(size_t* threshold, int* edge_items);
+
+#endif // _TENSOR_PRINT_H
@@ -0,0 +1,197 @@
+#ifndef _TENSOR_SIMD_H
+#define _TENSOR_SIMD_H
+
+#include "tensor/_tensor_ops.h"
+
+#include <stddef.h> // For size_t
+#include <stdint.h> // For int32_t, uint32_t, uint64_t
+#include <string.h> // For memcpy
+
+// (Internal) Vectorized kernels shared by the op implementations.
+// Not part of tensor.h: the public entry points are the ops themselves.
+
+#define SIMD_DTYPE_COUNT 3 // DTYPE_I32, DTYPE_F32, DTYPE_F64
+
+typedef enum
+{
+    SIMD_LAYOUT_VV, // out[i] = a[i] op b[i]
+    SIMD_LAYOUT_VS, // out[i] = a[i] op b[0]
+    SIMD_LAYOUT_SV, // out[i] = a[0] op b[i]
+    SIMD_LAYOUT_COUNT
+}
+SimdLayout;
+
+/**
+ * @brief A binary kernel over `n` contiguous elements. Unaligned pointers are fine,
+ * and `out` may be equal to `a` or `b` (in-place), but must not partially overlap them.
+ */
+typedef void (*SimdBinaryFn)(void* out, const void* a, const void* b, size_t n);
+
+typedef enum
+{
+    SIMD_REDUCE_SUM,
+    SIMD_REDUCE_MAX,
+    SIMD_REDUCE_MIN,
+    SIMD_REDUCE_COUNT
+}
+SimdReduceOp;
+
+// F32 sums are accumulated in vector registers for at most this many elements
+// before being folded into a double, which keeps the error bounded on huge inputs.
+#define SIMD_SUM_BLOCK 4096
+
+/**
+ * @brief Folds `n` contiguous elements into `*acc`.
+ * For SIMD_REDUCE_SUM the accumulator is a double (F32/F64) or an int64_t (I32);
+ * for SIMD_REDUCE_MAX/MIN it has the element type and follows SIMD_MAX_NAN()/
+ * SIMD_MIN_NAN(). `acc` must be initialized.
+ */
+typedef void (*SimdReduceFn)(const void* x, size_t n, void* acc);
+
+// The max/min reductions propagate NaN: once the running value `l` is NaN it stays NaN,
+// and a NaN element `r` fails the comparison and is taken. The result is therefore NaN
+// whenever any reduced element is, no matter how the elements are split into blocks.
+#define SIMD_MAX_NAN(l, r) (((l) > (r) || (l) != (l)) ? (l) : (r))
+#define SIMD_MIN_NAN(l, r) (((l) < (r) || (l) != (l)) ? (l) : (r))
+
+// Register tile of the GEMM microkernels: SIMD_GEMM_MR rows by NR columns of C.
+#define SIMD_GEMM_MR 6
+#define SIMD_GEMM_NR_F32 16
+#define SIMD_GEMM_NR_F64 8
+
+/**
+ * @brief GEMM microkernel: C[MR x NR] += A * B over `kc` steps.
+ * `a` is a packed panel (kc groups of MR values, one per row), `b` a packed panel
+ * (kc groups of NR values, one per column), and `c` is row-major with `ldc` elements per row.
+ */
+typedef void (*SimdGemmFn)(size_t kc, const void* a, const void* b, void* c, size_t ldc);
+
+/**
+ * @brief Converts `n` contiguous elements between a narrow dtype and its compute
+ * dtype (see simd_compute_dtype()). Unaligned pointers are fine.
+ */
+typedef void (*SimdConvertFn)(void* dst, const void* src, size_t n);
+
+/**
+ * @brief Quantizes F32 to I8/U8, or dequantizes I8/U8 to F32, over `n` contiguous
+ * elements. See tensor_to_dtype_quantized() for the exact rounding. `inv_scale` is
+ * 1 / scale when quantizing and scale when dequantizing.
+ */
+typedef void (*SimdQuantizeFn)(void* dst, const void* src, size_t n, float inv_scale, int32_t zero_point);
+
+/**
+ * @brief e[i] = exp(x[i] - shift) over `n` contiguous elements. Stores e[i] * scale to
+ * `out` unless it is NULL (`out` may be equal to `x`) and returns the sum of the e[i].
+ * The F32 vector kernels use a polynomial approximation on every element, tails
+ * included: within 2 ulp of expf, with results below FLT_MIN flushed to zero and
+ * inputs above about 88.37 overflowing to Inf.
+ */
+typedef double (*SimdExpFn)(void* out, const void* x, size_t n, double shift, double scale);
+
+/**
+ * @brief Mean and sum of squared deviations from it (M2) of `n` contiguous elements.
+ * Each block of SIMD_SUM_BLOCK elements is centered on its own mean and the blocks are
+ * merged in double, so a large common offset does not cancel out the variance.
+ */
+typedef void (*SimdMomentsFn)(const void* x, size_t n, double* mean, double* m2);
+
+/**
+ * @brief Index of the first of `n` contiguous elements whose sort key (see
+ * simd_sort_key_f32()), XORed with `flip`, is greater than `threshold`; `n` if there
+ * is none. Selection loops use it to skip the elements that cannot enter their
+ * current top set.
+ */
+typedef size_t (*SimdFindAboveFn)(const void* x, size_t n, uint32_t threshold, uint32_t flip);
+
+typedef struct
+{
+    const char* name; // "avx512", "avx2", "neon" or "scalar"
+
+    // binary[op][dtype][layout]; an entry is NULL when the ISA has no fast form for it
+    SimdBinaryFn binary[BINARY_OP_COUNT][SIMD_DTYPE_COUNT][SIMD_LAYOUT_COUNT];
+
+    // reduce[op][dtype]
+    SimdReduceFn reduce[SIMD_REDUCE_COUNT][SIMD_DTYPE_COUNT];
+
+    // gemm[dtype]; floating-point dtypes only
+    SimdGemmFn gemm[SIMD_DTYPE_COUNT];
+
+    // widen[dtype]: narrow dtype -> compute dtype; narrow[dtype]: the reverse.
+    // Entries for the narrow dtypes are always set (with scalar code if need be).
+    SimdConvertFn widen[DTYPE_COUNT];
+    SimdConvertFn narrow[DTYPE_COUNT];
+
+    // quantize[dtype]: F32 -> I8/U8; dequantize[dtype]: I8/U8 -> F32. Always set.
+    SimdQuantizeFn quantize[DTYPE_COUNT];
+    SimdQuantizeFn dequantize[DTYPE_COUNT];
+
+    // exp[dtype], moments[dtype]; F32/F64 only, always set
+    SimdExpFn exp[SIMD_DTYPE_COUNT];
+    SimdMomentsFn moments[SIMD_DTYPE_COUNT];
+
+    // find_above[dtype]; I32/F32 only, always set
+    SimdFindAboveFn find_above[SIMD_DTYPE_COUNT];
+}
+SimdKernelTable;
+
+/**
+ * @brief Returns the kernel table for the running CPU.
+ * The best instruction set is picked once, at first use, from cpu_get_features(),
+ * so a single binary runs the right code on every machine.
+ */
+const SimdKernelTable* simd_get_kernels(void);
+
+// Elements converted per step by the simd_widen()/simd_narrow() users: a tile of
+// the compute dtype stays in L1 next to the narrow data.
+#define SIMD_CONVERT_TILE 256
+
+/**
+ * @brief The dtype narrow dtypes are computed in: F32 for F16/BF16, I32 for I8/U8.
+ * Other dtypes are their own compute dtype.
+ */
+DataType simd_compute_dtype(DataType dtype);
+
+/**
+ * @brief Converts `n` elements of a narrow `dtype`, `stride` bytes apart, into
+ * contiguous elements of its compute dtype at `dst`.
+ */
+void simd_widen(DataType dtype, void* dst, const void* src, size_t n, size_t stride);
+
+/**
+ * @brief Converts `n` contiguous compute-dtype elements at `src` back to `dtype`,
+ * storing them `stride` bytes apart.
+ */
+void simd_narrow(DataType dtype, void* dst, size_t stride, const void* src, size_t n);
+
+/**
+ * @brief Sort keys: unsigned integers that compare like the values. Negative floats
+ * have all their bits flipped, the others only the sign bit; -0.0 gets the key of 0.0
+ * and every NaN the largest key. Written with selects so that loops over them vectorize.
+ */
+static inline uint32_t
+simd_sort_key_i32(int32_t v)
+{
+    return (uint32_t)v ^ 0x80000000u;
+}
+
+static inline uint32_t
+simd_sort_key_f32(float f)
+{
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    u = (f == 0.0f) ? 0 : u;
+    const uint32_t key = u ^ ((uint32_t)((int32_t)u >> 31) | 0x80000000u);
+    return (f != f) ? UINT32_MAX : key;
+}
+
+static inline uint64_t
+simd_sort_key_f64(double d)
+{
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    u = (d == 0.0) ? 0 : u;
+    const uint64_t key = u ^ ((uint64_t)((int64_t)u >> 63) | 0x8000000000000000ull);
+    return (d != d) ? UINT64_MAX : key;
+}
+
+#endif // _TENSOR_SIMD_H
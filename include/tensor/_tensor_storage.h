@@ -0,0 +1,99 @@
+#ifndef _TENSOR_STORAGE_H
+#define _TENSOR_STORAGE_H
+
+#include <stdbool.h>
+#include <stddef.h> // For size_t
+
+// (Internal) Reference-counted memory behind Tensor objects.
+//
+// Two levels of sharing:
+//   - A Storage is shared by a tensor and every view made from it (reshape, permute,
+//     expand, ...). Writes through any of them are seen by all of them.
+//   - A Storage points to a data buffer, which is shared copy-on-write between the
+//     Storages created by storage_share() (i.e. by tensor_copy()). The first write
+//     through a Storage whose buffer is still shared gives that Storage a private copy,
+//     so all of its views move to the new buffer together. A buffer whose pointer has
+//     been handed out for writing (storage_export_data()) is not shared any more:
+//     storage_share() copies it, because writes through that pointer cannot be seen.
+// Reference counts are atomic; a Storage may be released from any thread.
+
+struct _storage;
+typedef struct _storage* Storage;
+
+/**
+ * @brief Creates a Storage with a new aligned buffer of `nbytes` bytes.
+ * @param nbytes The size of the buffer; 0 is allowed (for tensors without elements) and
+ * still gives a valid, aligned data pointer.
+ * @param zero If true, the buffer is zero-initialized.
+ * @return A new Storage with one reference, or NULL on failure.
+ */
+Storage storage_create(size_t nbytes, bool zero);
+
+/**
+ * @brief Releases memory that a Storage did not allocate itself (see storage_wrap()).
+ * @param data The pointer that was passed to storage_wrap().
+ * @param ctx The context that was passed to storage_wrap().
+ */
+typedef void (*StorageDeleter)(void* data, void* ctx);
+
+/**
+ * @brief Creates a Storage over existing memory, for example a file mapping.
+ * The memory is not copied. When the last reference to the buffer goes away,
+ * `deleter(data, ctx)` is called (if `deleter` is NULL the memory is simply left alone).
+ * Writing through a Storage whose buffer is shared copy-on-write moves that Storage
+ * to a private heap copy, as usual; writing through an unshared one writes to `data`.
+ *
+ * @param data The memory to use, at least `nbytes` bytes.
+ * @param nbytes The size of the memory.
+ * @param deleter Called once the buffer is no longer used, or NULL.
+ * @param ctx Passed to `deleter`.
+ * @return A new Storage with one reference, or NULL on failure (`deleter` is then not called).
+ */
+Storage storage_wrap(void* data, size_t nbytes, StorageDeleter deleter, void* ctx);
+
+/**
+ * @brief Adds a reference to `storage` and returns it.
+ */
+Storage storage_retain(Storage storage);
+
+/**
+ * @brief Drops a reference; the Storage (and its buffer, once unshared) is freed at zero.
+ */
+void storage_release(Storage storage);
+
+/**
+ * @brief Creates a new Storage that shares `storage`'s buffer copy-on-write. O(1),
+ * unless the buffer has been exported (see storage_export_data()): then the new
+ * Storage gets a private copy right away.
+ * @return A new Storage with one reference, or NULL on failure.
+ */
+Storage storage_share(Storage storage);
+
+/**
+ * @brief Read-only access to the bytes. Never copies.
+ */
+const void* storage_data(const Storage storage);
+
+/**
+ * @brief Writable access to the bytes. If the buffer is shared with another Storage,
+ * it is copied first (copy-on-write), so the returned pointer may differ from the
+ * one storage_data() returned before.
+ * @return The data pointer, or NULL if the copy could not be allocated.
+ */
+void* storage_mutable_data(Storage storage);
+
+/**
+ * @brief Like storage_mutable_data(), for a pointer that may be written through after
+ * this call returns (one handed out to the user). Writes through it bypass copy-on-write,
+ * so the buffer is marked as exported and is never shared again: later storage_share()
+ * calls copy it instead.
+ * @return The data pointer, or NULL if the copy could not be allocated.
+ */
+void* storage_export_data(Storage storage);
+
+/**
+ * @brief The size of the buffer in bytes.
+ */
+size_t storage_nbytes(const Storage storage);
+
+#endif // _TENSOR_STORAGE_H
@@ -0,0 +1,55 @@
+#ifndef _TENSOR_STREAM_H
+#define _TENSOR_STREAM_H
+
+#include "tensor/_tensor_core.h"
+#include "tensor/_tensor_io.h"
+
+#include <stdbool.h>
+#include <stddef.h> // For size_t
+
+// --- Chunked out-of-core processing ---
+//
+// tensor_stream() runs a computation over a tensor that may be much larger than memory,
+// typically one returned by tensor_load_npy() / tensor_load_raw(), whose data is a file
+// mapping. The tensor is split along axis 0 into chunks of whole rows, and the chunks
+// are handed to a callback one after the other, so only a few chunks are ever resident:
+//
+//     chunk k     : the callback runs on the calling thread (its ops use the thread pool)
+//     chunk k + 1 : a background I/O thread reads it in (madvise + prefault)
+//     result k - 1: the same I/O thread appends it to the TensorWriter
+//
+// Pages of finished chunks are marked as the first to reclaim, so memory use stays around
+// two input chunks and two results however large the input is. A callback that keeps up
+// with the disk finds every chunk already in memory.
+
+// Bytes per chunk when tensor_stream() is asked to choose the chunk size
+#define TENSOR_STREAM_CHUNK_BYTES ((size_t)64 << 20)
+
+/**
+ * @brief Processes one chunk.
+ * @param chunk Rows [first_row, first_row + rows) of the input, a view that is only
+ * valid during the call. Read it only: its pages are shared with the file mapping.
+ * @param first_row Index of the chunk's first row in the whole input.
+ * @param result Set to a new tensor to append to the writer (the pipeline takes it over
+ * and frees it), or left NULL when there is nothing to write for this chunk.
+ * @param ctx The pointer passed to tensor_stream().
+ * @return false to stop the pipeline with an error.
+ */
+typedef bool (*TensorChunkFn)(const Tensor chunk, size_t first_row, Tensor* result, void* ctx);
+
+/**
+ * @brief Runs `fn` on consecutive chunks of `input` along axis 0, prefetching the next
+ * chunk and writing the previous result in the background.
+ *
+ * @param input The tensor to process, at least one dimension.
+ * @param chunk_rows Rows per chunk (the last chunk may be shorter), or 0 to pick about
+ * TENSOR_STREAM_CHUNK_BYTES bytes per chunk.
+ * @param fn Called once per chunk, in order, on the calling thread.
+ * @param ctx Passed to `fn`.
+ * @param writer Receives the results in order, or NULL if `fn` produces none. The writer
+ * stays open; close it with tensor_writer_close() afterwards.
+ * @return true if every chunk was processed and every result written.
+ */
+bool tensor_stream(const Tensor input, size_t chunk_rows, TensorChunkFn fn, void* ctx, TensorWriter writer);
+
+#endif // _TENSOR_STREAM_H
@@ -6,21 +6,31 @@
 #include <stdbool.h>
 
 /**
- * @brief 创建一个具有新形状的张量视图。
- * * 新张量与原张量共享底层数据。因此，元素的总数必须保持不变。
- * 返回的张量是一个视图，它不拥有数据（owns_data=false）。
+ * @brief 改变张量的形状。
+ * * 只要内存布局允许（被合并或拆分的那些维度彼此连续，例如 permute 或切片之后
+ * 只展平其中连续的部分），返回的就是与原张量共享 storage 的视图，不复制数据。
+ * 否则会先复制成连续张量，再返回这份新数据上的张量。元素的总数必须保持不变。
  * 使用完毕后，请务必对其调用 tensor_free()。
  *
  * @param t 要操作的原始张量。
- * @param new_shape 描述新形状的 Shape 对象。
- * @return 一个具有新形状的张量视图，如果失败则返回 NULL。
+ * @param new_shape 描述新形状的 Shape 对象（只使用它的 dims）。
+ * @return 一个具有新形状的张量，如果失败则返回 NULL。
  */
 Tensor tensor_reshape(const Tensor t, const Shape new_shape);
 
+/**
+ * @brief 同 tensor_reshape()，并告诉调用者走的是哪条路径。
+ *
+ * @param t 要操作的原始张量。
+ * @param new_shape 描述新形状的 Shape 对象。
+ * @param is_view 可以为 NULL。返回视图时置为 true，发生了复制时置为 false。
+ * @return 一个具有新形状的张量，如果失败则返回 NULL。
+ */
+Tensor tensor_reshape_ex(const Tensor t, const Shape new_shape, bool* is_view);
+
 /**
  * @brief 置换张量的维度。
- * * 返回的张量是一个视图，与原张量共享数据。
- * 返回的张量是一个视图，它不拥有数据（owns_data=false）。
+ * * 返回的张量是一个视图，与原张量共享 storage，并让它保持存活。
  * 使用完毕后，请务必对其调用 tensor_free()。
  *
  * @param t 要操作的原始张量。
@@ -39,9 +49,9 @@ bool tensor_is_contiguous(const Tensor t);
 
 /**
  * @brief 返回一个内存连续的张量。
- * * 如果输入的张量已经是连续的，将返回该张量的一个副本（copy）。
+ * * 如果输入的张量已经是连续的，将返回该张量的一个写时复制的副本（tensor_copy，O(1)）。
  * 如果不是，将创建一个新的连续张量，并复制数据。
- * 返回的张量总是拥有其数据（owns_data=true）。
+ * 无论哪种情况，之后写入结果都不会影响原张量。
  *
  * @param t 要操作的张量。
  * @return 一个新的连续张量。请记得使用 tensor_free() 释放它。
@@ -50,7 +60,7 @@ Tensor tensor_contiguous(const Tensor t);
 
 /**
  * @brief 通过广播将张量扩展到更大的尺寸。
- * * 返回的张量是一个视图，不拥有其数据。
+ * * 返回的张量是一个视图，与原张量共享 storage。
  * 只有当原始维度大小为1时，该维度才能被扩展。
  *
  * @param t 要操作的原始张量。
@@ -59,5 +69,110 @@ Tensor tensor_contiguous(const Tensor t);
  */
 Tensor tensor_expand(const Tensor t, const Shape target_shape);
 
+/**
+ * @brief 沿一个轴切片：取 [start, stop) 中每隔 step 个的元素，等价于 Python 的 t[..., start:stop:step, ...]。
+ * * 返回的张量是一个视图，与原张量共享 storage，不复制任何数据：
+ * 起点折算进 storage offset，step 折算进该轴的 stride。
+ * 越界的 start/stop 会被截断到 [0, dim]，stop <= start 得到长度为 0 的视图。
+ *
+ * @param t 要操作的原始张量。
+ * @param axis 要切片的轴。
+ * @param start 起始下标（包含，不支持负数）。
+ * @param stop 结束下标（不包含，不支持负数）。
+ * @param step 步长，必须为正数。
+ * @return 一个切片视图，如果失败则返回 NULL。
+ */
+Tensor tensor_slice(const Tensor t, int axis, int start, int stop, int step);
+
+/**
+ * @brief 沿一个轴取 [start, start + length) 的连续一段，等价于 tensor_slice(t, axis, start, start + length, 1)。
+ * * 与 tensor_slice() 不同，范围越界会报错而不是被截断。
+ *
+ * @param t 要操作的原始张量。
+ * @param axis 要操作的轴。
+ * @param start 起始下标。
+ * @param length 长度。
+ * @return 一个视图，如果失败则返回 NULL。
+ */
+Tensor tensor_narrow(const Tensor t, int axis, int start, int length);
+
+/**
+ * @brief 取一个轴上第 index 个位置，结果去掉该轴（少一维），等价于 t[..., index, ...]。
+ * * 返回的张量是一个视图，与原张量共享 storage。
+ *
+ * @param t 要操作的原始张量。
+ * @param axis 要操作的轴。
+ * @param index 下标。
+ * @return 一个视图，如果失败则返回 NULL。
+ */
+Tensor tensor_select(const Tensor t, int axis, int index);
+
+/**
+ * @brief 用任意的 dims/strides/offset 在原张量的 storage 上创建视图。
+ * * 这是最底层的视图工具：广播（stride 为 0）、滑动窗口（相邻位置重叠）等布局都可以直接表达。
+ * 视图能访问到的每个元素都会被检查是否落在 storage 之内，越界时返回 NULL。
+ * 注意：当不同位置映射到同一个元素时（重叠视图），不要通过它写入。
+ *
+ * @param t 提供 storage 的张量。
+ * @param dims 视图的 ndim 个维度。
+ * @param strides 视图的 ndim 个步长（以元素为单位）。
+ * @param ndim 维数。
+ * @param offset 视图第一个元素在 storage 中的位置（以元素为单位，是绝对位置，不是相对于 t 的偏移）。
+ * @return 一个视图，如果失败则返回 NULL。
+ */
+Tensor tensor_as_strided(const Tensor t, const int* dims, const size_t* strides, int ndim, size_t offset);
+
+/**
+ * @brief 沿一个轴展开出所有长度为 size、间隔为 step 的滑动窗口（im2col）。
+ * * 结果比原张量多一维：原来的轴变为窗口个数 (dim - size) / step + 1，
+ * 新增的最后一维是窗口内的 size 个元素。返回的是与原张量共享 storage 的视图，
+ * 相邻窗口重叠的部分不会被复制，可以直接交给 tensor_matmul()/tensor_bmm() 这类按 stride 读取的算子。
+ *
+ * @param t 要操作的原始张量。
+ * @param axis 要展开的轴。
+ * @param size 窗口长度（1 <= size <= dim）。
+ * @param step 相邻窗口起点的间隔，必须为正数。
+ * @return 一个窗口视图，如果失败则返回 NULL。
+ */
+Tensor tensor_unfold(const Tensor t, int axis, int size, int step);
+
+/**
+ * @brief 沿已有的轴 axis 拼接 n 个张量，等价于 torch.cat / np.concatenate。
+ * * 各输入的 dtype 和维数必须相同，除 axis 以外的维度也必须相同（axis 上可以为 0）。
+ * 输出的形状只计算一次、数据只分配一次；每个输入按 stride 直接复制进输出中对应的一段，
+ * 所以切片、转置之类的非连续视图不必先变成连续张量。复制被切成大小相近的块交给线程池，
+ * 许多小张量和少数大张量都能并行。
+ *
+ * @param tensors n 个输入张量。
+ * @param n 输入个数，至少为 1。
+ * @param axis 拼接的轴。
+ * @return 一个新的连续张量，如果失败则返回 NULL。
+ */
+Tensor tensor_cat(const Tensor* tensors, int n, int axis);
+
+/**
+ * @brief 同 tensor_cat()，把结果写进调用者提供的 out，不分配输出。
+ * * out 的形状和 dtype 必须与结果一致，可以是视图（例如一个可复用的 batch 缓冲区的切片），
+ * 但不能与任何输入共享内存。
+ *
+ * @return 成功返回 true，失败返回 false（此时 out 的内容未定义）。
+ */
+bool tensor_cat_out(Tensor out, const Tensor* tensors, int n, int axis);
+
+/**
+ * @brief 沿一个新轴 axis 堆叠 n 个形状相同的张量，等价于 torch.stack / np.stack。
+ * * 结果比输入多一维，axis 上的长度为 n。实现方式与 tensor_cat() 相同。
+ *
+ * @param tensors n 个输入张量，形状和 dtype 必须相同。
+ * @param n 输入个数，至少为 1。
+ * @param axis 新轴在结果中的位置（0 <= axis <= 输入的维数）。
+ * @return 一个新的连续张量，如果失败则返回 NULL。
+ */
+Tensor tensor_stack(const Tensor* tensors, int n, int axis);
+
+/**
+ * @brief 同 tensor_stack()，把结果写进调用者提供的 out。要求见 tensor_cat_out()。
+ */
+bool tensor_stack_out(Tensor out, const Tensor* tensors, int n, int axis);
 
 #endif // _TENSOR_VIEW_H
\ No newline at end of file
@@ -2,7 +2,15 @@
 #define TENSOR_H
 
 #include "tensor/_tensor_core.h"
+#include "tensor/_tensor_cast.h"
 #include "tensor/_tensor_view.h"
+#include "tensor/_tensor_iter.h"
 #include "tensor/_tensor_ops.h"
+#include "tensor/_tensor_linalg.h"
+#include "tensor/_tensor_lazy.h"
+#include "tensor/_tensor_io.h"
+#include "tensor/_tensor_index.h"
+#include "tensor/_tensor_access.h"
+#include "tensor/_tensor_stream.h"
 
 #endif // TENSOR_H
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef _CPU_FEATURES_H
+#define _CPU_FEATURES_H
+
+#include <stdbool.h>
+
+typedef struct
+{
+    bool avx2;       // x86: AVX2 (with FMA)
+    bool avx512f;    // x86: AVX-512 Foundation
+    bool f16c;       // x86: F32 <-> F16 conversions
+    bool avx512bf16; // x86: AVX-512 F32 -> BF16 conversions
+    bool neon;       // ARM: Advanced SIMD (always present on AArch64)
+}
+CpuFeatures;
+
+/**
+ * @brief Detects the SIMD features of the running CPU.
+ * Detection runs once, on first use; later calls return the cached result.
+ * Setting the environment variable SNAKE_SIMD to "scalar", "avx2" or "avx512"
+ * caps the features reported, which is handy for benchmarks and debugging.
+ *
+ * @return A pointer to the process-wide feature set. Never NULL.
+ */
+const CpuFeatures* cpu_get_features(void);
+
+#endif // _CPU_FEATURES_H
@@ -1,7 +1,9 @@
 #ifndef _MALLOC_H
 #define _MALLOC_H
 
-#include <stdlib.h> 
+#include <stdbool.h>
+#include <stdio.h>  // For FILE
+#include <stdlib.h>
 
 void* _safe_malloc_internal(size_t size, const char* file, int line);
 #define safemalloc(size) _safe_malloc_internal(size, __FILE__, __LINE__)
@@ -9,5 +11,213 @@ void* _safe_malloc_internal(size_t size, const char* file, int line);
 void* _safe_calloc_internal(size_t num, size_t size, const char* file, int line);
 #define safecalloc(num, size) _safe_calloc_internal(num, size, __FILE__, __LINE__)
 
-#endif // _MALLOC_H
+// --- Aligned allocation (tensor storage) ---
+
+#define SAFE_DEFAULT_ALIGNMENT 64 // one cache line, and a full AVX-512 vector
+
+void* _safe_aligned_alloc_internal(size_t num, size_t size, int zero, const char* file, int line);
+
+/**
+ * @brief Allocates `size` bytes aligned to the current alignment (see safe_alloc_set_alignment).
+ * Blocks from this family must be released with safe_aligned_free(), never free().
+ */
+#define safe_aligned_malloc(size) _safe_aligned_alloc_internal(1, size, 0, __FILE__, __LINE__)
+
+/**
+ * @brief Like safe_aligned_malloc(), for `num * size` zero-initialized bytes (overflow-checked).
+ */
+#define safe_aligned_calloc(num, size) _safe_aligned_alloc_internal(num, size, 1, __FILE__, __LINE__)
+
+/**
+ * @brief Releases a block from safe_aligned_malloc()/safe_aligned_calloc(). NULL is a no-op.
+ */
+void safe_aligned_free(void* ptr);
+
+/**
+ * @brief Sets the alignment of later aligned allocations (default SAFE_DEFAULT_ALIGNMENT).
+ * @param alignment A power of two, at least sizeof(void*) and at most 2 MiB.
+ * @return 0 on success, -1 if `alignment` is invalid (the setting is left unchanged).
+ */
+int safe_alloc_set_alignment(size_t alignment);
+size_t safe_alloc_get_alignment(void);
+
+/**
+ * @brief Opts in to huge-page backing: aligned allocations of at least `bytes` are mapped
+ * on 2 MiB boundaries and advised with MADV_HUGEPAGE, so the kernel can back them with
+ * transparent huge pages. 0 (the default) disables the path. It can also be enabled
+ * with the SNAKE_HUGEPAGE_THRESHOLD environment variable (in bytes).
+ * On systems without madvise/THP the mapping is still made, just with normal pages.
+ */
+void safe_alloc_set_hugepage_threshold(size_t bytes);
+size_t safe_alloc_get_hugepage_threshold(void);
+
+// --- Small objects, arenas and scopes (tensor headers, shapes, temporary buffers) ---
+//
+// Small fixed-size objects such as Tensor and Shape headers come from
+// safe_small_alloc(). Outside of a scope they are served from per-thread freelists
+// (one per size class), so steady-state create/free cycles do not touch the global heap.
+//
+// Inside an arena scope (safe_arena_enter() ... safe_arena_leave()) they are bump-
+// allocated from the thread's current arena instead, and freeing them is a no-op; the
+// whole scope is released at once with safe_arena_reset(). With SAFE_ARENA_DATA the
+// aligned allocations used for tensor data come from the arena as well.
+//
+// Everything allocated from an arena is invalid after safe_arena_reset(). A reset only
+// reclaims arena memory: anything a scoped object references outside of the arena
+// (e.g. heap tensor data when SAFE_ARENA_DATA is off) still has to be freed normally,
+// for instance with tensor_free(), which is always safe to call on scoped tensors.
+// The private copy a copy-on-write tensor gets on its first write is always allocated
+// from the heap, even inside a scope, since the tensor may have been created outside it.
+// An arena must only be used by one thread at a time.
+
+void* _safe_small_alloc_internal(size_t size, const char* file, int line);
+
+/**
+ * @brief Allocates a small object (from the current arena, or a per-thread freelist).
+ * Blocks from this family must be released with safe_small_free(), never free().
+ */
+#define safe_small_alloc(size) _safe_small_alloc_internal(size, __FILE__, __LINE__)
+
+/**
+ * @brief Releases a block from safe_small_alloc(). Arena blocks are left for the reset. NULL is a no-op.
+ */
+void safe_small_free(void* ptr);
+
+#define SAFE_ARENA_DATA 1 // also serve safe_aligned_malloc()/safe_aligned_calloc() from the arena
+
+typedef struct _safe_arena SafeArena;
+
+/**
+ * @brief Creates an arena that grows in blocks of `block_size` bytes (0 selects 64 KiB).
+ * @param flags 0 or SAFE_ARENA_DATA.
+ * @return The new arena, or NULL on failure.
+ */
+SafeArena* safe_arena_create(size_t block_size, int flags);
+
+/**
+ * @brief Frees the arena and everything allocated from it. NULL is a no-op.
+ */
+void safe_arena_destroy(SafeArena* arena);
+
+/**
+ * @brief Releases everything allocated from the arena at once, keeping its first block for reuse.
+ */
+void safe_arena_reset(SafeArena* arena);
 
+/**
+ * @brief Bytes currently handed out by the arena, including alignment padding.
+ */
+size_t safe_arena_used(const SafeArena* arena);
+
+/**
+ * @brief Makes `arena` the calling thread's current arena (NULL: none) and returns the previous one.
+ * Scopes nest: pass the returned value to safe_arena_leave() to restore it.
+ */
+SafeArena* safe_arena_enter(SafeArena* arena);
+void safe_arena_leave(SafeArena* previous);
+
+/**
+ * @brief The calling thread's current arena, or NULL.
+ */
+SafeArena* safe_arena_current(void);
+
+// --- Allocation tracing (opt-in) ---
+//
+// When tracing is on, every allocation made through this header is attributed to its
+// call site (the __FILE__/__LINE__ of the macro) and counted with relaxed atomics:
+// number of allocations, bytes requested, bytes still live and the peak of the live
+// bytes, per call site and per category. Tracing is off by default and costs one
+// relaxed load per allocation then; enable it with safe_alloc_trace_enable() or by
+// setting the SNAKE_ALLOC_TRACE environment variable to a non-zero value.
+//
+// Only allocations made while tracing is on are tracked; freeing them later is
+// accounted for even if tracing has been turned off in between. Blocks from
+// safemalloc()/safecalloc() are released with plain free(), which cannot be seen, so
+// SAFE_ALLOC_GENERAL only counts allocations and bytes, never live bytes. Objects
+// carved out of an arena are counted at their call site too, but their memory is
+// live as part of the arena's blocks (SAFE_ALLOC_ARENA).
+
+typedef enum
+{
+    SAFE_ALLOC_GENERAL, // safemalloc()/safecalloc(); live bytes are not tracked
+    SAFE_ALLOC_DATA,    // aligned allocations, i.e. tensor storage
+    SAFE_ALLOC_SMALL,   // safe_small_alloc(), i.e. Tensor/Shape/Storage headers
+    SAFE_ALLOC_ARENA,   // blocks owned by arenas
+    SAFE_ALLOC_CATEGORY_COUNT
+}
+SafeAllocCategory;
+
+typedef struct
+{
+    size_t live_bytes; // over all categories
+    size_t peak_bytes; // highest live_bytes seen since tracing started or the last reset
+    size_t allocs[SAFE_ALLOC_CATEGORY_COUNT];
+    size_t live[SAFE_ALLOC_CATEGORY_COUNT];
+    size_t peak[SAFE_ALLOC_CATEGORY_COUNT];
+}
+SafeAllocStats;
+
+typedef struct
+{
+    const char* file;
+    int line;
+    SafeAllocCategory category;
+    size_t allocs;     // allocations made here
+    size_t bytes;      // bytes requested here in total
+    size_t live_bytes; // bytes allocated here and not freed yet
+    size_t peak_bytes; // highest live_bytes of this site
+}
+SafeAllocSite;
+
+typedef struct
+{
+    bool is_free;
+    SafeAllocCategory category;
+    size_t bytes;
+    const char* file; // where the block was allocated, also for frees
+    int line;
+    size_t live_bytes; // total live bytes after this event
+}
+SafeAllocEvent;
+
+/**
+ * @brief Called for every traced allocation and free, on the thread that made it.
+ * It must not allocate through this header.
+ */
+typedef void (*SafeAllocHook)(const SafeAllocEvent* event, void* ctx);
+
+/**
+ * @brief Turns tracing on or off (see above).
+ */
+void safe_alloc_trace_enable(bool enable);
+bool safe_alloc_trace_enabled(void);
+
+/**
+ * @brief Installs a hook for traced events, e.g. to forward them to a metrics exporter
+ * (NULL removes it). Set it while no other thread is allocating.
+ */
+void safe_alloc_trace_set_hook(SafeAllocHook hook, void* ctx);
+
+/**
+ * @brief Gets the global counters.
+ */
+void safe_alloc_trace_stats(SafeAllocStats* stats);
+
+/**
+ * @brief Copies up to `max` call sites into `sites`, highest peak_bytes first
+ * (then most bytes requested).
+ * @return The number of call sites seen, which may be more than `max`.
+ */
+size_t safe_alloc_trace_sites(SafeAllocSite* sites, size_t max);
+
+/**
+ * @brief Restarts the peaks (global, per category and per site) from the current live bytes.
+ */
+void safe_alloc_trace_reset_peak(void);
+
+/**
+ * @brief Prints the global counters and the call sites, highest peak first, to `out`.
+ */
+void safe_alloc_trace_dump(FILE* out);
+
+#endif // _MALLOC_H
@@ -0,0 +1,67 @@
+#ifndef _PARALLEL_H
+#define _PARALLEL_H
+
+#include <stddef.h> // For size_t
+
+/**
+ * @brief A loop body that processes the index range [begin, end).
+ */
+typedef void (*ParallelForFn)(size_t begin, size_t end, void* ctx);
+
+// Minimum number of bytes of work in one chunk chosen by parallel_grain(), so that
+// per-chunk overhead stays small next to the work itself.
+#define PARALLEL_CHUNK_BYTES ((size_t)64 << 10)
+
+/**
+ * @brief Runs `fn` over [begin, end), split into chunks of at least `grain` indices
+ * that are processed concurrently on the shared thread pool. The calling thread takes
+ * part in the work, and the call returns once every chunk is done. Ranges smaller
+ * than two grains run inline on the caller.
+ *
+ * Each participating thread starts on its own contiguous slice of the range and,
+ * once that is done, steals the remaining chunks of the others, so uneven chunks do
+ * not leave threads idle. Any number of threads may call parallel_for at the same
+ * time (including from inside a loop body); their calls share the pool.
+ *
+ * @param begin First index.
+ * @param end One past the last index.
+ * @param grain Minimum number of indices per chunk (0 is treated as 1). See parallel_grain().
+ * @param fn The loop body.
+ * @param ctx User context passed to `fn`.
+ */
+void parallel_for(size_t begin, size_t end, size_t grain, ParallelForFn fn, void* ctx);
+
+/**
+ * @brief Like parallel_for(), using at most `max_threads` threads (including the caller)
+ * for this call. 0 applies no extra limit.
+ */
+void parallel_for_ex(size_t begin, size_t end, size_t grain, int max_threads, ParallelForFn fn, void* ctx);
+
+/**
+ * @brief Picks a grain for loops whose indices each touch `bytes_per_index` bytes
+ * (e.g. the number of operands times tensor_get_item_size()), so that every chunk
+ * covers about PARALLEL_CHUNK_BYTES.
+ */
+size_t parallel_grain(size_t bytes_per_index);
+
+/**
+ * @brief Gets the number of threads parallel_for may use.
+ * Defaults to the number of online CPUs, or to the SNAKE_NUM_THREADS environment variable.
+ */
+int parallel_get_num_threads(void);
+
+/**
+ * @brief Sets the number of threads parallel_for may use (values < 1 are treated as 1).
+ */
+void parallel_set_num_threads(int num_threads);
+
+/**
+ * @brief Limits the parallel_for calls made by the calling thread (and therefore every
+ * op it runs) to `max_threads` threads. 0 removes the limit. Useful in servers that
+ * run several requests at once and want to share the cores between them. The limit
+ * also holds for parallel_for calls nested in those loops, whichever thread runs them.
+ * @return The previous limit of the calling thread.
+ */
+int parallel_set_thread_limit(int max_threads);
+
+#endif // _PARALLEL_H
@@ -2,92 +2,467 @@
 
 #include "utils/_malloc.h"
 
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h> // for uint64_t
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdio.h>
 
 
+// 维数不超过这个值时 dims/strides 直接放在结构体里，否则接在结构体尾部。
+// 两种情况下每个 Shape 都只有一次分配，strides 和 dims 紧挨着存放。
+#define SHAPE_INLINE_DIMS 8
+
+// 缓存分成这么多段，每段一把锁、一张哈希表，不同形状的查找很少互相等待
+#define SHAPE_CACHE_STRIPES 16
+// 每段哈希表最初的桶数；平均每桶超过一个元素时翻倍
+#define SHAPE_CACHE_MIN_BUCKETS 64
+// 每段最多暂时留着这么多没人引用的实例，超过时清理
+#define SHAPE_CACHE_KEEP 256
 
 struct _shape
 {
     int* _dims;
     size_t* _stride;
     int _ndim;
+    // 以下字段只对缓存里的共享实例有意义
+    bool _interned;
+    atomic_uint _refs;
+    size_t _hash;
+    struct _shape* _next;   // 同一个桶里的下一个实例
+    struct _shape* _contig; // dims 相同的行主序实例（可能就是自己），shape_equals 只比较它
+    // 前 ndim 个 size_t 是 strides，其后紧跟 ndim 个 int 的 dims
+    size_t _inline[SHAPE_INLINE_DIMS + (SHAPE_INLINE_DIMS * sizeof(int) + sizeof(size_t) - 1) / sizeof(size_t)];
+    size_t _extra[]; // ndim > SHAPE_INLINE_DIMS 时使用，布局同上
 };
 
-// --- Lifecycle Functions ---
+static void
+_shape_init(Shape shape, int ndim, size_t* storage)
+{
+    shape->_ndim = ndim;
+    shape->_stride = storage;
+    shape->_dims = (int*)(storage + ((ndim > 0) ? (size_t)ndim : 0));
+    shape->_interned = false;
+}
 
-/**
- * @brief Creates a new Shape object from a given dimensions array.
- */
-Shape
-shape_create(const int* dims, int ndim)
+static size_t
+_shape_extra_bytes(int ndim)
+{
+    return (ndim > SHAPE_INLINE_DIMS) ? (size_t)ndim * (sizeof(size_t) + sizeof(int)) : 0;
+}
+
+// 分配一个 ndim 维的 Shape，_dims/_stride 已指向各自的存储，内容未初始化
+static Shape
+_shape_alloc(int ndim)
 {
-    Shape new = safemalloc(sizeof(struct _shape));
+    Shape new = safe_small_alloc(sizeof(struct _shape) + _shape_extra_bytes(ndim));
     if (new == NULL) return NULL;
 
-    new->_dims = safemalloc(sizeof(int) * ndim);
-    if (new->_dims == NULL)
+    _shape_init(new, ndim, (ndim > SHAPE_INLINE_DIMS) ? new->_extra : new->_inline);
+    return new;
+}
+
+// Calculate strides for row-major layout
+static void
+_shape_init_strides(Shape shape)
+{
+    const int ndim = shape->_ndim;
+    if (ndim <= 0) return;
+
+    shape->_stride[ndim-1] = 1;
+    for (int i = ndim-2; i >= 0; i--)
+        shape->_stride[i] = shape->_stride[i+1] * shape->_dims[i+1];
+}
+
+// 复制成一个独立的私有 Shape
+static Shape
+_shape_dup(const Shape other)
+{
+    Shape new = _shape_alloc(other->_ndim);
+    if (new == NULL) return NULL;
+
+    // Copy dimensions and strides directly, no need to recalculate
+    memcpy(new->_dims, other->_dims, sizeof(int) * new->_ndim);
+    memcpy(new->_stride, other->_stride, sizeof(size_t) * new->_ndim);
+
+    return new;
+}
+
+// 准备一个 ndim 维的临时 Shape：维数不大时用调用方栈上的 tmp，否则分配
+static Shape
+_shape_begin(struct _shape* tmp, int ndim)
+{
+    if (ndim > SHAPE_INLINE_DIMS) return _shape_alloc(ndim);
+
+    _shape_init(tmp, ndim, tmp->_inline);
+    return tmp;
+}
+
+// 释放 _shape_begin() 得到的 Shape：栈上的临时 Shape（tmp）不用释放，堆上的才释放
+static void
+_shape_discard(struct _shape* tmp, Shape shape)
+{
+    if (shape != tmp) safe_small_free(shape);
+}
+
+// --- Shape cache ---
+// 缓存里的实例不可变、带引用计数，只用 safemalloc 分配（不进 arena），因为它们被所有
+// 线程、所有作用域共享。引用计数减到 0 时实例先留在表里，下一次创建同样的形状直接
+// 复用，这样反复创建、释放同一个视图的循环不会每次都分配；段里的实例太多时才把
+// 没人引用的那些清掉。查找命中时的加一和清理都在段锁里，所以不会清掉刚被找到的实例，
+// 释放引用则不用锁。
+
+typedef struct
+{
+    pthread_mutex_t lock;
+    Shape* buckets;      // bucket_count 个链表头，第一次插入时分配
+    size_t bucket_count; // 2 的幂
+    size_t count;        // 包括引用计数为 0、暂时留着的实例
+    size_t sweep_at;     // count 到这个值时清理一次
+}
+ShapeCacheStripe;
+
+static ShapeCacheStripe _stripes[SHAPE_CACHE_STRIPES];
+static pthread_once_t _stripes_once = PTHREAD_ONCE_INIT;
+static atomic_int _cache_on = -1; // -1 表示还没读环境变量
+
+static void
+_stripes_init(void)
+{
+    for (int i = 0; i < SHAPE_CACHE_STRIPES; i++)
     {
-        free(new);
-        return NULL;
+        pthread_mutex_init(&_stripes[i].lock, NULL);
+        _stripes[i].sweep_at = SHAPE_CACHE_KEEP;
+    }
+}
+
+static bool
+_cache_enabled(void)
+{
+    int on = atomic_load_explicit(&_cache_on, memory_order_relaxed);
+    if (on < 0)
+    {
+        const char* env = getenv("SNAKE_SHAPE_CACHE");
+        int expected = -1;
+        atomic_compare_exchange_strong(&_cache_on, &expected, (env != NULL && strtol(env, NULL, 10) != 0) ? 1 : 0);
+        on = atomic_load(&_cache_on);
+    }
+    return on != 0;
+}
+
+static size_t
+_shape_hash(const int* dims, const size_t* strides, int ndim)
+{
+    uint64_t h = 0xcbf29ce484222325ull ^ (uint64_t)ndim;
+    for (int i = 0; i < ndim; i++)
+    {
+        h = (h ^ (uint32_t)dims[i]) * 0x100000001b3ull;
+        h = (h ^ (uint64_t)strides[i]) * 0x100000001b3ull;
     }
-    memcpy(new->_dims, dims, sizeof(int) * ndim);
-    new->_ndim = ndim;
+    // 收尾混合，让高位和低位都参与段和桶的选择
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return (size_t)h;
+}
 
-    new->_stride = safemalloc(sizeof(size_t) * ndim);
-    if (new->_stride == NULL)
+static bool
+_is_row_major(const int* dims, const size_t* strides, int ndim)
+{
+    size_t expected = 1;
+    for (int i = ndim - 1; i >= 0; i--)
     {
-        free(new->_dims);
-        free(new);
-        return NULL;
+        if (strides[i] != expected) return false;
+        expected *= (size_t)dims[i];
+    }
+    return true;
+}
+
+static ShapeCacheStripe*
+_stripe_of(size_t hash)
+{
+    return &_stripes[hash & (SHAPE_CACHE_STRIPES - 1)];
+}
+
+static Shape*
+_bucket_of(ShapeCacheStripe* stripe, size_t hash)
+{
+    return &stripe->buckets[(hash >> 4) & (stripe->bucket_count - 1)];
+}
+
+// 在段里找一个相同的实例，找到时引用计数加一。调用方持有段锁
+static Shape
+_stripe_find(ShapeCacheStripe* stripe, size_t hash, const Shape key)
+{
+    if (stripe->buckets == NULL) return NULL;
+    for (Shape s = *_bucket_of(stripe, hash); s != NULL; s = s->_next)
+    {
+        if (s->_hash == hash && s->_ndim == key->_ndim &&
+            memcmp(s->_dims, key->_dims, sizeof(int) * key->_ndim) == 0 &&
+            memcmp(s->_stride, key->_stride, sizeof(size_t) * key->_ndim) == 0)
+        {
+            atomic_fetch_add_explicit(&s->_refs, 1, memory_order_relaxed);
+            return s;
+        }
     }
+    return NULL;
+}
 
-    // Calculate strides for row-major layout
+// 把没人引用的实例从段里摘下来，用 _next 串成链表返回。调用方持有段锁，
+// 解锁后再用 _free_swept() 释放
+static Shape
+_stripe_sweep(ShapeCacheStripe* stripe)
+{
+    Shape swept = NULL;
+    for (size_t b = 0; b < stripe->bucket_count; b++)
+    {
+        for (Shape* link = &stripe->buckets[b]; *link != NULL;)
+        {
+            Shape s = *link;
+            if (atomic_load_explicit(&s->_refs, memory_order_acquire) != 0)
+            {
+                link = &s->_next;
+                continue;
+            }
+            *link = s->_next;
+            s->_next = swept;
+            swept = s;
+            stripe->count--;
+        }
+    }
+    return swept;
+}
+
+static void _shape_release(Shape shape);
+
+static void
+_free_swept(Shape swept)
+{
+    for (Shape s = swept, next; s != NULL; s = next)
+    {
+        next = s->_next;
+        if (s->_contig != s) _shape_release(s->_contig);
+        free(s);
+    }
+}
+
+// 插入一个新实例，先按需清理、扩容。调用方持有段锁；清掉的实例通过 swept 交给调用方释放
+static bool
+_stripe_insert(ShapeCacheStripe* stripe, Shape shape, Shape* swept)
+{
+    if (stripe->count >= stripe->sweep_at)
+    {
+        *swept = _stripe_sweep(stripe);
+        // 剩下的都还在用时，等表再长一倍才清理下一次，避免每次插入都扫一遍
+        stripe->sweep_at = (2 * stripe->count > SHAPE_CACHE_KEEP) ? 2 * stripe->count : SHAPE_CACHE_KEEP;
+    }
+    if (stripe->count >= stripe->bucket_count)
+    {
+        const size_t new_count = (stripe->bucket_count == 0) ? SHAPE_CACHE_MIN_BUCKETS : 2 * stripe->bucket_count;
+        Shape* buckets = safecalloc(new_count, sizeof(Shape));
+        if (buckets == NULL && stripe->buckets == NULL) return false;
+        if (buckets != NULL) // 扩容失败时继续用原来的表，只是链表更长
+        {
+            for (size_t b = 0; b < stripe->bucket_count; b++)
+            {
+                for (Shape s = stripe->buckets[b], next; s != NULL; s = next)
+                {
+                    next = s->_next;
+                    Shape* head = &buckets[(s->_hash >> 4) & (new_count - 1)];
+                    s->_next = *head;
+                    *head = s;
+                }
+            }
+            free(stripe->buckets);
+            stripe->buckets = buckets;
+            stripe->bucket_count = new_count;
+        }
+    }
+    Shape* head = _bucket_of(stripe, shape->_hash);
+    shape->_next = *head;
+    *head = shape;
+    stripe->count++;
+    return true;
+}
+
+// 返回与私有的 key 相同（dims 和 strides 都相同）的共享实例，没有就登记一个；不接管 key
+static Shape
+_shape_intern(const Shape key)
+{
+    pthread_once(&_stripes_once, _stripes_init);
+    const size_t hash = _shape_hash(key->_dims, key->_stride, key->_ndim);
+    ShapeCacheStripe* stripe = _stripe_of(hash);
+
+    pthread_mutex_lock(&stripe->lock);
+    Shape found = _stripe_find(stripe, hash, key);
+    pthread_mutex_unlock(&stripe->lock);
+    if (found != NULL) return found;
+
+    // 没有命中：在锁外建好新实例（包括它的行主序实例，那可能要锁另一段），再登记
+    const int ndim = key->_ndim;
+    Shape new = safemalloc(sizeof(struct _shape) + _shape_extra_bytes(ndim));
+    if (new == NULL) return NULL;
+    _shape_init(new, ndim, (ndim > SHAPE_INLINE_DIMS) ? new->_extra : new->_inline);
     if (ndim > 0)
     {
-        new->_stride[ndim-1] = 1;
-        for (int i = ndim-2; i >= 0; i--)
-            new->_stride[i] = new->_stride[i+1] * new->_dims[i+1];
+        memcpy(new->_dims, key->_dims, sizeof(int) * ndim);
+        memcpy(new->_stride, key->_stride, sizeof(size_t) * ndim);
+    }
+    new->_interned = true;
+    atomic_init(&new->_refs, 1);
+    new->_hash = hash;
+    new->_next = NULL;
+    new->_contig = new;
+    if (!_is_row_major(new->_dims, new->_stride, ndim))
+    {
+        struct _shape tmp;
+        Shape row_major = _shape_begin(&tmp, ndim);
+        if (row_major == NULL)
+        {
+            free(new);
+            return NULL;
+        }
+        memcpy(row_major->_dims, new->_dims, sizeof(int) * ndim);
+        _shape_init_strides(row_major);
+        new->_contig = _shape_intern(row_major);
+        _shape_discard(&tmp, row_major);
+        if (new->_contig == NULL)
+        {
+            free(new);
+            return NULL;
+        }
     }
 
-    return new;
+    Shape swept = NULL;
+    pthread_mutex_lock(&stripe->lock);
+    found = _stripe_find(stripe, hash, key); // 别的线程可能刚登记了同一个
+    const bool inserted = found == NULL && _stripe_insert(stripe, new, &swept);
+    pthread_mutex_unlock(&stripe->lock);
+    _free_swept(swept);
+    if (inserted) return new;
+
+    new->_next = NULL;
+    _free_swept(new);
+    return found;
+}
+
+static void
+_shape_release(Shape shape)
+{
+    // 减到 0 的实例留在表里，由 _stripe_sweep() 回收
+    atomic_fetch_sub_explicit(&shape->_refs, 1, memory_order_release);
+}
+
+// 构造完成：缓存打开时换成缓存里的共享实例，否则复制成调用方自己的 Shape。
+// 先在栈上构造再复制，命中缓存时就完全不用分配
+static Shape
+_shape_end(struct _shape* tmp, Shape shape)
+{
+    Shape result = _cache_enabled() ? _shape_intern(shape) : _shape_dup(shape);
+    _shape_discard(tmp, shape);
+    return result;
+}
+
+void
+shape_cache_set_enabled(bool enabled)
+{
+    atomic_store(&_cache_on, enabled ? 1 : 0);
+
+    // 关掉时不再需要留着没人引用的实例；仍在用的不受影响
+    if (!enabled) shape_cache_trim();
+}
+
+bool
+shape_cache_is_enabled(void)
+{
+    return _cache_enabled();
 }
 
+size_t
+shape_cache_trim(void)
+{
+    pthread_once(&_stripes_once, _stripes_init);
+
+    // 清掉一个视图的形状会放掉它对行主序实例的引用，后者可能在下一轮才变成没人引用
+    bool swept_any = true;
+    while (swept_any)
+    {
+        swept_any = false;
+        for (int i = 0; i < SHAPE_CACHE_STRIPES; i++)
+        {
+            pthread_mutex_lock(&_stripes[i].lock);
+            Shape swept = _stripe_sweep(&_stripes[i]);
+            pthread_mutex_unlock(&_stripes[i].lock);
+            swept_any |= swept != NULL;
+            _free_swept(swept);
+        }
+    }
+
+    size_t count = 0;
+    for (int i = 0; i < SHAPE_CACHE_STRIPES; i++)
+    {
+        pthread_mutex_lock(&_stripes[i].lock);
+        count += _stripes[i].count;
+        pthread_mutex_unlock(&_stripes[i].lock);
+    }
+    return count;
+}
+
+
+// --- Lifecycle Functions ---
+
 /**
- * @brief Creates a copy of an existing Shape object.
+ * @brief Creates a new Shape object from a given dimensions array.
  */
 Shape
-shape_copy(const Shape other)
+shape_create(const int* dims, int ndim)
 {
-    if (other == NULL) return NULL;
-
-    Shape new = safemalloc(sizeof(struct _shape));
+    struct _shape tmp;
+    Shape new = _shape_begin(&tmp, ndim);
     if (new == NULL) return NULL;
 
-    new->_ndim = other->_ndim;
+    if (ndim > 0) memcpy(new->_dims, dims, sizeof(int) * ndim);
+    _shape_init_strides(new);
+
+    return _shape_end(&tmp, new);
+}
 
-    // Copy dimensions
-    new->_dims = safemalloc(sizeof(int) * new->_ndim);
-    if (new->_dims == NULL)
+/**
+ * @brief Creates a new Shape object with explicit strides.
+ */
+Shape
+shape_create_strided(const int* dims, const size_t* strides, int ndim)
+{
+    struct _shape tmp;
+    Shape new = _shape_begin(&tmp, ndim);
+    if (new == NULL) return NULL;
+
+    if (ndim > 0)
     {
-        free(new);
-        return NULL;
+        memcpy(new->_dims, dims, sizeof(int) * ndim);
+        memcpy(new->_stride, strides, sizeof(size_t) * ndim);
     }
-    memcpy(new->_dims, other->_dims, sizeof(int) * new->_ndim);
 
-    // Copy strides directly, no need to recalculate
-    new->_stride = safemalloc(sizeof(size_t) * new->_ndim);
-    if (new->_stride == NULL)
+    return _shape_end(&tmp, new);
+}
+
+/**
+ * @brief Creates a copy of an existing Shape object.
+ */
+Shape
+shape_copy(const Shape other)
+{
+    if (other == NULL) return NULL;
+
+    // 共享实例只需多一个引用；缓存打开时私有的 Shape 也换成共享实例
+    if (other->_interned)
     {
-        free(new->_dims);
-        free(new);
-        return NULL;
+        atomic_fetch_add_explicit(&other->_refs, 1, memory_order_relaxed);
+        return other;
     }
-    memcpy(new->_stride, other->_stride, sizeof(size_t) * new->_ndim);
-
-    return new;
+    return _cache_enabled() ? _shape_intern(other) : _shape_dup(other);
 }
 
 /**
@@ -98,9 +473,14 @@ shape_free(Shape shape)
 {
     if (shape == NULL) return;
 
-    free(shape->_dims);
-    free(shape->_stride);
-    free(shape);
+    if (shape->_interned)
+    {
+        _shape_release(shape);
+        return;
+    }
+
+    // dims/strides 与结构体在同一块内存里
+    safe_small_free(shape);
 }
 
 
@@ -192,6 +572,10 @@ shape_equals(const Shape a, const Shape b)
     if (a == NULL || b == NULL)
         return false;
 
+    // 共享实例的 dims 相同当且仅当它们的行主序实例是同一个
+    if (a->_interned && b->_interned)
+        return a->_contig == b->_contig;
+
     if (a->_ndim != b->_ndim)
         return false;
 
@@ -246,6 +630,40 @@ shape_is_contiguous(const Shape shape)
     return true;
 }
 
+bool
+shape_is_non_overlapping(const Shape shape)
+{
+    if (shape == NULL) return false;
+
+    // 只看长度大于 1 的维度，按 stride 从小到大插入排序
+    int dims[shape->_ndim > 0 ? shape->_ndim : 1];
+    size_t strides[shape->_ndim > 0 ? shape->_ndim : 1];
+    int n = 0;
+    for (int i = 0; i < shape->_ndim; i++)
+    {
+        if (shape->_dims[i] == 0) return true; // 没有元素
+        if (shape->_dims[i] == 1) continue;
+
+        int j = n++;
+        for (; j > 0 && strides[j - 1] > shape->_stride[i]; j--)
+        {
+            dims[j] = dims[j - 1];
+            strides[j] = strides[j - 1];
+        }
+        dims[j] = shape->_dims[i];
+        strides[j] = shape->_stride[i];
+    }
+
+    // 每一维的 stride 都必须跨过比它更小的那些维度所能覆盖的全部范围
+    size_t extent = 0; // 更小的维度能到达的最远偏移
+    for (int i = 0; i < n; i++)
+    {
+        if (strides[i] <= extent) return false;
+        extent += (size_t)(dims[i] - 1) * strides[i];
+    }
+    return true;
+}
+
 Shape
 shape_permute(const Shape source_shape, const int* axes)
 {
@@ -253,7 +671,9 @@ shape_permute(const Shape source_shape, const int* axes)
 
     int ndim = source_shape->_ndim;
 
-    bool* axis_seen = safecalloc(ndim, sizeof(bool)); // 创建一个“清单”
+    // 创建一个“清单”；常见的小维数直接用栈上的
+    bool seen_inline[SHAPE_INLINE_DIMS] = { false };
+    bool* axis_seen = (ndim <= SHAPE_INLINE_DIMS) ? seen_inline : safecalloc(ndim, sizeof(bool));
     if (axis_seen == NULL) return NULL; // 内存分配失败
 
     for (int i = 0; i < ndim; i++) {
@@ -262,37 +682,25 @@ shape_permute(const Shape source_shape, const int* axes)
         // 1. 检查范围
         if (original_axis < 0 || original_axis >= ndim) {
             fprintf(stderr, "Error: axis %d is out of bounds for tensor of dimension %d\n", original_axis, ndim);
-            free(axis_seen);
+            if (axis_seen != seen_inline) free(axis_seen);
             return NULL;
         }
         
         // 2. 检查唯一性
         if (axis_seen[original_axis]) {
             fprintf(stderr, "Error: duplicate axis %d found in axes array\n", original_axis);
-            free(axis_seen);
+            if (axis_seen != seen_inline) free(axis_seen);
             return NULL;
         }
         
         axis_seen[original_axis] = true; // 在清单上打勾
     }
-    free(axis_seen); // 检查完毕，释放清单
+    if (axis_seen != seen_inline) free(axis_seen); // 检查完毕，释放清单
 
-    Shape new_shape = safemalloc(sizeof(struct _shape));
+    struct _shape tmp;
+    Shape new_shape = _shape_begin(&tmp, ndim);
     if (new_shape == NULL) return NULL;
 
-    new_shape->_ndim = ndim;
-
-    // 分配新维度和新步长的内存
-    new_shape->_dims = safemalloc(sizeof(int) * ndim);
-    new_shape->_stride = safemalloc(sizeof(size_t) * ndim);
-    
-    if (new_shape->_dims == NULL || new_shape->_stride == NULL) {
-        free(new_shape->_dims);
-        free(new_shape->_stride);
-        free(new_shape);
-        return NULL;
-    }
-
     // 根据 axes 重新排序 shape 和 stride
     for (int i = 0; i < ndim; i++)
     {
@@ -301,8 +709,7 @@ shape_permute(const Shape source_shape, const int* axes)
         new_shape->_stride[i] = source_shape->_stride[original_axis];
     }
 
-    return new_shape;
-
+    return _shape_end(&tmp, new_shape);
 }
 
 // broad rule is from the right to left. e.g:
@@ -340,19 +747,14 @@ shape_expand(const Shape source_shape, const Shape target_shape)
     }
 
     // --- 2. 创建并填充新的 Shape 对象 ---
-    Shape new_shape = safemalloc(sizeof(struct _shape));
+    struct _shape tmp;
+    Shape new_shape = _shape_begin(&tmp, target_ndim);
     if (new_shape == NULL) return NULL;
-    
-    new_shape->_ndim = target_ndim;
 
     // a. 新的 dims 就是 target_dims 的一个副本
-    new_shape->_dims = safemalloc(sizeof(int) * target_ndim);
-    if (new_shape->_dims == NULL) { free(new_shape); return NULL; }
     memcpy(new_shape->_dims, target_dims, sizeof(int) * target_ndim);
 
     // b. 计算新的 strides，这是广播的核心
-    new_shape->_stride = safemalloc(sizeof(size_t) * target_ndim);
-    if (new_shape->_stride == NULL) { free(new_shape->_dims); free(new_shape); return NULL; }
 
     int shape_diff = target_ndim - source_ndim;
     for (int i = 0; i < target_ndim; i++)
@@ -368,5 +770,108 @@ shape_expand(const Shape source_shape, const Shape target_shape)
         }
     }
 
-    return new_shape;
-}
\ No newline at end of file
+    return _shape_end(&tmp, new_shape);
+}
+
+// 从右往左把源维度分成一个个“块”：块内相邻维度满足 stride[i] == stride[i+1] * dim[i+1]，
+// 即块内可以当成一段等步长的一维数据。新维度也从右往左依次填进这些块，
+// 每个块恰好被若干个新维度铺满时，才能作为视图。e.g:
+// source: dims (4, 6), strides (12, 1)  <-- 对 (4, 12) 的列切片，两维之间不连续
+// dims (4, 2, 3) 可以：(4) 和 (6) 各自是一块，6 被拆成 (2, 3)
+// dims (24)      不行：需要跨块合并
+Shape
+shape_reshape(const Shape source_shape, const int* dims, int ndim)
+{
+    if (source_shape == NULL || (dims == NULL && ndim > 0)) return NULL;
+
+    size_t count = 1;
+    for (int i = 0; i < ndim; i++) count *= (size_t)dims[i];
+    if (count != shape_get_elements_count(source_shape)) return NULL;
+
+    // 先在私有的 Shape 里算好 strides，成功后才交给缓存
+    struct _shape tmp;
+    Shape new_shape = _shape_begin(&tmp, ndim);
+    if (new_shape == NULL) return NULL;
+    if (ndim > 0) memcpy(new_shape->_dims, dims, sizeof(int) * ndim);
+    _shape_init_strides(new_shape);
+
+    // 没有元素或者源是标量时，任意 strides 都合法，用行主序即可
+    const int old_ndim = source_shape->_ndim;
+    if (count == 0 || old_ndim == 0) return _shape_end(&tmp, new_shape);
+
+    const int* old_dims = source_shape->_dims;
+    const size_t* old_strides = source_shape->_stride;
+    size_t* new_strides = new_shape->_stride;
+
+    int view_d = ndim - 1;
+    size_t chunk_base_stride = old_strides[old_ndim - 1];
+    size_t tensor_numel = 1;
+    size_t view_numel = 1;
+    for (int tensor_d = old_ndim - 1; tensor_d >= 0; tensor_d--)
+    {
+        tensor_numel *= (size_t)old_dims[tensor_d];
+
+        // 到了块的左边界：前一维不能和当前块连成等步长的一段
+        const bool chunk_ends = tensor_d == 0 ||
+            (old_dims[tensor_d - 1] != 1 && old_strides[tensor_d - 1] != tensor_numel * chunk_base_stride);
+        if (!chunk_ends) continue;
+
+        while (view_d >= 0 && (view_numel < tensor_numel || dims[view_d] == 1))
+        {
+            new_strides[view_d] = view_numel * chunk_base_stride;
+            view_numel *= (size_t)dims[view_d];
+            view_d--;
+        }
+        if (view_numel != tensor_numel)
+        {
+            _shape_discard(&tmp, new_shape);
+            return NULL; // 新维度跨越了块的边界
+        }
+
+        if (tensor_d > 0)
+        {
+            chunk_base_stride = old_strides[tensor_d - 1];
+            tensor_numel = 1;
+            view_numel = 1;
+        }
+    }
+    if (view_d != -1)
+    {
+        _shape_discard(&tmp, new_shape);
+        return NULL;
+    }
+
+    return _shape_end(&tmp, new_shape);
+}
+
+// 广播结果的形状：右对齐后逐维比较，相等或其中一个为 1 即可。e.g:
+// a:    (5, 1, 4)
+// b:       (3, 1)
+// out:  (5, 3, 4)
+Shape
+shape_broadcast(const Shape a, const Shape b)
+{
+    if (a == NULL || b == NULL) return NULL;
+
+    const int ndim = (a->_ndim > b->_ndim) ? a->_ndim : b->_ndim;
+    struct _shape tmp;
+    Shape result = _shape_begin(&tmp, ndim);
+    if (result == NULL) return NULL;
+
+    for (int i = 1; i <= ndim; i++)
+    {
+        int da = (i <= a->_ndim) ? a->_dims[a->_ndim - i] : 1;
+        int db = (i <= b->_ndim) ? b->_dims[b->_ndim - i] : 1;
+
+        if (da != db && da != 1 && db != 1)
+        {
+            fprintf(stderr, "Error: shapes are not broadcastable (dimension %d vs %d).\n", da, db);
+            _shape_discard(&tmp, result);
+            return NULL;
+        }
+        result->_dims[ndim - i] = (da == 1) ? db : da;
+    }
+
+    _shape_init_strides(result);
+    return _shape_end(&tmp, result);
+}
@@ -0,0 +1,148 @@
+#include "tensor/_strided_copy.h"
+#include "tensor/_tensor_iter.h"
+
+#include <stdint.h> // for uint8_t ... uint64_t
+#include <string.h> // for memcpy()
+
+#define STRIDED_COPY_TILE 32
+
+// 寻找“转置型”布局：一侧的最内层是连续的，而另一侧的连续维度在更外层。
+// 返回那一维在合并后维度中的下标，找不到则返回 -1。
+static int
+_find_transpose_axis(const TensorIter* it, size_t item_size)
+{
+    const int n = it->ndim;
+    if (n < 2) return -1;
+
+    const size_t* other;
+    if (it->strides[0][n-1] == item_size && it->strides[1][n-1] != item_size)
+        other = it->strides[1];
+    else if (it->strides[1][n-1] == item_size && it->strides[0][n-1] != item_size)
+        other = it->strides[0];
+    else
+        return -1;
+
+    for (int k = n - 2; k >= 0; k--)
+    {
+        if (other[k] == item_size)
+        {
+            if (it->dims[k] < 4 || it->dims[n-1] < 4)
+                return -1; // 太窄的块没必要分块
+            return k;
+        }
+    }
+    return -1;
+}
+
+#define _COPY_RUN_TYPED(T) \
+    for (size_t i = 0; i < n; i++) \
+    { \
+        *(T*)dst = *(const T*)src; \
+        dst += ds; \
+        src += ss; \
+    }
+
+// 复制一段一维的 run
+static void
+_copy_run(char* dst, size_t ds, const char* src, size_t ss, size_t n, size_t item_size)
+{
+    if (ds == item_size && ss == item_size)
+    {
+        memcpy(dst, src, n * item_size);
+        return;
+    }
+
+    switch (item_size)
+    {
+        case 1: _COPY_RUN_TYPED(uint8_t); break;
+        case 2: _COPY_RUN_TYPED(uint16_t); break;
+        case 4: _COPY_RUN_TYPED(uint32_t); break;
+        case 8: _COPY_RUN_TYPED(uint64_t); break;
+        default:
+            for (size_t i = 0; i < n; i++)
+            {
+                memcpy(dst, src, item_size);
+                dst += ds;
+                src += ss;
+            }
+            break;
+    }
+}
+
+#define _COPY_TILE_TYPED(T) \
+    for (size_t i0 = 0; i0 < rows; i0 += STRIDED_COPY_TILE) \
+    { \
+        const size_t i1 = (i0 + STRIDED_COPY_TILE < rows) ? i0 + STRIDED_COPY_TILE : rows; \
+        for (size_t j0 = 0; j0 < cols; j0 += STRIDED_COPY_TILE) \
+        { \
+            const size_t j1 = (j0 + STRIDED_COPY_TILE < cols) ? j0 + STRIDED_COPY_TILE : cols; \
+            for (size_t i = i0; i < i1; i++) \
+            { \
+                char* d = dst + i * dr + j0 * dc; \
+                const char* s = src + i * sr + j0 * sc; \
+                for (size_t j = j0; j < j1; j++) \
+                { \
+                    *(T*)d = *(const T*)s; \
+                    d += dc; \
+                    s += sc; \
+                } \
+            } \
+        } \
+    }
+
+// 以 STRIDED_COPY_TILE x STRIDED_COPY_TILE 为单位复制一个 2-D 块，
+// 让读写两侧在块内都能留在缓存里。
+static void
+_copy_tile(char* dst, size_t dr, size_t dc, const char* src, size_t sr, size_t sc,
+           size_t rows, size_t cols, size_t item_size)
+{
+    switch (item_size)
+    {
+        case 1: _COPY_TILE_TYPED(uint8_t); break;
+        case 2: _COPY_TILE_TYPED(uint16_t); break;
+        case 4: _COPY_TILE_TYPED(uint32_t); break;
+        case 8: _COPY_TILE_TYPED(uint64_t); break;
+        default:
+            for (size_t i = 0; i < rows; i++)
+                _copy_run(dst + i * dr, dc, src + i * sr, sc, cols, item_size);
+            break;
+    }
+}
+
+bool
+strided_copy(void* dst, const size_t* dst_strides,
+             const void* src, const size_t* src_strides,
+             const int* dims, int ndim, size_t item_size)
+{
+    // 迭代器负责去掉长度为 1 的维度、合并步长衔接的维度，并增量推进偏移量
+    TensorIter it;
+    void* data[2] = { dst, (void*)src };
+    const size_t* strides[2] = { dst_strides, src_strides };
+    const size_t item_sizes[2] = { item_size, item_size };
+    if (!tensor_iter_init_strided(&it, 2, data, strides, item_sizes, dims, ndim))
+        return false;
+
+    // 转置型布局：把连续的那一维从遍历中拿出来，和最内层一起组成 2-D 块
+    size_t rows = 0;
+    size_t row_strides[2] = {0};
+    const int tile_axis = _find_transpose_axis(&it, item_size);
+    const bool tiled = tile_axis >= 0 && tensor_iter_remove_axis(&it, tile_axis, &rows, row_strides);
+
+    while (tensor_iter_next(&it))
+    {
+        if (tiled)
+        {
+            _copy_tile(it.ptrs[0], row_strides[0], it.inner_strides[0],
+                       it.ptrs[1], row_strides[1], it.inner_strides[1],
+                       rows, it.inner_size, item_size);
+        }
+        else
+        {
+            _copy_run(it.ptrs[0], it.inner_strides[0],
+                      it.ptrs[1], it.inner_strides[1],
+                      it.inner_size, item_size);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,405 @@
+#include "tensor/_tensor_cast.h"
+#include "tensor/_tensor_access.h"
+#include "tensor/_tensor_iter.h"
+#include "tensor/_tensor_simd.h"
+#include "tensor/_shape.h"
+#include "utils/_parallel.h"
+
+#include <stdint.h> // for int32_t, int64_t
+#include <stdio.h>  // for fprintf()
+#include <string.h> // for memcpy()
+#include <math.h>   // for isfinite()
+
+// 每段 run 的转换方式
+typedef enum
+{
+    CAST_COPY,       // 同一个 dtype
+    CAST_FLOAT,      // F32 / F16 / BF16 之间：经过一块 F32
+    CAST_INT,        // I32 / I8 / U8 之间：经过一块 I32（回绕）
+    CAST_QUANTIZE,   // 浮点 -> I8 / U8，仿射量化
+    CAST_DEQUANTIZE, // I8 / U8 -> 浮点
+    CAST_NATIVE,     // 两边都是 C 的算术类型（F32 / F64 / 整数）：按类型特化的逐行内核
+    CAST_GENERIC     // 其余组合：逐个元素经过 double / int64_t
+}
+CastPath;
+
+typedef void (*CastRowFn)(char* out, const char* in, size_t n, size_t out_stride, size_t in_stride);
+
+typedef struct
+{
+    TensorIter it; // 操作数: out, in
+    CastPath path;
+    DataType from, to;
+    size_t from_size, to_size;
+    float scale; // 量化时是 1 / scale
+    int32_t zero_point;
+    CastRowFn row; // CAST_NATIVE 时使用
+}
+CastTask;
+
+static bool
+_is_float(DataType dtype)
+{
+    return dtype == DTYPE_F32 || dtype == DTYPE_F64 || dtype == DTYPE_F16 || dtype == DTYPE_BF16;
+}
+
+// --- 按块转换：窄类型 <-> 计算类型，走向量化内核 ---
+
+// 读 m 个元素到连续的 F32 块（from 为 F32 / F16 / BF16 / F64）
+static void
+_load_f32(DataType from, float* tile, const char* in, size_t m, size_t stride)
+{
+    if (from == DTYPE_F16 || from == DTYPE_BF16)
+        simd_widen(from, tile, in, m, stride);
+    else if (from == DTYPE_F64)
+        for (size_t i = 0; i < m; i++) tile[i] = (float)*(const double*)(in + i * stride);
+    else
+        for (size_t i = 0; i < m; i++) memcpy(tile + i, in + i * stride, sizeof(float));
+}
+
+static void
+_store_f32(DataType to, char* out, size_t stride, const float* tile, size_t m)
+{
+    if (to == DTYPE_F16 || to == DTYPE_BF16)
+        simd_narrow(to, out, stride, tile, m);
+    else if (to == DTYPE_F64)
+        for (size_t i = 0; i < m; i++) *(double*)(out + i * stride) = tile[i];
+    else
+        for (size_t i = 0; i < m; i++) memcpy(out + i * stride, tile + i, sizeof(float));
+}
+
+// 只读不写时，连续的 F32 输入可以直接使用，不必复制
+static const float*
+_view_f32(DataType from, float* tile, const char* in, size_t m, size_t stride)
+{
+    if (from == DTYPE_F32 && stride == sizeof(float)) return (const float*)in;
+    _load_f32(from, tile, in, m, stride);
+    return tile;
+}
+
+static void
+_load_i32(DataType from, int32_t* tile, const char* in, size_t m, size_t stride)
+{
+    if (from == DTYPE_I8 || from == DTYPE_U8)
+        simd_widen(from, tile, in, m, stride);
+    else
+        for (size_t i = 0; i < m; i++) memcpy(tile + i, in + i * stride, sizeof(int32_t));
+}
+
+static void
+_store_i32(DataType to, char* out, size_t stride, const int32_t* tile, size_t m)
+{
+    if (to == DTYPE_I8 || to == DTYPE_U8)
+        simd_narrow(to, out, stride, tile, m);
+    else
+        for (size_t i = 0; i < m; i++) memcpy(out + i * stride, tile + i, sizeof(int32_t));
+}
+
+// --- 逐元素的通用转换 ---
+
+static double
+_read_f64(DataType dtype, const char* p)
+{
+    switch (dtype)
+    {
+        case DTYPE_I32: return *(const int32_t*)p;
+        case DTYPE_F32: return *(const float*)p;
+        case DTYPE_F64: return *(const double*)p;
+        case DTYPE_F16: return f16_to_f32(*(const uint16_t*)p);
+        case DTYPE_BF16: return bf16_to_f32(*(const uint16_t*)p);
+        case DTYPE_I8: return *(const int8_t*)p;
+        case DTYPE_U8: return *(const uint8_t*)p;
+        default: return 0.0;
+    }
+}
+
+static int64_t
+_read_i64(DataType dtype, const char* p)
+{
+    switch (dtype)
+    {
+        case DTYPE_I32: return *(const int32_t*)p;
+        case DTYPE_I8: return *(const int8_t*)p;
+        case DTYPE_U8: return *(const uint8_t*)p;
+        default: return 0;
+    }
+}
+
+// 浮点 -> 整数：向零截断，超出范围时饱和，NaN 变成 0
+static int64_t
+_saturate(double v, double lo, double hi)
+{
+    if (v != v) return 0;
+    if (v <= lo) return (int64_t)lo;
+    if (v >= hi) return (int64_t)hi;
+    return (int64_t)v;
+}
+
+static void
+_write(DataType to, char* p, DataType from, const char* src)
+{
+    if (!_is_float(from) && !_is_float(to))
+    {
+        // 整数之间：按补码截断，和 C 的转换一样回绕
+        const uint32_t v = (uint32_t)_read_i64(from, src);
+        switch (to)
+        {
+            case DTYPE_I32: *(int32_t*)p = (int32_t)v; break;
+            case DTYPE_I8: *(int8_t*)p = (int8_t)(uint8_t)v; break;
+            case DTYPE_U8: *(uint8_t*)p = (uint8_t)v; break;
+            default: break;
+        }
+        return;
+    }
+
+    const double v = _read_f64(from, src);
+    switch (to)
+    {
+        case DTYPE_I32: *(int32_t*)p = (int32_t)_saturate(v, INT32_MIN, INT32_MAX); break;
+        case DTYPE_I8: *(int8_t*)p = (int8_t)_saturate(v, INT8_MIN, INT8_MAX); break;
+        case DTYPE_U8: *(uint8_t*)p = (uint8_t)_saturate(v, 0, UINT8_MAX); break;
+        case DTYPE_F32: *(float*)p = (float)v; break;
+        case DTYPE_F64: *(double*)p = v; break;
+        case DTYPE_F16: *(uint16_t*)p = f32_to_f16((float)v); break;
+        case DTYPE_BF16: *(uint16_t*)p = f32_to_bf16((float)v); break;
+        default: break;
+    }
+}
+
+// --- 按类型特化的内核 ---
+
+// 和 _saturate() 的结果一致：NaN 变成 0，超出 [LO, HI] 时取 MIN / MAX，其余向零截断。
+// F32 输入直接在 float 里比较：LO / HI 取 float 能精确表示的边界，结果与先转 double 相同
+#define _CAST_SATURATE(T, LO, HI, MIN, MAX) \
+    ((x != x) ? (T)0 : (x <= (LO)) ? (T)(MIN) : (x >= (HI)) ? (T)(MAX) : (T)x)
+
+TENSOR_DEFINE_UNARY_ROW(_cast_f32_f64, double, float, x)
+TENSOR_DEFINE_UNARY_ROW(_cast_f64_f32, float, double, x)
+
+TENSOR_DEFINE_UNARY_ROW(_cast_f32_i32, int32_t, float, _CAST_SATURATE(int32_t, -2147483648.0f, 2147483648.0f, INT32_MIN, INT32_MAX))
+TENSOR_DEFINE_UNARY_ROW(_cast_f32_i8, int8_t, float, _CAST_SATURATE(int8_t, (float)INT8_MIN, (float)INT8_MAX, INT8_MIN, INT8_MAX))
+TENSOR_DEFINE_UNARY_ROW(_cast_f32_u8, uint8_t, float, _CAST_SATURATE(uint8_t, 0.0f, (float)UINT8_MAX, 0, UINT8_MAX))
+TENSOR_DEFINE_UNARY_ROW(_cast_f64_i32, int32_t, double, _CAST_SATURATE(int32_t, (double)INT32_MIN, (double)INT32_MAX, INT32_MIN, INT32_MAX))
+TENSOR_DEFINE_UNARY_ROW(_cast_f64_i8, int8_t, double, _CAST_SATURATE(int8_t, (double)INT8_MIN, (double)INT8_MAX, INT8_MIN, INT8_MAX))
+TENSOR_DEFINE_UNARY_ROW(_cast_f64_u8, uint8_t, double, _CAST_SATURATE(uint8_t, 0.0, (double)UINT8_MAX, 0, UINT8_MAX))
+
+TENSOR_DEFINE_UNARY_ROW(_cast_i32_f32, float, int32_t, x)
+TENSOR_DEFINE_UNARY_ROW(_cast_i32_f64, double, int32_t, x)
+TENSOR_DEFINE_UNARY_ROW(_cast_i8_f32, float, int8_t, x)
+TENSOR_DEFINE_UNARY_ROW(_cast_i8_f64, double, int8_t, x)
+TENSOR_DEFINE_UNARY_ROW(_cast_u8_f32, float, uint8_t, x)
+TENSOR_DEFINE_UNARY_ROW(_cast_u8_f64, double, uint8_t, x)
+
+// [from][to]；NULL 表示没有特化内核（相同 dtype、F16 / BF16，或者另有专门的路径）
+static const CastRowFn _native_casts[DTYPE_COUNT][DTYPE_COUNT] =
+{
+    [DTYPE_F32] = { [DTYPE_F64] = _cast_f32_f64, [DTYPE_I32] = _cast_f32_i32, [DTYPE_I8] = _cast_f32_i8, [DTYPE_U8] = _cast_f32_u8 },
+    [DTYPE_F64] = { [DTYPE_F32] = _cast_f64_f32, [DTYPE_I32] = _cast_f64_i32, [DTYPE_I8] = _cast_f64_i8, [DTYPE_U8] = _cast_f64_u8 },
+    [DTYPE_I32] = { [DTYPE_F32] = _cast_i32_f32, [DTYPE_F64] = _cast_i32_f64 },
+    [DTYPE_I8] = { [DTYPE_F32] = _cast_i8_f32, [DTYPE_F64] = _cast_i8_f64 },
+    [DTYPE_U8] = { [DTYPE_F32] = _cast_u8_f32, [DTYPE_F64] = _cast_u8_f64 },
+};
+
+// --- 并行驱动 ---
+
+static void
+_cast_run(const CastTask* task, char* out, const char* in, size_t n, size_t so, size_t si)
+{
+    if (task->path == CAST_COPY)
+    {
+        if (so == task->to_size && si == task->to_size)
+            memcpy(out, in, n * task->to_size);
+        else
+            for (size_t i = 0; i < n; i++) memcpy(out + i * so, in + i * si, task->to_size);
+        return;
+    }
+    if (task->path == CAST_NATIVE)
+    {
+        task->row(out, in, n, so, si);
+        return;
+    }
+    if (task->path == CAST_GENERIC)
+    {
+        for (size_t i = 0; i < n; i++) _write(task->to, out + i * so, task->from, in + i * si);
+        return;
+    }
+
+    const SimdKernelTable* kernels = simd_get_kernels();
+    float ftile[SIMD_CONVERT_TILE];
+    int32_t itile[SIMD_CONVERT_TILE];
+    uint8_t btile[SIMD_CONVERT_TILE];
+
+    for (size_t done = 0; done < n; done += SIMD_CONVERT_TILE)
+    {
+        const size_t m = (n - done < SIMD_CONVERT_TILE) ? n - done : SIMD_CONVERT_TILE;
+        const char* src = in + done * si;
+        char* dst = out + done * so;
+
+        switch (task->path)
+        {
+            case CAST_FLOAT: // 目标是连续的 F32 时直接转换到输出里
+                if (task->to == DTYPE_F32 && so == sizeof(float))
+                    _load_f32(task->from, (float*)dst, src, m, si);
+                else
+                    _store_f32(task->to, dst, so, _view_f32(task->from, ftile, src, m, si), m);
+                break;
+
+            case CAST_INT:
+                if (task->to == DTYPE_I32 && so == sizeof(int32_t))
+                    _load_i32(task->from, (int32_t*)dst, src, m, si);
+                else if (task->from == DTYPE_I32 && si == sizeof(int32_t))
+                    _store_i32(task->to, dst, so, (const int32_t*)src, m);
+                else
+                {
+                    _load_i32(task->from, itile, src, m, si);
+                    _store_i32(task->to, dst, so, itile, m);
+                }
+                break;
+
+            case CAST_QUANTIZE:
+            {
+                const float* x = _view_f32(task->from, ftile, src, m, si);
+                uint8_t* q = (so == 1) ? (uint8_t*)dst : btile;
+                kernels->quantize[task->to](q, x, m, task->scale, task->zero_point);
+                if (q == btile)
+                    for (size_t i = 0; i < m; i++) dst[i * so] = (char)btile[i];
+                break;
+            }
+
+            case CAST_DEQUANTIZE:
+            {
+                const uint8_t* q = (const uint8_t*)src;
+                if (si != 1)
+                {
+                    for (size_t i = 0; i < m; i++) btile[i] = (uint8_t)src[i * si];
+                    q = btile;
+                }
+                kernels->dequantize[task->from](ftile, q, m, task->scale, task->zero_point);
+                _store_f32(task->to, dst, so, ftile, m);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+static void
+_cast_worker(size_t begin, size_t end, void* ctx)
+{
+    const CastTask* task = (const CastTask*)ctx;
+    TensorIter it = task->it;
+
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+        _cast_run(task, it.ptrs[0], it.ptrs[1], it.inner_size, it.inner_strides[0], it.inner_strides[1]);
+}
+
+static Tensor
+_cast(const Tensor t, DataType dtype, CastTask* task)
+{
+    Tensor out = tensor_empty(tensor_get_shape(t), dtype);
+    void* out_data = (out != NULL) ? _tensor_get_data(out) : NULL;
+    if (out_data == NULL)
+    {
+        tensor_free(out);
+        return NULL;
+    }
+
+    task->from = tensor_get_dtype(t);
+    task->to = dtype;
+    task->from_size = tensor_get_item_size(t);
+    task->to_size = tensor_get_item_size(out);
+
+    void* data[2] = { out_data, (void*)tensor_get_data_const(t) };
+    const size_t* strides[2] = { tensor_get_strides(out), tensor_get_strides(t) };
+    const size_t item_sizes[2] = { task->to_size, task->from_size };
+    const Shape shape = tensor_get_shape(t);
+    if (!tensor_iter_init_strided(&task->it, 2, data, strides, item_sizes, shape_get_dims(shape), shape_get_ndim(shape)))
+    {
+        tensor_free(out);
+        return NULL;
+    }
+
+    parallel_for(0, task->it.size, parallel_grain(task->from_size + task->to_size), _cast_worker, task);
+    return out;
+}
+
+static bool
+_check_dtype(DataType dtype, const char* name)
+{
+    if (tensor_dtype_size(dtype) == 0)
+    {
+        fprintf(stderr, "Error: %s: invalid dtype %d.\n", name, (int)dtype);
+        return false;
+    }
+    return true;
+}
+
+Tensor
+tensor_to_dtype(const Tensor t, DataType dtype)
+{
+    if (t == NULL || !_check_dtype(dtype, "tensor_to_dtype")) return NULL;
+
+    const DataType from = tensor_get_dtype(t);
+    CastTask task = { .scale = 1.0f, .zero_point = 0 };
+    if (from == dtype)
+        task.path = CAST_COPY;
+    else if ((from == DTYPE_F32 || from == DTYPE_F16 || from == DTYPE_BF16) &&
+             (dtype == DTYPE_F32 || dtype == DTYPE_F16 || dtype == DTYPE_BF16))
+        task.path = CAST_FLOAT;
+    else if (!_is_float(from) && !_is_float(dtype))
+        task.path = CAST_INT;
+    else if (_native_casts[from][dtype] != NULL)
+    {
+        task.path = CAST_NATIVE;
+        task.row = _native_casts[from][dtype];
+    }
+    else
+        task.path = CAST_GENERIC;
+
+    return _cast(t, dtype, &task);
+}
+
+Tensor
+tensor_to_dtype_quantized(const Tensor t, DataType dtype, float scale, int zero_point)
+{
+    if (t == NULL || !_check_dtype(dtype, "tensor_to_dtype_quantized")) return NULL;
+    if (!(scale > 0.0f) || !isfinite(scale))
+    {
+        fprintf(stderr, "Error: tensor_to_dtype_quantized: scale must be positive and finite.\n");
+        return NULL;
+    }
+
+    const DataType from = tensor_get_dtype(t);
+    CastTask task = { .zero_point = zero_point };
+    DataType qtype;
+    if ((dtype == DTYPE_I8 || dtype == DTYPE_U8) && _is_float(from))
+    {
+        task.path = CAST_QUANTIZE;
+        task.scale = 1.0f / scale;
+        qtype = dtype;
+    }
+    else if ((from == DTYPE_I8 || from == DTYPE_U8) && _is_float(dtype))
+    {
+        task.path = CAST_DEQUANTIZE;
+        task.scale = scale;
+        qtype = from;
+    }
+    else
+    {
+        fprintf(stderr, "Error: tensor_to_dtype_quantized: expected a floating-point and an I8/U8 dtype.\n");
+        return NULL;
+    }
+
+    const int lo = (qtype == DTYPE_I8) ? INT8_MIN : 0;
+    const int hi = (qtype == DTYPE_I8) ? INT8_MAX : UINT8_MAX;
+    if (zero_point < lo || zero_point > hi)
+    {
+        fprintf(stderr, "Error: tensor_to_dtype_quantized: zero point %d is out of range [%d, %d].\n", zero_point, lo, hi);
+        return NULL;
+    }
+
+    return _cast(t, dtype, &task);
+}
@@ -1,66 +1,158 @@
 #include "tensor/_tensor_core.h"
+#include "tensor/_tensor_storage.h"
+#include "tensor/_tensor_cast.h"
+#include "tensor/_tensor_access.h"
 
 #include "utils/_malloc.h"
+#include "utils/_parallel.h"
 #include "tensor/_shape.h"
 
-#include <stdint.h> // for int32_t
+#include <stdint.h> // for int32_t, uintptr_t, SIZE_MAX
 #include <stddef.h> // for size_t
-#include <stdlib.h> // for free(), NULL
+#include <math.h>   // for signbit()
+#include <stdio.h>  // for fprintf()
+#include <stdlib.h> // for NULL
 #include <string.h> // for memcpy()
 #include <stdbool.h> // for bool, true, false
 
 struct _tensor
 {
-    void* _data;
+    Storage _storage; // 与所有视图共享，引用计数
+    size_t _offset;   // 第一个元素在 storage 中的位置（以元素为单位）
     Shape _shape;
     DataType _dtype;
-    bool _owns_data;
 };
 
+// 每个填充任务至少处理这么多元素
+#define FILL_GRAIN (1 << 16)
+
 static size_t _get_dtype_size(DataType dtype);
 
-Tensor 
-tensor_create(const Shape shape, DataType dtype)
+// 分配一个连续张量；zero 为 false 时数据保持未初始化
+static Tensor
+_tensor_alloc(const Shape shape, DataType dtype, bool zero)
 {
-    Tensor new = safemalloc(sizeof(struct _tensor));
+    Tensor new = safe_small_alloc(sizeof(struct _tensor));
     if (new == NULL) return NULL;
 
-    
     size_t num_elements = shape_get_elements_count(shape);
     size_t dtype_size = _get_dtype_size(dtype);
-    new->_data = safecalloc(num_elements, dtype_size);
-    if (new->_data == NULL)
+    // 张量数据按缓存行对齐，SIMD 内核可以用对齐访问、也不会跨行
+    new->_storage = storage_create(num_elements * dtype_size, zero);
+    if (new->_storage == NULL)
     {
-        free(new);
+        safe_small_free(new);
         return NULL;
     }
+    new->_offset = 0;
 
-    new->_shape = shape_copy(shape);
+    // 新分配的数据总是行主序连续的，所以按 dims 重新计算 strides，
+    // 而不是照搬传入 shape（它可能来自一个 permute/expand 视图）的 strides。
+    new->_shape = shape_create(shape_get_dims(shape), shape_get_ndim(shape));
     if (new->_shape == NULL)
     {
-        free(new->_data);
-        free(new);
+        storage_release(new->_storage);
+        safe_small_free(new);
         return NULL;
     }
 
     new->_dtype = dtype;
-    new->_owns_data = true;
 
     return new;
 }
 
+Tensor 
+tensor_create(const Shape shape, DataType dtype)
+{
+    return _tensor_alloc(shape, dtype, true);
+}
+
+Tensor
+tensor_empty(const Shape shape, DataType dtype)
+{
+    return _tensor_alloc(shape, dtype, false);
+}
+
+typedef struct
+{
+    void* data;
+    DataType dtype;
+    double value;
+}
+FillTask;
+
+#define _FILL(T, VALUE) \
+    { \
+        T* p = (T*)task->data; \
+        const T v = (VALUE); \
+        for (size_t i = begin; i < end; i++) p[i] = v; \
+    }
+
+// 整数填充值：与 _tensor_cast.c 的 _saturate() 一致，NaN 变成 0，超出 [lo, hi] 时取边界，其余向零截断
+static int64_t
+_fill_saturate(double v, double lo, double hi)
+{
+    if (v != v) return 0;
+    if (v <= lo) return (int64_t)lo;
+    if (v >= hi) return (int64_t)hi;
+    return (int64_t)v;
+}
+
+// 并行任务：填充元素 [begin, end)
+static void
+_fill_worker(size_t begin, size_t end, void* ctx)
+{
+    const FillTask* task = (const FillTask*)ctx;
+    // -0.0 也等于 0.0，但它的浮点位模式不全是 0，不能用 memset
+    if (task->value == 0.0 && !signbit(task->value))
+    {
+        const size_t item_size = _get_dtype_size(task->dtype);
+        memset((char*)task->data + begin * item_size, 0, (end - begin) * item_size);
+        return;
+    }
+    switch (task->dtype)
+    {
+        case DTYPE_I32: _FILL(int32_t, (int32_t)_fill_saturate(task->value, INT32_MIN, INT32_MAX)); break;
+        case DTYPE_F32: _FILL(float, (float)task->value); break;
+        case DTYPE_F64: _FILL(double, task->value); break;
+        case DTYPE_F16: _FILL(uint16_t, f32_to_f16((float)task->value)); break;
+        case DTYPE_BF16: _FILL(uint16_t, f32_to_bf16((float)task->value)); break;
+        case DTYPE_I8: _FILL(int8_t, (int8_t)_fill_saturate(task->value, INT8_MIN, INT8_MAX)); break;
+        case DTYPE_U8: _FILL(uint8_t, (uint8_t)_fill_saturate(task->value, 0, UINT8_MAX)); break;
+        default: break;
+    }
+}
+
+Tensor
+tensor_full(const Shape shape, DataType dtype, double value)
+{
+    Tensor new = tensor_empty(shape, dtype);
+    if (new == NULL) return NULL;
+
+    // 和各个算子一样按 parallel_for 均匀切分，页面由之后处理它的线程第一次写入
+    FillTask task = { _tensor_get_data(new), dtype, value };
+    parallel_for(0, shape_get_elements_count(new->_shape), FILL_GRAIN, _fill_worker, &task);
+    return new;
+}
+
+Tensor
+tensor_zeros(const Shape shape, DataType dtype)
+{
+    return tensor_full(shape, dtype, 0.0);
+}
+
 /**
  * @brief Creates a new tensor and initializes it with data from a provided buffer.
  */
 Tensor
 tensor_from_data(const void* data, const Shape shape, DataType dtype)
 {
-    // 1. 先创建一个具有正确尺寸的、零初始化的张量。
-    //    这个步骤处理了所有的内存分配和结构体初始化。
-    Tensor new_tensor = tensor_create(shape, dtype);
+    // 1. 先创建一个具有正确尺寸的张量。数据马上会被整体覆盖，
+    //    所以不做清零（没有数据源时才需要零初始化）。
+    Tensor new_tensor = (data != NULL) ? tensor_empty(shape, dtype) : tensor_create(shape, dtype);
     if (new_tensor == NULL)
     {
-        return NULL; // tensor_create 失败，直接返回
+        return NULL; // 分配失败，直接返回
     }
 
     // 2. 如果外部数据源是有效的，则将数据复制到新张量中。
@@ -71,7 +163,7 @@ tensor_from_data(const void* data, const Shape shape, DataType dtype)
         size_t num_bytes = num_elements * dtype_size;
         
         // 将用户提供的数据，拷贝到新分配的内存中
-        memcpy(new_tensor->_data, data, num_bytes);
+        memcpy(_tensor_get_data(new_tensor), data, num_bytes);
     }
 
     return new_tensor;
@@ -82,11 +174,11 @@ tensor_free(Tensor tensor)
 {
     if (tensor == NULL) return;
 
-    if (tensor->_owns_data)
-        free(tensor->_data);
+    // 最后一个引用（张量或视图）释放时，storage 才真正释放数据
+    storage_release(tensor->_storage);
 
     shape_free(tensor->_shape);
-    free(tensor);
+    safe_small_free(tensor);
 }
 
 Tensor
@@ -94,13 +186,22 @@ tensor_copy(const Tensor other)
 {
     if (other == NULL) return NULL;
 
-    Tensor new = tensor_create(other->_shape, other->_dtype);
+    // 写时复制：新张量拿到一个共享同一份数据的新 storage，O(1)。
+    // 任意一方第一次写入时才真正复制；已经交出过可写指针的数据则在这里直接复制。
+    Tensor new = safe_small_alloc(sizeof(struct _tensor));
     if (new == NULL) return NULL;
 
-    size_t num_elements = shape_get_elements_count(other->_shape);
-    size_t dtype_size = _get_dtype_size(other->_dtype);
-    size_t num_bytes = num_elements * dtype_size;
-    memcpy(new->_data, other->_data, num_bytes);
+    new->_storage = storage_share(other->_storage);
+    new->_shape = shape_copy(other->_shape);
+    if (new->_storage == NULL || new->_shape == NULL)
+    {
+        storage_release(new->_storage);
+        shape_free(new->_shape);
+        safe_small_free(new);
+        return NULL;
+    }
+    new->_offset = other->_offset;
+    new->_dtype = other->_dtype;
 
     return new;
 }
@@ -118,12 +219,26 @@ _get_dtype_size(DataType dtype)
 
         case DTYPE_F64:
             return sizeof(double);
+
+        case DTYPE_F16:
+        case DTYPE_BF16:
+            return sizeof(uint16_t);
+
+        case DTYPE_I8:
+        case DTYPE_U8:
+            return sizeof(uint8_t);
         
         default:
             return 0;
     }
 }
 
+size_t
+tensor_dtype_size(DataType dtype)
+{
+    return _get_dtype_size(dtype);
+}
+
 Shape 
 tensor_get_shape(const Tensor tensor)
 {
@@ -133,7 +248,26 @@ tensor_get_shape(const Tensor tensor)
 void*
 tensor_get_data(const Tensor tensor)
 {
-    return tensor->_data;
+    // 指针交给了调用者，之后可能随时写入：先取得独占的数据，并且以后 tensor_copy() 都复制数据
+    char* data = storage_export_data(tensor->_storage);
+    if (data == NULL) return NULL;
+    return data + tensor->_offset * _get_dtype_size(tensor->_dtype);
+}
+
+void*
+_tensor_get_data(const Tensor tensor)
+{
+    // 要写入了：如果数据还和某个 tensor_copy() 的结果共享，先复制一份
+    char* data = storage_mutable_data(tensor->_storage);
+    if (data == NULL) return NULL;
+    return data + tensor->_offset * _get_dtype_size(tensor->_dtype);
+}
+
+const void*
+tensor_get_data_const(const Tensor tensor)
+{
+    const char* data = storage_data(tensor->_storage);
+    return data + tensor->_offset * _get_dtype_size(tensor->_dtype);
 }
 
 DataType
@@ -176,6 +310,13 @@ tensor_get_elements_count(const Tensor tensor)
     return shape_get_elements_count(tensor->_shape);
 }
 
+size_t
+tensor_get_offset(const Tensor tensor)
+{
+    if (tensor == NULL) return 0;
+    return tensor->_offset;
+}
+
 size_t
 tensor_get_item_size(const Tensor tensor)
 {
@@ -185,33 +326,217 @@ tensor_get_item_size(const Tensor tensor)
 }
 
 /**
- * @brief (Internal) Creates a new Tensor view on existing data.
+ * @brief (Internal) Creates a new Tensor view that shares `base`'s storage.
  */
 Tensor
-_tensor_create_view(void* data, const Shape new_shape, DataType dtype)
+_tensor_create_view(const Tensor base, size_t offset, Shape new_shape)
 {
     // 1. 检查传入的参数是否有效
-    if (data == NULL || new_shape == NULL)
+    if (base == NULL || new_shape == NULL)
+    {
+        shape_free(new_shape);
         return NULL;
+    }
 
     // 2. 为 Tensor 结构体本身分配内存
-    Tensor new_tensor = safemalloc(sizeof(struct _tensor));
+    Tensor new_tensor = safe_small_alloc(sizeof(struct _tensor));
     if (new_tensor == NULL)
+    {
+        shape_free(new_shape);
         return NULL;
+    }
 
     // 3. 填充结构体字段
-    new_tensor->_data = data;           // <-- 关键点1: 直接“借用”数据指针
-    new_tensor->_dtype = dtype;         // 设置数据类型
-    new_tensor->_owns_data = false;     // <-- 关键点2: 明确表示不拥有数据
+    new_tensor->_storage = storage_retain(base->_storage); // <-- 关键点: 共享 storage，视图让父张量的数据保持存活
+    new_tensor->_offset = offset;
+    new_tensor->_shape = new_shape;                         // 接管 shape 的所有权
+    new_tensor->_dtype = base->_dtype;
+
+    return new_tensor;
+}
 
-    new_tensor->_shape = shape_copy(new_shape);
-    if (new_tensor->_shape == NULL)
+// 以外部内存建立张量，接管 shape（失败时也会释放它）；失败时不调用 deleter
+static Tensor
+_tensor_from_external(void* data, Shape shape, DataType dtype, TensorDeleter deleter, void* ctx, const char* name)
+{
+    if (data == NULL || shape == NULL)
     {
-        free(new_tensor);
+        shape_free(shape);
         return NULL;
     }
 
-    return new_tensor;
+    const size_t item_size = _get_dtype_size(dtype);
+    if (item_size == 0)
+    {
+        fprintf(stderr, "Error: %s: invalid dtype %d.\n", name, (int)dtype);
+        shape_free(shape);
+        return NULL;
+    }
+    if ((uintptr_t)data % item_size != 0)
+    {
+        fprintf(stderr, "Error: %s: data is not aligned to the element size (%zu bytes).\n", name, item_size);
+        shape_free(shape);
+        return NULL;
+    }
+
+    // 缓冲区至少要覆盖最远的那个元素；算出来的字节数溢出 size_t 的 shape 不可能放得下
+    const int ndim = shape_get_ndim(shape);
+    const int* dims = shape_get_dims(shape);
+    const size_t* strides = shape_get_strides(shape);
+    size_t span = 1;
+    bool overflow = false;
+    for (int i = 0; i < ndim; i++)
+    {
+        if (dims[i] == 0)
+        {
+            span = 0;
+            overflow = false;
+            break;
+        }
+        const size_t steps = (size_t)(dims[i] - 1);
+        if (steps > 0 && strides[i] > (SIZE_MAX - span) / steps) overflow = true;
+        else span += steps * strides[i];
+    }
+    if (overflow || span > SIZE_MAX / item_size)
+    {
+        fprintf(stderr, "Error: %s: the strides reach past the end of the address space.\n", name);
+        shape_free(shape);
+        return NULL;
+    }
+
+    // 先分配张量结构体：storage 一旦建立，释放它就会调用 deleter
+    Tensor new = safe_small_alloc(sizeof(struct _tensor));
+    if (new == NULL)
+    {
+        shape_free(shape);
+        return NULL;
+    }
+    new->_storage = storage_wrap(data, span * item_size, deleter, ctx);
+    if (new->_storage == NULL)
+    {
+        safe_small_free(new);
+        shape_free(shape);
+        return NULL;
+    }
+    // 调用者手里本来就有 data：和 tensor_get_data() 交出的指针一样，这份数据从此不再共享，
+    // 这样张量（以及调用者）的写入总是落在 data 上，tensor_copy() 则得到自己的副本
+    storage_export_data(new->_storage);
+    new->_offset = 0;
+    new->_shape = shape;
+    new->_dtype = dtype;
+    return new;
+}
+
+Tensor
+tensor_from_buffer(void* data, const Shape shape, DataType dtype, TensorDeleter deleter, void* ctx)
+{
+    if (shape == NULL) return NULL;
+    return _tensor_from_external(data, shape_copy(shape), dtype, deleter, ctx, "tensor_from_buffer");
+}
+
+Tensor
+tensor_create_view(void* data, Shape shape, DataType dtype)
+{
+    return _tensor_from_external(data, shape, dtype, NULL, NULL, "tensor_create_view");
+}
+
+// 张量元素所覆盖的字节范围 [lo, hi)。没有元素时返回 false
+static bool
+_byte_range(const Tensor t, uintptr_t* lo, uintptr_t* hi)
+{
+    const int ndim = shape_get_ndim(t->_shape);
+    const int* dims = shape_get_dims(t->_shape);
+    const size_t* strides = shape_get_strides(t->_shape);
+
+    size_t last = 0;
+    for (int i = 0; i < ndim; i++)
+    {
+        if (dims[i] == 0) return false;
+        last += (size_t)(dims[i] - 1) * strides[i];
+    }
+
+    const size_t item_size = _get_dtype_size(t->_dtype);
+    *lo = (uintptr_t)tensor_get_data_const(t);
+    *hi = *lo + (last + 1) * item_size;
+    return true;
+}
+
+bool
+tensor_may_share_memory(const Tensor a, const Tensor b)
+{
+    if (a == NULL || b == NULL) return false;
+
+    uintptr_t a_lo, a_hi, b_lo, b_hi;
+    if (!_byte_range(a, &a_lo, &a_hi) || !_byte_range(b, &b_lo, &b_hi)) return false;
+    return a_lo < b_hi && b_lo < a_hi;
+}
+
+Tensor
+_tensor_wrap_storage(Storage storage, size_t offset, Shape shape, DataType dtype)
+{
+    Tensor new = (storage != NULL && shape != NULL) ? safe_small_alloc(sizeof(struct _tensor)) : NULL;
+    if (new == NULL)
+    {
+        storage_release(storage);
+        shape_free(shape);
+        return NULL;
+    }
+
+    new->_storage = storage; // 接管调用者的引用
+    new->_offset = offset;
+    new->_shape = shape;
+    new->_dtype = dtype;
+    return new;
+}
+
+size_t
+_tensor_get_storage_elements(const Tensor tensor)
+{
+    return storage_nbytes(tensor->_storage) / _get_dtype_size(tensor->_dtype);
+}
+
+bool
+_tensor_check_out(const Tensor out, const int* dims, int ndim, DataType dtype, const char* name)
+{
+    if (out == NULL) return false;
+
+    if (out->_dtype != dtype)
+    {
+        fprintf(stderr, "Error: %s: output dtype does not match the result dtype.\n", name);
+        return false;
+    }
+
+    bool same = shape_get_ndim(out->_shape) == ndim;
+    for (int i = 0; same && i < ndim; i++)
+        same = shape_get_dim(out->_shape, i) == dims[i];
+    if (!same)
+    {
+        fprintf(stderr, "Error: %s: output shape does not match the result shape.\n", name);
+        return false;
+    }
+
+    // 广播之类的视图里多个位置共用一个元素，写进去的结果取决于写入顺序
+    if (!shape_is_non_overlapping(out->_shape))
+    {
+        fprintf(stderr, "Error: %s: output has overlapping elements (e.g. a broadcast view) and cannot be written.\n", name);
+        return false;
+    }
+    return true;
+}
+
+bool
+_tensor_out_alias_ok(const Tensor out, const void* out_data, const Tensor in, const Shape in_shape)
+{
+    if (!tensor_may_share_memory(out, in)) return true;
+    if (tensor_get_data_const(in) != out_data) return false;
+
+    const int ndim = shape_get_ndim(in_shape);
+    const int* dims = shape_get_dims(in_shape);
+    const size_t* in_strides = shape_get_strides(in_shape);
+    const size_t* out_strides = shape_get_strides(out->_shape);
+    for (int i = 0; i < ndim; i++)
+        if (dims[i] > 1 && in_strides[i] != out_strides[i]) return false;
+    return true;
 }
 
 void*
@@ -243,4 +568,63 @@ tensor_get_element_ptr(const Tensor source_tensor, const int* coords)
     void* element_ptr = (void*)(base_data + offset_in_elements * item_size);
 
     return element_ptr;
-}
\ No newline at end of file
+}
+
+static bool
+_accessor_check(const TensorAccessor* a, const Tensor t, DataType dtype, const char* caller)
+{
+    if (a == NULL || t == NULL)
+    {
+        fprintf(stderr, "Error: %s: accessor and tensor must not be NULL\n", caller);
+        return false;
+    }
+    if (t->_dtype != dtype)
+    {
+        fprintf(stderr, "Error: %s: tensor has dtype %d, accessor wants %d\n", caller, (int)t->_dtype, (int)dtype);
+        return false;
+    }
+    const int ndim = shape_get_ndim(t->_shape);
+    if (ndim > TENSOR_ACCESS_MAX_DIMS)
+    {
+        fprintf(stderr, "Error: %s: %d dimensions, at most %d are supported\n", caller, ndim, TENSOR_ACCESS_MAX_DIMS);
+        return false;
+    }
+    return true;
+}
+
+static bool
+_accessor_fill(TensorAccessor* a, const Tensor t, char* data)
+{
+    if (data == NULL) return false;
+
+    const int ndim = shape_get_ndim(t->_shape);
+    const int* dims = shape_get_dims(t->_shape);
+    const size_t* strides = shape_get_strides(t->_shape);
+    const size_t item_size = _get_dtype_size(t->_dtype);
+
+    a->data = data;
+    a->ndim = ndim;
+    a->dtype = t->_dtype;
+    for (int i = 0; i < TENSOR_ACCESS_MAX_DIMS; i++)
+    {
+        // 多余的维度填成长度 1、stride 0，这样按 4 维访问低维张量也不会越界
+        a->dims[i] = (i < ndim) ? dims[i] : 1;
+        a->strides[i] = (i < ndim) ? strides[i] * item_size : 0;
+    }
+    return true;
+}
+
+bool
+tensor_accessor_init(TensorAccessor* a, Tensor t, DataType dtype)
+{
+    // 先检查再取数据：取可写数据可能触发一次写时复制
+    if (!_accessor_check(a, t, dtype, "tensor_accessor_init")) return false;
+    return _accessor_fill(a, t, tensor_get_data(t));
+}
+
+bool
+tensor_accessor_init_const(TensorAccessor* a, const Tensor t, DataType dtype)
+{
+    if (!_accessor_check(a, t, dtype, "tensor_accessor_init_const")) return false;
+    return _accessor_fill(a, t, (char*)tensor_get_data_const(t));
+}
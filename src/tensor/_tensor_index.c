@@ -0,0 +1,615 @@
+#include "tensor/_tensor_index.h"
+#include "tensor/_tensor_iter.h"
+#include "tensor/_tensor_view.h"
+#include "tensor/_strided_copy.h"
+#include "tensor/_shape.h"
+#include "utils/_parallel.h"
+
+#include <stdatomic.h>
+#include <stdint.h> // for int32_t, uint32_t
+#include <stdio.h>  // for fprintf()
+#include <string.h> // for memcpy()
+
+// 提前这么多个下标预取它们指向的行/元素：随机访问的延迟由后面的几次访问分摊
+#define INDEX_PREFETCH_DISTANCE 8
+
+// 一维 scatter_add 没有可以分给线程的“列”时，至少这么长才按目标区间切分
+#define SCATTER_OWNER_MIN (1 << 15)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define _PREFETCH(p) __builtin_prefetch((p), 0, 1)
+#define _PREFETCH_W(p) __builtin_prefetch((p), 1, 1)
+#else
+#define _PREFETCH(p) ((void)(p))
+#define _PREFETCH_W(p) ((void)(p))
+#endif
+
+static bool
+_check_indices(const Tensor indices, const char* name)
+{
+    if (indices == NULL) return false;
+    if (tensor_get_dtype(indices) != DTYPE_I32)
+    {
+        fprintf(stderr, "Error: %s: indices must be DTYPE_I32.\n", name);
+        return false;
+    }
+    return true;
+}
+
+static bool
+_check_axis(const Tensor t, int axis, const char* name)
+{
+    if (t == NULL) return false;
+    if (axis < 0 || axis >= tensor_get_ndim(t))
+    {
+        fprintf(stderr, "Error: %s: axis %d is out of bounds for tensor of dimension %d\n", name, axis, tensor_get_ndim(t));
+        return false;
+    }
+    if (tensor_get_ndim(t) > TENSOR_ITER_MAX_DIMS)
+    {
+        fprintf(stderr, "Error: %s: too many dimensions.\n", name);
+        return false;
+    }
+    return true;
+}
+
+// 复制一行；常见的小尺寸用定长 memcpy，编译器会直接生成一次读写
+static inline void
+_copy_row(char* dst, const char* src, size_t bytes)
+{
+    switch (bytes)
+    {
+        case 1: memcpy(dst, src, 1); break;
+        case 2: memcpy(dst, src, 2); break;
+        case 4: memcpy(dst, src, 4); break;
+        case 8: memcpy(dst, src, 8); break;
+        default: memcpy(dst, src, bytes); break;
+    }
+}
+
+// --- index_select ---
+
+typedef struct
+{
+    const char* src;
+    char* out;
+    const int32_t* idx;
+    size_t k;              // 下标个数
+    uint32_t limit;        // 被索引的轴的长度
+    size_t src_axis;       // 被索引的轴在 src / out 中的步长（字节）
+    size_t out_axis;
+    size_t row_bytes;      // 行模式：axis 之后的连续块的字节数
+
+    // 行模式：axis 之前的维度
+    int nouter;
+    const int* outer_dims;
+    const size_t* src_outer; // 以元素为单位
+    const size_t* out_outer;
+
+    // 通用模式：去掉 axis 之后的维度，每个下标做一次跨步拷贝
+    int nslice;
+    int slice_dims[TENSOR_ITER_MAX_DIMS];
+    size_t src_slice[TENSOR_ITER_MAX_DIMS];
+    size_t out_slice[TENSOR_ITER_MAX_DIMS];
+
+    size_t item_size;
+    atomic_bool failed;
+}
+SelectTask;
+
+// 第 o 个外层位置（按行主序展开 axis 之前的维度）在 src 和 out 中的起点
+static void
+_select_outer(const SelectTask* task, size_t o, const char** src, char** out)
+{
+    size_t src_offset = 0, out_offset = 0;
+    for (int d = task->nouter - 1; d >= 0; d--)
+    {
+        const size_t c = o % (size_t)task->outer_dims[d];
+        o /= (size_t)task->outer_dims[d];
+        src_offset += c * task->src_outer[d];
+        out_offset += c * task->out_outer[d];
+    }
+    *src = task->src + src_offset * task->item_size;
+    *out = task->out + out_offset * task->item_size;
+}
+
+// 行模式：区间 [begin, end) 按 (外层位置, 下标) 展开，每个位置复制一整块
+static void
+_select_rows_worker(size_t begin, size_t end, void* ctx)
+{
+    SelectTask* task = (SelectTask*)ctx;
+    const int32_t* idx = task->idx;
+    const size_t k = task->k;
+    size_t j = begin % k;
+    const char* src;
+    char* out;
+    _select_outer(task, begin / k, &src, &out);
+
+    for (size_t f = begin; f < end; f++)
+    {
+        if (j + INDEX_PREFETCH_DISTANCE < k && (uint32_t)idx[j + INDEX_PREFETCH_DISTANCE] < task->limit)
+            _PREFETCH(src + (size_t)idx[j + INDEX_PREFETCH_DISTANCE] * task->src_axis);
+
+        const int32_t i = idx[j];
+        if ((uint32_t)i >= task->limit)
+            atomic_store(&task->failed, true);
+        else
+            _copy_row(out + j * task->out_axis, src + (size_t)i * task->src_axis, task->row_bytes);
+
+        if (++j == k && f + 1 < end)
+        {
+            j = 0;
+            _select_outer(task, (f + 1) / k, &src, &out);
+        }
+    }
+}
+
+// 通用模式：区间 [begin, end) 是下标，每个下标对应的切片做一次跨步拷贝
+static void
+_select_slices_worker(size_t begin, size_t end, void* ctx)
+{
+    SelectTask* task = (SelectTask*)ctx;
+    for (size_t j = begin; j < end; j++)
+    {
+        const int32_t i = task->idx[j];
+        if ((uint32_t)i >= task->limit ||
+            !strided_copy(task->out + j * task->out_axis, task->out_slice,
+                          task->src + (size_t)i * task->src_axis, task->src_slice,
+                          task->slice_dims, task->nslice, task->item_size))
+            atomic_store(&task->failed, true);
+    }
+}
+
+Tensor
+tensor_index_select(const Tensor t, int axis, const Tensor indices)
+{
+    const char* name = "tensor_index_select";
+    if (!_check_axis(t, axis, name) || !_check_indices(indices, name)) return NULL;
+    if (tensor_get_ndim(indices) != 1)
+    {
+        fprintf(stderr, "Error: %s: indices must be 1-D.\n", name);
+        return NULL;
+    }
+
+    const int ndim = tensor_get_ndim(t);
+    const int* dims = shape_get_dims(tensor_get_shape(t));
+    const size_t* strides = tensor_get_strides(t);
+    const size_t k = (size_t)tensor_get_dim(indices, 0);
+
+    int out_dims[TENSOR_ITER_MAX_DIMS];
+    memcpy(out_dims, dims, sizeof(int) * ndim);
+    out_dims[axis] = (int)k;
+    Shape out_shape = shape_create(out_dims, ndim);
+    Tensor out = (out_shape != NULL) ? tensor_empty(out_shape, tensor_get_dtype(t)) : NULL;
+    shape_free(out_shape);
+    if (out == NULL) return NULL;
+    if (tensor_get_elements_count(out) == 0) return out;
+
+    Tensor idx = tensor_contiguous(indices); // 已经连续时只是 O(1) 的写时复制引用
+    if (idx == NULL)
+    {
+        tensor_free(out);
+        return NULL;
+    }
+
+    SelectTask task;
+    task.src = tensor_get_data_const(t);
+    task.out = _tensor_get_data(out);
+    task.idx = tensor_get_data_const(idx);
+    task.k = k;
+    task.limit = (uint32_t)dims[axis];
+    task.item_size = tensor_get_item_size(t);
+    task.src_axis = strides[axis] * task.item_size;
+    task.out_axis = tensor_get_strides(out)[axis] * task.item_size;
+    atomic_init(&task.failed, false);
+
+    // axis 之后的维度在 t 中是否行主序连续（长度为 1 的维度不影响）
+    size_t inner = 1;
+    bool rows = true;
+    for (int d = ndim - 1; d > axis; d--)
+    {
+        if (dims[d] != 1 && strides[d] != inner) rows = false;
+        inner *= (size_t)dims[d];
+    }
+
+    if (rows)
+    {
+        // 行模式：axis 为最外层时就是逐行 memcpy（嵌入查表）
+        task.row_bytes = inner * task.item_size;
+        task.nouter = axis;
+        task.outer_dims = dims;
+        task.src_outer = strides;
+        task.out_outer = tensor_get_strides(out);
+        size_t outer = 1;
+        for (int d = 0; d < axis; d++) outer *= (size_t)dims[d];
+        parallel_for(0, outer * k, parallel_grain(2 * task.row_bytes + sizeof(int32_t)), _select_rows_worker, &task);
+    }
+    else
+    {
+        task.nslice = 0;
+        for (int d = 0; d < ndim; d++)
+        {
+            if (d == axis) continue;
+            task.slice_dims[task.nslice] = dims[d];
+            task.src_slice[task.nslice] = strides[d];
+            task.out_slice[task.nslice++] = tensor_get_strides(out)[d];
+        }
+        const size_t slice_bytes = tensor_get_elements_count(out) / k * task.item_size;
+        parallel_for(0, k, parallel_grain(2 * slice_bytes), _select_slices_worker, &task);
+    }
+
+    tensor_free(idx);
+    if (atomic_load(&task.failed))
+    {
+        fprintf(stderr, "Error: %s: index out of range for dimension of size %u.\n", name, task.limit);
+        tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+// --- gather / scatter_add 的公共部分 ---
+
+// 检查 indices（以及 src）与 t 的形状关系
+static bool
+_check_index_shape(const Tensor t, int axis, const Tensor indices, const Tensor src, const char* name)
+{
+    const int ndim = tensor_get_ndim(t);
+    if (tensor_get_ndim(indices) != ndim || (src != NULL && tensor_get_ndim(src) != ndim))
+    {
+        fprintf(stderr, "Error: %s: indices%s must have as many dimensions as the tensor.\n", name, src ? " and src" : "");
+        return false;
+    }
+    for (int d = 0; d < ndim; d++)
+    {
+        const int n = tensor_get_dim(indices, d);
+        if ((d != axis && n > tensor_get_dim(t, d)) || (src != NULL && n > tensor_get_dim(src, d)))
+        {
+            fprintf(stderr, "Error: %s: indices has size %d in dimension %d, which is too large.\n", name, n, d);
+            return false;
+        }
+    }
+    return true;
+}
+
+// t 的步长，axis 上换成 0：下标决定 axis 上的位置，其余维度与 indices 对齐
+static void
+_strides_without_axis(const Tensor t, int axis, size_t* strides)
+{
+    const int ndim = tensor_get_ndim(t);
+    memcpy(strides, tensor_get_strides(t), sizeof(size_t) * ndim);
+    strides[axis] = 0;
+}
+
+// --- gather ---
+
+typedef struct
+{
+    TensorIter it;  // 操作数: out, indices, t（axis 上步长为 0）
+    size_t axis_stride; // 字节
+    uint32_t limit;
+    size_t item_size;
+    atomic_bool failed;
+}
+GatherTask;
+
+#define _GATHER_RUN(T) \
+    for (size_t i = 0; i < n; i++) \
+    { \
+        if (i + INDEX_PREFETCH_DISTANCE < n) \
+        { \
+            const uint32_t ahead = *(const uint32_t*)(ip + (i + INDEX_PREFETCH_DISTANCE) * si); \
+            if (ahead < limit) _PREFETCH(tp + (i + INDEX_PREFETCH_DISTANCE) * st + ahead * sa); \
+        } \
+        const uint32_t ix = *(const uint32_t*)(ip + i * si); \
+        if (ix >= limit) { atomic_store(&task->failed, true); continue; } \
+        memcpy(op + i * so, tp + i * st + ix * sa, sizeof(T)); \
+    }
+
+static void
+_gather_worker(size_t begin, size_t end, void* ctx)
+{
+    GatherTask* task = (GatherTask*)ctx;
+    TensorIter it = task->it;
+    const size_t sa = task->axis_stride;
+    const uint32_t limit = task->limit;
+
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+    {
+        char* op = it.ptrs[0];
+        const char* ip = it.ptrs[1];
+        const char* tp = it.ptrs[2];
+        const size_t n = it.inner_size, so = it.inner_strides[0], si = it.inner_strides[1], st = it.inner_strides[2];
+        switch (task->item_size)
+        {
+            case 1: _GATHER_RUN(uint8_t); break;
+            case 2: _GATHER_RUN(uint16_t); break;
+            case 4: _GATHER_RUN(uint32_t); break;
+            case 8: _GATHER_RUN(uint64_t); break;
+            default: break;
+        }
+    }
+}
+
+Tensor
+tensor_gather(const Tensor t, int axis, const Tensor indices)
+{
+    const char* name = "tensor_gather";
+    if (!_check_axis(t, axis, name) || !_check_indices(indices, name)) return NULL;
+    if (!_check_index_shape(t, axis, indices, NULL, name)) return NULL;
+
+    const Shape shape = tensor_get_shape(indices);
+    Tensor out = tensor_empty(shape, tensor_get_dtype(t));
+    void* out_data = (out != NULL) ? _tensor_get_data(out) : NULL;
+    if (out_data == NULL)
+    {
+        tensor_free(out);
+        return NULL;
+    }
+
+    GatherTask task;
+    size_t t_strides[TENSOR_ITER_MAX_DIMS];
+    _strides_without_axis(t, axis, t_strides);
+    task.item_size = tensor_get_item_size(t);
+    task.axis_stride = tensor_get_strides(t)[axis] * task.item_size;
+    task.limit = (uint32_t)tensor_get_dim(t, axis);
+    atomic_init(&task.failed, false);
+
+    void* data[3] = { out_data, (void*)tensor_get_data_const(indices), (void*)tensor_get_data_const(t) };
+    const size_t* strides[3] = { tensor_get_strides(out), tensor_get_strides(indices), t_strides };
+    const size_t item_sizes[3] = { task.item_size, sizeof(int32_t), task.item_size };
+    if (!tensor_iter_init_strided(&task.it, 3, data, strides, item_sizes, shape_get_dims(shape), shape_get_ndim(shape)))
+    {
+        tensor_free(out);
+        return NULL;
+    }
+    parallel_for(0, task.it.size, parallel_grain(2 * task.item_size + sizeof(int32_t)), _gather_worker, &task);
+
+    if (atomic_load(&task.failed))
+    {
+        fprintf(stderr, "Error: %s: index out of range for dimension of size %u.\n", name, task.limit);
+        tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+// --- scatter_add ---
+
+typedef struct
+{
+    TensorIter it;       // 操作数: t（axis 上步长为 0）, indices, src
+    DataType dtype;
+    size_t t_axis;       // t 在 axis 上的步长（字节）
+    size_t idx_axis;     // 按列模式：indices / src 在 axis 上的步长（字节）
+    size_t src_axis;
+    size_t length;       // 按列模式：axis 上的位置个数
+    uint32_t limit;
+    size_t parts;        // 按目标切分模式：目标区间的份数
+    atomic_bool failed;
+}
+ScatterTask;
+
+static inline void
+_add_into(DataType dtype, char* dst, const char* src)
+{
+    switch (dtype)
+    {
+        case DTYPE_I32: // 按补码回绕
+            *(int32_t*)dst = (int32_t)((uint32_t)*(int32_t*)dst + (uint32_t)*(const int32_t*)src);
+            break;
+        case DTYPE_F32: *(float*)dst += *(const float*)src; break;
+        case DTYPE_F64: *(double*)dst += *(const double*)src; break;
+        default: break;
+    }
+}
+
+// 所有下标都在范围内吗？在修改 t 之前检查一遍
+typedef struct
+{
+    TensorIter it;
+    uint32_t limit;
+    atomic_bool failed;
+}
+RangeTask;
+
+static void
+_range_worker(size_t begin, size_t end, void* ctx)
+{
+    RangeTask* task = (RangeTask*)ctx;
+    TensorIter it = task->it;
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+    {
+        bool bad = false;
+        for (size_t i = 0; i < it.inner_size; i++)
+            bad |= *(const uint32_t*)(it.ptrs[0] + i * it.inner_strides[0]) >= task->limit;
+        if (bad) atomic_store(&task->failed, true);
+    }
+}
+
+static bool
+_indices_in_range(const Tensor indices, uint32_t limit)
+{
+    RangeTask task;
+    void* data[1] = { (void*)tensor_get_data_const(indices) };
+    const size_t* strides[1] = { tensor_get_strides(indices) };
+    const size_t item_sizes[1] = { sizeof(int32_t) };
+    const Shape shape = tensor_get_shape(indices);
+    if (!tensor_iter_init_strided(&task.it, 1, data, strides, item_sizes, shape_get_dims(shape), shape_get_ndim(shape)))
+        return false;
+    task.limit = limit;
+    atomic_init(&task.failed, false);
+    parallel_for(0, task.it.size, parallel_grain(sizeof(int32_t)), _range_worker, &task);
+    return !atomic_load(&task.failed);
+}
+
+// 下标互不冲突：每个位置独立处理，任意切分
+static void
+_scatter_unique_worker(size_t begin, size_t end, void* ctx)
+{
+    ScatterTask* task = (ScatterTask*)ctx;
+    TensorIter it = task->it;
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+    {
+        const size_t st = it.inner_strides[0], si = it.inner_strides[1], ss = it.inner_strides[2];
+        for (size_t i = 0; i < it.inner_size; i++)
+        {
+            if (i + INDEX_PREFETCH_DISTANCE < it.inner_size)
+            {
+                const uint32_t ahead = *(const uint32_t*)(it.ptrs[1] + (i + INDEX_PREFETCH_DISTANCE) * si);
+                _PREFETCH_W(it.ptrs[0] + (i + INDEX_PREFETCH_DISTANCE) * st + ahead * task->t_axis);
+            }
+            const uint32_t ix = *(const uint32_t*)(it.ptrs[1] + i * si);
+            _add_into(task->dtype, it.ptrs[0] + i * st + ix * task->t_axis, it.ptrs[2] + i * ss);
+        }
+    }
+}
+
+// 按列模式：迭代器只遍历除 axis 以外的维度（“列”），每个任务拥有自己的列，
+// 逐行（axis 上的每个位置）把一整段列更新进去。不同的列写的是 t 中不同的元素。
+static void
+_scatter_lanes_worker(size_t begin, size_t end, void* ctx)
+{
+    ScatterTask* task = (ScatterTask*)ctx;
+    TensorIter it = task->it;
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+    {
+        const size_t st = it.inner_strides[0], si = it.inner_strides[1], ss = it.inner_strides[2];
+        for (size_t l = 0; l < task->length; l++)
+        {
+            const char* ip = it.ptrs[1] + l * task->idx_axis;
+            const char* sp = it.ptrs[2] + l * task->src_axis;
+            for (size_t i = 0; i < it.inner_size; i++)
+            {
+                const uint32_t ix = *(const uint32_t*)(ip + i * si);
+                _add_into(task->dtype, it.ptrs[0] + i * st + ix * task->t_axis, sp + i * ss);
+            }
+        }
+    }
+}
+
+// 只有一列而且很长：每个任务负责 t 的一段目标区间，扫描全部下标，只处理落在自己区间内的
+static void
+_scatter_owner_worker(size_t begin, size_t end, void* ctx)
+{
+    ScatterTask* task = (ScatterTask*)ctx;
+    for (size_t part = begin; part < end; part++)
+    {
+        const uint32_t lo = (uint32_t)((uint64_t)task->limit * part / task->parts);
+        const uint32_t hi = (uint32_t)((uint64_t)task->limit * (part + 1) / task->parts);
+        TensorIter it = task->it;
+        while (tensor_iter_next(&it))
+        {
+            const size_t si = it.inner_strides[1], ss = it.inner_strides[2];
+            for (size_t i = 0; i < it.inner_size; i++)
+            {
+                const uint32_t ix = *(const uint32_t*)(it.ptrs[1] + i * si);
+                if (ix >= lo && ix < hi)
+                    _add_into(task->dtype, it.ptrs[0] + ix * task->t_axis, it.ptrs[2] + i * ss);
+            }
+        }
+    }
+}
+
+bool
+tensor_scatter_add_(Tensor t, int axis, const Tensor indices, const Tensor src, bool unique_indices)
+{
+    const char* name = "tensor_scatter_add_";
+    if (!_check_axis(t, axis, name) || !_check_indices(indices, name) || src == NULL) return false;
+
+    const DataType dtype = tensor_get_dtype(t);
+    if (dtype != DTYPE_I32 && dtype != DTYPE_F32 && dtype != DTYPE_F64)
+    {
+        fprintf(stderr, "Error: %s supports only DTYPE_I32, DTYPE_F32 and DTYPE_F64.\n", name);
+        return false;
+    }
+    if (tensor_get_dtype(src) != dtype)
+    {
+        fprintf(stderr, "Error: %s: src must have the same dtype as the tensor.\n", name);
+        return false;
+    }
+    if (!_check_index_shape(t, axis, indices, src, name)) return false;
+
+    const int ndim = tensor_get_ndim(t);
+    if (!_tensor_check_out(t, shape_get_dims(tensor_get_shape(t)), ndim, dtype, name)) return false;
+
+    ScatterTask task;
+    task.dtype = dtype;
+    task.limit = (uint32_t)tensor_get_dim(t, axis);
+    if (!_indices_in_range(indices, task.limit))
+    {
+        fprintf(stderr, "Error: %s: index out of range for dimension of size %u.\n", name, task.limit);
+        return false;
+    }
+
+    // 先拿可写指针（可能触发写时复制），再检查输入是否与它重叠
+    void* t_data = _tensor_get_data(t);
+    if (t_data == NULL) return false;
+    if (tensor_may_share_memory(t, indices) || tensor_may_share_memory(t, src))
+    {
+        fprintf(stderr, "Error: %s: indices and src must not overlap the tensor.\n", name);
+        return false;
+    }
+
+    const size_t item_size = tensor_get_item_size(t);
+    const int* idx_dims = shape_get_dims(tensor_get_shape(indices));
+    task.t_axis = tensor_get_strides(t)[axis] * item_size;
+
+    size_t t_strides[TENSOR_ITER_MAX_DIMS], idx_strides[TENSOR_ITER_MAX_DIMS], src_strides[TENSOR_ITER_MAX_DIMS];
+    _strides_without_axis(t, axis, t_strides);
+    memcpy(idx_strides, tensor_get_strides(indices), sizeof(size_t) * ndim);
+    memcpy(src_strides, tensor_get_strides(src), sizeof(size_t) * ndim);
+
+    void* data[3] = { t_data, (void*)tensor_get_data_const(indices), (void*)tensor_get_data_const(src) };
+    const size_t* strides[3] = { t_strides, idx_strides, src_strides };
+    const size_t item_sizes[3] = { item_size, sizeof(int32_t), item_size };
+    const size_t bytes_per_position = 2 * item_size + sizeof(int32_t);
+
+    if (unique_indices)
+    {
+        if (!tensor_iter_init_strided(&task.it, 3, data, strides, item_sizes, idx_dims, ndim)) return false;
+        parallel_for(0, task.it.size, parallel_grain(bytes_per_position), _scatter_unique_worker, &task);
+        return true;
+    }
+
+    // 去掉 axis 这一维：剩下的每个位置是一“列”，axis 上的位置在列内按顺序处理
+    task.length = (size_t)idx_dims[axis];
+    task.idx_axis = idx_strides[axis] * sizeof(int32_t);
+    task.src_axis = src_strides[axis] * item_size;
+    int lane_dims[TENSOR_ITER_MAX_DIMS];
+    memcpy(lane_dims, idx_dims, sizeof(int) * ndim);
+    lane_dims[axis] = 1;
+    if (!tensor_iter_init_strided(&task.it, 3, data, strides, item_sizes, lane_dims, ndim)) return false;
+
+    const size_t lanes = task.it.size;
+    const size_t threads = (size_t)parallel_get_num_threads();
+    if (lanes == 1 && threads > 1 && task.length >= SCATTER_OWNER_MIN)
+    {
+        // 一维：把 axis 恢复进迭代器，按目标区间切分
+        if (!tensor_iter_init_strided(&task.it, 3, data, strides, item_sizes, idx_dims, ndim)) return false;
+        task.parts = threads;
+        parallel_for(0, task.parts, 1, _scatter_owner_worker, &task);
+        return true;
+    }
+
+    const size_t grain = parallel_grain(bytes_per_position * (task.length > 0 ? task.length : 1));
+    parallel_for(0, lanes, grain, _scatter_lanes_worker, &task);
+    return true;
+}
+
+Tensor
+tensor_scatter_add(const Tensor t, int axis, const Tensor indices, const Tensor src, bool unique_indices)
+{
+    Tensor out = tensor_contiguous(t);
+    if (out == NULL) return NULL;
+    if (!tensor_scatter_add_(out, axis, indices, src, unique_indices))
+    {
+        tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
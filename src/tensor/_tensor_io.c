@@ -0,0 +1,752 @@
+#define _POSIX_C_SOURCE 200809L // for fileno(), mmap()
+
+#include "tensor/_tensor_io.h"
+#include "tensor/_tensor_iter.h"
+#include "tensor/_tensor_storage.h"
+#include "utils/_malloc.h"
+
+#include <limits.h> // for INT_MAX
+#include <stdint.h> // for uint8_t, uint32_t, int64_t
+#include <stdio.h>
+#include <stdlib.h> // for free()
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>    // for open()
+#include <sys/mman.h> // for mmap(), munmap()
+#include <sys/stat.h> // for fstat()
+#include <unistd.h>   // for close()
+#define IO_HAVE_MMAP 1
+#endif
+
+#define IO_ALIGNMENT 64              // 数据区起点的对齐，与 SAFE_DEFAULT_ALIGNMENT 相同
+#define IO_CHUNK ((size_t)64 << 10)  // 写跨步数据时每次攒够这么多字节再写出
+#define RAW_MAGIC "SNAKETNS"
+#define RAW_VERSION 1
+#define RAW_FIXED_HEADER 24          // 固定部分：magic + version + dtype + ndim + data offset
+
+static bool
+_host_is_little_endian(void)
+{
+    const uint16_t probe = 1;
+    return *(const uint8_t*)&probe == 1;
+}
+
+// --- 文件映射 ---
+
+// 整个文件的只读视图：映射（或读入内存）的起点和长度
+typedef struct
+{
+    char* base;
+    size_t size;
+    bool mapped; // false 表示 base 是 safemalloc 得到的缓冲区
+}
+FileView;
+
+static void
+_file_view_release(FileView* view)
+{
+    if (view->base == NULL) return;
+#ifdef IO_HAVE_MMAP
+    if (view->mapped)
+    {
+        munmap(view->base, view->size);
+        view->base = NULL;
+        return;
+    }
+#endif
+    free(view->base);
+    view->base = NULL;
+}
+
+// storage 的 deleter：ctx 是堆上的一份 FileView
+static void
+_file_view_deleter(void* data, void* ctx)
+{
+    (void)data;
+    _file_view_release((FileView*)ctx);
+    free(ctx);
+}
+
+static bool
+_file_view_open(FileView* view, const char* path, const char* name)
+{
+    view->base = NULL;
+    view->size = 0;
+    view->mapped = false;
+
+#ifdef IO_HAVE_MMAP
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Error: %s: cannot open '%s'.\n", name, path);
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        fprintf(stderr, "Error: %s: '%s' is empty or not a regular file.\n", name, path);
+        close(fd);
+        return false;
+    }
+
+    // 私有映射：页面按需读入、与其他进程共享页缓存；写入只影响本进程的副本
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // 映射建立后不再需要文件描述符
+    if (map == MAP_FAILED)
+    {
+        fprintf(stderr, "Error: %s: cannot map '%s'.\n", name, path);
+        return false;
+    }
+    view->base = map;
+    view->size = (size_t)st.st_size;
+    view->mapped = true;
+    return true;
+#else
+    FILE* f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Error: %s: cannot open '%s'.\n", name, path);
+        return false;
+    }
+
+    long size = -1;
+    if (fseek(f, 0, SEEK_END) == 0) size = ftell(f);
+    if (size <= 0 || fseek(f, 0, SEEK_SET) != 0)
+    {
+        fprintf(stderr, "Error: %s: '%s' is empty or not seekable.\n", name, path);
+        fclose(f);
+        return false;
+    }
+
+    view->base = safemalloc((size_t)size);
+    view->size = (size_t)size;
+    if (view->base == NULL || fread(view->base, 1, view->size, f) != view->size)
+    {
+        fprintf(stderr, "Error: %s: cannot read '%s'.\n", name, path);
+        _file_view_release(view);
+        fclose(f);
+        return false;
+    }
+    fclose(f);
+    return true;
+#endif
+}
+
+// 用文件里 data_offset 处的数据建立张量，接管 view（失败时也会释放它）
+static Tensor
+_tensor_from_view(FileView* view, size_t data_offset, Shape shape, DataType dtype, const char* name)
+{
+    if (shape == NULL)
+    {
+        _file_view_release(view);
+        return NULL;
+    }
+
+    const size_t item_size = tensor_dtype_size(dtype);
+    const size_t count = shape_get_elements_count(shape);
+    if (data_offset > view->size || count > (view->size - data_offset) / item_size)
+    {
+        fprintf(stderr, "Error: %s: the file is shorter than its header says.\n", name);
+        shape_free(shape);
+        _file_view_release(view);
+        return NULL;
+    }
+
+    // 数据区没有按元素大小对齐（很少见）：只能复制一份
+    if (data_offset % item_size != 0)
+    {
+        Shape dense = shape_create(shape_get_dims(shape), shape_get_ndim(shape));
+        Tensor t = (dense != NULL) ? tensor_empty(dense, dtype) : NULL;
+        shape_free(dense);
+        if (t != NULL)
+        {
+            // 把文件里的布局（可能是列主序）原样复制过去，再套上原来的 strides
+            void* dst = _tensor_get_data(t);
+            if (dst != NULL && count > 0) memcpy(dst, view->base + data_offset, count * item_size);
+            Tensor result = _tensor_create_view(t, 0, shape);
+            tensor_free(t);
+            _file_view_release(view);
+            return result;
+        }
+        shape_free(shape);
+        _file_view_release(view);
+        return NULL;
+    }
+
+    FileView* ctx = safemalloc(sizeof(FileView));
+    if (ctx == NULL)
+    {
+        shape_free(shape);
+        _file_view_release(view);
+        return NULL;
+    }
+    *ctx = *view;
+
+    Storage storage = storage_wrap(view->base + data_offset, view->size - data_offset, _file_view_deleter, ctx);
+    if (storage == NULL)
+    {
+        free(ctx);
+        shape_free(shape);
+        _file_view_release(view);
+        return NULL;
+    }
+    return _tensor_wrap_storage(storage, 0, shape, dtype);
+}
+
+// --- 流式写出 ---
+
+// 按行主序写出所有元素：连续的 run 直接写，跨步的 run 先攒进缓冲区
+static bool
+_write_elements(FILE* f, const Tensor t)
+{
+    const Shape shape = tensor_get_shape(t);
+    if (shape_get_elements_count(shape) == 0) return true;
+
+    const size_t item_size = tensor_get_item_size(t);
+    void* data[1] = { (void*)tensor_get_data_const(t) };
+    const size_t* strides[1] = { tensor_get_strides(t) };
+    const size_t item_sizes[1] = { item_size };
+
+    TensorIter it;
+    if (!tensor_iter_init_strided(&it, 1, data, strides, item_sizes, shape_get_dims(shape), shape_get_ndim(shape)))
+        return false;
+
+    char* buffer = NULL;
+    size_t used = 0;
+    bool ok = true;
+    while (ok && tensor_iter_next(&it))
+    {
+        const char* p = it.ptrs[0];
+        const size_t stride = it.inner_strides[0];
+        if (stride == item_size)
+        {
+            if (used > 0) ok = fwrite(buffer, 1, used, f) == used;
+            used = 0;
+            ok = ok && fwrite(p, item_size, it.inner_size, f) == it.inner_size;
+            continue;
+        }
+
+        if (buffer == NULL && (buffer = safemalloc(IO_CHUNK)) == NULL) return false;
+        for (size_t i = 0; ok && i < it.inner_size; i++, p += stride)
+        {
+            memcpy(buffer + used, p, item_size);
+            used += item_size;
+            if (used + item_size > IO_CHUNK)
+            {
+                ok = fwrite(buffer, 1, used, f) == used;
+                used = 0;
+            }
+        }
+    }
+    if (ok && used > 0) ok = fwrite(buffer, 1, used, f) == used;
+    free(buffer);
+    return ok;
+}
+
+// 打开文件、写头、写数据、关闭；任何一步失败都打印错误
+static bool
+_save(const Tensor t, const char* path, const char* header, size_t header_size, const char* name)
+{
+    FILE* f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Error: %s: cannot create '%s'.\n", name, path);
+        return false;
+    }
+
+    bool ok = fwrite(header, 1, header_size, f) == header_size && _write_elements(f, t);
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) fprintf(stderr, "Error: %s: failed to write '%s'.\n", name, path);
+    return ok;
+}
+
+static bool
+_check_saveable(const Tensor t, const char* name)
+{
+    if (t == NULL) return false;
+    if (!_host_is_little_endian())
+    {
+        fprintf(stderr, "Error: %s: only little-endian hosts are supported.\n", name);
+        return false;
+    }
+    const DataType dtype = tensor_get_dtype(t);
+    return dtype >= DTYPE_I32 && dtype < DTYPE_COUNT;
+}
+
+// --- .npy ---
+
+#define NPY_MAGIC "\x93NUMPY"
+#define NPY_MAGIC_LEN 6
+
+static const char*
+_npy_descr(DataType dtype)
+{
+    switch (dtype)
+    {
+        case DTYPE_I32: return "<i4";
+        case DTYPE_F32: return "<f4";
+        case DTYPE_F64: return "<f8";
+        case DTYPE_F16: return "<f2";
+        case DTYPE_I8: return "|i1";
+        case DTYPE_U8: return "|u1";
+        default: return NULL; // NumPy 没有 BF16
+
+    }
+}
+
+// 在头部字典里找到 'key': 之后第一个非空白字符
+static const char*
+_npy_find(const char* header, const char* end, const char* key)
+{
+    const size_t len = strlen(key);
+    for (const char* p = header; p + len + 2 < end; p++)
+    {
+        if ((*p == '\'' || *p == '"') && memcmp(p + 1, key, len) == 0 && p[len + 1] == *p)
+        {
+            p += len + 2;
+            while (p < end && (*p == ' ' || *p == ':')) p++;
+            return (p < end) ? p : NULL;
+        }
+    }
+    return NULL;
+}
+
+Tensor
+tensor_load_npy(const char* path)
+{
+    const char* name = "tensor_load_npy";
+    if (path == NULL) return NULL;
+    if (!_host_is_little_endian())
+    {
+        fprintf(stderr, "Error: %s: only little-endian hosts are supported.\n", name);
+        return NULL;
+    }
+
+    FileView view;
+    if (!_file_view_open(&view, path, name)) return NULL;
+
+    // 1. magic、版本和头部长度：1.0 是 2 字节长度，2.0/3.0 是 4 字节
+    const uint8_t* bytes = (const uint8_t*)view.base;
+    if (view.size < NPY_MAGIC_LEN + 4 || memcmp(bytes, NPY_MAGIC, NPY_MAGIC_LEN) != 0 || bytes[6] < 1 || bytes[6] > 3)
+    {
+        fprintf(stderr, "Error: %s: '%s' is not a supported .npy file.\n", name, path);
+        _file_view_release(&view);
+        return NULL;
+    }
+    size_t header_start, header_len;
+    if (bytes[6] == 1)
+    {
+        header_start = 10;
+        header_len = (size_t)bytes[8] | ((size_t)bytes[9] << 8);
+    }
+    else
+    {
+        header_start = 12;
+        header_len = (view.size < 12) ? 0 :
+                     ((size_t)bytes[8] | ((size_t)bytes[9] << 8) | ((size_t)bytes[10] << 16) | ((size_t)bytes[11] << 24));
+    }
+    if (header_len == 0 || header_len > view.size - header_start)
+    {
+        fprintf(stderr, "Error: %s: '%s' has a truncated header.\n", name, path);
+        _file_view_release(&view);
+        return NULL;
+    }
+    const char* header = view.base + header_start;
+    const char* end = header + header_len;
+
+    // 2. 解析 descr / fortran_order / shape
+    const char* descr = _npy_find(header, end, "descr");
+    const char* order = _npy_find(header, end, "fortran_order");
+    const char* dims_text = _npy_find(header, end, "shape");
+
+    DataType dtype = DTYPE_F32;
+    bool known = false;
+    if (descr != NULL && end - descr >= 5 && (descr[0] == '\'' || descr[0] == '"') && descr[4] == descr[0])
+    {
+        const char order_char = descr[1];
+        const bool little = order_char == '<' || order_char == '=' || order_char == '|';
+        if (little && memcmp(descr + 2, "i4", 2) == 0) { dtype = DTYPE_I32; known = true; }
+        if (little && memcmp(descr + 2, "f4", 2) == 0) { dtype = DTYPE_F32; known = true; }
+        if (little && memcmp(descr + 2, "f8", 2) == 0) { dtype = DTYPE_F64; known = true; }
+        if (little && memcmp(descr + 2, "f2", 2) == 0) { dtype = DTYPE_F16; known = true; }
+        if (little && memcmp(descr + 2, "i1", 2) == 0) { dtype = DTYPE_I8; known = true; }
+        if (little && memcmp(descr + 2, "u1", 2) == 0) { dtype = DTYPE_U8; known = true; }
+    }
+    if (!known)
+    {
+        fprintf(stderr, "Error: %s: '%s' has an unsupported dtype (expected '<i4', '<f4', '<f8', '<f2', '|i1' or '|u1').\n", name, path);
+        _file_view_release(&view);
+        return NULL;
+    }
+    const bool fortran = order != NULL && end - order >= 4 && memcmp(order, "True", 4) == 0;
+
+    int dims[TENSOR_ITER_MAX_DIMS];
+    int ndim = 0;
+    bool shape_ok = dims_text != NULL && *dims_text == '(';
+    for (const char* p = shape_ok ? dims_text + 1 : end; shape_ok && p < end && *p != ')'; )
+    {
+        if (*p == ' ' || *p == ',') { p++; continue; }
+        if (*p < '0' || *p > '9' || ndim == TENSOR_ITER_MAX_DIMS) { shape_ok = false; break; }
+
+        long long value = 0;
+        while (p < end && *p >= '0' && *p <= '9' && value <= INT_MAX) value = value * 10 + (*p++ - '0');
+        if (value > INT_MAX) { shape_ok = false; break; }
+        dims[ndim++] = (int)value;
+    }
+    if (!shape_ok)
+    {
+        fprintf(stderr, "Error: %s: '%s' has an invalid shape.\n", name, path);
+        _file_view_release(&view);
+        return NULL;
+    }
+
+    // 3. 列主序的数组直接用列主序的 strides 表示，不复制
+    Shape shape;
+    if (fortran && ndim > 1)
+    {
+        size_t strides[TENSOR_ITER_MAX_DIMS];
+        size_t running = 1;
+        for (int i = 0; i < ndim; i++)
+        {
+            strides[i] = running;
+            running *= (size_t)dims[i];
+        }
+        shape = shape_create_strided(dims, strides, ndim);
+    }
+    else
+    {
+        shape = shape_create(dims, ndim);
+    }
+    return _tensor_from_view(&view, header_start + header_len, shape, dtype, name);
+}
+
+// 字典最长的样子：每个维度最多 10 位数字加分隔符
+#define NPY_DICT_MAX (64 + TENSOR_ITER_MAX_DIMS * 16)
+#define NPY_HEADER_MAX (NPY_DICT_MAX + 2 * IO_ALIGNMENT)
+#define RAW_HEADER_MAX (RAW_FIXED_HEADER + 8 * TENSOR_ITER_MAX_DIMS + IO_ALIGNMENT)
+#define IO_HEADER_MAX NPY_HEADER_MAX // 两种头部都放得下
+
+// 写出 .npy 头部并返回它的长度（IO_ALIGNMENT 的倍数，至少 min_total）
+static size_t
+_npy_header(char* header, DataType dtype, const int* dims, int ndim, size_t min_total)
+{
+    // 字典，例如 {'descr': '<f4', 'fortran_order': False, 'shape': (3, 4), }
+    char dict[NPY_DICT_MAX];
+    int len = snprintf(dict, sizeof(dict), "{'descr': '%s', 'fortran_order': False, 'shape': (", _npy_descr(dtype));
+    for (int i = 0; i < ndim; i++)
+        len += snprintf(dict + len, sizeof(dict) - (size_t)len, (ndim == 1) ? "%d," : (i > 0 ? ", %d" : "%d"), dims[i]);
+    len += snprintf(dict + len, sizeof(dict) - (size_t)len, "), }");
+
+    // 头部用空格补齐并以换行结束，使数据区从 64 字节边界开始（1.0 版的 2 字节长度总是够用）
+    const size_t prefix = NPY_MAGIC_LEN + 2 + 2;
+    size_t total = (prefix + (size_t)len + 1 + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT;
+    if (total < min_total) total = min_total;
+    const size_t header_len = total - prefix;
+
+    memcpy(header, NPY_MAGIC, NPY_MAGIC_LEN);
+    header[6] = 1;
+    header[7] = 0;
+    header[8] = (char)(header_len & 0xff);
+    header[9] = (char)(header_len >> 8);
+    memcpy(header + prefix, dict, (size_t)len);
+    memset(header + prefix + len, ' ', header_len - (size_t)len - 1);
+    header[total - 1] = '\n';
+    return total;
+}
+
+bool
+tensor_save_npy(const Tensor t, const char* path)
+{
+    const char* name = "tensor_save_npy";
+    if (path == NULL || !_check_saveable(t, name)) return false;
+    if (_npy_descr(tensor_get_dtype(t)) == NULL)
+    {
+        fprintf(stderr, "Error: %s: the .npy format has no BF16 dtype; use tensor_save_raw().\n", name);
+        return false;
+    }
+
+    const Shape shape = tensor_get_shape(t);
+    const int ndim = shape_get_ndim(shape);
+    if (ndim > TENSOR_ITER_MAX_DIMS) return false;
+
+    char header[NPY_HEADER_MAX];
+    const size_t total = _npy_header(header, tensor_get_dtype(t), shape_get_dims(shape), ndim, 0);
+    return _save(t, path, header, total, name);
+}
+
+// --- 原生格式 ---
+
+static void
+_put_u32(char* p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) p[i] = (char)((v >> (8 * i)) & 0xff);
+}
+
+static uint32_t
+_get_u32(const char* p)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)(uint8_t)p[i] << (8 * i);
+    return v;
+}
+
+static void
+_put_i64(char* p, int64_t v)
+{
+    for (int i = 0; i < 8; i++) p[i] = (char)(((uint64_t)v >> (8 * i)) & 0xff);
+}
+
+static int64_t
+_get_i64(const char* p)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)(uint8_t)p[i] << (8 * i);
+    return (int64_t)v;
+}
+
+Tensor
+tensor_load_raw(const char* path)
+{
+    const char* name = "tensor_load_raw";
+    if (path == NULL) return NULL;
+    if (!_host_is_little_endian())
+    {
+        fprintf(stderr, "Error: %s: only little-endian hosts are supported.\n", name);
+        return NULL;
+    }
+
+    FileView view;
+    if (!_file_view_open(&view, path, name)) return NULL;
+
+    const char* h = view.base;
+    const uint32_t version = (view.size >= RAW_FIXED_HEADER) ? _get_u32(h + 8) : 0;
+    if (view.size < RAW_FIXED_HEADER || memcmp(h, RAW_MAGIC, 8) != 0 || version != RAW_VERSION)
+    {
+        fprintf(stderr, "Error: %s: '%s' is not a supported raw tensor file.\n", name, path);
+        _file_view_release(&view);
+        return NULL;
+    }
+
+    const uint32_t dtype = _get_u32(h + 12);
+    const uint32_t ndim = _get_u32(h + 16);
+    const uint32_t data_offset = _get_u32(h + 20);
+    bool ok = dtype < DTYPE_COUNT && ndim <= TENSOR_ITER_MAX_DIMS &&
+              data_offset >= RAW_FIXED_HEADER + 8 * ndim && data_offset <= view.size;
+
+    int dims[TENSOR_ITER_MAX_DIMS];
+    for (uint32_t i = 0; ok && i < ndim; i++)
+    {
+        const int64_t d = _get_i64(h + RAW_FIXED_HEADER + 8 * i);
+        ok = d >= 0 && d <= INT_MAX;
+        dims[i] = (int)d;
+    }
+    if (!ok)
+    {
+        fprintf(stderr, "Error: %s: '%s' has an invalid header.\n", name, path);
+        _file_view_release(&view);
+        return NULL;
+    }
+    return _tensor_from_view(&view, data_offset, shape_create(dims, (int)ndim), (DataType)dtype, name);
+}
+
+// 写出原生格式的头部并返回它的长度
+static size_t
+_raw_header(char* header, DataType dtype, const int* dims, int ndim)
+{
+    const size_t used = RAW_FIXED_HEADER + 8 * (size_t)ndim;
+    const size_t total = (used + IO_ALIGNMENT - 1) / IO_ALIGNMENT * IO_ALIGNMENT;
+    memset(header, 0, total);
+    memcpy(header, RAW_MAGIC, 8);
+    _put_u32(header + 8, RAW_VERSION);
+    _put_u32(header + 12, (uint32_t)dtype);
+    _put_u32(header + 16, (uint32_t)ndim);
+    _put_u32(header + 20, (uint32_t)total);
+    for (int i = 0; i < ndim; i++)
+        _put_i64(header + RAW_FIXED_HEADER + 8 * i, dims[i]);
+    return total;
+}
+
+bool
+tensor_save_raw(const Tensor t, const char* path)
+{
+    const char* name = "tensor_save_raw";
+    if (path == NULL || !_check_saveable(t, name)) return false;
+
+    const Shape shape = tensor_get_shape(t);
+    const int ndim = shape_get_ndim(shape);
+    if (ndim > TENSOR_ITER_MAX_DIMS) return false;
+
+    char header[RAW_HEADER_MAX];
+    const size_t total = _raw_header(header, tensor_get_dtype(t), shape_get_dims(shape), ndim);
+    return _save(t, path, header, total, name);
+}
+
+// --- 流式写出 ---
+
+struct _tensor_writer
+{
+    FILE* file;
+    char* path;           // 用于错误信息
+    bool npy;
+    bool started;         // 第一次追加之后 dtype 和 dims[1:] 就固定了
+    bool failed;
+    DataType dtype;
+    int ndim;
+    int dims[TENSOR_ITER_MAX_DIMS]; // dims[0] 是目前为止的总行数
+    size_t header_size;   // 先写一个占位的头部，关闭时在原处改写
+};
+
+static TensorWriter
+_writer_open(const char* path, bool npy, const char* name)
+{
+    if (path == NULL) return NULL;
+    if (!_host_is_little_endian())
+    {
+        fprintf(stderr, "Error: %s: only little-endian hosts are supported.\n", name);
+        return NULL;
+    }
+
+    TensorWriter w = safemalloc(sizeof(struct _tensor_writer));
+    const size_t path_len = strlen(path);
+    char* path_copy = safemalloc(path_len + 1);
+    if (w == NULL || path_copy == NULL)
+    {
+        free(path_copy);
+        free(w);
+        return NULL;
+    }
+    memcpy(path_copy, path, path_len + 1);
+
+    FILE* f = fopen(path, "wb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Error: %s: cannot create '%s'.\n", name, path);
+        free(path_copy);
+        free(w);
+        return NULL;
+    }
+
+    *w = (struct _tensor_writer){ .file = f, .path = path_copy, .npy = npy };
+    return w;
+}
+
+TensorWriter
+tensor_writer_open_npy(const char* path)
+{
+    return _writer_open(path, true, "tensor_writer_open_npy");
+}
+
+TensorWriter
+tensor_writer_open_raw(const char* path)
+{
+    return _writer_open(path, false, "tensor_writer_open_raw");
+}
+
+// 第一块决定 dtype 和每行的形状；之后的块必须与之一致
+static bool
+_writer_accepts(TensorWriter w, const Tensor rows, const char* name)
+{
+    const Shape shape = tensor_get_shape(rows);
+    const int ndim = shape_get_ndim(shape);
+    const int* dims = shape_get_dims(shape);
+    const DataType dtype = tensor_get_dtype(rows);
+
+    if (!w->started)
+    {
+        if (ndim < 1 || ndim > TENSOR_ITER_MAX_DIMS)
+        {
+            fprintf(stderr, "Error: %s: rows must have 1 to %d dimensions, got %d.\n", name, TENSOR_ITER_MAX_DIMS, ndim);
+            return false;
+        }
+        if (w->npy && _npy_descr(dtype) == NULL)
+        {
+            fprintf(stderr, "Error: %s: the .npy format has no BF16 dtype; use tensor_writer_open_raw().\n", name);
+            return false;
+        }
+        return true;
+    }
+
+    bool same = dtype == w->dtype && ndim == w->ndim;
+    for (int i = 1; same && i < ndim; i++) same = dims[i] == w->dims[i];
+    if (!same)
+    {
+        fprintf(stderr, "Error: %s: rows do not match the dtype and row shape of the earlier rows in '%s'.\n", name, w->path);
+        return false;
+    }
+    if (dims[0] > INT_MAX - w->dims[0])
+    {
+        fprintf(stderr, "Error: %s: '%s' would have more than %d rows.\n", name, w->path, INT_MAX);
+        return false;
+    }
+    return true;
+}
+
+bool
+tensor_writer_append(TensorWriter w, const Tensor rows)
+{
+    const char* name = "tensor_writer_append";
+    if (w == NULL || rows == NULL) return false;
+    // 形状不符的块被拒绝，但文件保持完整；写失败之后则不再接受任何数据
+    if (w->failed || !_writer_accepts(w, rows, name)) return false;
+
+    const Shape shape = tensor_get_shape(rows);
+    if (!w->started)
+    {
+        w->started = true;
+        w->dtype = tensor_get_dtype(rows);
+        w->ndim = shape_get_ndim(shape);
+        memcpy(w->dims, shape_get_dims(shape), (size_t)w->ndim * sizeof(int));
+        w->dims[0] = 0;
+
+        // 占位头部按最长的行数计算，关闭时写入真实行数后长度不会变长
+        char header[IO_HEADER_MAX];
+        w->dims[0] = INT_MAX;
+        w->header_size = w->npy ? _npy_header(header, w->dtype, w->dims, w->ndim, 0)
+                                : _raw_header(header, w->dtype, w->dims, w->ndim);
+        w->dims[0] = 0;
+        if (fwrite(header, 1, w->header_size, w->file) != w->header_size) w->failed = true;
+    }
+
+    if (!w->failed && !_write_elements(w->file, rows)) w->failed = true;
+    if (w->failed)
+    {
+        fprintf(stderr, "Error: %s: failed to write '%s'.\n", name, w->path);
+        return false;
+    }
+    w->dims[0] += shape_get_dims(shape)[0];
+    return true;
+}
+
+bool
+tensor_writer_close(TensorWriter w)
+{
+    const char* name = "tensor_writer_close";
+    if (w == NULL) return false;
+
+    bool ok = !w->failed;
+    if (ok && !w->started)
+    {
+        fprintf(stderr, "Error: %s: nothing was appended to '%s'.\n", name, w->path);
+        ok = false;
+    }
+    if (ok)
+    {
+        char header[IO_HEADER_MAX];
+        const size_t size = w->npy ? _npy_header(header, w->dtype, w->dims, w->ndim, w->header_size)
+                                   : _raw_header(header, w->dtype, w->dims, w->ndim);
+        ok = size == w->header_size && fseek(w->file, 0, SEEK_SET) == 0 &&
+             fwrite(header, 1, size, w->file) == size;
+        if (!ok) fprintf(stderr, "Error: %s: failed to write '%s'.\n", name, w->path);
+    }
+    if (fclose(w->file) != 0 && ok)
+    {
+        fprintf(stderr, "Error: %s: failed to write '%s'.\n", name, w->path);
+        ok = false;
+    }
+
+    free(w->path);
+    free(w);
+    return ok;
+}
@@ -0,0 +1,216 @@
+#include "tensor/_tensor_iter.h"
+
+#include <stdio.h>  // for fprintf()
+#include <string.h> // for memset()
+
+// 根据合并后的维度，刷新 run 的数量和最内层 run 的信息
+static void
+_iter_update_runs(TensorIter* it)
+{
+    it->num_runs = (it->size == 0) ? 0 : 1;
+    for (int d = 0; d < it->ndim - 1; d++)
+        it->num_runs *= it->dims[d];
+
+    if (it->ndim == 0)
+    {
+        it->_run_length = 1;
+        for (int op = 0; op < it->nops; op++)
+            it->inner_strides[op] = 0;
+    }
+    else
+    {
+        it->_run_length = it->dims[it->ndim - 1];
+        for (int op = 0; op < it->nops; op++)
+            it->inner_strides[op] = it->strides[op][it->ndim - 1];
+    }
+    it->inner_size = (it->size == 0) ? 0 : it->_run_length;
+
+    tensor_iter_seek(it, 0);
+}
+
+bool
+tensor_iter_init_strided(TensorIter* it, int nops, void* const* data,
+                         const size_t* const* strides, const size_t* item_sizes,
+                         const int* dims, int ndim)
+{
+    if (it == NULL || data == NULL || strides == NULL || item_sizes == NULL) return false;
+    if (nops <= 0 || nops > TENSOR_ITER_MAX_OPERANDS)
+    {
+        fprintf(stderr, "Error: tensor_iter supports 1 to %d operands, got %d.\n", TENSOR_ITER_MAX_OPERANDS, nops);
+        return false;
+    }
+    if (ndim > 0 && dims == NULL) return false;
+
+    it->nops = nops;
+    it->ndim = 0;
+    it->size = 1;
+    for (int op = 0; op < nops; op++)
+        it->base[op] = (char*)data[op];
+
+    for (int i = 0; i < ndim; i++)
+    {
+        if (dims[i] < 0) return false;
+        it->size *= (size_t)dims[i];
+        if (dims[i] == 1) continue; // 长度为 1 的维度不影响遍历
+
+        const size_t size = (size_t)dims[i];
+        const int n = it->ndim;
+
+        // 外层步长 == 内层步长 * 内层长度（对所有操作数都成立）时可以合并。
+        // 广播维度的步长为 0，0 == 0 * size 同样成立。
+        bool mergeable = n > 0;
+        for (int op = 0; op < nops && mergeable; op++)
+            mergeable = it->strides[op][n-1] == strides[op][i] * item_sizes[op] * size;
+
+        if (mergeable)
+        {
+            it->dims[n-1] *= size;
+            for (int op = 0; op < nops; op++)
+                it->strides[op][n-1] = strides[op][i] * item_sizes[op];
+            continue;
+        }
+
+        if (n == TENSOR_ITER_MAX_DIMS)
+        {
+            fprintf(stderr, "Error: tensor_iter supports at most %d non-trivial dimensions.\n", TENSOR_ITER_MAX_DIMS);
+            return false;
+        }
+        it->dims[n] = size;
+        for (int op = 0; op < nops; op++)
+            it->strides[op][n] = strides[op][i] * item_sizes[op];
+        it->ndim++;
+    }
+
+    _iter_update_runs(it);
+    return true;
+}
+
+bool
+tensor_iter_init(TensorIter* it, const Tensor* operands, int nops)
+{
+    if (it == NULL || operands == NULL) return false;
+    if (nops <= 0 || nops > TENSOR_ITER_MAX_OPERANDS)
+    {
+        fprintf(stderr, "Error: tensor_iter supports 1 to %d operands, got %d.\n", TENSOR_ITER_MAX_OPERANDS, nops);
+        return false;
+    }
+
+    void* data[TENSOR_ITER_MAX_OPERANDS];
+    const size_t* strides[TENSOR_ITER_MAX_OPERANDS];
+    size_t item_sizes[TENSOR_ITER_MAX_OPERANDS];
+
+    for (int op = 0; op < nops; op++)
+    {
+        if (operands[op] == NULL) return false;
+        if (!shape_equals(tensor_get_shape(operands[op]), tensor_get_shape(operands[0])))
+        {
+            fprintf(stderr, "Error: tensor_iter operands must have the same shape. Use tensor_expand() to broadcast.\n");
+            return false;
+        }
+        // 只有输出（第一个操作数）需要可写指针；输入用只读指针，不破坏写时复制的共享
+        data[op] = (op == 0) ? _tensor_get_data(operands[op]) : (void*)tensor_get_data_const(operands[op]);
+        strides[op] = tensor_get_strides(operands[op]);
+        item_sizes[op] = tensor_get_item_size(operands[op]);
+    }
+
+    const Shape shape = tensor_get_shape(operands[0]);
+    return tensor_iter_init_strided(it, nops, data, strides, item_sizes,
+                                    shape_get_dims(shape), shape_get_ndim(shape));
+}
+
+bool
+tensor_iter_next(TensorIter* it)
+{
+    if (it->_pos >= it->_end) return false;
+
+    // 只有受 set_range 限制的首尾两段才可能是不完整的 run
+    const size_t skip = it->_pos % it->_run_length;
+    size_t n = it->_run_length - skip;
+    if (n > it->_end - it->_pos) n = it->_end - it->_pos;
+
+    for (int op = 0; op < it->nops; op++)
+        it->ptrs[op] = it->base[op] + it->_offsets[op] + skip * it->inner_strides[op];
+    it->inner_size = n;
+    it->_pos += n;
+
+    if (skip + n < it->_run_length) return true; // 停在了 run 的中间
+    it->run_index++;
+    if (it->run_index >= it->num_runs) return true;
+
+    // 推进外层里程表，偏移量增量更新
+    for (int d = it->ndim - 2; d >= 0; d--)
+    {
+        it->_coords[d]++;
+        if (it->_coords[d] < it->dims[d])
+        {
+            for (int op = 0; op < it->nops; op++)
+                it->_offsets[op] += it->strides[op][d];
+            return true;
+        }
+
+        // 当前维度溢出：回到 0，并向更外一维进位
+        for (int op = 0; op < it->nops; op++)
+            it->_offsets[op] -= it->strides[op][d] * (it->dims[d] - 1);
+        it->_coords[d] = 0;
+    }
+    return true;
+}
+
+void
+tensor_iter_seek(TensorIter* it, size_t run_index)
+{
+    tensor_iter_set_range(it, run_index * it->_run_length, it->size);
+}
+
+void
+tensor_iter_set_range(TensorIter* it, size_t begin, size_t end)
+{
+    if (end > it->size) end = it->size;
+    if (it->_run_length == 0) begin = end = 0; // 空张量
+    it->_pos = begin;
+    it->_end = end;
+    it->run_index = (it->_run_length == 0) ? 0 : begin / it->_run_length;
+    memset(it->_offsets, 0, sizeof(it->_offsets));
+    memset(it->_coords, 0, sizeof(it->_coords));
+    if (begin >= end) return;
+
+    // 把线性的 run 编号拆成外层坐标，再一次性算出偏移量
+    size_t rest = it->run_index;
+    for (int d = it->ndim - 2; d >= 0; d--)
+    {
+        it->_coords[d] = rest % it->dims[d];
+        rest /= it->dims[d];
+        for (int op = 0; op < it->nops; op++)
+            it->_offsets[op] += it->_coords[d] * it->strides[op][d];
+    }
+}
+
+void
+tensor_iter_reset(TensorIter* it, void* const* data)
+{
+    for (int op = 0; op < it->nops; op++)
+        it->base[op] = (char*)data[op];
+    tensor_iter_seek(it, 0);
+}
+
+bool
+tensor_iter_remove_axis(TensorIter* it, int axis, size_t* size, size_t* strides)
+{
+    if (it == NULL || axis < 0 || axis >= it->ndim - 1) return false;
+
+    const size_t removed = it->dims[axis];
+    if (size != NULL) *size = removed;
+    for (int op = 0; op < it->nops; op++)
+    {
+        if (strides != NULL) strides[op] = it->strides[op][axis];
+        for (int d = axis; d < it->ndim - 1; d++)
+            it->strides[op][d] = it->strides[op][d+1];
+    }
+    for (int d = axis; d < it->ndim - 1; d++)
+        it->dims[d] = it->dims[d+1];
+
+    it->ndim--;
+    it->size /= removed;
+    _iter_update_runs(it);
+    return true;
+}
@@ -0,0 +1,542 @@
+#include "tensor/_tensor_lazy.h"
+#include "tensor/_tensor_iter.h"
+#include "tensor/_tensor_simd.h"
+#include "tensor/_shape.h"
+#include "utils/_malloc.h"
+#include "utils/_parallel.h"
+
+#include <math.h>   // for expf(), logf(), sqrtf(), fabs(), ...
+#include <stdint.h> // for int32_t, uint32_t
+#include <stdio.h>  // for fprintf()
+#include <string.h> // for memcpy()
+
+// 融合内核每次处理的元素个数：每个栈槽一块，整个栈留在 L1 里
+#define LAZY_TILE 256
+// 求值栈的深度上限，以及一趟融合最多执行的指令数
+#define LAZY_STACK_DEPTH 8
+#define LAZY_MAX_PROGRAM 64
+
+typedef enum
+{
+    LAZY_NODE_TENSOR,
+    LAZY_NODE_SCALAR,
+    LAZY_NODE_UNARY,
+    LAZY_NODE_BINARY
+}
+LazyNodeKind;
+
+struct _lazy_expr
+{
+    LazyNodeKind kind;
+    int refcount;
+    int dtype;          // DataType；只由标量构成的表达式为 -1，取与之运算的张量的 dtype
+    bool float_only;    // 子树里有只支持浮点的一元运算
+    Shape shape;        // 广播后的形状（行主序）
+    Tensor tensor;      // LAZY_NODE_TENSOR：输入张量的视图
+    double value;       // LAZY_NODE_SCALAR
+    int op;             // BinaryOp 或 LazyUnaryOp
+    LazyExpr a;
+    LazyExpr b;
+};
+
+// --- 表达式的构建 ---
+
+static LazyExpr
+_node_create(LazyNodeKind kind, int dtype, Shape shape)
+{
+    if (shape == NULL) return NULL;
+
+    LazyExpr e = safe_small_alloc(sizeof(struct _lazy_expr));
+    if (e == NULL)
+    {
+        shape_free(shape);
+        return NULL;
+    }
+    e->kind = kind;
+    e->refcount = 1;
+    e->dtype = dtype;
+    e->float_only = false;
+    e->shape = shape;
+    e->tensor = NULL;
+    e->value = 0.0;
+    e->op = 0;
+    e->a = NULL;
+    e->b = NULL;
+    return e;
+}
+
+static LazyExpr
+_retain(LazyExpr e)
+{
+    e->refcount++;
+    return e;
+}
+
+LazyExpr
+lazy_tensor(const Tensor t)
+{
+    if (t == NULL) return NULL;
+
+    const DataType dtype = tensor_get_dtype(t);
+    if (dtype < DTYPE_I32 || dtype > DTYPE_F64)
+    {
+        fprintf(stderr, "Error: lazy_tensor: lazy expressions support I32, F32 and F64; convert with tensor_to_dtype() first.\n");
+        return NULL;
+    }
+
+    const Shape shape = tensor_get_shape(t);
+    LazyExpr e = _node_create(LAZY_NODE_TENSOR, dtype, shape_create(shape_get_dims(shape), shape_get_ndim(shape)));
+    if (e == NULL) return NULL;
+
+    // 持有一个视图：求值时才读数据，也让 storage 保持存活
+    e->tensor = _tensor_create_view(t, tensor_get_offset(t), shape_copy(shape));
+    if (e->tensor == NULL)
+    {
+        lazy_free(e);
+        return NULL;
+    }
+    return e;
+}
+
+LazyExpr
+lazy_scalar(double value)
+{
+    LazyExpr e = _node_create(LAZY_NODE_SCALAR, -1, shape_create(NULL, 0));
+    if (e != NULL) e->value = value;
+    return e;
+}
+
+LazyExpr
+lazy_binary(LazyExpr a, LazyExpr b, BinaryOp op)
+{
+    if (a == NULL || b == NULL) return NULL;
+    if (op < 0 || op >= BINARY_OP_COUNT) return NULL;
+
+    if (a->dtype >= 0 && b->dtype >= 0 && a->dtype != b->dtype)
+    {
+        fprintf(stderr, "Error: lazy_binary: operands must have the same dtype.\n");
+        return NULL;
+    }
+    const int dtype = (a->dtype >= 0) ? a->dtype : b->dtype;
+    const bool float_only = a->float_only || b->float_only;
+    if (float_only && dtype == DTYPE_I32)
+    {
+        fprintf(stderr, "Error: lazy_binary: exp/log/sqrt/rsqrt need a floating-point dtype.\n");
+        return NULL;
+    }
+
+    LazyExpr e = _node_create(LAZY_NODE_BINARY, dtype, shape_broadcast(a->shape, b->shape));
+    if (e == NULL) return NULL;
+    e->float_only = float_only;
+    e->op = op;
+    e->a = _retain(a);
+    e->b = _retain(b);
+    return e;
+}
+
+LazyExpr
+lazy_unary(LazyExpr a, LazyUnaryOp op)
+{
+    if (a == NULL) return NULL;
+    if (op < 0 || op >= LAZY_UNARY_COUNT) return NULL;
+
+    const bool float_only = a->float_only || op >= LAZY_UNARY_EXP;
+    if (float_only && a->dtype == DTYPE_I32)
+    {
+        fprintf(stderr, "Error: lazy_unary: exp/log/sqrt/rsqrt need a floating-point dtype.\n");
+        return NULL;
+    }
+
+    LazyExpr e = _node_create(LAZY_NODE_UNARY, a->dtype, shape_copy(a->shape));
+    if (e == NULL) return NULL;
+    e->float_only = float_only;
+    e->op = op;
+    e->a = _retain(a);
+    return e;
+}
+
+LazyExpr lazy_add(LazyExpr a, LazyExpr b) { return lazy_binary(a, b, BINARY_OP_ADD); }
+LazyExpr lazy_sub(LazyExpr a, LazyExpr b) { return lazy_binary(a, b, BINARY_OP_SUB); }
+LazyExpr lazy_mul(LazyExpr a, LazyExpr b) { return lazy_binary(a, b, BINARY_OP_MUL); }
+LazyExpr lazy_div(LazyExpr a, LazyExpr b) { return lazy_binary(a, b, BINARY_OP_DIV); }
+LazyExpr lazy_maximum(LazyExpr a, LazyExpr b) { return lazy_binary(a, b, BINARY_OP_MAX); }
+LazyExpr lazy_minimum(LazyExpr a, LazyExpr b) { return lazy_binary(a, b, BINARY_OP_MIN); }
+LazyExpr lazy_neg(LazyExpr a) { return lazy_unary(a, LAZY_UNARY_NEG); }
+LazyExpr lazy_relu(LazyExpr a) { return lazy_unary(a, LAZY_UNARY_RELU); }
+
+void
+lazy_free(LazyExpr e)
+{
+    if (e == NULL || --e->refcount > 0) return;
+
+    lazy_free(e->a);
+    lazy_free(e->b);
+    tensor_free(e->tensor);
+    shape_free(e->shape);
+    safe_small_free(e);
+}
+
+Shape
+lazy_get_shape(const LazyExpr e)
+{
+    return (e != NULL) ? e->shape : NULL;
+}
+
+// --- 编译：把表达式树翻译成一段栈式程序 ---
+
+typedef enum
+{
+    LAZY_INSN_LOAD,   // 压入输入 operand 的一块
+    LAZY_INSN_CONST,  // 压入常量 value
+    LAZY_INSN_UNARY,  // 栈顶 = op(栈顶)
+    LAZY_INSN_BINARY  // 弹出 r、l，压入 l op r
+}
+LazyInsnKind;
+
+typedef struct
+{
+    LazyInsnKind kind;
+    int op;
+    int operand;
+    double value;
+    const SimdBinaryFn* simd; // LAZY_INSN_BINARY：按布局索引的向量化内核，求值时按 dtype 填入
+}
+LazyInsn;
+
+typedef struct
+{
+    LazyInsn code[LAZY_MAX_PROGRAM];
+    int length;
+    LazyExpr inputs[LAZY_MAX_INPUTS]; // 去重后的张量输入
+    int ninputs;
+}
+LazyProgram;
+
+static bool
+_emit(LazyProgram* prog, LazyInsnKind kind, int op, int operand, double value)
+{
+    if (prog->length == LAZY_MAX_PROGRAM) return false;
+    prog->code[prog->length++] = (LazyInsn){ kind, op, operand, value, NULL };
+    return true;
+}
+
+// 编译 e，sp 是编译它之前栈上已有的元素个数。超出任一上限时返回 false
+static bool
+_compile(LazyProgram* prog, LazyExpr e, int sp)
+{
+    if (sp + 1 > LAZY_STACK_DEPTH) return false;
+
+    switch (e->kind)
+    {
+        case LAZY_NODE_TENSOR:
+        {
+            int k = 0;
+            while (k < prog->ninputs && prog->inputs[k] != e) k++;
+            if (k == prog->ninputs)
+            {
+                if (prog->ninputs == LAZY_MAX_INPUTS) return false;
+                prog->inputs[prog->ninputs++] = e;
+            }
+            return _emit(prog, LAZY_INSN_LOAD, 0, k, 0.0);
+        }
+
+        case LAZY_NODE_SCALAR:
+            return _emit(prog, LAZY_INSN_CONST, 0, 0, e->value);
+
+        case LAZY_NODE_UNARY:
+            // relu 就是 maximum(x, 0)，走向量化的二元内核
+            if (e->op == LAZY_UNARY_RELU)
+                return _compile(prog, e->a, sp) && sp + 2 <= LAZY_STACK_DEPTH &&
+                       _emit(prog, LAZY_INSN_CONST, 0, 0, 0.0) && _emit(prog, LAZY_INSN_BINARY, BINARY_OP_MAX, 0, 0.0);
+            return _compile(prog, e->a, sp) && _emit(prog, LAZY_INSN_UNARY, e->op, 0, 0.0);
+
+        case LAZY_NODE_BINARY:
+            return _compile(prog, e->a, sp) && _compile(prog, e->b, sp + 1) &&
+                   _emit(prog, LAZY_INSN_BINARY, e->op, 0, 0.0);
+    }
+    return false;
+}
+
+// --- 融合内核 ---
+
+// 整数除法与 tensor_binary 相同：向零截断；除数为 0 时结果为 0，INT32_MIN / -1 按补码回绕
+#define _I32_DIV(l, r) ((r) == 0 ? 0 : ((r) == -1 ? (int32_t)(0u - (uint32_t)(l)) : (l) / (r)))
+#define _I32_NEG(x) ((int32_t)(0u - (uint32_t)(x)))
+
+#define _LAZY_MAP(T, EXPR) \
+    for (size_t i = 0; i < m; i++) { const T x = l[i]; out[i] = (EXPR); }
+#define _LAZY_ZIP(T, EXPR) \
+    for (size_t i = 0; i < m; i++) { const T x = l[i * sl], y = r[i * sr]; out[i] = (EXPR); }
+
+// 为每个 dtype 生成一元、二元运算和执行一段 run 的函数。
+// 栈上的每个值要么是一块 m 个元素，要么是一个广播的标量（常量、stride 为 0 的输入），
+// 连续的输入直接指向原数据，不复制。二元运算优先用向量化内核，表达式与 tensor_binary 相同，
+// 所以结果与逐个调用 eager 算子逐位一致。
+#define _DEFINE_LAZY_KERNELS(suffix, T, NEG, ABS, EXP, LOG, SQRT, DIV) \
+static void \
+_unary_##suffix(int op, T* out, const T* l, size_t m) \
+{ \
+    switch (op) \
+    { \
+        case LAZY_UNARY_NEG:   _LAZY_MAP(T, NEG); break; \
+        case LAZY_UNARY_ABS:   _LAZY_MAP(T, ABS); break; \
+        case LAZY_UNARY_EXP:   _LAZY_MAP(T, EXP); break; \
+        case LAZY_UNARY_LOG:   _LAZY_MAP(T, LOG); break; \
+        case LAZY_UNARY_SQRT:  _LAZY_MAP(T, SQRT); break; \
+        case LAZY_UNARY_RSQRT: _LAZY_MAP(T, (T)1 / (SQRT)); break; \
+        default: break; \
+    } \
+} \
+\
+static void \
+_binary_##suffix(int op, T* out, const T* l, const T* r, size_t m, size_t sl, size_t sr) \
+{ \
+    switch (op) \
+    { \
+        case BINARY_OP_ADD: _LAZY_ZIP(T, x + y); break; \
+        case BINARY_OP_SUB: _LAZY_ZIP(T, x - y); break; \
+        case BINARY_OP_MUL: _LAZY_ZIP(T, x * y); break; \
+        case BINARY_OP_DIV: _LAZY_ZIP(T, DIV); break; \
+        case BINARY_OP_MAX: _LAZY_ZIP(T, x > y ? x : y); break; \
+        case BINARY_OP_MIN: _LAZY_ZIP(T, x < y ? x : y); break; \
+        default: break; \
+    } \
+} \
+\
+static void \
+_run_##suffix(const LazyProgram* prog, char* const* ptrs, const size_t* strides, size_t n) \
+{ \
+    T buf[LAZY_STACK_DEPTH][LAZY_TILE]; \
+    const T* val[LAZY_STACK_DEPTH]; \
+    bool scalar[LAZY_STACK_DEPTH]; \
+    const size_t so = strides[0]; \
+    for (size_t t0 = 0; t0 < n; t0 += LAZY_TILE) \
+    { \
+        const size_t m = (n - t0 < LAZY_TILE) ? n - t0 : LAZY_TILE; \
+        char* out = ptrs[0] + t0 * so; \
+        int sp = 0; \
+        for (int pc = 0; pc < prog->length; pc++) \
+        { \
+            const LazyInsn* insn = &prog->code[pc]; \
+            switch (insn->kind) \
+            { \
+                case LAZY_INSN_LOAD: \
+                { \
+                    const size_t s = strides[1 + insn->operand]; \
+                    const char* src = ptrs[1 + insn->operand] + t0 * s; \
+                    scalar[sp] = (s == 0); \
+                    if (s == 0 || s == sizeof(T)) \
+                    { \
+                        val[sp] = (const T*)src; \
+                    } \
+                    else \
+                    { \
+                        for (size_t i = 0; i < m; i++) buf[sp][i] = *(const T*)(src + i * s); \
+                        val[sp] = buf[sp]; \
+                    } \
+                    sp++; \
+                    break; \
+                } \
+                case LAZY_INSN_CONST: \
+                    buf[sp][0] = (T)insn->value; \
+                    val[sp] = buf[sp]; \
+                    scalar[sp++] = true; \
+                    break; \
+                case LAZY_INSN_UNARY: \
+                    _unary_##suffix(insn->op, buf[sp - 1], val[sp - 1], scalar[sp - 1] ? 1 : m); \
+                    val[sp - 1] = buf[sp - 1]; \
+                    break; \
+                case LAZY_INSN_BINARY: \
+                { \
+                    sp--; \
+                    const T* l = val[sp - 1]; \
+                    const T* r = val[sp]; \
+                    /* 最后一条指令直接写进连续的输出，省掉一次复制 */ \
+                    const bool last = pc == prog->length - 1 && so == sizeof(T); \
+                    T* dst = last ? (T*)out : buf[sp - 1]; \
+                    if (scalar[sp - 1] && scalar[sp]) \
+                    { \
+                        _binary_##suffix(insn->op, dst, l, r, 1, 0, 0); \
+                    } \
+                    else \
+                    { \
+                        const SimdLayout layout = scalar[sp] ? SIMD_LAYOUT_VS : (scalar[sp - 1] ? SIMD_LAYOUT_SV : SIMD_LAYOUT_VV); \
+                        if (insn->simd != NULL && insn->simd[layout] != NULL) \
+                            insn->simd[layout](dst, l, r, m); \
+                        else \
+                            _binary_##suffix(insn->op, dst, l, r, m, scalar[sp - 1] ? 0 : 1, scalar[sp] ? 0 : 1); \
+                        scalar[sp - 1] = false; \
+                    } \
+                    val[sp - 1] = dst; \
+                    break; \
+                } \
+            } \
+        } \
+        if (scalar[0]) for (size_t i = 0; i < m; i++) *(T*)(out + i * so) = val[0][0]; \
+        else if (val[0] == (const T*)out) continue; \
+        else if (so == sizeof(T)) memcpy(out, val[0], m * sizeof(T)); \
+        else for (size_t i = 0; i < m; i++) *(T*)(out + i * so) = val[0][i]; \
+    } \
+}
+
+// 只支持浮点的运算在构建时就拒绝了 I32，这里的整数版本不会被执行
+_DEFINE_LAZY_KERNELS(i32, int32_t, _I32_NEG(x), (x < 0 ? _I32_NEG(x) : x), x, x, x, _I32_DIV(x, y))
+_DEFINE_LAZY_KERNELS(f32, float, -x, fabsf(x), expf(x), logf(x), sqrtf(x), x / y)
+_DEFINE_LAZY_KERNELS(f64, double, -x, fabs(x), exp(x), log(x), sqrt(x), x / y)
+
+typedef void (*LazyRunFn)(const LazyProgram* prog, char* const* ptrs, const size_t* strides, size_t n);
+
+// 按 dtype 索引，顺序与 DataType 枚举一致
+static const LazyRunFn _lazy_runs[3] = { _run_i32, _run_f32, _run_f64 };
+
+typedef struct
+{
+    const LazyProgram* prog;
+    LazyRunFn run;
+    TensorIter it; // 操作数: out, inputs...
+}
+LazyTask;
+
+// 并行任务：处理输出元素 [begin, end)
+static void
+_lazy_worker(size_t begin, size_t end, void* ctx)
+{
+    const LazyTask* task = (const LazyTask*)ctx;
+    TensorIter it = task->it; // 每个任务各自持有一份迭代器
+
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+        task->run(task->prog, it.ptrs, it.inner_strides, it.inner_size);
+}
+
+// --- 求值 ---
+
+// 执行一段编译好的程序，一趟写完 out
+static bool
+_execute(Tensor out, LazyProgram* prog, const char* name)
+{
+    const Shape out_shape = tensor_get_shape(out);
+    const size_t item_size = tensor_get_item_size(out);
+    const DataType dtype = tensor_get_dtype(out);
+
+    for (int pc = 0; pc < prog->length; pc++)
+        if (prog->code[pc].kind == LAZY_INSN_BINARY)
+            prog->code[pc].simd = simd_get_kernels()->binary[prog->code[pc].op][dtype];
+
+    // 1. 每个输入按输出形状广播（只算 strides）
+    Shape shapes[LAZY_MAX_INPUTS] = { NULL };
+    bool ok = true;
+    for (int k = 0; ok && k < prog->ninputs; k++)
+    {
+        shapes[k] = shape_expand(tensor_get_shape(prog->inputs[k]->tensor), out_shape);
+        ok = shapes[k] != NULL;
+    }
+
+    // 2. 先拿输出的可写指针，再检查输入与输出的重叠
+    void* out_data = ok ? _tensor_get_data(out) : NULL;
+    ok = out_data != NULL;
+    for (int k = 0; ok && k < prog->ninputs; k++)
+    {
+        if (!_tensor_out_alias_ok(out, out_data, prog->inputs[k]->tensor, shapes[k]))
+        {
+            fprintf(stderr, "Error: %s: an input partially overlaps the output.\n", name);
+            ok = false;
+        }
+    }
+
+    // 3. 输出和所有输入一起遍历，每段 run 执行一遍程序
+    if (ok)
+    {
+        void* data[1 + LAZY_MAX_INPUTS] = { out_data };
+        const size_t* strides[1 + LAZY_MAX_INPUTS] = { tensor_get_strides(out) };
+        size_t item_sizes[1 + LAZY_MAX_INPUTS] = { item_size };
+        for (int k = 0; k < prog->ninputs; k++)
+        {
+            data[1 + k] = (void*)tensor_get_data_const(prog->inputs[k]->tensor);
+            strides[1 + k] = shape_get_strides(shapes[k]);
+            item_sizes[1 + k] = item_size;
+        }
+
+        LazyTask task;
+        task.prog = prog;
+        task.run = _lazy_runs[dtype];
+        ok = tensor_iter_init_strided(&task.it, 1 + prog->ninputs, data, strides, item_sizes,
+                                      shape_get_dims(out_shape), shape_get_ndim(out_shape));
+        if (ok)
+            parallel_for(0, task.it.size, parallel_grain((size_t)(1 + prog->ninputs) * item_size),
+                         _lazy_worker, &task);
+    }
+
+    for (int k = 0; k < prog->ninputs; k++) shape_free(shapes[k]);
+    return ok;
+}
+
+static bool
+_eval_into(Tensor out, const LazyExpr e, const char* name)
+{
+    LazyProgram prog;
+    prog.length = 0;
+    prog.ninputs = 0;
+    if (_compile(&prog, e, 0)) return _execute(out, &prog, name);
+
+    // 一趟放不下：先把非叶子的子表达式各自求值成临时张量，再对剩下的一层求值。
+    // 临时张量取输出的 dtype：只由标量构成的子树 dtype 为 -1，不能按 lazy_eval() 的 F64 求值，
+    // 否则与另一边的张量 dtype 不一致；子树有 dtype 时它本来就与输出相同
+    const DataType dtype = tensor_get_dtype(out);
+    LazyExpr children[2] = { e->a, e->b };
+    LazyExpr lowered[2] = { NULL, NULL };
+    bool ok = true;
+    for (int c = 0; ok && c < 2 && children[c] != NULL; c++)
+    {
+        if (children[c]->kind == LAZY_NODE_TENSOR || children[c]->kind == LAZY_NODE_SCALAR)
+        {
+            lowered[c] = _retain(children[c]);
+            continue;
+        }
+        Tensor t = tensor_empty(children[c]->shape, dtype);
+        lowered[c] = (t != NULL && _eval_into(t, children[c], name)) ? lazy_tensor(t) : NULL;
+        tensor_free(t); // 叶子持有视图，临时张量随它一起释放
+        ok = lowered[c] != NULL;
+    }
+
+    LazyExpr top = NULL;
+    if (ok) top = (e->kind == LAZY_NODE_UNARY) ? lazy_unary(lowered[0], e->op) : lazy_binary(lowered[0], lowered[1], e->op);
+    ok = top != NULL && _eval_into(out, top, name);
+
+    lazy_free(top);
+    lazy_free(lowered[0]);
+    lazy_free(lowered[1]);
+    return ok;
+}
+
+Tensor
+lazy_eval(const LazyExpr e)
+{
+    if (e == NULL) return NULL;
+
+    Tensor out = tensor_empty(e->shape, (e->dtype >= 0) ? (DataType)e->dtype : DTYPE_F64);
+    if (out == NULL) return NULL;
+
+    if (!_eval_into(out, e, "lazy_eval"))
+    {
+        tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+bool
+lazy_eval_out(Tensor out, const LazyExpr e)
+{
+    if (e == NULL) return false;
+
+    const DataType dtype = (e->dtype >= 0) ? (DataType)e->dtype : tensor_get_dtype(out);
+    if (!_tensor_check_out(out, shape_get_dims(e->shape), shape_get_ndim(e->shape), dtype, "lazy_eval_out"))
+        return false;
+    if (e->float_only && dtype == DTYPE_I32)
+    {
+        fprintf(stderr, "Error: lazy_eval_out: exp/log/sqrt/rsqrt need a floating-point dtype.\n");
+        return false;
+    }
+    return _eval_into(out, e, "lazy_eval_out");
+}
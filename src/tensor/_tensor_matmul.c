@@ -0,0 +1,333 @@
+#include "tensor/_tensor_linalg.h"
+#include "tensor/_tensor_simd.h"
+#include "tensor/_shape.h"
+#include "utils/_malloc.h"
+#include "utils/_parallel.h"
+
+#include <stdatomic.h>
+#include <stdio.h>  // for fprintf()
+#include <stdlib.h> // for free()
+#include <string.h> // for memcpy(), memset()
+
+// GotoBLAS 式的分块：
+//   - C 按 MC x NC 切成宏块，每个宏块是一个并行任务；
+//   - K 按 KC 切片，每片把 A 的 MC x KC 块、B 的 KC x NC 块打包成连续的 panel；
+//   - panel 上由微内核计算 MR x NR 的寄存器块。
+// A 块 (MC x KC) 大致放在 L2，B 的一个 KC x NR 微 panel 放在 L1。
+#define GEMM_MR SIMD_GEMM_MR
+#define GEMM_KC 256
+#define GEMM_MC 96
+#define GEMM_NC_F32 1024
+#define GEMM_NC_F64 512
+#define GEMM_MAX_BATCH_DIMS 32
+
+#define _MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// 一次 (批量) 矩阵乘的全部参数；步长以元素为单位
+typedef struct
+{
+    const char* a;
+    const char* b;
+    char* c;
+    size_t m, n, k;
+    size_t rsa, csa;  // A 的行/列步长
+    size_t rsb, csb;  // B 的行/列步长
+
+    // 批量维：第 i 个批次的偏移由 batch_dims 展开得到
+    int nbatch_dims;
+    int batch_dims[GEMM_MAX_BATCH_DIMS];
+    size_t batch_stride_a[GEMM_MAX_BATCH_DIMS];
+    size_t batch_stride_b[GEMM_MAX_BATCH_DIMS];
+
+    size_t m_tiles, n_tiles; // 每个批次的宏块个数
+    SimdGemmFn kernel;       // 向量化微内核，可能为 NULL
+    atomic_bool failed;      // 某个任务分配打包缓冲区失败
+}
+GemmPlan;
+
+// 根据批次号算出 A、B 在各自数据里的元素偏移
+static void
+_batch_offsets(const GemmPlan* p, size_t batch, size_t* off_a, size_t* off_b)
+{
+    *off_a = 0;
+    *off_b = 0;
+    for (int i = p->nbatch_dims - 1; i >= 0; i--)
+    {
+        const size_t coord = batch % (size_t)p->batch_dims[i];
+        batch /= (size_t)p->batch_dims[i];
+        *off_a += coord * p->batch_stride_a[i];
+        *off_b += coord * p->batch_stride_b[i];
+    }
+}
+
+// 为每个浮点类型生成打包函数、标量微内核和宏块驱动
+#define _DEFINE_GEMM(SUFFIX, T, NR, NC) \
+\
+/* A[mc x kc] -> 每 MR 行一个 panel，panel 内按 k 排列；不足 MR 行补 0 */ \
+static void \
+_pack_a_##SUFFIX(T* dst, const T* a, size_t rs, size_t cs, size_t mc, size_t kc) \
+{ \
+    for (size_t i0 = 0; i0 < mc; i0 += GEMM_MR) \
+    { \
+        const size_t mr = _MIN(GEMM_MR, mc - i0); \
+        const T* src = a + i0 * rs; \
+        for (size_t k = 0; k < kc; k++, dst += GEMM_MR) \
+        { \
+            size_t i = 0; \
+            for (; i < mr; i++) dst[i] = src[i * rs + k * cs]; \
+            for (; i < GEMM_MR; i++) dst[i] = 0; \
+        } \
+    } \
+} \
+\
+/* B[kc x nc] -> 每 NR 列一个 panel，panel 内按 k 排列；不足 NR 列补 0 */ \
+static void \
+_pack_b_##SUFFIX(T* dst, const T* b, size_t rs, size_t cs, size_t kc, size_t nc) \
+{ \
+    for (size_t j0 = 0; j0 < nc; j0 += (NR)) \
+    { \
+        const size_t nr = _MIN((NR), nc - j0); \
+        const T* src = b + j0 * cs; \
+        for (size_t k = 0; k < kc; k++, dst += (NR)) \
+        { \
+            const T* row = src + k * rs; \
+            if (cs == 1 && nr == (NR)) \
+            { \
+                memcpy(dst, row, sizeof(T) * (NR)); \
+                continue; \
+            } \
+            size_t j = 0; \
+            for (; j < nr; j++) dst[j] = row[j * cs]; \
+            for (; j < (NR); j++) dst[j] = 0; \
+        } \
+    } \
+} \
+\
+/* 没有向量化内核时使用的通用微内核 */ \
+static void \
+_micro_##SUFFIX(size_t kc, const void* a, const void* b, void* c, size_t ldc) \
+{ \
+    const T* pa = (const T*)a; \
+    const T* pb = (const T*)b; \
+    T acc[GEMM_MR][NR] = { { 0 } }; \
+    for (size_t k = 0; k < kc; k++, pa += GEMM_MR, pb += (NR)) \
+        for (int i = 0; i < GEMM_MR; i++) \
+            for (int j = 0; j < (NR); j++) acc[i][j] += pa[i] * pb[j]; \
+    for (int i = 0; i < GEMM_MR; i++) \
+    { \
+        T* row = (T*)c + i * ldc; \
+        for (int j = 0; j < (NR); j++) row[j] += acc[i][j]; \
+    } \
+} \
+\
+/* 并行任务：处理宏块 [begin, end)，按 (批次, M 块, N 块) 编号 */ \
+static void \
+_gemm_tiles_##SUFFIX(size_t begin, size_t end, void* ctx) \
+{ \
+    GemmPlan* p = (GemmPlan*)ctx; \
+    const SimdGemmFn kernel = p->kernel != NULL ? p->kernel : _micro_##SUFFIX; \
+    const size_t kc_max = _MIN(GEMM_KC, p->k); \
+    const size_t mc_max = (_MIN(GEMM_MC, p->m) + GEMM_MR - 1) / GEMM_MR * GEMM_MR; \
+    const size_t nc_max = (_MIN((NC), p->n) + (NR) - 1) / (NR) * (NR); \
+    T* pack_a = safemalloc(sizeof(T) * mc_max * kc_max); \
+    T* pack_b = safemalloc(sizeof(T) * nc_max * kc_max); \
+    if (pack_a == NULL || pack_b == NULL) \
+    { \
+        atomic_store(&p->failed, true); \
+        free(pack_a); \
+        free(pack_b); \
+        return; \
+    } \
+    T edge[GEMM_MR * (NR)]; \
+    \
+    for (size_t t = begin; t < end; t++) \
+    { \
+        const size_t per_batch = p->m_tiles * p->n_tiles; \
+        const size_t batch = t / per_batch; \
+        const size_t ic = (t % per_batch) / p->n_tiles * GEMM_MC; \
+        const size_t jc = (t % per_batch) % p->n_tiles * (NC); \
+        const size_t mc = _MIN(GEMM_MC, p->m - ic); \
+        const size_t nc = _MIN((NC), p->n - jc); \
+        \
+        size_t off_a, off_b; \
+        _batch_offsets(p, batch, &off_a, &off_b); \
+        const T* a = (const T*)p->a + off_a + ic * p->rsa; \
+        const T* b = (const T*)p->b + off_b + jc * p->csb; \
+        T* c = (T*)p->c + batch * p->m * p->n + ic * p->n + jc; \
+        \
+        for (size_t pc = 0; pc < p->k; pc += GEMM_KC) \
+        { \
+            const size_t kc = _MIN(GEMM_KC, p->k - pc); \
+            _pack_b_##SUFFIX(pack_b, b + pc * p->rsb, p->rsb, p->csb, kc, nc); \
+            _pack_a_##SUFFIX(pack_a, a + pc * p->csa, p->rsa, p->csa, mc, kc); \
+            \
+            for (size_t jr = 0; jr < nc; jr += (NR)) \
+            { \
+                const size_t nr = _MIN((NR), nc - jr); \
+                const T* pb = pack_b + jr * kc; \
+                for (size_t ir = 0; ir < mc; ir += GEMM_MR) \
+                { \
+                    const size_t mr = _MIN(GEMM_MR, mc - ir); \
+                    const T* pa = pack_a + ir * kc; \
+                    T* cij = c + ir * p->n + jr; \
+                    if (mr == GEMM_MR && nr == (NR)) \
+                    { \
+                        kernel(kc, pa, pb, cij, p->n); \
+                        continue; \
+                    } \
+                    /* 边缘块：先算到临时缓冲区，再把有效部分加回 C */ \
+                    memset(edge, 0, sizeof(edge)); \
+                    kernel(kc, pa, pb, edge, (NR)); \
+                    for (size_t i = 0; i < mr; i++) \
+                        for (size_t j = 0; j < nr; j++) cij[i * p->n + j] += edge[i * (NR) + j]; \
+                } \
+            } \
+        } \
+    } \
+    free(pack_a); \
+    free(pack_b); \
+}
+
+_DEFINE_GEMM(f32, float, SIMD_GEMM_NR_F32, GEMM_NC_F32)
+_DEFINE_GEMM(f64, double, SIMD_GEMM_NR_F64, GEMM_NC_F64)
+
+// a: [..., M, K], b: [..., K, N]；min_ndim/max_ndim 限定两个操作数的维数
+static Tensor
+_matmul(const Tensor a, const Tensor b, int min_ndim, int max_ndim, const char* name)
+{
+    if (a == NULL || b == NULL) return NULL;
+
+    const DataType dtype = tensor_get_dtype(a);
+    if (dtype != tensor_get_dtype(b))
+    {
+        fprintf(stderr, "Error: %s requires both operands to have the same dtype.\n", name);
+        return NULL;
+    }
+    if (dtype != DTYPE_F32 && dtype != DTYPE_F64)
+    {
+        fprintf(stderr, "Error: %s supports only DTYPE_F32 and DTYPE_F64.\n", name);
+        return NULL;
+    }
+
+    const int nda = tensor_get_ndim(a);
+    const int ndb = tensor_get_ndim(b);
+    if (nda < min_ndim || nda > max_ndim || ndb < min_ndim || ndb > max_ndim)
+    {
+        fprintf(stderr, "Error: %s got operands with %d and %d dimensions.\n", name, nda, ndb);
+        return NULL;
+    }
+
+    const int* dims_a = shape_get_dims(tensor_get_shape(a));
+    const int* dims_b = shape_get_dims(tensor_get_shape(b));
+    const int m = dims_a[nda - 2], k = dims_a[nda - 1];
+    const int n = dims_b[ndb - 1];
+    if (dims_b[ndb - 2] != k)
+    {
+        fprintf(stderr, "Error: %s inner dimensions do not match (%d vs %d).\n", name, k, dims_b[ndb - 2]);
+        return NULL;
+    }
+
+    // 1. 广播批量维，得到输出形状 [batch..., M, N]
+    Shape batch_a = shape_create(dims_a, nda - 2);
+    Shape batch_b = shape_create(dims_b, ndb - 2);
+    Shape batch = shape_broadcast(batch_a, batch_b);
+    shape_free(batch_a);
+    shape_free(batch_b);
+    if (batch == NULL) return NULL;
+
+    const int nbatch = shape_get_ndim(batch);
+    if (nbatch > GEMM_MAX_BATCH_DIMS)
+    {
+        fprintf(stderr, "Error: %s supports at most %d batch dimensions.\n", name, GEMM_MAX_BATCH_DIMS);
+        shape_free(batch);
+        return NULL;
+    }
+
+    int target[GEMM_MAX_BATCH_DIMS + 2];
+    memcpy(target, shape_get_dims(batch), sizeof(int) * nbatch);
+    shape_free(batch);
+
+    // 2. 把两个操作数展开到完整的批量形状上（广播维的步长为 0）
+    target[nbatch] = m;
+    target[nbatch + 1] = k;
+    Shape target_a = shape_create(target, nbatch + 2);
+    Shape view_a = shape_expand(tensor_get_shape(a), target_a);
+    target[nbatch] = k;
+    target[nbatch + 1] = n;
+    Shape target_b = shape_create(target, nbatch + 2);
+    Shape view_b = shape_expand(tensor_get_shape(b), target_b);
+    target[nbatch] = m;
+    Shape out_shape = shape_create(target, nbatch + 2);
+    shape_free(target_a);
+    shape_free(target_b);
+
+    Tensor out = (view_a && view_b && out_shape) ? tensor_create(out_shape, dtype) : NULL;
+    if (out == NULL)
+    {
+        shape_free(view_a);
+        shape_free(view_b);
+        shape_free(out_shape);
+        return NULL;
+    }
+
+    const size_t* sa = shape_get_strides(view_a);
+    const size_t* sb = shape_get_strides(view_b);
+
+    GemmPlan plan;
+    plan.a = tensor_get_data_const(a);
+    plan.b = tensor_get_data_const(b);
+    plan.c = _tensor_get_data(out);
+    plan.m = (size_t)m;
+    plan.n = (size_t)n;
+    plan.k = (size_t)k;
+    plan.rsa = sa[nbatch];
+    plan.csa = sa[nbatch + 1];
+    plan.rsb = sb[nbatch];
+    plan.csb = sb[nbatch + 1];
+    plan.nbatch_dims = nbatch;
+    size_t batches = 1;
+    for (int i = 0; i < nbatch; i++)
+    {
+        plan.batch_dims[i] = target[i];
+        plan.batch_stride_a[i] = sa[i];
+        plan.batch_stride_b[i] = sb[i];
+        batches *= (size_t)target[i];
+    }
+    shape_free(view_a);
+    shape_free(view_b);
+    shape_free(out_shape);
+
+    // K == 0 时结果就是全 0，tensor_create 已经清零
+    if (plan.m == 0 || plan.n == 0 || plan.k == 0 || batches == 0) return out;
+
+    plan.kernel = simd_get_kernels()->gemm[dtype];
+    atomic_init(&plan.failed, false);
+    plan.m_tiles = (plan.m + GEMM_MC - 1) / GEMM_MC;
+    const size_t nc = (dtype == DTYPE_F32) ? GEMM_NC_F32 : GEMM_NC_F64;
+    plan.n_tiles = (plan.n + nc - 1) / nc;
+
+    const size_t tiles = batches * plan.m_tiles * plan.n_tiles;
+    if (dtype == DTYPE_F32)
+        parallel_for(0, tiles, 1, _gemm_tiles_f32, &plan);
+    else
+        parallel_for(0, tiles, 1, _gemm_tiles_f64, &plan);
+
+    if (atomic_load(&plan.failed))
+    {
+        tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+Tensor
+tensor_matmul(const Tensor a, const Tensor b)
+{
+    return _matmul(a, b, 2, 2, "tensor_matmul");
+}
+
+Tensor
+tensor_bmm(const Tensor a, const Tensor b)
+{
+    return _matmul(a, b, 2, GEMM_MAX_BATCH_DIMS + 2, "tensor_bmm");
+}
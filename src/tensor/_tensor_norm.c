@@ -0,0 +1,601 @@
+#include "tensor/_tensor_ops.h"
+#include "tensor/_tensor_iter.h"
+#include "tensor/_tensor_simd.h"
+#include "tensor/_shape.h"
+#include "utils/_malloc.h"
+#include "utils/_parallel.h"
+
+#include <math.h>   // for exp(), log(), sqrt(), INFINITY
+#include <stdatomic.h>
+#include <stdio.h>  // for fprintf()
+#include <stdlib.h> // for free()
+#include <string.h> // for memcpy()
+
+// 行模式的分块大小（元素）：在线算法每块更新一次最大值，块在第二次读时还在 L1 里
+#define NORM_BLOCK 2048
+// 列模式一次处理的相邻位置个数：每个位置的最大值、和留在栈上
+#define NORM_COLUMN_TILE 64
+// 列模式的输出不连续时，攒够这么多行再写出
+#define NORM_STAGE_ROWS 16
+
+typedef enum
+{
+    NORM_SOFTMAX,
+    NORM_LOG_SOFTMAX,
+    NORM_LAYER
+}
+NormOp;
+
+typedef struct
+{
+    NormOp op;
+    DataType dtype;        // 输入 / 输出的 dtype
+    DataType compute;      // 计算用的 dtype：F32 或 F64
+    size_t item_size;
+    size_t compute_size;
+    size_t n;              // 规约轴的长度
+    size_t in_axis;        // 规约轴上的步长（字节）
+    size_t out_axis;
+    TensorIter lanes;      // 操作数: in, out —— 遍历规约轴以外的位置
+    const void* weight;    // layer_norm：计算类型的连续数组，可能为 NULL
+    const void* bias;
+    double eps;
+    const SimdKernelTable* kernels;
+    atomic_bool failed;    // 工作缓冲区分配失败
+}
+NormTask;
+
+// --- 连续行上的基本运算：优先用向量内核，表里没有时（标量表）退回普通循环 ---
+
+#define _NORM_APPLY_LOOP(T) \
+    do { \
+        T* o = (T*)out; \
+        const T* x = (const T*)a; \
+        const T* y = (const T*)b; \
+        const size_t step = (layout == SIMD_LAYOUT_VS) ? 0 : 1; \
+        for (size_t i = 0; i < n; i++) \
+        { \
+            const T l = x[i], r = y[i * step]; \
+            switch (op) \
+            { \
+                case BINARY_OP_ADD: o[i] = l + r; break; \
+                case BINARY_OP_SUB: o[i] = l - r; break; \
+                case BINARY_OP_MUL: o[i] = l * r; break; \
+                default: o[i] = (l > r ? l : r); break; \
+            } \
+        } \
+    } while (0)
+
+// out = a op b（ADD / SUB / MUL / MAX），b 按 layout 是一个标量或一整行
+static void
+_norm_apply(const NormTask* task, BinaryOp op, SimdLayout layout, void* out, const void* a, const void* b, size_t n)
+{
+    const SimdBinaryFn fn = task->kernels->binary[op][task->compute][layout];
+    if (fn != NULL)
+        fn(out, a, b, n);
+    else if (task->compute == DTYPE_F32)
+        _NORM_APPLY_LOOP(float);
+    else
+        _NORM_APPLY_LOOP(double);
+}
+
+// out = a op value
+static void
+_norm_apply_scalar(const NormTask* task, BinaryOp op, void* out, const void* a, double value, size_t n)
+{
+    const float value32 = (float)value;
+    const void* b = (task->compute == DTYPE_F32) ? (const void*)&value32 : (const void*)&value;
+    _norm_apply(task, op, SIMD_LAYOUT_VS, out, a, b, n);
+}
+
+static double
+_row_max(const NormTask* task, const void* x, size_t n)
+{
+    const SimdReduceFn fn = task->kernels->reduce[SIMD_REDUCE_MAX][task->compute];
+    if (task->compute == DTYPE_F32)
+    {
+        float best = -INFINITY;
+        if (fn != NULL) fn(x, n, &best);
+        else for (size_t i = 0; i < n; i++) best = (best > ((const float*)x)[i]) ? best : ((const float*)x)[i];
+        return best;
+    }
+    double best = -INFINITY;
+    if (fn != NULL) fn(x, n, &best);
+    else for (size_t i = 0; i < n; i++) best = (best > ((const double*)x)[i]) ? best : ((const double*)x)[i];
+    return best;
+}
+
+// 一行 softmax / log_softmax：第一遍在线求最大值 m 和 sum(exp(x - m))，第二遍写结果
+static void
+_softmax_row(const NormTask* task, void* y, const void* x)
+{
+    const size_t n = task->n, size = task->compute_size;
+    const SimdExpFn exp_fn = task->kernels->exp[task->compute];
+    double m = -INFINITY, s = 0.0;
+    for (size_t start = 0; start < n; start += NORM_BLOCK)
+    {
+        const size_t len = (n - start < NORM_BLOCK) ? n - start : NORM_BLOCK;
+        const char* block = (const char*)x + start * size;
+        const double bm = _row_max(task, block, len);
+        if (bm == -INFINITY) continue; // 整块都是 -inf，贡献为 0
+        if (bm > m)
+        {
+            s *= exp(m - bm); // 最大值变大了：已有的和按新的最大值缩放
+            m = bm;
+        }
+        s += exp_fn(NULL, block, len, m, 1.0);
+    }
+    // 整行都是 -inf 时 m 仍为 -inf，结果是 NaN（与 0 / 0 一致）
+
+    if (task->op == NORM_SOFTMAX)
+        exp_fn(y, x, n, m, 1.0 / s);
+    else
+        _norm_apply_scalar(task, BINARY_OP_SUB, y, x, m + log(s), n);
+}
+
+// 一行 layer_norm：一遍求均值和方差，第二遍分块做 (x - mean) * rstd * w + b，块留在 L1 里
+static void
+_layer_norm_row(const NormTask* task, void* y, const void* x)
+{
+    const size_t n = task->n, size = task->compute_size;
+    double mean, m2;
+    task->kernels->moments[task->compute](x, n, &mean, &m2);
+    const double rstd = 1.0 / sqrt(m2 / (double)n + task->eps);
+
+    for (size_t start = 0; start < n; start += NORM_BLOCK)
+    {
+        const size_t len = (n - start < NORM_BLOCK) ? n - start : NORM_BLOCK;
+        char* yb = (char*)y + start * size;
+        _norm_apply_scalar(task, BINARY_OP_SUB, yb, (const char*)x + start * size, mean, len);
+        _norm_apply_scalar(task, BINARY_OP_MUL, yb, yb, rstd, len);
+        if (task->weight != NULL)
+            _norm_apply(task, BINARY_OP_MUL, SIMD_LAYOUT_VV, yb, yb, (const char*)task->weight + start * size, len);
+        if (task->bias != NULL)
+            _norm_apply(task, BINARY_OP_ADD, SIMD_LAYOUT_VV, yb, yb, (const char*)task->bias + start * size, len);
+    }
+}
+
+// --- 跨步读写：窄类型顺便转换成计算类型 ---
+
+static void
+_load_strided(DataType dtype, size_t compute_size, void* dst, const char* src, size_t n, size_t stride)
+{
+    if (dtype == DTYPE_F16 || dtype == DTYPE_BF16)
+    {
+        simd_widen(dtype, dst, src, n, stride);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) memcpy((char*)dst + i * compute_size, src + i * stride, compute_size);
+}
+
+static void
+_store_strided(DataType dtype, size_t compute_size, char* dst, size_t stride, const void* src, size_t n)
+{
+    if (dtype == DTYPE_F16 || dtype == DTYPE_BF16)
+    {
+        simd_narrow(dtype, dst, stride, src, n);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) memcpy(dst + i * stride, (const char*)src + i * compute_size, compute_size);
+}
+
+// 行模式：规约轴在输入/输出中连续、类型也不用转换时直接在原地计算，否则经过 buf
+static void
+_norm_lane(const NormTask* task, char* out, const char* in, void* buf)
+{
+    const bool same_type = task->dtype == task->compute;
+    const void* x = in;
+    if (!same_type || task->in_axis != task->item_size)
+    {
+        _load_strided(task->dtype, task->compute_size, buf, in, task->n, task->in_axis);
+        x = buf;
+    }
+    const bool direct_out = same_type && task->out_axis == task->item_size;
+    void* y = direct_out ? (void*)out : buf;
+
+    if (task->op == NORM_LAYER) _layer_norm_row(task, y, x);
+    else _softmax_row(task, y, x);
+
+    if (!direct_out) _store_strided(task->dtype, task->compute_size, out, task->out_axis, buf, task->n);
+}
+
+// --- 列模式 ---
+// 相邻的 w 个位置在输入中连续，而规约轴不连续（例如对行主序矩阵的第 0 维做 softmax）。
+// 沿规约轴一行一行地扫，每行是 w 个连续元素，w 个位置的统计量用同样的向量内核一起更新；
+// 和在计算类型里累加，每 NORM_BLOCK 行并入 double。
+// 写出的每个元素只依赖同一位置已经读过的输入，所以可以原地计算。
+
+static void
+_columns_fill(const NormTask* task, void* dst, double value, size_t w)
+{
+    for (size_t j = 0; j < w; j++)
+    {
+        if (task->compute == DTYPE_F32) ((float*)dst)[j] = (float)value;
+        else ((double*)dst)[j] = value;
+    }
+}
+
+// total += part，然后把 part 清零
+static void
+_columns_fold(const NormTask* task, double* total, void* part, size_t w)
+{
+    for (size_t j = 0; j < w; j++)
+    {
+        if (task->compute == DTYPE_F32) total[j] += ((float*)part)[j];
+        else total[j] += ((double*)part)[j];
+    }
+    _columns_fill(task, part, 0.0, w);
+}
+
+static double
+_columns_get(const NormTask* task, const void* src, size_t j)
+{
+    return (task->compute == DTYPE_F32) ? ((const float*)src)[j] : ((const double*)src)[j];
+}
+
+// 列模式的输出：输出行连续时直接写；否则（例如输入是转置视图）先在 stage 里攒 NORM_STAGE_ROWS 行，
+// 再按位置写出，每个位置一次写一小段连续内存，而不是每个元素各落在输出的不同行上
+typedef struct
+{
+    char* out;
+    size_t out_lane;
+    size_t first;   // stage 第一行对应的规约轴位置
+    size_t rows;    // stage 里已有的行数
+    _Alignas(64) char stage[NORM_STAGE_ROWS * NORM_COLUMN_TILE * sizeof(double)];
+}
+ColumnSink;
+
+static void
+_sink_flush(const NormTask* task, ColumnSink* sink, size_t w)
+{
+    const size_t oa = task->out_axis;
+    for (size_t j = 0; j < w; j++)
+    {
+        char* o = sink->out + j * sink->out_lane + sink->first * oa;
+        if (task->compute == DTYPE_F32)
+            for (size_t k = 0; k < sink->rows; k++) *(float*)(o + k * oa) = ((const float*)sink->stage)[k * NORM_COLUMN_TILE + j];
+        else
+            for (size_t k = 0; k < sink->rows; k++) *(double*)(o + k * oa) = ((const double*)sink->stage)[k * NORM_COLUMN_TILE + j];
+    }
+    sink->first += sink->rows;
+    sink->rows = 0;
+}
+
+// 写出规约轴位置 r 上的 w 个结果（r 依次递增）
+static void
+_sink_row(const NormTask* task, ColumnSink* sink, size_t r, const void* e, size_t w)
+{
+    const size_t size = task->compute_size;
+    if (sink->out_lane == size)
+    {
+        memcpy(sink->out + r * task->out_axis, e, w * size);
+        return;
+    }
+    memcpy(sink->stage + sink->rows * NORM_COLUMN_TILE * size, e, w * size);
+    if (++sink->rows == NORM_STAGE_ROWS) _sink_flush(task, sink, w);
+}
+
+static void
+_norm_columns(const NormTask* task, char* out, size_t out_lane, const char* in, size_t w)
+{
+    const size_t n = task->n, ia = task->in_axis, oa = task->out_axis, size = task->compute_size;
+    _Alignas(64) char center[NORM_COLUMN_TILE * sizeof(double)]; // softmax: 最大值；layer_norm: 均值
+    _Alignas(64) char scale[NORM_COLUMN_TILE * sizeof(double)];
+    _Alignas(64) char part[NORM_COLUMN_TILE * sizeof(double)];   // 部分和
+    _Alignas(64) char e[NORM_COLUMN_TILE * sizeof(double)];
+    double total[NORM_COLUMN_TILE];
+    for (size_t j = 0; j < w; j++) total[j] = 0.0;
+    _columns_fill(task, part, 0.0, w);
+    ColumnSink sink;
+    sink.out = out;
+    sink.out_lane = out_lane;
+    sink.first = sink.rows = 0;
+    const bool direct = out_lane == size;
+
+    if (task->op == NORM_LAYER)
+    {
+        for (size_t r = 0; r < n; r++)
+        {
+            _norm_apply(task, BINARY_OP_ADD, SIMD_LAYOUT_VV, part, part, in + r * ia, w);
+            if ((r + 1) % NORM_BLOCK == 0) _columns_fold(task, total, part, w);
+        }
+        _columns_fold(task, total, part, w);
+        double mean[NORM_COLUMN_TILE];
+        for (size_t j = 0; j < w; j++)
+        {
+            mean[j] = total[j] / (double)n;
+            total[j] = 0.0;
+        }
+        for (size_t j = 0; j < w; j++)
+        {
+            if (task->compute == DTYPE_F32) ((float*)center)[j] = (float)mean[j];
+            else ((double*)center)[j] = mean[j];
+        }
+
+        // 以 center（均值舍入到计算类型）为中心累加平方偏差，再修正舍入的差
+        for (size_t r = 0; r < n; r++)
+        {
+            _norm_apply(task, BINARY_OP_SUB, SIMD_LAYOUT_VV, e, in + r * ia, center, w);
+            _norm_apply(task, BINARY_OP_MUL, SIMD_LAYOUT_VV, e, e, e, w);
+            _norm_apply(task, BINARY_OP_ADD, SIMD_LAYOUT_VV, part, part, e, w);
+            if ((r + 1) % NORM_BLOCK == 0) _columns_fold(task, total, part, w);
+        }
+        _columns_fold(task, total, part, w);
+        for (size_t j = 0; j < w; j++)
+        {
+            const double shift = mean[j] - _columns_get(task, center, j);
+            const double var = total[j] / (double)n - shift * shift;
+            const double rstd = 1.0 / sqrt(((var > 0.0) ? var : 0.0) + task->eps);
+            if (task->compute == DTYPE_F32) ((float*)scale)[j] = (float)rstd;
+            else ((double*)scale)[j] = rstd;
+        }
+
+        for (size_t r = 0; r < n; r++)
+        {
+            _norm_apply(task, BINARY_OP_SUB, SIMD_LAYOUT_VV, e, in + r * ia, center, w);
+            _norm_apply(task, BINARY_OP_MUL, SIMD_LAYOUT_VV, e, e, scale, w);
+            if (task->weight != NULL)
+                _norm_apply(task, BINARY_OP_MUL, SIMD_LAYOUT_VS, e, e, (const char*)task->weight + r * size, w);
+            if (task->bias != NULL)
+                _norm_apply(task, BINARY_OP_ADD, SIMD_LAYOUT_VS, e, e, (const char*)task->bias + r * size, w);
+            _sink_row(task, &sink, r, e, w);
+        }
+        _sink_flush(task, &sink, w);
+        return;
+    }
+
+    const SimdExpFn exp_fn = task->kernels->exp[task->compute];
+    _columns_fill(task, center, -INFINITY, w);
+    for (size_t r = 0; r < n; r++)
+        _norm_apply(task, BINARY_OP_MAX, SIMD_LAYOUT_VV, center, center, in + r * ia, w);
+
+    for (size_t r = 0; r < n; r++)
+    {
+        _norm_apply(task, BINARY_OP_SUB, SIMD_LAYOUT_VV, e, in + r * ia, center, w);
+        exp_fn(e, e, w, 0.0, 1.0);
+        _norm_apply(task, BINARY_OP_ADD, SIMD_LAYOUT_VV, part, part, e, w);
+        if ((r + 1) % NORM_BLOCK == 0) _columns_fold(task, total, part, w);
+        if (task->op == NORM_SOFTMAX && direct) memcpy(out + r * oa, e, w * size); // 第三遍原地乘 1 / sum
+    }
+    _columns_fold(task, total, part, w);
+
+    // softmax: 乘以 1 / sum；log_softmax: 减去 max + log(sum)
+    for (size_t j = 0; j < w; j++)
+    {
+        const double c = (task->op == NORM_SOFTMAX) ? 1.0 / total[j] : _columns_get(task, center, j) + log(total[j]);
+        if (task->compute == DTYPE_F32) ((float*)scale)[j] = (float)c;
+        else ((double*)scale)[j] = c;
+    }
+    for (size_t r = 0; r < n; r++)
+    {
+        if (task->op == NORM_LOG_SOFTMAX)
+        {
+            _norm_apply(task, BINARY_OP_SUB, SIMD_LAYOUT_VV, e, in + r * ia, scale, w);
+        }
+        else if (direct)
+        {
+            _norm_apply(task, BINARY_OP_MUL, SIMD_LAYOUT_VV, out + r * oa, out + r * oa, scale, w);
+            continue;
+        }
+        else // 第二遍没有写出，这里重新计算 exp
+        {
+            _norm_apply(task, BINARY_OP_SUB, SIMD_LAYOUT_VV, e, in + r * ia, center, w);
+            exp_fn(e, e, w, 0.0, 1.0);
+            _norm_apply(task, BINARY_OP_MUL, SIMD_LAYOUT_VV, e, e, scale, w);
+        }
+        _sink_row(task, &sink, r, e, w);
+    }
+    _sink_flush(task, &sink, w);
+}
+
+static void
+_norm_worker(size_t begin, size_t end, void* ctx)
+{
+    NormTask* task = (NormTask*)ctx;
+    TensorIter it = task->lanes;
+    void* buf = NULL; // 行模式的工作缓冲区，第一次用到时再分配
+
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+    {
+        const size_t in_lane = it.inner_strides[0], out_lane = it.inner_strides[1];
+        const bool columns = task->dtype == task->compute && task->in_axis != task->item_size &&
+                             in_lane == task->item_size && it.inner_size > 1;
+        if (columns)
+        {
+            for (size_t j = 0; j < it.inner_size; j += NORM_COLUMN_TILE)
+            {
+                const size_t w = (it.inner_size - j < NORM_COLUMN_TILE) ? it.inner_size - j : NORM_COLUMN_TILE;
+                char* out = it.ptrs[1] + j * out_lane;
+                const char* in = it.ptrs[0] + j * in_lane;
+                _norm_columns(task, out, out_lane, in, w);
+            }
+            continue;
+        }
+
+        if (buf == NULL && (task->dtype != task->compute || task->in_axis != task->item_size || task->out_axis != task->item_size))
+        {
+            buf = safemalloc(task->n * task->compute_size);
+            if (buf == NULL)
+            {
+                atomic_store(&task->failed, true);
+                return;
+            }
+        }
+        for (size_t i = 0; i < it.inner_size; i++)
+            _norm_lane(task, it.ptrs[1] + i * out_lane, it.ptrs[0] + i * in_lane, buf);
+    }
+    free(buf);
+}
+
+// weight / bias：1-D、与输入同一 dtype、长度等于规约轴
+static bool
+_check_param(const Tensor p, DataType dtype, size_t n, const char* what, const char* name)
+{
+    if (p == NULL) return true;
+    if (tensor_get_ndim(p) != 1 || (size_t)tensor_get_dim(p, 0) != n || tensor_get_dtype(p) != dtype)
+    {
+        fprintf(stderr, "Error: %s: %s must be a 1-D tensor of %zu elements with the input's dtype.\n", name, what, n);
+        return false;
+    }
+    return true;
+}
+
+static Tensor
+_normalize(Tensor out, const Tensor t, int axis, NormOp op, const Tensor weight, const Tensor bias, double eps, const char* name)
+{
+    if (t == NULL) return NULL;
+
+    // 1. 检查参数
+    const int ndim = tensor_get_ndim(t);
+    if (axis < 0 || axis >= ndim)
+    {
+        fprintf(stderr, "Error: axis %d is out of bounds for tensor of dimension %d\n", axis, ndim);
+        return NULL;
+    }
+    if (ndim > TENSOR_ITER_MAX_DIMS)
+    {
+        fprintf(stderr, "Error: %s supports at most %d dimensions.\n", name, TENSOR_ITER_MAX_DIMS);
+        return NULL;
+    }
+    const DataType dtype = tensor_get_dtype(t);
+    if (dtype != DTYPE_F32 && dtype != DTYPE_F64 && dtype != DTYPE_F16 && dtype != DTYPE_BF16)
+    {
+        fprintf(stderr, "Error: %s supports only floating-point dtypes.\n", name);
+        return NULL;
+    }
+    const size_t n = (size_t)tensor_get_dim(t, axis);
+    if (op == NORM_LAYER)
+    {
+        if (!(eps >= 0.0))
+        {
+            fprintf(stderr, "Error: %s: eps must be non-negative.\n", name);
+            return NULL;
+        }
+        if (!_check_param(weight, dtype, n, "weight", name) || !_check_param(bias, dtype, n, "bias", name)) return NULL;
+    }
+
+    // 2. 创建或检查输出
+    const Shape shape = tensor_get_shape(t);
+    const int* dims = shape_get_dims(shape);
+    const bool owned = out == NULL;
+    if (owned)
+    {
+        out = tensor_empty(shape, dtype);
+        if (out == NULL) return NULL;
+    }
+    else if (!_tensor_check_out(out, dims, ndim, dtype, name))
+    {
+        return NULL;
+    }
+
+    // 先拿可写指针（可能触发写时复制），再检查输入是否与它重叠；布局完全相同时可以原地计算
+    void* out_data = _tensor_get_data(out);
+    if (out_data == NULL || !_tensor_out_alias_ok(out, out_data, t, shape))
+    {
+        if (out_data != NULL) fprintf(stderr, "Error: %s: the input partially overlaps the output.\n", name);
+        if (owned) tensor_free(out);
+        return NULL;
+    }
+    if (tensor_get_elements_count(t) == 0) return out;
+
+    // 3. 建立任务
+    NormTask task;
+    task.op = op;
+    task.dtype = dtype;
+    task.compute = simd_compute_dtype(dtype);
+    task.item_size = tensor_get_item_size(t);
+    task.compute_size = tensor_dtype_size(task.compute);
+    task.n = n;
+    task.in_axis = tensor_get_strides(t)[axis] * task.item_size;
+    task.out_axis = tensor_get_strides(out)[axis] * task.item_size;
+    task.eps = eps;
+    task.kernels = simd_get_kernels();
+    task.weight = task.bias = NULL;
+    atomic_init(&task.failed, false);
+
+    // weight / bias 先转换成计算类型的连续数组
+    void* params = NULL;
+    if (op == NORM_LAYER && (weight != NULL || bias != NULL))
+    {
+        params = safemalloc(2 * n * task.compute_size);
+        if (params == NULL)
+        {
+            if (owned) tensor_free(out);
+            return NULL;
+        }
+        char* w = (char*)params;
+        char* b = w + n * task.compute_size;
+        if (weight != NULL)
+        {
+            _load_strided(dtype, task.compute_size, w, tensor_get_data_const(weight), n, tensor_get_strides(weight)[0] * task.item_size);
+            task.weight = w;
+        }
+        if (bias != NULL)
+        {
+            _load_strided(dtype, task.compute_size, b, tensor_get_data_const(bias), n, tensor_get_strides(bias)[0] * task.item_size);
+            task.bias = b;
+        }
+    }
+
+    // 规约轴以外的位置：把规约轴的长度当成 1，迭代器会跳过它
+    int lane_dims[TENSOR_ITER_MAX_DIMS];
+    memcpy(lane_dims, dims, sizeof(int) * ndim);
+    lane_dims[axis] = 1;
+    void* data[2] = { (void*)tensor_get_data_const(t), out_data };
+    const size_t* strides[2] = { tensor_get_strides(t), tensor_get_strides(out) };
+    const size_t item_sizes[2] = { task.item_size, task.item_size };
+    bool ok = tensor_iter_init_strided(&task.lanes, 2, data, strides, item_sizes, lane_dims, ndim);
+
+    if (ok)
+    {
+        parallel_for(0, task.lanes.size, parallel_grain(2 * n * task.item_size), _norm_worker, &task);
+        ok = !atomic_load(&task.failed);
+    }
+    free(params);
+    if (!ok)
+    {
+        if (owned) tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+Tensor
+tensor_softmax(const Tensor t, int axis)
+{
+    return _normalize(NULL, t, axis, NORM_SOFTMAX, NULL, NULL, 0.0, "tensor_softmax");
+}
+
+Tensor
+tensor_log_softmax(const Tensor t, int axis)
+{
+    return _normalize(NULL, t, axis, NORM_LOG_SOFTMAX, NULL, NULL, 0.0, "tensor_log_softmax");
+}
+
+Tensor
+tensor_layer_norm(const Tensor t, int axis, const Tensor weight, const Tensor bias, double eps)
+{
+    return _normalize(NULL, t, axis, NORM_LAYER, weight, bias, eps, "tensor_layer_norm");
+}
+
+bool
+tensor_softmax_out(Tensor out, const Tensor t, int axis)
+{
+    if (out == NULL) return false;
+    return _normalize(out, t, axis, NORM_SOFTMAX, NULL, NULL, 0.0, "tensor_softmax_out") != NULL;
+}
+
+bool
+tensor_log_softmax_out(Tensor out, const Tensor t, int axis)
+{
+    if (out == NULL) return false;
+    return _normalize(out, t, axis, NORM_LOG_SOFTMAX, NULL, NULL, 0.0, "tensor_log_softmax_out") != NULL;
+}
+
+bool
+tensor_layer_norm_out(Tensor out, const Tensor t, int axis, const Tensor weight, const Tensor bias, double eps)
+{
+    if (out == NULL) return false;
+    return _normalize(out, t, axis, NORM_LAYER, weight, bias, eps, "tensor_layer_norm_out") != NULL;
+}
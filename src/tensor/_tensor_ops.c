@@ -0,0 +1,284 @@
+#include "tensor/_tensor_ops.h"
+#include "tensor/_tensor_iter.h"
+#include "tensor/_tensor_simd.h"
+#include "tensor/_shape.h"
+#include "utils/_parallel.h"
+
+#include <stdint.h> // for int32_t, uint32_t
+#include <stdio.h>  // for fprintf()
+
+// 一段 run 上的二元内核：n 个元素，步长以字节为单位（0 表示广播）
+typedef void (*BinaryKernel)(char* out, const char* a, const char* b, size_t n,
+                             size_t so, size_t sa, size_t sb);
+
+// 为每个 (op, dtype) 生成一个内核。快速路径：
+//   1. 三者都连续               —— 典型的同形状运算、行广播的内层
+//   2. 右操作数是标量 (sb == 0)  —— 标量广播、列广播的内层
+//   3. 左操作数是标量 (sa == 0)
+// 其余情况退回通用的跨步循环。
+#define _DEFINE_BINARY_KERNEL(name, T, EXPR) \
+static void \
+name(char* out, const char* a, const char* b, size_t n, size_t so, size_t sa, size_t sb) \
+{ \
+    T* o = (T*)out; \
+    const T* x = (const T*)a; \
+    const T* y = (const T*)b; \
+    if (so == sizeof(T) && sa == sizeof(T) && sb == sizeof(T)) \
+    { \
+        for (size_t i = 0; i < n; i++) { const T l = x[i], r = y[i]; o[i] = (EXPR); } \
+    } \
+    else if (so == sizeof(T) && sa == sizeof(T) && sb == 0) \
+    { \
+        const T r = y[0]; \
+        for (size_t i = 0; i < n; i++) { const T l = x[i]; o[i] = (EXPR); } \
+    } \
+    else if (so == sizeof(T) && sa == 0 && sb == sizeof(T)) \
+    { \
+        const T l = x[0]; \
+        for (size_t i = 0; i < n; i++) { const T r = y[i]; o[i] = (EXPR); } \
+    } \
+    else \
+    { \
+        for (size_t i = 0; i < n; i++) \
+        { \
+            const T l = *(const T*)(a + i * sa), r = *(const T*)(b + i * sb); \
+            *(T*)(out + i * so) = (EXPR); \
+        } \
+    } \
+}
+
+// 整数除法：向零截断；除数为 0 时结果为 0，INT32_MIN / -1 按补码回绕，避免 SIGFPE
+#define _I32_DIV(l, r) ((r) == 0 ? 0 : ((r) == -1 ? (int32_t)(0u - (uint32_t)(l)) : (l) / (r)))
+
+#define _DEFINE_BINARY_KERNELS(suffix, T) \
+    _DEFINE_BINARY_KERNEL(_add_##suffix, T, l + r) \
+    _DEFINE_BINARY_KERNEL(_sub_##suffix, T, l - r) \
+    _DEFINE_BINARY_KERNEL(_mul_##suffix, T, l * r) \
+    _DEFINE_BINARY_KERNEL(_max_##suffix, T, (l > r ? l : r)) \
+    _DEFINE_BINARY_KERNEL(_min_##suffix, T, (l < r ? l : r))
+
+// 整数加减乘经 uint32_t 计算，溢出时按补码回绕，与 SIMD 内核一致
+_DEFINE_BINARY_KERNEL(_add_i32, int32_t, (int32_t)((uint32_t)l + (uint32_t)r))
+_DEFINE_BINARY_KERNEL(_sub_i32, int32_t, (int32_t)((uint32_t)l - (uint32_t)r))
+_DEFINE_BINARY_KERNEL(_mul_i32, int32_t, (int32_t)((uint32_t)l * (uint32_t)r))
+_DEFINE_BINARY_KERNEL(_max_i32, int32_t, (l > r ? l : r))
+_DEFINE_BINARY_KERNEL(_min_i32, int32_t, (l < r ? l : r))
+_DEFINE_BINARY_KERNELS(f32, float)
+_DEFINE_BINARY_KERNELS(f64, double)
+_DEFINE_BINARY_KERNEL(_div_i32, int32_t, _I32_DIV(l, r))
+_DEFINE_BINARY_KERNEL(_div_f32, float, l / r)
+_DEFINE_BINARY_KERNEL(_div_f64, double, l / r)
+
+// 按 [op][dtype] 索引，dtype 顺序与 DataType 枚举一致
+static const BinaryKernel _binary_kernels[BINARY_OP_COUNT][3] =
+{
+    [BINARY_OP_ADD] = { _add_i32, _add_f32, _add_f64 },
+    [BINARY_OP_SUB] = { _sub_i32, _sub_f32, _sub_f64 },
+    [BINARY_OP_MUL] = { _mul_i32, _mul_f32, _mul_f64 },
+    [BINARY_OP_DIV] = { _div_i32, _div_f32, _div_f64 },
+    [BINARY_OP_MAX] = { _max_i32, _max_f32, _max_f64 },
+    [BINARY_OP_MIN] = { _min_i32, _min_f32, _min_f64 },
+};
+
+// 处理一段 run：连续或单侧标量的布局优先走向量化内核，缺失时退回标量内核
+static void
+_binary_run(BinaryKernel kernel, const SimdBinaryFn* simd, size_t item_size,
+            char* out, const char* a, const char* b, size_t n,
+            size_t so, size_t sa, size_t sb)
+{
+    if (so == item_size)
+    {
+        SimdLayout layout = SIMD_LAYOUT_COUNT;
+        if (sa == item_size && sb == item_size) layout = SIMD_LAYOUT_VV;
+        else if (sa == item_size && sb == 0)    layout = SIMD_LAYOUT_VS;
+        else if (sa == 0 && sb == item_size)    layout = SIMD_LAYOUT_SV;
+
+        if (layout != SIMD_LAYOUT_COUNT && simd[layout] != NULL)
+        {
+            simd[layout](out, a, b, n);
+            return;
+        }
+    }
+    kernel(out, a, b, n, so, sa, sb);
+}
+
+typedef struct
+{
+    TensorIter it; // 操作数: out, a, b
+    BinaryKernel kernel;
+    const SimdBinaryFn* simd;
+    size_t item_size;
+    DataType dtype; // 窄类型时 kernel / simd 是计算类型的内核
+}
+BinaryTask;
+
+// 窄类型（F16/BF16/I8/U8）的一段 run：按块扩展到 F32/I32，用计算类型的内核处理，
+// 再舍入回原类型。标量一侧 (stride 0) 只转换一次，块内仍走 VS / SV 的向量内核。
+static void
+_binary_run_narrow(const BinaryTask* task, char* out, const char* a, const char* b, size_t n,
+                   size_t so, size_t sa, size_t sb)
+{
+    _Alignas(64) char ta[SIMD_CONVERT_TILE * 4];
+    _Alignas(64) char tb[SIMD_CONVERT_TILE * 4];
+    _Alignas(64) char to[SIMD_CONVERT_TILE * 4];
+    if (sa == 0) simd_widen(task->dtype, ta, a, 1, task->item_size);
+    if (sb == 0) simd_widen(task->dtype, tb, b, 1, task->item_size);
+
+    for (size_t done = 0; done < n; done += SIMD_CONVERT_TILE)
+    {
+        const size_t m = (n - done < SIMD_CONVERT_TILE) ? n - done : SIMD_CONVERT_TILE;
+        if (sa != 0) simd_widen(task->dtype, ta, a + done * sa, m, sa);
+        if (sb != 0) simd_widen(task->dtype, tb, b + done * sb, m, sb);
+        _binary_run(task->kernel, task->simd, 4, to, ta, tb, m, 4, (sa != 0) ? 4 : 0, (sb != 0) ? 4 : 0);
+        simd_narrow(task->dtype, out + done * so, so, to, m);
+    }
+}
+
+// 并行任务：处理输出元素 [begin, end)
+static void
+_binary_worker(size_t begin, size_t end, void* ctx)
+{
+    const BinaryTask* task = (const BinaryTask*)ctx;
+    TensorIter it = task->it; // 每个任务各自持有一份迭代器
+
+    const bool narrow = simd_compute_dtype(task->dtype) != task->dtype;
+
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+    {
+        if (narrow)
+            _binary_run_narrow(task, it.ptrs[0], it.ptrs[1], it.ptrs[2], it.inner_size,
+                               it.inner_strides[0], it.inner_strides[1], it.inner_strides[2]);
+        else
+            _binary_run(task->kernel, task->simd, task->item_size,
+                        it.ptrs[0], it.ptrs[1], it.ptrs[2], it.inner_size,
+                        it.inner_strides[0], it.inner_strides[1], it.inner_strides[2]);
+    }
+}
+
+// 检查操作数的 dtype，并计算广播后的输出形状
+static Shape
+_binary_result_shape(const Tensor a, const Tensor b, BinaryOp op)
+{
+    if (a == NULL || b == NULL) return NULL;
+    if (op < 0 || op >= BINARY_OP_COUNT) return NULL;
+
+    const DataType dtype = tensor_get_dtype(a);
+    if (tensor_get_dtype(b) != dtype)
+    {
+        fprintf(stderr, "Error: binary op operands must have the same dtype.\n");
+        return NULL;
+    }
+    if (dtype < DTYPE_I32 || dtype >= DTYPE_COUNT) return NULL;
+
+    return shape_broadcast(tensor_get_shape(a), tensor_get_shape(b));
+}
+
+// 把 a op b 写进 out。out 的形状必须已经是广播后的形状，dtype 与操作数相同
+static bool
+_binary_into(Tensor out, const Tensor a, const Tensor b, BinaryOp op, const char* name)
+{
+    // 1. 只计算广播后的 strides（stride 为 0 的维度即广播维度），不物化扩展后的张量
+    const Shape out_shape = tensor_get_shape(out);
+    Shape a_shape = shape_expand(tensor_get_shape(a), out_shape);
+    Shape b_shape = shape_expand(tensor_get_shape(b), out_shape);
+
+    // 2. 先拿到输出的可写指针（可能触发写时复制），再检查输入是否与它重叠
+    void* out_data = (a_shape && b_shape) ? _tensor_get_data(out) : NULL;
+    bool ok = out_data != NULL;
+    if (ok && (!_tensor_out_alias_ok(out, out_data, a, a_shape) || !_tensor_out_alias_ok(out, out_data, b, b_shape)))
+    {
+        fprintf(stderr, "Error: %s: an input partially overlaps the output.\n", name);
+        ok = false;
+    }
+
+    // 3. 三个操作数一起遍历，每段 run 交给对应 dtype 的内核
+    if (ok)
+    {
+        const DataType dtype = tensor_get_dtype(out);
+        const size_t item_size = tensor_get_item_size(out);
+        void* data[3] = { out_data, (void*)tensor_get_data_const(a), (void*)tensor_get_data_const(b) };
+        const size_t* strides[3] = { tensor_get_strides(out), shape_get_strides(a_shape), shape_get_strides(b_shape) };
+        const size_t item_sizes[3] = { item_size, item_size, item_size };
+
+        BinaryTask task;
+        ok = tensor_iter_init_strided(&task.it, 3, data, strides, item_sizes,
+                                      shape_get_dims(out_shape), shape_get_ndim(out_shape));
+        if (ok)
+        {
+            const DataType compute = simd_compute_dtype(dtype);
+            task.kernel = _binary_kernels[op][compute];
+            task.simd = simd_get_kernels()->binary[op][compute];
+            task.item_size = item_size;
+            task.dtype = dtype;
+            parallel_for(0, task.it.size, parallel_grain(3 * item_size), _binary_worker, &task);
+        }
+    }
+
+    shape_free(a_shape);
+    shape_free(b_shape);
+    return ok;
+}
+
+Tensor
+tensor_binary(const Tensor a, const Tensor b, BinaryOp op)
+{
+    Shape out_shape = _binary_result_shape(a, b, op);
+    if (out_shape == NULL) return NULL;
+
+    Tensor out = tensor_empty(out_shape, tensor_get_dtype(a));
+    shape_free(out_shape);
+    if (out == NULL) return NULL;
+
+    if (!_binary_into(out, a, b, op, "tensor_binary"))
+    {
+        tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+static bool
+_binary_out(Tensor out, const Tensor a, const Tensor b, BinaryOp op, const char* name)
+{
+    Shape out_shape = _binary_result_shape(a, b, op);
+    if (out_shape == NULL) return false;
+
+    bool ok = _tensor_check_out(out, shape_get_dims(out_shape), shape_get_ndim(out_shape),
+                                tensor_get_dtype(a), name);
+    shape_free(out_shape);
+    return ok && _binary_into(out, a, b, op, name);
+}
+
+bool
+tensor_binary_out(Tensor out, const Tensor a, const Tensor b, BinaryOp op)
+{
+    return _binary_out(out, a, b, op, "tensor_binary_out");
+}
+
+bool
+tensor_binary_(Tensor a, const Tensor b, BinaryOp op)
+{
+    return _binary_out(a, a, b, op, "tensor_binary_");
+}
+
+Tensor tensor_add(const Tensor a, const Tensor b) { return tensor_binary(a, b, BINARY_OP_ADD); }
+Tensor tensor_sub(const Tensor a, const Tensor b) { return tensor_binary(a, b, BINARY_OP_SUB); }
+Tensor tensor_mul(const Tensor a, const Tensor b) { return tensor_binary(a, b, BINARY_OP_MUL); }
+Tensor tensor_div(const Tensor a, const Tensor b) { return tensor_binary(a, b, BINARY_OP_DIV); }
+Tensor tensor_maximum(const Tensor a, const Tensor b) { return tensor_binary(a, b, BINARY_OP_MAX); }
+Tensor tensor_minimum(const Tensor a, const Tensor b) { return tensor_binary(a, b, BINARY_OP_MIN); }
+
+bool tensor_add_out(Tensor out, const Tensor a, const Tensor b) { return tensor_binary_out(out, a, b, BINARY_OP_ADD); }
+bool tensor_sub_out(Tensor out, const Tensor a, const Tensor b) { return tensor_binary_out(out, a, b, BINARY_OP_SUB); }
+bool tensor_mul_out(Tensor out, const Tensor a, const Tensor b) { return tensor_binary_out(out, a, b, BINARY_OP_MUL); }
+bool tensor_div_out(Tensor out, const Tensor a, const Tensor b) { return tensor_binary_out(out, a, b, BINARY_OP_DIV); }
+bool tensor_maximum_out(Tensor out, const Tensor a, const Tensor b) { return tensor_binary_out(out, a, b, BINARY_OP_MAX); }
+bool tensor_minimum_out(Tensor out, const Tensor a, const Tensor b) { return tensor_binary_out(out, a, b, BINARY_OP_MIN); }
+
+bool tensor_add_(Tensor a, const Tensor b) { return tensor_binary_(a, b, BINARY_OP_ADD); }
+bool tensor_sub_(Tensor a, const Tensor b) { return tensor_binary_(a, b, BINARY_OP_SUB); }
+bool tensor_mul_(Tensor a, const Tensor b) { return tensor_binary_(a, b, BINARY_OP_MUL); }
+bool tensor_div_(Tensor a, const Tensor b) { return tensor_binary_(a, b, BINARY_OP_DIV); }
+bool tensor_maximum_(Tensor a, const Tensor b) { return tensor_binary_(a, b, BINARY_OP_MAX); }
+bool tensor_minimum_(Tensor a, const Tensor b) { return tensor_binary_(a, b, BINARY_OP_MIN); }
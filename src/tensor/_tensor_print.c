@@ -1,86 +1,171 @@
 #include "tensor/_tensor_print.h"
 #include "tensor/_tensor_core.h"
+#include "tensor/_tensor_cast.h"
 #include "tensor/_shape.h"
-#include "utils/_malloc.h"
 
-#include <stdio.h> // for fprintf(), stdout
-#include <stdlib.h> // for free()
-#include <string.h> // for memset()
+#include <stdio.h> // for fwrite(), snprintf(), stdout
+#include <stdarg.h> // for va_list
+#include <string.h> // for memcpy()
 #include <stdbool.h> // for bool, true, false
+#include <stdatomic.h>
 #include <math.h> // for isfinite(), floor(), fabs(), log10()
 
-typedef enum 
+#define PRINT_BUFFER 4096 // 写文件时攒够这么多字节再 fwrite
+
+static atomic_size_t _threshold = TENSOR_PRINT_THRESHOLD;
+static atomic_int _edge_items = TENSOR_PRINT_EDGE_ITEMS;
+
+void
+tensor_print_set_options(size_t threshold, int edge_items)
+{
+    atomic_store(&_threshold, threshold);
+    atomic_store(&_edge_items, (edge_items > 0) ? edge_items : 0);
+}
+
+void
+tensor_print_get_options(size_t* threshold, int* edge_items)
+{
+    if (threshold != NULL) *threshold = atomic_load(&_threshold);
+    if (edge_items != NULL) *edge_items = atomic_load(&_edge_items);
+}
+
+// --- 输出：带缓冲的文件，或者字符串 ---
+
+typedef struct
+{
+    FILE* stream;  // NULL 表示写入 out
+    char* out;
+    size_t cap;
+    size_t total;  // 到目前为止产生的字符数（字符串输出时可能超过 cap）
+    size_t used;   // buf 中待写出的字节数
+    char buf[PRINT_BUFFER];
+}
+PrintSink;
+
+static void
+_sink_flush(PrintSink* sink)
+{
+    if (sink->stream != NULL && sink->used > 0) fwrite(sink->buf, 1, sink->used, sink->stream);
+    sink->used = 0;
+}
+
+static void
+_sink_write(PrintSink* sink, const char* s, size_t n)
+{
+    if (sink->stream == NULL)
+    {
+        // 字符串输出：放得下多少写多少，留一个字节给结尾的 NUL
+        if (sink->total + 1 < sink->cap)
+        {
+            const size_t room = sink->cap - 1 - sink->total;
+            memcpy(sink->out + sink->total, s, (n < room) ? n : room);
+        }
+        sink->total += n;
+        return;
+    }
+
+    sink->total += n;
+    if (sink->used + n > PRINT_BUFFER)
+    {
+        _sink_flush(sink);
+        if (n > PRINT_BUFFER)
+        {
+            fwrite(s, 1, n, sink->stream);
+            return;
+        }
+    }
+    memcpy(sink->buf + sink->used, s, n);
+    sink->used += n;
+}
+
+static void
+_sink_printf(PrintSink* sink, const char* format, ...)
+{
+    char text[512]; // 足够放下最宽的 %f（1e308 也只有 300 多位）
+    va_list args;
+    va_start(args, format);
+    const int n = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (n > 0) _sink_write(sink, text, ((size_t)n < sizeof(text)) ? (size_t)n : sizeof(text) - 1);
+}
+
+static void
+_sink_puts(PrintSink* sink, const char* s)
+{
+    _sink_write(sink, s, strlen(s));
+}
+
+// --- 格式 ---
+
+typedef enum
 {
     FORMAT_DEFAULT,
     FORMAT_SCIENTIFIC,
     FORMAT_FIXED
-} 
+}
 FormatType;
 
-typedef struct 
+typedef struct
 {
     int width;
     int precision;
     FormatType type;
-} 
+}
 PrintFormat;
 
-static PrintFormat 
-_calculate_print_format(const double* data, size_t n) 
+// 选择格式所需的统计量，逐个元素累积，不需要缓冲区
+typedef struct
+{
+    bool int_mode;     // 所有有限值都是整数
+    bool any_finite;   // 至少有一个有限的非零数
+    double min_abs;
+    double max_abs;
+}
+FormatStats;
+
+static void
+_stats_add(FormatStats* stats, double value)
 {
-    if (n == 0) 
-        return (PrintFormat){0, 4, FORMAT_DEFAULT};
+    if (isfinite(value) && value != floor(value)) stats->int_mode = false;
 
-    bool int_mode = true;
-    for (size_t i = 0; i < n; ++i) 
+    const double z = fabs(value);
+    if (isfinite(z) && z > 0)
     {
-        if (isfinite(data[i]) && data[i] != floor(data[i])) 
+        if (!stats->any_finite)
         {
-            int_mode = false;
-            break;
+            stats->min_abs = stats->max_abs = z;
+            stats->any_finite = true;
         }
-    }
-
-    double exp_min = 0.0, exp_max = 0.0;
-    bool first_finite = true;
-    for (size_t i = 0; i < n; ++i) 
-    {
-        double z = fabs(data[i]);
-        if (isfinite(z) && z > 0) 
+        else
         {
-            if (first_finite) 
-            {
-                exp_min = exp_max = z;
-                first_finite = false;
-            } 
-            else 
-            {
-                if (z < exp_min) exp_min = z;
-                if (z > exp_max) exp_max = z;
-            }
+            if (z < stats->min_abs) stats->min_abs = z;
+            if (z > stats->max_abs) stats->max_abs = z;
         }
     }
+}
 
-    if (!first_finite) // 如果找到了至少一个有限的非零数
-    { 
-        exp_min = floor(log10(exp_min));
-        exp_max = floor(log10(exp_max));
+static PrintFormat
+_stats_format(const FormatStats* stats)
+{
+    double exp_min = 0.0, exp_max = 0.0;
+    if (stats->any_finite) // 如果找到了至少一个有限的非零数
+    {
+        exp_min = floor(log10(stats->min_abs));
+        exp_max = floor(log10(stats->max_abs));
     }
 
-    if (int_mode) 
+    if (stats->int_mode)
     {
-        if (exp_max > 9) 
+        if (exp_max > 9)
             return (PrintFormat){11, 4, FORMAT_SCIENTIFIC};
-        else 
-        {
+        else
             return (PrintFormat){(int)exp_max + 2, 0, FORMAT_DEFAULT};
-        }
-    } 
-    else 
+    }
+    else
     {
-        if (exp_max - exp_min > 4) 
+        if (exp_max - exp_min > 4)
             return (PrintFormat){11, 4, FORMAT_SCIENTIFIC};
-        else 
+        else
         {
             int precision = 4;
             int width = (exp_max > 0 ? (int)exp_max : 0) + precision + 2;
@@ -89,142 +174,201 @@ _calculate_print_format(const double* data, size_t n)
     }
 }
 
-static void 
-_print_value(FILE* stream, double value, const PrintFormat* fmt)
+static void
+_print_value(PrintSink* sink, double value, const PrintFormat* fmt)
 {
-    switch (fmt->type) 
+    switch (fmt->type)
     {
-        case FORMAT_DEFAULT:
-            fprintf(stream, "%*g", fmt->width, value);
+        case FORMAT_DEFAULT: // 整数：%g 超过 6 位就会变成科学计数法，所以用 %.0f
+            _sink_printf(sink, "%*.0f", fmt->width, value);
             break;
 
         case FORMAT_SCIENTIFIC:
-            fprintf(stream, "%*.*e", fmt->width, fmt->precision, value);
+            _sink_printf(sink, "%*.*e", fmt->width, fmt->precision, value);
             break;
 
         case FORMAT_FIXED:
-            fprintf(stream, "%*.*f", fmt->width, fmt->precision, value);
+            _sink_printf(sink, "%*.*f", fmt->width, fmt->precision, value);
             break;
     }
 }
 
-static void 
-_print_recursive(FILE* stream, const Tensor t, int* coords, int current_dim, const PrintFormat* fmt) 
+// --- 遍历要打印的元素 ---
+
+typedef struct
 {
-    const int ndim = tensor_get_ndim(t);
-    const int size_this_dim = tensor_get_dim(t, current_dim);
+    const Tensor t;
+    int ndim;
+    const int* dims;
+    const size_t* strides; // 以元素为单位
+    size_t item_size;
+    bool summarize;
+    int edge_items;
+}
+PrintWalk;
+
+static double
+_read_value(const Tensor t, const char* p)
+{
+    switch (tensor_get_dtype(t))
+    {
+        case DTYPE_F32: return (double)(*(const float*)p);
+        case DTYPE_F64: return *(const double*)p;
+        case DTYPE_I32: return (double)(*(const int*)p);
+        case DTYPE_F16: return (double)f16_to_f32(*(const uint16_t*)p);
+        case DTYPE_BF16: return (double)bf16_to_f32(*(const uint16_t*)p);
+        case DTYPE_I8: return (double)(*(const int8_t*)p);
+        case DTYPE_U8: return (double)(*(const uint8_t*)p);
+        default: break;
+    }
+    return 0.0;
+}
 
-    fprintf(stream, "[");
+// 这个轴上是否要省略中间的元素，以及下标 i 之后的下一个被打印的下标
+static bool
+_elides(const PrintWalk* walk, int dim)
+{
+    return walk->summarize && walk->dims[dim] > 2 * walk->edge_items;
+}
+
+static int
+_next_index(const PrintWalk* walk, int dim, int i)
+{
+    if (_elides(walk, dim) && i + 1 == walk->edge_items) return walk->dims[dim] - walk->edge_items;
+    return i + 1;
+}
 
-    if (current_dim == ndim - 1) 
-    { // Base case: a single row
-        for (int i = 0; i < size_this_dim; i ++) 
+// 第一遍：只扫描会被打印出来的元素，累积格式统计量
+static void
+_scan(const PrintWalk* walk, const char* base, int dim, FormatStats* stats)
+{
+    const int n = walk->dims[dim];
+    const size_t stride = walk->strides[dim] * walk->item_size;
+    int i = _elides(walk, dim) && walk->edge_items == 0 ? n : 0;
+    for (; i < n; i = _next_index(walk, dim, i))
+    {
+        if (dim == walk->ndim - 1)
+            _stats_add(stats, _read_value(walk->t, base + (size_t)i * stride));
+        else
+            _scan(walk, base + (size_t)i * stride, dim + 1, stats);
+    }
+}
+
+// 第二遍：按选定的格式打印；被省略的部分写成 "..."
+static void
+_print_block(const PrintWalk* walk, PrintSink* sink, const char* base, int dim, const PrintFormat* fmt)
+{
+    const int n = walk->dims[dim];
+    const size_t stride = walk->strides[dim] * walk->item_size;
+    const bool elide = _elides(walk, dim);
+    const bool row = dim == walk->ndim - 1;
+
+    _sink_puts(sink, "[");
+    bool first = true;
+    int i = (elide && walk->edge_items == 0) ? n : 0;
+    if (i == n && elide) _sink_puts(sink, "...");
+    for (; i < n; i = _next_index(walk, dim, i))
+    {
+        if (!first)
         {
-            coords[current_dim] = i;
-            void* elem_ptr = tensor_get_element_ptr(t, coords);
-            
-            double val = 0.0;
-            switch (tensor_get_dtype(t)) 
-            {
-                case DTYPE_F32: val = (double)(*(float*)elem_ptr); break;
-                case DTYPE_F64: val = *(double*)elem_ptr; break;
-                case DTYPE_I32: val = (double)(*(int*)elem_ptr); break;
-            }
-
-            _print_value(stream, val, fmt);
-
-            if (i < size_this_dim - 1) 
-            {
-                fprintf(stream, ", ");
-            }
+            if (row) _sink_puts(sink, ", ");
+            else _sink_printf(sink, ",\n%*s", dim + 1, "");
         }
-    } 
-    else // Recursive step
-    { 
-        for (int i = 0; i < size_this_dim; i++) 
+        if (elide && i == n - walk->edge_items)
         {
-            coords[current_dim] = i;
-            if (i > 0) 
-            {
-                fprintf(stream, ",\n%*s", (current_dim + 1), "");
-            }
-            _print_recursive(stream, t, coords, current_dim + 1, fmt);
+            // 被省略的中间部分
+            if (row) _sink_puts(sink, "..., ");
+            else _sink_printf(sink, "...,\n%*s", dim + 1, "");
         }
+        first = false;
+
+        if (row)
+            _print_value(sink, _read_value(walk->t, base + (size_t)i * stride), fmt);
+        else
+            _print_block(walk, sink, base + (size_t)i * stride, dim + 1, fmt);
     }
-    fprintf(stream, "]");
+    _sink_puts(sink, "]");
 }
 
-static void 
-_tensor_print_stream(FILE* stream, const Tensor t) 
+static void
+_tensor_print_sink(PrintSink* sink, const Tensor t)
 {
-    if (t == NULL) 
+    if (t == NULL)
     {
-        fprintf(stream, "[ Tensor (NULL) ]\n");
+        _sink_puts(sink, "[ Tensor (NULL) ]\n");
         return;
     }
 
+    const Shape shape = tensor_get_shape(t);
     const int ndim = tensor_get_ndim(t);
     const size_t num_elements = tensor_get_elements_count(t);
+    const char* data = tensor_get_data_const(t); // 只读，不会触发写时复制
 
-    if (num_elements == 0) 
+    if (num_elements == 0)
     {
-        fprintf(stream, "[]\n");
+        _sink_puts(sink, "[]\n");
     }
-    else if (ndim == 0) 
+    else if (ndim == 0)
     {
-        void* elem_ptr = tensor_get_data(t);
-        double val = (tensor_get_dtype(t) == DTYPE_F32) ? (double)(*(float*)elem_ptr) : (double)(*(int*)elem_ptr); // 简化处理
-        fprintf(stream, "%.4f\n", val);
-    } 
-    else 
+        FormatStats stats = { true, false, 0.0, 0.0 };
+        const double value = _read_value(t, data);
+        _stats_add(&stats, value);
+        const PrintFormat fmt = _stats_format(&stats);
+        _print_value(sink, value, &fmt);
+        _sink_puts(sink, "\n");
+    }
+    else
     {
-        // --- 阶段一：预扫描，获取所有元素的值用于格式计算 ---
-        double* temp_data = (double*)safemalloc(num_elements * sizeof(double));
-        if (!temp_data) return;
+        PrintWalk walk = { t, ndim, shape_get_dims(shape), tensor_get_strides(t), tensor_get_item_size(t),
+                           num_elements > atomic_load(&_threshold), atomic_load(&_edge_items) };
 
-        int* coords = (int*)safecalloc(ndim, sizeof(int));
-        if (!coords) { free(temp_data); return; }
+        // 格式只依据实际打印出来的元素计算（与 NumPy 相同），一遍扫描即可
+        FormatStats stats = { true, false, 0.0, 0.0 };
+        _scan(&walk, data, 0, &stats);
+        const PrintFormat fmt = _stats_format(&stats);
 
-        for (size_t i = 0; i < num_elements; i++) 
-        {
-            // "里程表"逻辑，用于遍历所有逻辑坐标
-            void* elem_ptr = tensor_get_element_ptr(t, coords);
-            switch (tensor_get_dtype(t)) {
-                case DTYPE_F32: temp_data[i] = (double)(*(float*)elem_ptr); break;
-                case DTYPE_F64: temp_data[i] = *(double*)elem_ptr; break;
-                case DTYPE_I32: temp_data[i] = (double)(*(int*)elem_ptr); break;
-            }
-
-            // 更新里程表
-            int current_d = ndim - 1;
-            while (current_d >= 0) {
-                coords[current_d]++;
-                if (coords[current_d] < tensor_get_dim(t, current_d)) break;
-                coords[current_d] = 0;
-                current_d--;
-            }
-        }
-        
-        // 计算最佳格式
-        PrintFormat fmt = _calculate_print_format(temp_data, num_elements);
-        free(temp_data); // 临时数据用完即焚
-
-        // --- 阶段二：使用计算出的格式进行递归打印 ---
-        memset(coords, 0, ndim * sizeof(int)); // 重置坐标
-        _print_recursive(stream, t, coords, 0, &fmt);
-        fprintf(stream, "\n");
-        
-        free(coords);
+        _print_block(&walk, sink, data, 0, &fmt);
+        _sink_puts(sink, "\n");
     }
-    
+
     // 打印最后的摘要信息
-    fprintf(stream, "[Tensor of shape: ");
-    shape_print(tensor_get_shape(t));
-    fprintf(stream, "]\n");
+    _sink_puts(sink, "[Tensor of shape: Shape[");
+    for (int i = 0; i < ndim; i++) _sink_printf(sink, (i > 0) ? ", %d" : "%d", tensor_get_dim(t, i));
+    _sink_puts(sink, "]]\n");
 }
 
 // --- 公开 API 实现 ---
-void tensor_print(const Tensor t) 
+void
+tensor_print(const Tensor t)
+{
+    tensor_fprint(stdout, t);
+}
+
+void
+tensor_fprint(FILE* stream, const Tensor t)
 {
-    _tensor_print_stream(stdout, t);
-}
\ No newline at end of file
+    if (stream == NULL) return;
+
+    PrintSink sink;
+    sink.stream = stream;
+    sink.out = NULL;
+    sink.cap = 0;
+    sink.total = 0;
+    sink.used = 0;
+    _tensor_print_sink(&sink, t);
+    _sink_flush(&sink);
+}
+
+size_t
+tensor_sprint(char* buffer, size_t size, const Tensor t)
+{
+    PrintSink sink;
+    sink.stream = NULL;
+    sink.out = buffer;
+    sink.cap = (buffer != NULL) ? size : 0;
+    sink.total = 0;
+    sink.used = 0;
+    _tensor_print_sink(&sink, t);
+    if (sink.cap > 0) buffer[(sink.total < sink.cap) ? sink.total : sink.cap - 1] = '\0';
+    return sink.total;
+}
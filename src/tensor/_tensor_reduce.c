@@ -0,0 +1,727 @@
+#include "tensor/_tensor_ops.h"
+#include "tensor/_tensor_iter.h"
+#include "tensor/_tensor_simd.h"
+#include "tensor/_tensor_cast.h"
+#include "tensor/_shape.h"
+#include "utils/_malloc.h"
+#include "utils/_parallel.h"
+
+#include <math.h>   // for INFINITY, NAN
+#include <stdint.h> // for int32_t, int64_t, INT32_MIN, INT32_MAX
+#include <stdio.h>  // for fprintf()
+#include <stdlib.h> // for free()
+#include <string.h> // for memcpy()
+
+// 每个并行任务至少处理这么多输入元素，避免任务太碎
+#define REDUCE_GRAIN 32768
+// 输出很少而规约很长时（例如全量求和），把规约本身切成固定大小的块并行。
+// 是否切块只看问题的大小，块大小也固定，所以结果与线程数无关
+#define REDUCE_SPLIT_CHUNK (1 << 18)
+#define REDUCE_SPLIT_MAX_OUTPUTS 16
+// “纵向”规约一次处理的输出个数，累加器留在 L1 里
+#define REDUCE_VERTICAL_BLOCK 256
+
+// 累加器：求和时 F32/F64 用 double、I32 用 int64；max/min 用元素本身的类型
+typedef union
+{
+    double f;
+    int64_t i;
+    float f32;
+    int32_t i32;
+}
+ReduceAcc;
+
+typedef struct
+{
+    SimdReduceOp op;
+    bool mean;            // 在 sum 的基础上除以 reduce_size
+    bool argmax;
+    DataType dtype;       // 计算用的 dtype：窄类型扩展成 F32 / I32，其余就是输入 dtype
+    DataType in_dtype;    // 输入 dtype
+    DataType out_dtype;
+    size_t item_size;     // 输入元素大小
+    size_t compute_size;  // dtype 的元素大小
+    SimdReduceFn simd;    // 连续 run 上的向量化内核，可能为 NULL
+
+    TensorIter outer;     // 操作数: out, in —— 遍历保留下来的维度
+    TensorIter inner;     // 操作数: in      —— 遍历被规约的维度
+    size_t outputs;       // 输出元素个数
+    size_t reduce_size;   // 每个输出规约的元素个数
+    bool vertical;        // 规约维不连续、但相邻输出在输入里连续：按行累加
+}
+ReducePlan;
+
+// --- 累加器的基本操作 ---
+
+static void
+_acc_init(const ReducePlan* p, ReduceAcc* acc)
+{
+    switch (p->op)
+    {
+        case SIMD_REDUCE_SUM:
+            if (p->dtype == DTYPE_I32) acc->i = 0; else acc->f = 0.0;
+            break;
+
+        case SIMD_REDUCE_MAX:
+            if (p->dtype == DTYPE_I32) acc->i32 = INT32_MIN;
+            else if (p->dtype == DTYPE_F32) acc->f32 = -INFINITY;
+            else acc->f = -INFINITY;
+            break;
+
+        case SIMD_REDUCE_MIN:
+            if (p->dtype == DTYPE_I32) acc->i32 = INT32_MAX;
+            else if (p->dtype == DTYPE_F32) acc->f32 = INFINITY;
+            else acc->f = INFINITY;
+            break;
+
+        default:
+            break;
+    }
+}
+
+#define _FOLD_STRIDED(T, FIELD, EXPR) \
+    for (size_t k = 0; k < n; k++, ptr += stride) \
+    { \
+        const T x = *(const T*)ptr; \
+        FIELD = (EXPR); \
+    }
+
+// 把一段计算类型的 run（n 个元素，字节步长 stride）并入累加器
+static void
+_acc_run_wide(const ReducePlan* p, ReduceAcc* acc, const char* ptr, size_t n, size_t stride)
+{
+    if (n == 0) return;
+    if (stride == p->compute_size && p->simd != NULL)
+    {
+        p->simd(ptr, n, acc);
+        return;
+    }
+    if (stride == 0 && p->op == SIMD_REDUCE_SUM) // 广播维度：同一个值重复 n 次
+    {
+        switch (p->dtype)
+        {
+            case DTYPE_I32: acc->i += (int64_t)*(const int32_t*)ptr * (int64_t)n; break;
+            case DTYPE_F32: acc->f += (double)*(const float*)ptr * (double)n; break;
+            case DTYPE_F64: acc->f += *(const double*)ptr * (double)n; break;
+            default: break;
+        }
+        return;
+    }
+    if (stride == 0) n = 1; // 广播维度上的 max/min 只需看一次
+
+    switch (p->op)
+    {
+        case SIMD_REDUCE_SUM:
+            switch (p->dtype)
+            {
+                case DTYPE_I32: _FOLD_STRIDED(int32_t, acc->i, acc->i + x); break;
+                case DTYPE_F32: _FOLD_STRIDED(float, acc->f, acc->f + x); break;
+                case DTYPE_F64: _FOLD_STRIDED(double, acc->f, acc->f + x); break;
+                default: break;
+            }
+            break;
+
+        case SIMD_REDUCE_MAX:
+            switch (p->dtype)
+            {
+                case DTYPE_I32: _FOLD_STRIDED(int32_t, acc->i32, acc->i32 > x ? acc->i32 : x); break;
+                case DTYPE_F32: _FOLD_STRIDED(float, acc->f32, SIMD_MAX_NAN(acc->f32, x)); break;
+                case DTYPE_F64: _FOLD_STRIDED(double, acc->f, SIMD_MAX_NAN(acc->f, x)); break;
+                default: break;
+            }
+            break;
+
+        case SIMD_REDUCE_MIN:
+            switch (p->dtype)
+            {
+                case DTYPE_I32: _FOLD_STRIDED(int32_t, acc->i32, acc->i32 < x ? acc->i32 : x); break;
+                case DTYPE_F32: _FOLD_STRIDED(float, acc->f32, SIMD_MIN_NAN(acc->f32, x)); break;
+                case DTYPE_F64: _FOLD_STRIDED(double, acc->f, SIMD_MIN_NAN(acc->f, x)); break;
+                default: break;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+// 把一段输入 run 并入累加器；窄类型先按块扩展成计算类型
+static void
+_acc_run(const ReducePlan* p, ReduceAcc* acc, const char* ptr, size_t n, size_t stride)
+{
+    if (p->in_dtype == p->dtype)
+    {
+        _acc_run_wide(p, acc, ptr, n, stride);
+        return;
+    }
+
+    _Alignas(64) char tile[SIMD_CONVERT_TILE * 4];
+    if (stride == 0)
+    {
+        simd_widen(p->in_dtype, tile, ptr, 1, p->item_size);
+        _acc_run_wide(p, acc, tile, n, 0);
+        return;
+    }
+    for (size_t done = 0; done < n; done += SIMD_CONVERT_TILE)
+    {
+        const size_t m = (n - done < SIMD_CONVERT_TILE) ? n - done : SIMD_CONVERT_TILE;
+        simd_widen(p->in_dtype, tile, ptr + done * stride, m, stride);
+        _acc_run_wide(p, acc, tile, m, p->compute_size);
+    }
+}
+
+static void
+_acc_combine(const ReducePlan* p, ReduceAcc* acc, const ReduceAcc* other)
+{
+    // other 本身就是一个“值”，按步长为 0 的单元素 run 并入即可
+    if (p->op == SIMD_REDUCE_SUM)
+    {
+        if (p->dtype == DTYPE_I32) acc->i += other->i; else acc->f += other->f;
+        return;
+    }
+    _acc_run_wide(p, acc, (const char*)other, 1, p->compute_size);
+}
+
+static void
+_acc_store(const ReducePlan* p, const ReduceAcc* acc, char* out)
+{
+    if (p->op == SIMD_REDUCE_SUM)
+    {
+        const double n = (double)p->reduce_size;
+        switch (p->out_dtype)
+        {
+            case DTYPE_I32: *(int32_t*)out = (int32_t)acc->i; break;
+            case DTYPE_F32: *(float*)out = (float)(p->mean ? acc->f / n : acc->f); break;
+            case DTYPE_F16: *(uint16_t*)out = f32_to_f16((float)(p->mean ? acc->f / n : acc->f)); break;
+            case DTYPE_BF16: *(uint16_t*)out = f32_to_bf16((float)(p->mean ? acc->f / n : acc->f)); break;
+            case DTYPE_F64:
+                if (p->dtype == DTYPE_I32)
+                    *(double*)out = p->mean ? (double)acc->i / n : (double)acc->i;
+                else
+                    *(double*)out = p->mean ? acc->f / n : acc->f;
+                break;
+            default: break;
+        }
+        return;
+    }
+
+    // max/min 的结果就是某个输入元素，转换回输入 dtype 没有误差
+    switch (p->out_dtype)
+    {
+        case DTYPE_I32: *(int32_t*)out = acc->i32; break;
+        case DTYPE_F32: *(float*)out = acc->f32; break;
+        case DTYPE_F64: *(double*)out = acc->f; break;
+        case DTYPE_F16: *(uint16_t*)out = f32_to_f16(acc->f32); break;
+        case DTYPE_BF16: *(uint16_t*)out = f32_to_bf16(acc->f32); break;
+        case DTYPE_I8: *(int8_t*)out = (int8_t)acc->i32; break;
+        case DTYPE_U8: *(uint8_t*)out = (uint8_t)acc->i32; break;
+        default: break;
+    }
+}
+
+// --- 单个输出的规约 ---
+
+// 规约 inner 遍历中 [begin, end) 这一段元素
+static void
+_reduce_range(const ReducePlan* p, TensorIter* inner, const char* base,
+              size_t begin, size_t end, ReduceAcc* acc)
+{
+    void* data[1] = { (void*)base };
+    tensor_iter_reset(inner, data);
+    tensor_iter_set_range(inner, begin, end);
+    while (tensor_iter_next(inner))
+        _acc_run(p, acc, inner->ptrs[0], inner->inner_size, inner->inner_strides[0]);
+}
+
+// 与 max 的 NaN 规则一致：第一个 NaN 胜过所有数，此后不再更新
+#define _ARGMAX_BETTER(x, best) ((x) > (best) || ((x) != (x) && (best) == (best)))
+
+#define _ARGMAX_SCAN(T) \
+    { \
+        T best = *(const T*)base; \
+        for (size_t k = 1; k < n; k++) \
+        { \
+            const T x = *(const T*)(base + k * stride); \
+            if (_ARGMAX_BETTER(x, best)) { best = x; idx = (int32_t)k; } \
+        } \
+    }
+
+// 窄类型：按块扩展后扫描，块之间接着比较
+#define _ARGMAX_TILES(T) \
+    { \
+        T best = 0; \
+        T tile[SIMD_CONVERT_TILE]; \
+        for (size_t done = 0; done < n; done += SIMD_CONVERT_TILE) \
+        { \
+            const size_t m = (n - done < SIMD_CONVERT_TILE) ? n - done : SIMD_CONVERT_TILE; \
+            simd_widen(p->in_dtype, tile, base + done * stride, m, stride); \
+            if (done == 0) best = tile[0]; \
+            for (size_t k = 0; k < m; k++) \
+                if (_ARGMAX_BETTER(tile[k], best)) { best = tile[k]; idx = (int32_t)(done + k); } \
+        } \
+    }
+
+// argmax 只沿一个轴：从头扫描，严格大于才更新，因此返回第一个最大值（或第一个 NaN）的下标
+static int32_t
+_argmax_one(const ReducePlan* p, const char* base)
+{
+    const size_t n = p->reduce_size;
+    const size_t stride = (p->inner.ndim > 0) ? p->inner.inner_strides[0] : 0;
+    int32_t idx = 0;
+    if (p->in_dtype != p->dtype)
+    {
+        // 规约维长度为 1 时 inner 没有维度，stride 取 0 也只读第一个元素
+        if (p->dtype == DTYPE_F32) _ARGMAX_TILES(float)
+        else _ARGMAX_TILES(int32_t)
+        return idx;
+    }
+    switch (p->dtype)
+    {
+        case DTYPE_I32: _ARGMAX_SCAN(int32_t); break;
+        case DTYPE_F32: _ARGMAX_SCAN(float); break;
+        case DTYPE_F64: _ARGMAX_SCAN(double); break;
+        default: break;
+    }
+    return idx;
+}
+
+// --- 纵向规约：把规约维上的每一“行”整段并入一排累加器 ---
+
+#define _FOLD_ROW(T, FIELD, EXPR) \
+    { \
+        const T* row = (const T*)ptr; \
+        for (size_t j = 0; j < m; j++) \
+        { \
+            const T x = row[j]; \
+            acc[j].FIELD = (EXPR); \
+        } \
+    }
+
+static void
+_acc_row(const ReducePlan* p, ReduceAcc* acc, const char* ptr, size_t m)
+{
+    _Alignas(64) char tile[REDUCE_VERTICAL_BLOCK * 4];
+    if (p->in_dtype != p->dtype) // 窄类型：先把这一行扩展成计算类型
+    {
+        simd_widen(p->in_dtype, tile, ptr, m, p->item_size);
+        ptr = tile;
+    }
+
+    switch (p->op)
+    {
+        case SIMD_REDUCE_SUM:
+            switch (p->dtype)
+            {
+                case DTYPE_I32: _FOLD_ROW(int32_t, i, acc[j].i + x); break;
+                case DTYPE_F32: _FOLD_ROW(float, f, acc[j].f + x); break;
+                case DTYPE_F64: _FOLD_ROW(double, f, acc[j].f + x); break;
+                default: break;
+            }
+            break;
+
+        case SIMD_REDUCE_MAX:
+            switch (p->dtype)
+            {
+                case DTYPE_I32: _FOLD_ROW(int32_t, i32, acc[j].i32 > x ? acc[j].i32 : x); break;
+                case DTYPE_F32: _FOLD_ROW(float, f32, SIMD_MAX_NAN(acc[j].f32, x)); break;
+                case DTYPE_F64: _FOLD_ROW(double, f, SIMD_MAX_NAN(acc[j].f, x)); break;
+                default: break;
+            }
+            break;
+
+        case SIMD_REDUCE_MIN:
+            switch (p->dtype)
+            {
+                case DTYPE_I32: _FOLD_ROW(int32_t, i32, acc[j].i32 < x ? acc[j].i32 : x); break;
+                case DTYPE_F32: _FOLD_ROW(float, f32, SIMD_MIN_NAN(acc[j].f32, x)); break;
+                case DTYPE_F64: _FOLD_ROW(double, f, SIMD_MIN_NAN(acc[j].f, x)); break;
+                default: break;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+// 以第 0 行为初值，从第 1 行起逐行比较；严格大于才更新，保证取第一个最大值
+#define _ARGMAX_ROWS(T) \
+    { \
+        T best[REDUCE_VERTICAL_BLOCK]; \
+        memcpy(best, in, m * sizeof(T)); \
+        for (size_t k = 1; k < p->reduce_size; k++) \
+        { \
+            const T* row = (const T*)(in + k * stride); \
+            for (size_t j = 0; j < m; j++) \
+                if (_ARGMAX_BETTER(row[j], best[j])) { best[j] = row[j]; idx[j] = (int32_t)k; } \
+        } \
+    }
+
+// 处理 m 个在输入里相邻（连续）的输出：in 指向第一个输出对应的输入位置
+static void
+_reduce_vertical(const ReducePlan* p, TensorIter* inner, char* out, size_t out_stride,
+                 const char* in, size_t m)
+{
+    void* data[1] = { (void*)in };
+    tensor_iter_reset(inner, data);
+
+    if (p->argmax)
+    {
+        int32_t idx[REDUCE_VERTICAL_BLOCK] = { 0 };
+        const size_t stride = inner->inner_strides[0];
+        switch (p->dtype)
+        {
+            case DTYPE_I32: _ARGMAX_ROWS(int32_t); break;
+            case DTYPE_F32: _ARGMAX_ROWS(float); break;
+            case DTYPE_F64: _ARGMAX_ROWS(double); break;
+            default: break;
+        }
+        for (size_t j = 0; j < m; j++)
+            *(int32_t*)(out + j * out_stride) = idx[j];
+        return;
+    }
+
+    ReduceAcc acc[REDUCE_VERTICAL_BLOCK];
+    for (size_t j = 0; j < m; j++) _acc_init(p, &acc[j]);
+    while (tensor_iter_next(inner))
+    {
+        const char* ptr = inner->ptrs[0];
+        for (size_t k = 0; k < inner->inner_size; k++, ptr += inner->inner_strides[0])
+            _acc_row(p, acc, ptr, m);
+    }
+    for (size_t j = 0; j < m; j++)
+        _acc_store(p, &acc[j], out + j * out_stride);
+}
+
+// --- 并行驱动 ---
+
+// 并行任务：处理输出 [begin, end)
+static void
+_reduce_outputs_worker(size_t begin, size_t end, void* ctx)
+{
+    const ReducePlan* p = (const ReducePlan*)ctx;
+    TensorIter outer = p->outer; // 每个任务各自持有一份迭代器
+    TensorIter inner = p->inner;
+
+    tensor_iter_set_range(&outer, begin, end);
+    while (tensor_iter_next(&outer))
+    {
+        char* out = outer.ptrs[0];
+        const char* in = outer.ptrs[1];
+        const size_t so = outer.inner_strides[0];
+        const size_t si = outer.inner_strides[1];
+
+        if (p->vertical)
+        {
+            for (size_t j0 = 0; j0 < outer.inner_size; j0 += REDUCE_VERTICAL_BLOCK)
+            {
+                size_t m = outer.inner_size - j0;
+                if (m > REDUCE_VERTICAL_BLOCK) m = REDUCE_VERTICAL_BLOCK;
+                _reduce_vertical(p, &inner, out + j0 * so, so, in + j0 * si, m);
+            }
+            continue;
+        }
+
+        for (size_t j = 0; j < outer.inner_size; j++)
+        {
+            if (p->argmax)
+            {
+                *(int32_t*)(out + j * so) = _argmax_one(p, in + j * si);
+                continue;
+            }
+            ReduceAcc acc;
+            _acc_init(p, &acc);
+            _reduce_range(p, &inner, in + j * si, 0, p->reduce_size, &acc);
+            _acc_store(p, &acc, out + j * so);
+        }
+    }
+}
+
+typedef struct
+{
+    const ReducePlan* plan;
+    const char* base;
+    ReduceAcc* partials;
+}
+SplitTask;
+
+// 并行任务：处理规约块 [begin, end)，每块写一个部分和
+static void
+_reduce_split_worker(size_t begin, size_t end, void* ctx)
+{
+    SplitTask* task = (SplitTask*)ctx;
+    const ReducePlan* p = task->plan;
+    TensorIter inner = p->inner;
+
+    for (size_t c = begin; c < end; c++)
+    {
+        const size_t lo = c * REDUCE_SPLIT_CHUNK;
+        const size_t hi = (lo + REDUCE_SPLIT_CHUNK < p->reduce_size) ? lo + REDUCE_SPLIT_CHUNK : p->reduce_size;
+        _acc_init(p, &task->partials[c]);
+        _reduce_range(p, &inner, task->base, lo, hi, &task->partials[c]);
+    }
+}
+
+static bool
+_reduce_execute(ReducePlan* p)
+{
+    const bool split = !p->argmax && p->outputs <= REDUCE_SPLIT_MAX_OUTPUTS && p->reduce_size >= 2 * REDUCE_SPLIT_CHUNK;
+
+    if (!split)
+    {
+        size_t grain = REDUCE_GRAIN / (p->reduce_size > 0 ? p->reduce_size : 1);
+        parallel_for(0, p->outputs, grain > 0 ? grain : 1, _reduce_outputs_worker, p);
+        return true;
+    }
+
+    // 输出太少：逐个输出处理，把每个输出的规约切块并行，再按块的顺序合并
+    const size_t nchunks = (p->reduce_size + REDUCE_SPLIT_CHUNK - 1) / REDUCE_SPLIT_CHUNK;
+    ReduceAcc* partials = safemalloc(nchunks * sizeof(ReduceAcc));
+    if (partials == NULL) return false;
+
+    while (tensor_iter_next(&p->outer))
+    {
+        for (size_t j = 0; j < p->outer.inner_size; j++)
+        {
+            SplitTask task = { p, p->outer.ptrs[1] + j * p->outer.inner_strides[1], partials };
+            parallel_for(0, nchunks, 1, _reduce_split_worker, &task);
+
+            ReduceAcc acc = partials[0];
+            for (size_t c = 1; c < nchunks; c++)
+                _acc_combine(p, &acc, &partials[c]);
+            _acc_store(p, &acc, p->outer.ptrs[0] + j * p->outer.inner_strides[0]);
+        }
+    }
+    free(partials);
+    return true;
+}
+
+// --- 公共入口 ---
+
+// out 为 NULL 时新建输出张量；否则写进调用方提供的 out（_out 变体），失败时不释放它
+static Tensor
+_reduce(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim,
+        SimdReduceOp op, bool mean, bool argmax, const char* name)
+{
+    if (t == NULL) return NULL;
+
+    const DataType dtype = tensor_get_dtype(t);
+    if (dtype < DTYPE_I32 || dtype >= DTYPE_COUNT) return NULL;
+    const DataType compute = simd_compute_dtype(dtype);
+
+    const int ndim = tensor_get_ndim(t);
+    const int* dims = shape_get_dims(tensor_get_shape(t));
+    const size_t* strides = tensor_get_strides(t);
+
+    // 1. 标记要规约的轴；axes 为空表示规约全部轴
+    bool reduced[TENSOR_ITER_MAX_DIMS] = { false };
+    if (ndim > TENSOR_ITER_MAX_DIMS)
+    {
+        fprintf(stderr, "Error: reductions support at most %d dimensions.\n", TENSOR_ITER_MAX_DIMS);
+        return NULL;
+    }
+    if (axes == NULL || naxes == 0)
+    {
+        for (int i = 0; i < ndim; i++) reduced[i] = true;
+    }
+    else
+    {
+        for (int i = 0; i < naxes; i++)
+        {
+            if (axes[i] < 0 || axes[i] >= ndim)
+            {
+                fprintf(stderr, "Error: axis %d is out of bounds for tensor of dimension %d\n", axes[i], ndim);
+                return NULL;
+            }
+            if (reduced[axes[i]])
+            {
+                fprintf(stderr, "Error: duplicate axis %d found in axes array\n", axes[i]);
+                return NULL;
+            }
+            reduced[axes[i]] = true;
+        }
+    }
+
+    // 2. 拆成保留维（外层）和规约维（内层），并计算输出形状
+    int out_dims[TENSOR_ITER_MAX_DIMS], kept_dims[TENSOR_ITER_MAX_DIMS], red_dims[TENSOR_ITER_MAX_DIMS];
+    int kept_axes[TENSOR_ITER_MAX_DIMS]; // 每个保留维在输出中对应的轴
+    size_t kept_strides[TENSOR_ITER_MAX_DIMS], red_strides[TENSOR_ITER_MAX_DIMS];
+    int out_ndim = 0, nkept = 0, nred = 0;
+    size_t reduce_size = 1;
+    for (int i = 0; i < ndim; i++)
+    {
+        if (reduced[i])
+        {
+            red_dims[nred] = dims[i];
+            red_strides[nred++] = strides[i];
+            reduce_size *= (size_t)dims[i];
+            if (keepdim) out_dims[out_ndim++] = 1;
+        }
+        else
+        {
+            kept_axes[nkept] = out_ndim;
+            kept_dims[nkept] = dims[i];
+            kept_strides[nkept++] = strides[i];
+            out_dims[out_ndim++] = dims[i];
+        }
+    }
+
+    if (reduce_size == 0 && op != SIMD_REDUCE_SUM)
+    {
+        fprintf(stderr, "Error: cannot compute max/min/argmax over a zero-size dimension.\n");
+        return NULL;
+    }
+
+    // 3. 创建输出张量
+    DataType out_dtype = dtype;
+    if (argmax) out_dtype = DTYPE_I32;
+    else if (mean && compute == DTYPE_I32) out_dtype = DTYPE_F64;
+    else if (op == SIMD_REDUCE_SUM && compute == DTYPE_I32) out_dtype = DTYPE_I32; // I8/U8 的和
+
+    const bool owned = out == NULL;
+    if (owned)
+    {
+        Shape out_shape = shape_create(out_dims, out_ndim);
+        if (out_shape == NULL) return NULL;
+        out = tensor_empty(out_shape, out_dtype); // 每个输出元素都会被写入
+        shape_free(out_shape);
+        if (out == NULL) return NULL;
+    }
+    else if (!_tensor_check_out(out, out_dims, out_ndim, out_dtype, name))
+    {
+        return NULL;
+    }
+
+    // 先拿可写指针（可能触发写时复制），再检查输出是否与输入重叠
+    void* out_data = _tensor_get_data(out);
+    if (out_data == NULL || (!owned && tensor_may_share_memory(out, t)))
+    {
+        if (out_data != NULL) fprintf(stderr, "Error: %s: the output overlaps the input.\n", name);
+        if (owned) tensor_free(out);
+        return NULL;
+    }
+
+    // 保留维在输出中的步长
+    size_t out_strides[TENSOR_ITER_MAX_DIMS];
+    for (int i = 0; i < nkept; i++)
+        out_strides[i] = tensor_get_strides(out)[kept_axes[i]];
+
+    // 4. 建立遍历计划
+    ReducePlan plan;
+    plan.op = op;
+    plan.mean = mean;
+    plan.argmax = argmax;
+    plan.dtype = compute;
+    plan.in_dtype = dtype;
+    plan.out_dtype = out_dtype;
+    plan.item_size = tensor_get_item_size(t);
+    plan.compute_size = tensor_dtype_size(compute);
+    plan.simd = argmax ? NULL : simd_get_kernels()->reduce[op][compute];
+    plan.reduce_size = reduce_size;
+
+    void* outer_data[2] = { out_data, (void*)tensor_get_data_const(t) };
+    const size_t* outer_strides[2] = { out_strides, kept_strides };
+    const size_t outer_items[2] = { tensor_get_item_size(out), plan.item_size };
+    void* inner_data[1] = { (void*)tensor_get_data_const(t) };
+    const size_t* inner_strides[1] = { red_strides };
+    const size_t inner_items[1] = { plan.item_size };
+
+    if (!tensor_iter_init_strided(&plan.outer, 2, outer_data, outer_strides, outer_items, kept_dims, nkept) ||
+        !tensor_iter_init_strided(&plan.inner, 1, inner_data, inner_strides, inner_items, red_dims, nred))
+    {
+        if (owned) tensor_free(out);
+        return NULL;
+    }
+    plan.outputs = plan.outer.size;
+
+    // 规约维的 run 不连续，而相邻输出在输入中连续（例如对行主序矩阵按列求和）
+    const bool inner_contiguous = plan.inner.ndim == 0 || plan.inner.inner_strides[0] == plan.item_size;
+    plan.vertical = !inner_contiguous && plan.outputs > 1 && plan.reduce_size > 0 &&
+                    plan.outer.inner_strides[1] == plan.item_size &&
+                    (!argmax || (plan.inner.ndim <= 1 && compute == dtype));
+
+    if (!_reduce_execute(&plan))
+    {
+        if (owned) tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+Tensor
+tensor_sum(const Tensor t, const int* axes, int naxes, bool keepdim)
+{
+    return _reduce(NULL, t, axes, naxes, keepdim, SIMD_REDUCE_SUM, false, false, "tensor_sum");
+}
+
+Tensor
+tensor_mean(const Tensor t, const int* axes, int naxes, bool keepdim)
+{
+    return _reduce(NULL, t, axes, naxes, keepdim, SIMD_REDUCE_SUM, true, false, "tensor_mean");
+}
+
+Tensor
+tensor_max(const Tensor t, const int* axes, int naxes, bool keepdim)
+{
+    return _reduce(NULL, t, axes, naxes, keepdim, SIMD_REDUCE_MAX, false, false, "tensor_max");
+}
+
+Tensor
+tensor_min(const Tensor t, const int* axes, int naxes, bool keepdim)
+{
+    return _reduce(NULL, t, axes, naxes, keepdim, SIMD_REDUCE_MIN, false, false, "tensor_min");
+}
+
+static Tensor
+_argmax(Tensor out, const Tensor t, int axis, bool keepdim, const char* name)
+{
+    if (t == NULL) return NULL;
+    if (axis < 0 || axis >= tensor_get_ndim(t))
+    {
+        fprintf(stderr, "Error: axis %d is out of bounds for tensor of dimension %d\n", axis, tensor_get_ndim(t));
+        return NULL;
+    }
+    return _reduce(out, t, &axis, 1, keepdim, SIMD_REDUCE_MAX, false, true, name);
+}
+
+Tensor
+tensor_argmax(const Tensor t, int axis, bool keepdim)
+{
+    return _argmax(NULL, t, axis, keepdim, "tensor_argmax");
+}
+
+bool
+tensor_sum_out(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim)
+{
+    if (out == NULL) return false;
+    return _reduce(out, t, axes, naxes, keepdim, SIMD_REDUCE_SUM, false, false, "tensor_sum_out") != NULL;
+}
+
+bool
+tensor_mean_out(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim)
+{
+    if (out == NULL) return false;
+    return _reduce(out, t, axes, naxes, keepdim, SIMD_REDUCE_SUM, true, false, "tensor_mean_out") != NULL;
+}
+
+bool
+tensor_max_out(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim)
+{
+    if (out == NULL) return false;
+    return _reduce(out, t, axes, naxes, keepdim, SIMD_REDUCE_MAX, false, false, "tensor_max_out") != NULL;
+}
+
+bool
+tensor_min_out(Tensor out, const Tensor t, const int* axes, int naxes, bool keepdim)
+{
+    if (out == NULL) return false;
+    return _reduce(out, t, axes, naxes, keepdim, SIMD_REDUCE_MIN, false, false, "tensor_min_out") != NULL;
+}
+
+bool
+tensor_argmax_out(Tensor out, const Tensor t, int axis, bool keepdim)
+{
+    if (out == NULL) return false;
+    return _argmax(out, t, axis, keepdim, "tensor_argmax_out") != NULL;
+}
@@ -0,0 +1,1280 @@
+#include "tensor/_tensor_simd.h"
+#include "utils/_cpu_features.h"
+
+#include "tensor/_tensor_cast.h"
+
+#include <pthread.h> // for pthread_once()
+#include <stdint.h>  // for int32_t
+#include <string.h>  // for memcpy()
+#include <math.h>    // for lrintf(), expf(), exp()
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define SIMD_HAVE_NEON 1
+#include <arm_neon.h>
+#endif
+
+// 每个 (ISA, dtype, op) 生成三个函数：vv / vs / sv。
+// 主循环每次处理两个向量，尾部退回标量；标量表达式和 _tensor_ops.c 里的保持一致，
+// 这样无论落在哪条路径上结果都相同。
+#define _SIMD_DEFINE(ISA, ATTR, T, VT, W, LOAD, STORE, SET1, NAME, VOP, SOP) \
+static ATTR void \
+ISA##_##NAME##_vv(void* out, const void* a, const void* b, size_t n) \
+{ \
+    T* o = (T*)out; \
+    const T* x = (const T*)a; \
+    const T* y = (const T*)b; \
+    size_t i = 0; \
+    for (; i + 2 * (W) <= n; i += 2 * (W)) \
+    { \
+        VT l0 = LOAD(x + i), l1 = LOAD(x + i + (W)); \
+        VT r0 = LOAD(y + i), r1 = LOAD(y + i + (W)); \
+        STORE(o + i, VOP(l0, r0)); \
+        STORE(o + i + (W), VOP(l1, r1)); \
+    } \
+    for (; i < n; i++) { const T l = x[i], r = y[i]; o[i] = (SOP); } \
+} \
+static ATTR void \
+ISA##_##NAME##_vs(void* out, const void* a, const void* b, size_t n) \
+{ \
+    T* o = (T*)out; \
+    const T* x = (const T*)a; \
+    const T r = *(const T*)b; \
+    const VT vr = SET1(r); \
+    size_t i = 0; \
+    for (; i + 2 * (W) <= n; i += 2 * (W)) \
+    { \
+        VT l0 = LOAD(x + i), l1 = LOAD(x + i + (W)); \
+        STORE(o + i, VOP(l0, vr)); \
+        STORE(o + i + (W), VOP(l1, vr)); \
+    } \
+    for (; i < n; i++) { const T l = x[i]; o[i] = (SOP); } \
+} \
+static ATTR void \
+ISA##_##NAME##_sv(void* out, const void* a, const void* b, size_t n) \
+{ \
+    T* o = (T*)out; \
+    const T l = *(const T*)a; \
+    const T* y = (const T*)b; \
+    const VT vl = SET1(l); \
+    size_t i = 0; \
+    for (; i + 2 * (W) <= n; i += 2 * (W)) \
+    { \
+        VT r0 = LOAD(y + i), r1 = LOAD(y + i + (W)); \
+        STORE(o + i, VOP(vl, r0)); \
+        STORE(o + i + (W), VOP(vl, r1)); \
+    } \
+    for (; i < n; i++) { const T r = y[i]; o[i] = (SOP); } \
+}
+
+#define _SIMD_REGISTER(table, OP, DT, ISA, NAME) \
+    do { \
+        (table)->binary[OP][DT][SIMD_LAYOUT_VV] = ISA##_##NAME##_vv; \
+        (table)->binary[OP][DT][SIMD_LAYOUT_VS] = ISA##_##NAME##_vs; \
+        (table)->binary[OP][DT][SIMD_LAYOUT_SV] = ISA##_##NAME##_sv; \
+    } while (0)
+
+// 浮点类型共用的一组 op 注册
+#define _SIMD_REGISTER_FLOAT(table, DT, ISA) \
+    do { \
+        _SIMD_REGISTER(table, BINARY_OP_ADD, DT, ISA, add); \
+        _SIMD_REGISTER(table, BINARY_OP_SUB, DT, ISA, sub); \
+        _SIMD_REGISTER(table, BINARY_OP_MUL, DT, ISA, mul); \
+        _SIMD_REGISTER(table, BINARY_OP_DIV, DT, ISA, div); \
+        _SIMD_REGISTER(table, BINARY_OP_MAX, DT, ISA, max); \
+        _SIMD_REGISTER(table, BINARY_OP_MIN, DT, ISA, min); \
+    } while (0)
+
+// 整数没有向量除法，DIV 留空由标量内核处理
+#define _SIMD_REGISTER_INT(table, DT, ISA) \
+    do { \
+        _SIMD_REGISTER(table, BINARY_OP_ADD, DT, ISA, add); \
+        _SIMD_REGISTER(table, BINARY_OP_SUB, DT, ISA, sub); \
+        _SIMD_REGISTER(table, BINARY_OP_MUL, DT, ISA, mul); \
+        _SIMD_REGISTER(table, BINARY_OP_MAX, DT, ISA, max); \
+        _SIMD_REGISTER(table, BINARY_OP_MIN, DT, ISA, min); \
+    } while (0)
+
+#define _SIMD_FLOAT_OPS(DEF, ADD, SUB, MUL, DIV, MAX, MIN) \
+    DEF(add, ADD, l + r) \
+    DEF(sub, SUB, l - r) \
+    DEF(mul, MUL, l * r) \
+    DEF(div, DIV, l / r) \
+    DEF(max, MAX, (l > r ? l : r)) \
+    DEF(min, MIN, (l < r ? l : r))
+
+// 整数的尾部元素经 uint32_t 计算，溢出时与向量部分一样回绕（有符号溢出是未定义行为）
+#define _SIMD_INT_OPS(DEF, ADD, SUB, MUL, MAX, MIN) \
+    DEF(add, ADD, (int32_t)((uint32_t)l + (uint32_t)r)) \
+    DEF(sub, SUB, (int32_t)((uint32_t)l - (uint32_t)r)) \
+    DEF(mul, MUL, (int32_t)((uint32_t)l * (uint32_t)r)) \
+    DEF(max, MAX, (l > r ? l : r)) \
+    DEF(min, MIN, (l < r ? l : r))
+
+// 浮点求和：每 SIMD_SUM_BLOCK 个元素先在 4 组向量寄存器里累加，再按 double 并入总和，
+// 分块把单精度的误差限制在块内，1e8 级别的输入依然准确。
+#define _SIMD_DEFINE_SUM(ISA, ATTR, T, VT, W, LOAD, ZERO, ADD, STOREU) \
+static ATTR void \
+ISA##_sum(const void* x, size_t n, void* acc) \
+{ \
+    const T* p = (const T*)x; \
+    double total = *(double*)acc; \
+    size_t i = 0; \
+    while (n - i >= 4 * (W)) \
+    { \
+        const size_t end = (n - i > SIMD_SUM_BLOCK) ? i + SIMD_SUM_BLOCK : n; \
+        VT s0 = ZERO(), s1 = ZERO(), s2 = ZERO(), s3 = ZERO(); \
+        for (; i + 4 * (W) <= end; i += 4 * (W)) \
+        { \
+            s0 = ADD(s0, LOAD(p + i)); \
+            s1 = ADD(s1, LOAD(p + i + (W))); \
+            s2 = ADD(s2, LOAD(p + i + 2 * (W))); \
+            s3 = ADD(s3, LOAD(p + i + 3 * (W))); \
+        } \
+        T lanes[W]; \
+        STOREU(lanes, ADD(ADD(s0, s1), ADD(s2, s3))); \
+        for (int l = 0; l < (W); l++) total += lanes[l]; \
+    } \
+    for (; i < n; i++) total += p[i]; \
+    *(double*)acc = total; \
+}
+
+// max / min：两组向量并行比较，最后在各 lane 之间收拢；
+// SOP 的形式 (l 为累计值, r 为新元素) 与向量指令的语义一致，遇到 NaN 时都让 NaN 传下去。
+#define _SIMD_DEFINE_MINMAX(ISA, ATTR, T, VT, W, LOAD, SET1, STOREU, NAME, VOP, SOP) \
+static ATTR void \
+ISA##_##NAME(const void* x, size_t n, void* acc) \
+{ \
+    const T* p = (const T*)x; \
+    T best = *(T*)acc; \
+    size_t i = 0; \
+    if (n >= 2 * (W)) \
+    { \
+        VT v0 = SET1(best), v1 = v0; \
+        for (; i + 2 * (W) <= n; i += 2 * (W)) \
+        { \
+            v0 = VOP(v0, LOAD(p + i)); \
+            v1 = VOP(v1, LOAD(p + i + (W))); \
+        } \
+        T lanes[W]; \
+        STOREU(lanes, VOP(v0, v1)); \
+        for (int k = 0; k < (W); k++) { const T l = best, r = lanes[k]; best = (SOP); } \
+    } \
+    for (; i < n; i++) { const T l = best, r = p[i]; best = (SOP); } \
+    *(T*)acc = best; \
+}
+
+#define _SIMD_DEFINE_REDUCE(ISA, ATTR, T, VT, W, LOAD, SET1, STOREU, MAX, MIN) \
+    _SIMD_DEFINE_MINMAX(ISA, ATTR, T, VT, W, LOAD, SET1, STOREU, max, MAX, SIMD_MAX_NAN(l, r)) \
+    _SIMD_DEFINE_MINMAX(ISA, ATTR, T, VT, W, LOAD, SET1, STOREU, min, MIN, SIMD_MIN_NAN(l, r))
+
+#define _SIMD_REGISTER_REDUCE(table, DT, ISA) \
+    do { \
+        (table)->reduce[SIMD_REDUCE_SUM][DT] = ISA##_sum; \
+        (table)->reduce[SIMD_REDUCE_MAX][DT] = ISA##_max; \
+        (table)->reduce[SIMD_REDUCE_MIN][DT] = ISA##_min; \
+    } while (0)
+
+// GEMM 微内核：MR x NR 的 C 块留在寄存器里，NR / W 个向量一行。
+// 每个 k 读一组 B（NR 个）、逐行广播一个 A，做 FMA；最后把累加结果加回 C。
+#define _SIMD_DEFINE_GEMM(ISA, ATTR, T, VT, W, NR, LOAD, STORE, SET1, ZERO, ADD, FMA) \
+static ATTR void \
+ISA##_gemm(size_t kc, const void* a, const void* b, void* c, size_t ldc) \
+{ \
+    const T* pa = (const T*)a; \
+    const T* pb = (const T*)b; \
+    T* pc = (T*)c; \
+    VT acc[SIMD_GEMM_MR][(NR) / (W)]; \
+    _Pragma("GCC unroll 8") \
+    for (int i = 0; i < SIMD_GEMM_MR; i++) \
+        _Pragma("GCC unroll 8") \
+        for (int v = 0; v < (NR) / (W); v++) acc[i][v] = ZERO(); \
+    for (size_t k = 0; k < kc; k++, pa += SIMD_GEMM_MR, pb += (NR)) \
+    { \
+        VT bv[(NR) / (W)]; \
+        _Pragma("GCC unroll 8") \
+        for (int v = 0; v < (NR) / (W); v++) bv[v] = LOAD(pb + v * (W)); \
+        _Pragma("GCC unroll 8") \
+        for (int i = 0; i < SIMD_GEMM_MR; i++) \
+        { \
+            const VT ai = SET1(pa[i]); \
+            _Pragma("GCC unroll 8") \
+            for (int v = 0; v < (NR) / (W); v++) acc[i][v] = FMA(ai, bv[v], acc[i][v]); \
+        } \
+    } \
+    _Pragma("GCC unroll 8") \
+    for (int i = 0; i < SIMD_GEMM_MR; i++) \
+        _Pragma("GCC unroll 8") \
+        for (int v = 0; v < (NR) / (W); v++) \
+        { \
+            T* row = pc + i * ldc + v * (W); \
+            STORE(row, ADD(LOAD(row), acc[i][v])); \
+        } \
+}
+
+// 块的合并（Chan 等人的公式）：count/mean/m2 是已经合并的部分，加入一个新块
+static inline void
+_moments_merge(double* count, double* mean, double* m2, double block_count, double block_mean, double block_m2)
+{
+    const double total = *count + block_count;
+    const double delta = block_mean - *mean;
+    *mean += delta * block_count / total;
+    *m2 += block_m2 + delta * delta * *count * block_count / total;
+    *count = total;
+}
+
+// 均值和平方偏差和：每 SIMD_SUM_BLOCK 个元素一块，块内先求和得到块均值 c（元素类型），
+// 再累加 (x - c)^2；c 与真实块均值之差按 m * (mean - c)^2 修正回来，最后逐块合并
+#define _SIMD_DEFINE_MOMENTS(ISA, ATTR, T, VT, W, LOAD, ZERO, SET1, ADD, SUB, MUL, STOREU) \
+static ATTR void \
+ISA##_moments(const void* x, size_t n, double* mean, double* m2) \
+{ \
+    const T* p = (const T*)x; \
+    double count = 0.0, mu = 0.0, q = 0.0; \
+    for (size_t start = 0; start < n; start += SIMD_SUM_BLOCK) \
+    { \
+        const T* b = p + start; \
+        const size_t m = (n - start < SIMD_SUM_BLOCK) ? n - start : SIMD_SUM_BLOCK; \
+        T lanes[W]; \
+        size_t i = 0; \
+        VT s0 = ZERO(), s1 = ZERO(); \
+        for (; i + 2 * (W) <= m; i += 2 * (W)) \
+        { \
+            s0 = ADD(s0, LOAD(b + i)); \
+            s1 = ADD(s1, LOAD(b + i + (W))); \
+        } \
+        STOREU(lanes, ADD(s0, s1)); \
+        double sum = 0.0; \
+        for (int l = 0; l < (W); l++) sum += lanes[l]; \
+        for (; i < m; i++) sum += b[i]; \
+        const double bm = sum / (double)m; \
+        const T c = (T)bm; \
+        const VT vc = SET1(c); \
+        s0 = ZERO(); \
+        s1 = ZERO(); \
+        for (i = 0; i + 2 * (W) <= m; i += 2 * (W)) \
+        { \
+            const VT d0 = SUB(LOAD(b + i), vc), d1 = SUB(LOAD(b + i + (W)), vc); \
+            s0 = ADD(s0, MUL(d0, d0)); \
+            s1 = ADD(s1, MUL(d1, d1)); \
+        } \
+        STOREU(lanes, ADD(s0, s1)); \
+        double dev = 0.0; \
+        for (int l = 0; l < (W); l++) dev += lanes[l]; \
+        for (; i < m; i++) { const double d = (double)(b[i] - c); dev += d * d; } \
+        dev -= (double)m * (bm - c) * (bm - c); \
+        _moments_merge(&count, &mu, &q, (double)m, bm, (dev > 0.0) ? dev : 0.0); \
+    } \
+    *mean = mu; \
+    *m2 = q; \
+}
+
+// --- x86: AVX2 ---
+#ifdef SIMD_HAVE_X86
+
+#define _ATTR_AVX2 __attribute__((target("avx2,fma")))
+#define _AVX2_LOADI(p) _mm256_loadu_si256((const __m256i*)(p))
+#define _AVX2_STOREI(p, v) _mm256_storeu_si256((__m256i*)(p), (v))
+
+#define _AVX2_F32(NAME, VOP, SOP) _SIMD_DEFINE(avx2_f32, _ATTR_AVX2, float, __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, NAME, VOP, SOP)
+#define _AVX2_F64(NAME, VOP, SOP) _SIMD_DEFINE(avx2_f64, _ATTR_AVX2, double, __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, NAME, VOP, SOP)
+#define _AVX2_I32(NAME, VOP, SOP) _SIMD_DEFINE(avx2_i32, _ATTR_AVX2, int32_t, __m256i, 8, _AVX2_LOADI, _AVX2_STOREI, _mm256_set1_epi32, NAME, VOP, SOP)
+
+_SIMD_FLOAT_OPS(_AVX2_F32, _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_div_ps, _mm256_max_ps, _mm256_min_ps)
+_SIMD_FLOAT_OPS(_AVX2_F64, _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_div_pd, _mm256_max_pd, _mm256_min_pd)
+_SIMD_INT_OPS(_AVX2_I32, _mm256_add_epi32, _mm256_sub_epi32, _mm256_mullo_epi32, _mm256_max_epi32, _mm256_min_epi32)
+
+_SIMD_DEFINE_SUM(avx2_f32, _ATTR_AVX2, float, __m256, 8, _mm256_loadu_ps, _mm256_setzero_ps, _mm256_add_ps, _mm256_storeu_ps)
+_SIMD_DEFINE_SUM(avx2_f64, _ATTR_AVX2, double, __m256d, 4, _mm256_loadu_pd, _mm256_setzero_pd, _mm256_add_pd, _mm256_storeu_pd)
+// 规约用的 max/min：max_ps(l, r) 有 NaN 时返回 r，累计值 l 已经是 NaN 时再把它选回来
+#define _AVX2_MAXN_PS(l, r) _mm256_blendv_ps(_mm256_max_ps((l), (r)), (l), _mm256_cmp_ps((l), (l), _CMP_UNORD_Q))
+#define _AVX2_MINN_PS(l, r) _mm256_blendv_ps(_mm256_min_ps((l), (r)), (l), _mm256_cmp_ps((l), (l), _CMP_UNORD_Q))
+#define _AVX2_MAXN_PD(l, r) _mm256_blendv_pd(_mm256_max_pd((l), (r)), (l), _mm256_cmp_pd((l), (l), _CMP_UNORD_Q))
+#define _AVX2_MINN_PD(l, r) _mm256_blendv_pd(_mm256_min_pd((l), (r)), (l), _mm256_cmp_pd((l), (l), _CMP_UNORD_Q))
+
+_SIMD_DEFINE_REDUCE(avx2_f32, _ATTR_AVX2, float, __m256, 8, _mm256_loadu_ps, _mm256_set1_ps, _mm256_storeu_ps, _AVX2_MAXN_PS, _AVX2_MINN_PS)
+_SIMD_DEFINE_REDUCE(avx2_f64, _ATTR_AVX2, double, __m256d, 4, _mm256_loadu_pd, _mm256_set1_pd, _mm256_storeu_pd, _AVX2_MAXN_PD, _AVX2_MINN_PD)
+_SIMD_DEFINE_REDUCE(avx2_i32, _ATTR_AVX2, int32_t, __m256i, 8, _AVX2_LOADI, _mm256_set1_epi32, _AVX2_STOREI, _mm256_max_epi32, _mm256_min_epi32)
+
+_SIMD_DEFINE_GEMM(avx2_f32, _ATTR_AVX2, float, __m256, 8, SIMD_GEMM_NR_F32, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_set1_ps, _mm256_setzero_ps, _mm256_add_ps, _mm256_fmadd_ps)
+_SIMD_DEFINE_GEMM(avx2_f64, _ATTR_AVX2, double, __m256d, 4, SIMD_GEMM_NR_F64, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_set1_pd, _mm256_setzero_pd, _mm256_add_pd, _mm256_fmadd_pd)
+
+_SIMD_DEFINE_MOMENTS(avx2_f32, _ATTR_AVX2, float, __m256, 8, _mm256_loadu_ps, _mm256_setzero_ps, _mm256_set1_ps, _mm256_add_ps, _mm256_sub_ps, _mm256_mul_ps, _mm256_storeu_ps)
+_SIMD_DEFINE_MOMENTS(avx2_f64, _ATTR_AVX2, double, __m256d, 4, _mm256_loadu_pd, _mm256_setzero_pd, _mm256_set1_pd, _mm256_add_pd, _mm256_sub_pd, _mm256_mul_pd, _mm256_storeu_pd)
+
+// I32 求和先扩展到 64 位再累加，不会溢出
+static _ATTR_AVX2 void
+avx2_i32_sum(const void* x, size_t n, void* acc)
+{
+    const int32_t* p = (const int32_t*)x;
+    int64_t total = *(int64_t*)acc;
+    size_t i = 0;
+    __m256i s0 = _mm256_setzero_si256(), s1 = _mm256_setzero_si256();
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _AVX2_LOADI(p + i);
+        s0 = _mm256_add_epi64(s0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        s1 = _mm256_add_epi64(s1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    int64_t lanes[4];
+    _AVX2_STOREI(lanes, _mm256_add_epi64(s0, s1));
+    total += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < n; i++) total += p[i];
+    *(int64_t*)acc = total;
+}
+
+// expf 的向量近似（Cephes）：x = k ln2 + r，|r| <= ln2 / 2，r 上用 5 次多项式，再把 k 拼进指数位。
+// 小于 ln(FLT_MIN) 的输入直接得到 0，所以 softmax 里被屏蔽成 -inf 的位置是精确的 0；
+// 大于 _EXP_HI 的输入得到 Inf（指数位放不下 2^128）。
+// min/max 遇到 NaN 时返回第二个操作数，把 x 放在第二个位置就能让 NaN 原样传下去。
+#define _EXP_HI 88.3762626647949f
+#define _EXP_LO -87.3365447504f
+#define _EXP_LOG2E 1.44269504088896341f
+#define _EXP_C1 0.693359375f
+#define _EXP_C2 -2.12194440e-4f
+#define _EXP_P0 1.9875691500e-4f
+#define _EXP_P1 1.3981999507e-3f
+#define _EXP_P2 8.3334519073e-3f
+#define _EXP_P3 4.1665795894e-2f
+#define _EXP_P4 1.6666665459e-1f
+#define _EXP_P5 5.0000001201e-1f
+
+static _ATTR_AVX2 inline __m256
+_avx2_exp_ps(__m256 x)
+{
+    const __m256 under = _mm256_cmp_ps(x, _mm256_set1_ps(_EXP_LO), _CMP_LT_OQ);
+    const __m256 over = _mm256_cmp_ps(x, _mm256_set1_ps(_EXP_HI), _CMP_GT_OQ);
+    x = _mm256_min_ps(_mm256_set1_ps(_EXP_HI), x);
+    x = _mm256_max_ps(_mm256_set1_ps(_EXP_LO), x);
+    const __m256 k = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(_EXP_LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256 r = _mm256_fnmadd_ps(k, _mm256_set1_ps(_EXP_C1), x);
+    r = _mm256_fnmadd_ps(k, _mm256_set1_ps(_EXP_C2), r);
+    __m256 y = _mm256_set1_ps(_EXP_P0);
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(_EXP_P1));
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(_EXP_P2));
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(_EXP_P3));
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(_EXP_P4));
+    y = _mm256_fmadd_ps(y, r, _mm256_set1_ps(_EXP_P5));
+    y = _mm256_fmadd_ps(y, _mm256_mul_ps(r, r), _mm256_add_ps(r, _mm256_set1_ps(1.0f)));
+    const __m256i e = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(k), _mm256_set1_epi32(127)), 23);
+    y = _mm256_andnot_ps(under, _mm256_mul_ps(y, _mm256_castsi256_ps(e)));
+    return _mm256_blendv_ps(y, _mm256_set1_ps(INFINITY), over);
+}
+
+// 尾部用掩码读写，和主循环走同一个近似，结果与元素落在哪个位置无关
+static _ATTR_AVX2 double
+avx2_f32_exp(void* out, const void* x, size_t n, double shift, double scale)
+{
+    const float* p = (const float*)x;
+    float* o = (float*)out;
+    const __m256 vs = _mm256_set1_ps((float)shift), vk = _mm256_set1_ps((float)scale);
+    double total = 0.0;
+    for (size_t start = 0; start < n; start += SIMD_SUM_BLOCK)
+    {
+        const size_t end = (n - start > SIMD_SUM_BLOCK) ? start + SIMD_SUM_BLOCK : n;
+        __m256 s = _mm256_setzero_ps();
+        size_t i = start;
+        for (; i + 8 <= end; i += 8)
+        {
+            const __m256 e = _avx2_exp_ps(_mm256_sub_ps(_mm256_loadu_ps(p + i), vs));
+            s = _mm256_add_ps(s, e);
+            if (o != NULL) _mm256_storeu_ps(o + i, _mm256_mul_ps(e, vk));
+        }
+        if (i < end)
+        {
+            const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(end - i)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            const __m256 e = _mm256_and_ps(_mm256_castsi256_ps(mask), _avx2_exp_ps(_mm256_sub_ps(_mm256_maskload_ps(p + i, mask), vs)));
+            s = _mm256_add_ps(s, e);
+            if (o != NULL) _mm256_maskstore_ps(o + i, mask, _mm256_mul_ps(e, vk));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, s);
+        for (int l = 0; l < 8; l++) total += lanes[l];
+    }
+    return total;
+}
+
+// 排序键的向量版本，与 simd_sort_key_f32() 逐位一致
+static _ATTR_AVX2 inline __m256i
+_avx2_key_ps(__m256 v)
+{
+    const __m256i zero = _mm256_castps_si256(_mm256_cmp_ps(v, _mm256_setzero_ps(), _CMP_EQ_OQ));
+    const __m256i u = _mm256_andnot_si256(zero, _mm256_castps_si256(v));
+    const __m256i key = _mm256_xor_si256(u, _mm256_or_si256(_mm256_srai_epi32(u, 31), _mm256_set1_epi32(INT32_MIN)));
+    return _mm256_or_si256(key, _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+}
+
+#define _AVX2_KEY_I32(v) _mm256_xor_si256((v), _mm256_set1_epi32(INT32_MIN))
+#define _AVX2_KEY_F32(v) _avx2_key_ps(_mm256_castsi256_ps(v))
+
+// 16 个一组比较；AVX2 只有有符号比较，键和阈值都翻转符号位后顺序不变
+#define _AVX2_FIND_ABOVE(NAME, T, KEY, SCALAR_KEY) \
+static _ATTR_AVX2 size_t \
+avx2_##NAME##_find_above(const void* x, size_t n, uint32_t threshold, uint32_t flip) \
+{ \
+    const T* p = (const T*)x; \
+    const __m256i bias = _mm256_set1_epi32((int32_t)(flip ^ 0x80000000u)); \
+    const __m256i t = _mm256_set1_epi32((int32_t)(threshold ^ 0x80000000u)); \
+    size_t i = 0; \
+    for (; i + 16 <= n; i += 16) \
+    { \
+        const __m256i a = _mm256_xor_si256(KEY(_mm256_loadu_si256((const __m256i*)(p + i))), bias); \
+        const __m256i b = _mm256_xor_si256(KEY(_mm256_loadu_si256((const __m256i*)(p + i + 8))), bias); \
+        const uint32_t lo = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, t))); \
+        const uint32_t hi = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, t))); \
+        const uint32_t mask = lo | (hi << 8); \
+        if (mask != 0) return i + (size_t)__builtin_ctz(mask); \
+    } \
+    for (; i < n; i++) \
+        if ((SCALAR_KEY(p[i]) ^ flip) > threshold) return i; \
+    return n; \
+}
+
+_AVX2_FIND_ABOVE(i32, int32_t, _AVX2_KEY_I32, simd_sort_key_i32)
+_AVX2_FIND_ABOVE(f32, float, _AVX2_KEY_F32, simd_sort_key_f32)
+
+static void
+_register_avx2(SimdKernelTable* table)
+{
+    table->name = "avx2";
+    _SIMD_REGISTER_INT(table, DTYPE_I32, avx2_i32);
+    _SIMD_REGISTER_FLOAT(table, DTYPE_F32, avx2_f32);
+    _SIMD_REGISTER_FLOAT(table, DTYPE_F64, avx2_f64);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_I32, avx2_i32);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_F32, avx2_f32);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_F64, avx2_f64);
+    table->gemm[DTYPE_F32] = avx2_f32_gemm;
+    table->gemm[DTYPE_F64] = avx2_f64_gemm;
+    table->exp[DTYPE_F32] = avx2_f32_exp;
+    table->moments[DTYPE_F32] = avx2_f32_moments;
+    table->moments[DTYPE_F64] = avx2_f64_moments;
+    table->find_above[DTYPE_I32] = avx2_i32_find_above;
+    table->find_above[DTYPE_F32] = avx2_f32_find_above;
+}
+
+// --- x86: AVX-512 ---
+
+#define _ATTR_AVX512 __attribute__((target("avx512f")))
+
+#define _AVX512_F32(NAME, VOP, SOP) _SIMD_DEFINE(avx512_f32, _ATTR_AVX512, float, __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, NAME, VOP, SOP)
+#define _AVX512_F64(NAME, VOP, SOP) _SIMD_DEFINE(avx512_f64, _ATTR_AVX512, double, __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, NAME, VOP, SOP)
+#define _AVX512_I32(NAME, VOP, SOP) _SIMD_DEFINE(avx512_i32, _ATTR_AVX512, int32_t, __m512i, 16, _mm512_loadu_si512, _mm512_storeu_si512, _mm512_set1_epi32, NAME, VOP, SOP)
+
+_SIMD_FLOAT_OPS(_AVX512_F32, _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps, _mm512_div_ps, _mm512_max_ps, _mm512_min_ps)
+_SIMD_FLOAT_OPS(_AVX512_F64, _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd, _mm512_div_pd, _mm512_max_pd, _mm512_min_pd)
+_SIMD_INT_OPS(_AVX512_I32, _mm512_add_epi32, _mm512_sub_epi32, _mm512_mullo_epi32, _mm512_max_epi32, _mm512_min_epi32)
+
+_SIMD_DEFINE_GEMM(avx512_f32, _ATTR_AVX512, float, __m512, 16, SIMD_GEMM_NR_F32, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_set1_ps, _mm512_setzero_ps, _mm512_add_ps, _mm512_fmadd_ps)
+_SIMD_DEFINE_GEMM(avx512_f64, _ATTR_AVX512, double, __m512d, 8, SIMD_GEMM_NR_F64, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_set1_pd, _mm512_setzero_pd, _mm512_add_pd, _mm512_fmadd_pd)
+
+_SIMD_DEFINE_MOMENTS(avx512_f32, _ATTR_AVX512, float, __m512, 16, _mm512_loadu_ps, _mm512_setzero_ps, _mm512_set1_ps, _mm512_add_ps, _mm512_sub_ps, _mm512_mul_ps, _mm512_storeu_ps)
+_SIMD_DEFINE_MOMENTS(avx512_f64, _ATTR_AVX512, double, __m512d, 8, _mm512_loadu_pd, _mm512_setzero_pd, _mm512_set1_pd, _mm512_add_pd, _mm512_sub_pd, _mm512_mul_pd, _mm512_storeu_pd)
+
+_SIMD_DEFINE_SUM(avx512_f32, _ATTR_AVX512, float, __m512, 16, _mm512_loadu_ps, _mm512_setzero_ps, _mm512_add_ps, _mm512_storeu_ps)
+_SIMD_DEFINE_SUM(avx512_f64, _ATTR_AVX512, double, __m512d, 8, _mm512_loadu_pd, _mm512_setzero_pd, _mm512_add_pd, _mm512_storeu_pd)
+#define _AVX512_MAXN_PS(l, r) _mm512_mask_blend_ps(_mm512_cmp_ps_mask((l), (l), _CMP_UNORD_Q), _mm512_max_ps((l), (r)), (l))
+#define _AVX512_MINN_PS(l, r) _mm512_mask_blend_ps(_mm512_cmp_ps_mask((l), (l), _CMP_UNORD_Q), _mm512_min_ps((l), (r)), (l))
+#define _AVX512_MAXN_PD(l, r) _mm512_mask_blend_pd(_mm512_cmp_pd_mask((l), (l), _CMP_UNORD_Q), _mm512_max_pd((l), (r)), (l))
+#define _AVX512_MINN_PD(l, r) _mm512_mask_blend_pd(_mm512_cmp_pd_mask((l), (l), _CMP_UNORD_Q), _mm512_min_pd((l), (r)), (l))
+
+_SIMD_DEFINE_REDUCE(avx512_f32, _ATTR_AVX512, float, __m512, 16, _mm512_loadu_ps, _mm512_set1_ps, _mm512_storeu_ps, _AVX512_MAXN_PS, _AVX512_MINN_PS)
+_SIMD_DEFINE_REDUCE(avx512_f64, _ATTR_AVX512, double, __m512d, 8, _mm512_loadu_pd, _mm512_set1_pd, _mm512_storeu_pd, _AVX512_MAXN_PD, _AVX512_MINN_PD)
+_SIMD_DEFINE_REDUCE(avx512_i32, _ATTR_AVX512, int32_t, __m512i, 16, _mm512_loadu_si512, _mm512_set1_epi32, _mm512_storeu_si512, _mm512_max_epi32, _mm512_min_epi32)
+
+static _ATTR_AVX512 void
+avx512_i32_sum(const void* x, size_t n, void* acc)
+{
+    const int32_t* p = (const int32_t*)x;
+    int64_t total = *(int64_t*)acc;
+    size_t i = 0;
+    __m512i s0 = _mm512_setzero_si512(), s1 = _mm512_setzero_si512();
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512i v = _mm512_loadu_si512(p + i);
+        s0 = _mm512_add_epi64(s0, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+        s1 = _mm512_add_epi64(s1, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+    }
+    total += _mm512_reduce_add_epi64(_mm512_add_epi64(s0, s1));
+    for (; i < n; i++) total += p[i];
+    *(int64_t*)acc = total;
+}
+
+static _ATTR_AVX512 inline __m512
+_avx512_exp_ps(__m512 x)
+{
+    const __mmask16 under = _mm512_cmp_ps_mask(x, _mm512_set1_ps(_EXP_LO), _CMP_LT_OQ);
+    const __mmask16 over = _mm512_cmp_ps_mask(x, _mm512_set1_ps(_EXP_HI), _CMP_GT_OQ);
+    x = _mm512_min_ps(_mm512_set1_ps(_EXP_HI), x);
+    x = _mm512_max_ps(_mm512_set1_ps(_EXP_LO), x);
+    const __m512 k = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps(_EXP_LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512 r = _mm512_fnmadd_ps(k, _mm512_set1_ps(_EXP_C1), x);
+    r = _mm512_fnmadd_ps(k, _mm512_set1_ps(_EXP_C2), r);
+    __m512 y = _mm512_set1_ps(_EXP_P0);
+    y = _mm512_fmadd_ps(y, r, _mm512_set1_ps(_EXP_P1));
+    y = _mm512_fmadd_ps(y, r, _mm512_set1_ps(_EXP_P2));
+    y = _mm512_fmadd_ps(y, r, _mm512_set1_ps(_EXP_P3));
+    y = _mm512_fmadd_ps(y, r, _mm512_set1_ps(_EXP_P4));
+    y = _mm512_fmadd_ps(y, r, _mm512_set1_ps(_EXP_P5));
+    y = _mm512_fmadd_ps(y, _mm512_mul_ps(r, r), _mm512_add_ps(r, _mm512_set1_ps(1.0f)));
+    const __m512i e = _mm512_slli_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(k), _mm512_set1_epi32(127)), 23);
+    y = _mm512_maskz_mul_ps((__mmask16)~under, y, _mm512_castsi512_ps(e));
+    return _mm512_mask_mov_ps(y, over, _mm512_set1_ps(INFINITY));
+}
+
+static _ATTR_AVX512 double
+avx512_f32_exp(void* out, const void* x, size_t n, double shift, double scale)
+{
+    const float* p = (const float*)x;
+    float* o = (float*)out;
+    const __m512 vs = _mm512_set1_ps((float)shift), vk = _mm512_set1_ps((float)scale);
+    double total = 0.0;
+    for (size_t start = 0; start < n; start += SIMD_SUM_BLOCK)
+    {
+        const size_t end = (n - start > SIMD_SUM_BLOCK) ? start + SIMD_SUM_BLOCK : n;
+        __m512 s = _mm512_setzero_ps();
+        size_t i = start;
+        for (; i + 16 <= end; i += 16)
+        {
+            const __m512 e = _avx512_exp_ps(_mm512_sub_ps(_mm512_loadu_ps(p + i), vs));
+            s = _mm512_add_ps(s, e);
+            if (o != NULL) _mm512_storeu_ps(o + i, _mm512_mul_ps(e, vk));
+        }
+        if (i < end)
+        {
+            const __mmask16 mask = (__mmask16)((1u << (end - i)) - 1);
+            const __m512 e = _mm512_maskz_mov_ps(mask, _avx512_exp_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(mask, p + i), vs)));
+            s = _mm512_add_ps(s, e);
+            if (o != NULL) _mm512_mask_storeu_ps(o + i, mask, _mm512_mul_ps(e, vk));
+        }
+        float lanes[16];
+        _mm512_storeu_ps(lanes, s);
+        for (int l = 0; l < 16; l++) total += lanes[l];
+    }
+    return total;
+}
+
+static _ATTR_AVX512 inline __m512i
+_avx512_key_ps(__m512 v)
+{
+    const __mmask16 zero = _mm512_cmp_ps_mask(v, _mm512_setzero_ps(), _CMP_EQ_OQ);
+    const __m512i u = _mm512_maskz_mov_epi32((__mmask16)~zero, _mm512_castps_si512(v));
+    const __m512i key = _mm512_xor_si512(u, _mm512_or_si512(_mm512_srai_epi32(u, 31), _mm512_set1_epi32(INT32_MIN)));
+    return _mm512_mask_mov_epi32(key, _mm512_cmp_ps_mask(v, v, _CMP_UNORD_Q), _mm512_set1_epi32(-1));
+}
+
+#define _AVX512_KEY_I32(v) _mm512_xor_si512((v), _mm512_set1_epi32(INT32_MIN))
+#define _AVX512_KEY_F32(v) _avx512_key_ps(_mm512_castsi512_ps(v))
+
+// 32 个一组比较，尾部用掩码
+#define _AVX512_FIND_ABOVE(NAME, KEY) \
+static _ATTR_AVX512 size_t \
+avx512_##NAME##_find_above(const void* x, size_t n, uint32_t threshold, uint32_t flip) \
+{ \
+    const int32_t* p = (const int32_t*)x; \
+    const __m512i f = _mm512_set1_epi32((int32_t)flip); \
+    const __m512i t = _mm512_set1_epi32((int32_t)threshold); \
+    size_t i = 0; \
+    for (; i + 32 <= n; i += 32) \
+    { \
+        const __m512i a = _mm512_xor_si512(KEY(_mm512_loadu_si512(p + i)), f); \
+        const __m512i b = _mm512_xor_si512(KEY(_mm512_loadu_si512(p + i + 16)), f); \
+        const uint32_t mask = (uint32_t)_mm512_cmpgt_epu32_mask(a, t) | ((uint32_t)_mm512_cmpgt_epu32_mask(b, t) << 16); \
+        if (mask != 0) return i + (size_t)__builtin_ctz(mask); \
+    } \
+    for (; i < n; i += 16) \
+    { \
+        const __mmask16 live = (n - i >= 16) ? (__mmask16)0xffff : (__mmask16)((1u << (n - i)) - 1); \
+        const __m512i a = _mm512_xor_si512(KEY(_mm512_maskz_loadu_epi32(live, p + i)), f); \
+        const uint32_t mask = _mm512_mask_cmpgt_epu32_mask(live, a, t); \
+        if (mask != 0) return i + (size_t)__builtin_ctz(mask); \
+    } \
+    return n; \
+}
+
+_AVX512_FIND_ABOVE(i32, _AVX512_KEY_I32)
+_AVX512_FIND_ABOVE(f32, _AVX512_KEY_F32)
+
+static void
+_register_avx512(SimdKernelTable* table)
+{
+    table->name = "avx512";
+    _SIMD_REGISTER_INT(table, DTYPE_I32, avx512_i32);
+    _SIMD_REGISTER_FLOAT(table, DTYPE_F32, avx512_f32);
+    _SIMD_REGISTER_FLOAT(table, DTYPE_F64, avx512_f64);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_I32, avx512_i32);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_F32, avx512_f32);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_F64, avx512_f64);
+    table->gemm[DTYPE_F32] = avx512_f32_gemm;
+    table->gemm[DTYPE_F64] = avx512_f64_gemm;
+    table->exp[DTYPE_F32] = avx512_f32_exp;
+    table->moments[DTYPE_F32] = avx512_f32_moments;
+    table->moments[DTYPE_F64] = avx512_f64_moments;
+    table->find_above[DTYPE_I32] = avx512_i32_find_above;
+    table->find_above[DTYPE_F32] = avx512_f32_find_above;
+}
+
+#endif // SIMD_HAVE_X86
+
+// --- ARM: NEON ---
+#ifdef SIMD_HAVE_NEON
+
+#define _ATTR_NEON
+
+#define _NEON_F32(NAME, VOP, SOP) _SIMD_DEFINE(neon_f32, _ATTR_NEON, float, float32x4_t, 4, vld1q_f32, vst1q_f32, vdupq_n_f32, NAME, VOP, SOP)
+#define _NEON_F64(NAME, VOP, SOP) _SIMD_DEFINE(neon_f64, _ATTR_NEON, double, float64x2_t, 2, vld1q_f64, vst1q_f64, vdupq_n_f64, NAME, VOP, SOP)
+#define _NEON_I32(NAME, VOP, SOP) _SIMD_DEFINE(neon_i32, _ATTR_NEON, int32_t, int32x4_t, 4, vld1q_s32, vst1q_s32, vdupq_n_s32, NAME, VOP, SOP)
+
+// vmaxq/vminq 遇到 NaN 返回 NaN；按比较结果选择，与标量的 (l > r ? l : r) 和 x86 的 max_ps 一样，
+// 比较不成立（包括有 NaN）时取 r
+#define _NEON_MAX_F32(l, r) vbslq_f32(vcgtq_f32((l), (r)), (l), (r))
+#define _NEON_MIN_F32(l, r) vbslq_f32(vcltq_f32((l), (r)), (l), (r))
+#define _NEON_MAX_F64(l, r) vbslq_f64(vcgtq_f64((l), (r)), (l), (r))
+#define _NEON_MIN_F64(l, r) vbslq_f64(vcltq_f64((l), (r)), (l), (r))
+
+_SIMD_FLOAT_OPS(_NEON_F32, vaddq_f32, vsubq_f32, vmulq_f32, vdivq_f32, _NEON_MAX_F32, _NEON_MIN_F32)
+_SIMD_FLOAT_OPS(_NEON_F64, vaddq_f64, vsubq_f64, vmulq_f64, vdivq_f64, _NEON_MAX_F64, _NEON_MIN_F64)
+_SIMD_INT_OPS(_NEON_I32, vaddq_s32, vsubq_s32, vmulq_s32, vmaxq_s32, vminq_s32)
+
+#define _NEON_ZERO_F32() vdupq_n_f32(0.0f)
+#define _NEON_ZERO_F64() vdupq_n_f64(0.0)
+
+_SIMD_DEFINE_SUM(neon_f32, _ATTR_NEON, float, float32x4_t, 4, vld1q_f32, _NEON_ZERO_F32, vaddq_f32, vst1q_f32)
+_SIMD_DEFINE_SUM(neon_f64, _ATTR_NEON, double, float64x2_t, 2, vld1q_f64, _NEON_ZERO_F64, vaddq_f64, vst1q_f64)
+// 规约要让 NaN 传下去，这正是 vmaxq/vminq 本身的语义
+_SIMD_DEFINE_REDUCE(neon_f32, _ATTR_NEON, float, float32x4_t, 4, vld1q_f32, vdupq_n_f32, vst1q_f32, vmaxq_f32, vminq_f32)
+_SIMD_DEFINE_REDUCE(neon_f64, _ATTR_NEON, double, float64x2_t, 2, vld1q_f64, vdupq_n_f64, vst1q_f64, vmaxq_f64, vminq_f64)
+_SIMD_DEFINE_REDUCE(neon_i32, _ATTR_NEON, int32_t, int32x4_t, 4, vld1q_s32, vdupq_n_s32, vst1q_s32, vmaxq_s32, vminq_s32)
+
+// vfmaq(c, a, b) = c + a * b，参数顺序和 x86 的 fmadd(a, b, c) 不同
+#define _NEON_FMA_F32(a, b, c) vfmaq_f32((c), (a), (b))
+#define _NEON_FMA_F64(a, b, c) vfmaq_f64((c), (a), (b))
+
+_SIMD_DEFINE_GEMM(neon_f32, _ATTR_NEON, float, float32x4_t, 4, SIMD_GEMM_NR_F32, vld1q_f32, vst1q_f32, vdupq_n_f32, _NEON_ZERO_F32, vaddq_f32, _NEON_FMA_F32)
+_SIMD_DEFINE_GEMM(neon_f64, _ATTR_NEON, double, float64x2_t, 2, SIMD_GEMM_NR_F64, vld1q_f64, vst1q_f64, vdupq_n_f64, _NEON_ZERO_F64, vaddq_f64, _NEON_FMA_F64)
+
+_SIMD_DEFINE_MOMENTS(neon_f32, _ATTR_NEON, float, float32x4_t, 4, vld1q_f32, _NEON_ZERO_F32, vdupq_n_f32, vaddq_f32, vsubq_f32, vmulq_f32, vst1q_f32)
+_SIMD_DEFINE_MOMENTS(neon_f64, _ATTR_NEON, double, float64x2_t, 2, vld1q_f64, _NEON_ZERO_F64, vdupq_n_f64, vaddq_f64, vsubq_f64, vmulq_f64, vst1q_f64)
+
+static void
+neon_i32_sum(const void* x, size_t n, void* acc)
+{
+    const int32_t* p = (const int32_t*)x;
+    int64_t total = *(int64_t*)acc;
+    size_t i = 0;
+    int64x2_t s0 = vdupq_n_s64(0), s1 = vdupq_n_s64(0);
+    for (; i + 8 <= n; i += 8)
+    {
+        s0 = vpadalq_s32(s0, vld1q_s32(p + i));
+        s1 = vpadalq_s32(s1, vld1q_s32(p + i + 4));
+    }
+    total += vaddvq_s64(vaddq_s64(s0, s1));
+    for (; i < n; i++) total += p[i];
+    *(int64_t*)acc = total;
+}
+
+static void
+_register_neon(SimdKernelTable* table)
+{
+    table->name = "neon";
+    _SIMD_REGISTER_INT(table, DTYPE_I32, neon_i32);
+    _SIMD_REGISTER_FLOAT(table, DTYPE_F32, neon_f32);
+    _SIMD_REGISTER_FLOAT(table, DTYPE_F64, neon_f64);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_I32, neon_i32);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_F32, neon_f32);
+    _SIMD_REGISTER_REDUCE(table, DTYPE_F64, neon_f64);
+    table->gemm[DTYPE_F32] = neon_f32_gemm;
+    table->gemm[DTYPE_F64] = neon_f64_gemm;
+    table->moments[DTYPE_F32] = neon_f32_moments;
+    table->moments[DTYPE_F64] = neon_f64_moments;
+}
+
+#endif // SIMD_HAVE_NEON
+
+// --- softmax / layer_norm 用的数学内核 ---
+// 标量版本总是注册；F32 的 exp 在 x86 上换成向量近似，其余情况用 libm
+
+#define _SCALAR_EXP(NAME, T, EXP) \
+static double \
+scalar_##NAME##_exp(void* out, const void* x, size_t n, double shift, double scale) \
+{ \
+    const T* p = (const T*)x; \
+    T* o = (T*)out; \
+    const T s = (T)shift, k = (T)scale; \
+    double total = 0.0; \
+    for (size_t i = 0; i < n; i++) \
+    { \
+        const T e = EXP(p[i] - s); \
+        total += e; \
+        if (o != NULL) o[i] = e * k; \
+    } \
+    return total; \
+}
+
+// 与向量版本相同的分块方式，块内直接用 double 累加
+#define _SCALAR_MOMENTS(NAME, T) \
+static void \
+scalar_##NAME##_moments(const void* x, size_t n, double* mean, double* m2) \
+{ \
+    const T* p = (const T*)x; \
+    double count = 0.0, mu = 0.0, q = 0.0; \
+    for (size_t start = 0; start < n; start += SIMD_SUM_BLOCK) \
+    { \
+        const T* b = p + start; \
+        const size_t m = (n - start < SIMD_SUM_BLOCK) ? n - start : SIMD_SUM_BLOCK; \
+        double sum = 0.0, dev = 0.0; \
+        for (size_t i = 0; i < m; i++) sum += b[i]; \
+        const double bm = sum / (double)m; \
+        for (size_t i = 0; i < m; i++) { const double d = b[i] - bm; dev += d * d; } \
+        _moments_merge(&count, &mu, &q, (double)m, bm, dev); \
+    } \
+    *mean = mu; \
+    *m2 = q; \
+}
+
+_SCALAR_EXP(f32, float, expf)
+_SCALAR_EXP(f64, double, exp)
+_SCALAR_MOMENTS(f32, float)
+_SCALAR_MOMENTS(f64, double)
+
+#define _SCALAR_FIND_ABOVE(NAME, T) \
+static size_t \
+scalar_##NAME##_find_above(const void* x, size_t n, uint32_t threshold, uint32_t flip) \
+{ \
+    const T* p = (const T*)x; \
+    for (size_t i = 0; i < n; i++) \
+        if ((simd_sort_key_##NAME(p[i]) ^ flip) > threshold) return i; \
+    return n; \
+}
+
+_SCALAR_FIND_ABOVE(i32, int32_t)
+_SCALAR_FIND_ABOVE(f32, float)
+
+static void
+_register_scalar_math(SimdKernelTable* table)
+{
+    table->exp[DTYPE_F32] = scalar_f32_exp;
+    table->exp[DTYPE_F64] = scalar_f64_exp;
+    table->moments[DTYPE_F32] = scalar_f32_moments;
+    table->moments[DTYPE_F64] = scalar_f64_moments;
+    table->find_above[DTYPE_I32] = scalar_i32_find_above;
+    table->find_above[DTYPE_F32] = scalar_f32_find_above;
+}
+
+// --- 类型转换 ---
+// 窄类型（F16/BF16/I8/U8）的运算都在 F32/I32 中进行，这里是两者之间的转换内核。
+// 标量版本和 _tensor_cast.h 里的单值函数一致；向量版本逐位给出同样的结果。
+
+// 量化时先把 x / scale 限制在 ±_QUANT_LIMIT 之内再取整，避免转换成 int32 时溢出；
+// NaN 经过第一次比较变成上限，所以会饱和到目标范围的最大值
+#define _QUANT_LIMIT 65536.0f
+
+static inline int32_t
+_quantize_one(float x, float inv_scale, int32_t zero_point, int32_t lo, int32_t hi)
+{
+    float v = x * inv_scale;
+    v = (v < _QUANT_LIMIT) ? v : _QUANT_LIMIT;
+    v = (v > -_QUANT_LIMIT) ? v : -_QUANT_LIMIT;
+    const int32_t q = (int32_t)lrintf(v) + zero_point;
+    return (q < lo) ? lo : ((q > hi) ? hi : q);
+}
+
+#define _SCALAR_CONVERT(NAME, TD, TS, EXPR) \
+static void \
+scalar_##NAME(void* dst, const void* src, size_t n) \
+{ \
+    TD* d = (TD*)dst; \
+    const TS* s = (const TS*)src; \
+    for (size_t i = 0; i < n; i++) d[i] = EXPR(s[i]); \
+}
+
+#define _AS_INT32(x) ((int32_t)(x))
+#define _AS_INT8(x) ((int8_t)(x))   // 截断，和 C 的整数转换一样回绕
+#define _AS_UINT8(x) ((uint8_t)(x))
+
+_SCALAR_CONVERT(f16_widen, float, uint16_t, f16_to_f32)
+_SCALAR_CONVERT(f16_narrow, uint16_t, float, f32_to_f16)
+_SCALAR_CONVERT(bf16_widen, float, uint16_t, bf16_to_f32)
+_SCALAR_CONVERT(bf16_narrow, uint16_t, float, f32_to_bf16)
+_SCALAR_CONVERT(i8_widen, int32_t, int8_t, _AS_INT32)
+_SCALAR_CONVERT(i8_narrow, int8_t, int32_t, _AS_INT8)
+_SCALAR_CONVERT(u8_widen, int32_t, uint8_t, _AS_INT32)
+_SCALAR_CONVERT(u8_narrow, uint8_t, int32_t, _AS_UINT8)
+
+#define _SCALAR_QUANTIZE(NAME, T, LO, HI) \
+static void \
+scalar_##NAME##_quantize(void* dst, const void* src, size_t n, float inv_scale, int32_t zero_point) \
+{ \
+    T* d = (T*)dst; \
+    const float* s = (const float*)src; \
+    for (size_t i = 0; i < n; i++) d[i] = (T)_quantize_one(s[i], inv_scale, zero_point, LO, HI); \
+} \
+\
+static void \
+scalar_##NAME##_dequantize(void* dst, const void* src, size_t n, float scale, int32_t zero_point) \
+{ \
+    float* d = (float*)dst; \
+    const T* s = (const T*)src; \
+    for (size_t i = 0; i < n; i++) d[i] = (float)((int32_t)s[i] - zero_point) * scale; \
+}
+
+_SCALAR_QUANTIZE(i8, int8_t, -128, 127)
+_SCALAR_QUANTIZE(u8, uint8_t, 0, 255)
+
+static void
+_register_scalar_convert(SimdKernelTable* table)
+{
+    table->widen[DTYPE_F16] = scalar_f16_widen;
+    table->narrow[DTYPE_F16] = scalar_f16_narrow;
+    table->widen[DTYPE_BF16] = scalar_bf16_widen;
+    table->narrow[DTYPE_BF16] = scalar_bf16_narrow;
+    table->widen[DTYPE_I8] = scalar_i8_widen;
+    table->narrow[DTYPE_I8] = scalar_i8_narrow;
+    table->widen[DTYPE_U8] = scalar_u8_widen;
+    table->narrow[DTYPE_U8] = scalar_u8_narrow;
+    table->quantize[DTYPE_I8] = scalar_i8_quantize;
+    table->dequantize[DTYPE_I8] = scalar_i8_dequantize;
+    table->quantize[DTYPE_U8] = scalar_u8_quantize;
+    table->dequantize[DTYPE_U8] = scalar_u8_dequantize;
+}
+
+#ifdef SIMD_HAVE_X86
+
+// 向量主循环之后，尾部交给对应的标量内核
+#define _CONVERT_TAIL(NAME, TD, TS) \
+    scalar_##NAME((TD*)dst + i, (const TS*)src + i, n - i)
+
+#define _ATTR_F16C __attribute__((target("avx2,fma,f16c")))
+#define _ATTR_AVX512BF16 __attribute__((target("avx512f,avx512bf16")))
+
+static _ATTR_F16C void
+avx2_f16_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps((float*)dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)((const uint16_t*)src + i))));
+    _CONVERT_TAIL(f16_widen, float, uint16_t);
+}
+
+static _ATTR_F16C void
+avx2_f16_narrow(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _mm_storeu_si128((__m128i*)((uint16_t*)dst + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps((const float*)src + i), _MM_FROUND_TO_NEAREST_INT));
+    _CONVERT_TAIL(f16_narrow, uint16_t, float);
+}
+
+static _ATTR_AVX2 void
+avx2_bf16_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)((const uint16_t*)src + i)));
+        _AVX2_STOREI((float*)dst + i, _mm256_slli_epi32(h, 16));
+    }
+    _CONVERT_TAIL(bf16_widen, float, uint16_t);
+}
+
+// 没有 AVX-512 BF16 时用整数运算实现同样的舍入：NaN 变成静默 NaN，非正规数变成 0
+static _ATTR_AVX2 __m256i
+_avx2_round_bf16(__m256i bits)
+{
+    const __m256i abs = _mm256_and_si256(bits, _mm256_set1_epi32(0x7fffffff));
+    const __m256i is_nan = _mm256_cmpgt_epi32(abs, _mm256_set1_epi32(0x7f800000));
+    const __m256i is_tiny = _mm256_cmpeq_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7f800000)), _mm256_setzero_si256());
+    const __m256i high = _mm256_srli_epi32(bits, 16);
+    const __m256i odd = _mm256_and_si256(high, _mm256_set1_epi32(1));
+    __m256i r = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, _mm256_set1_epi32(0x7fff)), odd), 16);
+    r = _mm256_blendv_epi8(r, _mm256_and_si256(high, _mm256_set1_epi32(0x8000)), is_tiny);
+    return _mm256_blendv_epi8(r, _mm256_or_si256(high, _mm256_set1_epi32(0x40)), is_nan);
+}
+
+static _ATTR_AVX2 void
+avx2_bf16_narrow(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m256i r0 = _avx2_round_bf16(_AVX2_LOADI((const float*)src + i));
+        const __m256i r1 = _avx2_round_bf16(_AVX2_LOADI((const float*)src + i + 8));
+        // packus 按 128 位分道交错，permute 还原顺序
+        _AVX2_STOREI((uint16_t*)dst + i, _mm256_permute4x64_epi64(_mm256_packus_epi32(r0, r1), 0xd8));
+    }
+    _CONVERT_TAIL(bf16_narrow, uint16_t, float);
+}
+
+static _ATTR_AVX2 void
+avx2_i8_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _AVX2_STOREI((int32_t*)dst + i, _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)((const int8_t*)src + i))));
+    _CONVERT_TAIL(i8_widen, int32_t, int8_t);
+}
+
+static _ATTR_AVX2 void
+avx2_u8_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+        _AVX2_STOREI((int32_t*)dst + i, _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)((const uint8_t*)src + i))));
+    _CONVERT_TAIL(u8_widen, int32_t, uint8_t);
+}
+
+// 取每个 int32 的最低字节（截断），I8 和 U8 相同
+static _ATTR_AVX2 void
+avx2_byte_narrow(void* dst, const void* src, size_t n)
+{
+    const __m256i low_bytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                               0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i gather = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const __m256i b = _mm256_shuffle_epi8(_AVX2_LOADI((const int32_t*)src + i), low_bytes);
+        _mm_storel_epi64((__m128i*)((uint8_t*)dst + i), _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(b, gather)));
+    }
+    _CONVERT_TAIL(u8_narrow, uint8_t, int32_t);
+}
+
+// 32 个 float 量化成 32 个字节：取整、加零点，再用饱和打包限制到目标范围。
+// 两级 pack 都按 128 位分道交错，最后用一次 permute 还原顺序。
+#define _AVX2_QUANTIZE(NAME, PACK8) \
+static _ATTR_AVX2 __m256i \
+_avx2_##NAME##_q8(const float* s, __m256 inv, __m256i zp) \
+{ \
+    const __m256 lim = _mm256_set1_ps(_QUANT_LIMIT), neg = _mm256_set1_ps(-_QUANT_LIMIT); \
+    __m256i q[4]; \
+    for (int k = 0; k < 4; k++) \
+    { \
+        const __m256 v = _mm256_max_ps(_mm256_min_ps(_mm256_mul_ps(_mm256_loadu_ps(s + 8 * k), inv), lim), neg); \
+        q[k] = _mm256_add_epi32(_mm256_cvtps_epi32(v), zp); \
+    } \
+    const __m256i b = PACK8(_mm256_packs_epi32(q[0], q[1]), _mm256_packs_epi32(q[2], q[3])); \
+    return _mm256_permutevar8x32_epi32(b, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)); \
+} \
+\
+static _ATTR_AVX2 void \
+avx2_##NAME##_quantize(void* dst, const void* src, size_t n, float inv_scale, int32_t zero_point) \
+{ \
+    const __m256 inv = _mm256_set1_ps(inv_scale); \
+    const __m256i zp = _mm256_set1_epi32(zero_point); \
+    size_t i = 0; \
+    for (; i + 32 <= n; i += 32) \
+        _AVX2_STOREI((uint8_t*)dst + i, _avx2_##NAME##_q8((const float*)src + i, inv, zp)); \
+    scalar_##NAME##_quantize((uint8_t*)dst + i, (const float*)src + i, n - i, inv_scale, zero_point); \
+}
+
+// _mm256_min_ps(x, lim) 在 x 为 NaN 时返回 lim，和标量的 (v < lim) ? v : lim 一致
+_AVX2_QUANTIZE(i8, _mm256_packs_epi16)
+_AVX2_QUANTIZE(u8, _mm256_packus_epi16)
+
+#define _AVX2_DEQUANTIZE(NAME, CVT) \
+static _ATTR_AVX2 void \
+avx2_##NAME##_dequantize(void* dst, const void* src, size_t n, float scale, int32_t zero_point) \
+{ \
+    const __m256 s = _mm256_set1_ps(scale); \
+    const __m256i zp = _mm256_set1_epi32(zero_point); \
+    size_t i = 0; \
+    for (; i + 8 <= n; i += 8) \
+    { \
+        const __m256i q = CVT(_mm_loadl_epi64((const __m128i*)((const uint8_t*)src + i))); \
+        _mm256_storeu_ps((float*)dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(q, zp)), s)); \
+    } \
+    scalar_##NAME##_dequantize((float*)dst + i, (const uint8_t*)src + i, n - i, scale, zero_point); \
+}
+
+_AVX2_DEQUANTIZE(i8, _mm256_cvtepi8_epi32)
+_AVX2_DEQUANTIZE(u8, _mm256_cvtepu8_epi32)
+
+static _ATTR_AVX512 void
+avx512_f16_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_ps((float*)dst + i, _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)((const uint16_t*)src + i))));
+    _CONVERT_TAIL(f16_widen, float, uint16_t);
+}
+
+static _ATTR_AVX512 void
+avx512_f16_narrow(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm256_storeu_si256((__m256i*)((uint16_t*)dst + i),
+                            _mm512_cvtps_ph(_mm512_loadu_ps((const float*)src + i), _MM_FROUND_TO_NEAREST_INT));
+    _CONVERT_TAIL(f16_narrow, uint16_t, float);
+}
+
+static _ATTR_AVX512 void
+avx512_bf16_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        const __m512i h = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)((const uint16_t*)src + i)));
+        _mm512_storeu_si512((float*)dst + i, _mm512_slli_epi32(h, 16));
+    }
+    _CONVERT_TAIL(bf16_widen, float, uint16_t);
+}
+
+static _ATTR_AVX512BF16 void
+avx512_bf16_narrow(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm256_storeu_si256((__m256i*)((uint16_t*)dst + i), (__m256i)_mm512_cvtneps_pbh(_mm512_loadu_ps((const float*)src + i)));
+    _CONVERT_TAIL(bf16_narrow, uint16_t, float);
+}
+
+static _ATTR_AVX512 void
+avx512_i8_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_si512((int32_t*)dst + i, _mm512_cvtepi8_epi32(_mm_loadu_si128((const __m128i*)((const int8_t*)src + i))));
+    _CONVERT_TAIL(i8_widen, int32_t, int8_t);
+}
+
+static _ATTR_AVX512 void
+avx512_u8_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm512_storeu_si512((int32_t*)dst + i, _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)((const uint8_t*)src + i))));
+    _CONVERT_TAIL(u8_widen, int32_t, uint8_t);
+}
+
+static _ATTR_AVX512 void
+avx512_byte_narrow(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+        _mm_storeu_si128((__m128i*)((uint8_t*)dst + i), _mm512_cvtepi32_epi8(_mm512_loadu_si512((const int32_t*)src + i)));
+    _CONVERT_TAIL(u8_narrow, uint8_t, int32_t);
+}
+
+#define _AVX512_QUANTIZE(NAME, LO, HI) \
+static _ATTR_AVX512 void \
+avx512_##NAME##_quantize(void* dst, const void* src, size_t n, float inv_scale, int32_t zero_point) \
+{ \
+    const __m512 inv = _mm512_set1_ps(inv_scale); \
+    const __m512 lim = _mm512_set1_ps(_QUANT_LIMIT), neg = _mm512_set1_ps(-_QUANT_LIMIT); \
+    const __m512i zp = _mm512_set1_epi32(zero_point); \
+    const __m512i lo = _mm512_set1_epi32(LO), hi = _mm512_set1_epi32(HI); \
+    size_t i = 0; \
+    for (; i + 16 <= n; i += 16) \
+    { \
+        const __m512 v = _mm512_max_ps(_mm512_min_ps(_mm512_mul_ps(_mm512_loadu_ps((const float*)src + i), inv), lim), neg); \
+        const __m512i q = _mm512_min_epi32(_mm512_max_epi32(_mm512_add_epi32(_mm512_cvtps_epi32(v), zp), lo), hi); \
+        _mm_storeu_si128((__m128i*)((uint8_t*)dst + i), _mm512_cvtepi32_epi8(q)); \
+    } \
+    scalar_##NAME##_quantize((uint8_t*)dst + i, (const float*)src + i, n - i, inv_scale, zero_point); \
+}
+
+_AVX512_QUANTIZE(i8, -128, 127)
+_AVX512_QUANTIZE(u8, 0, 255)
+
+static void
+_register_x86_convert(SimdKernelTable* table, const CpuFeatures* features)
+{
+    if (features->avx2)
+    {
+        table->widen[DTYPE_BF16] = avx2_bf16_widen;
+        table->narrow[DTYPE_BF16] = avx2_bf16_narrow;
+        table->widen[DTYPE_I8] = avx2_i8_widen;
+        table->narrow[DTYPE_I8] = avx2_byte_narrow;
+        table->widen[DTYPE_U8] = avx2_u8_widen;
+        table->narrow[DTYPE_U8] = avx2_byte_narrow;
+        table->quantize[DTYPE_I8] = avx2_i8_quantize;
+        table->dequantize[DTYPE_I8] = avx2_i8_dequantize;
+        table->quantize[DTYPE_U8] = avx2_u8_quantize;
+        table->dequantize[DTYPE_U8] = avx2_u8_dequantize;
+    }
+    if (features->f16c)
+    {
+        table->widen[DTYPE_F16] = avx2_f16_widen;
+        table->narrow[DTYPE_F16] = avx2_f16_narrow;
+    }
+    if (features->avx512f)
+    {
+        table->widen[DTYPE_F16] = avx512_f16_widen;
+        table->narrow[DTYPE_F16] = avx512_f16_narrow;
+        table->widen[DTYPE_BF16] = avx512_bf16_widen;
+        table->widen[DTYPE_I8] = avx512_i8_widen;
+        table->narrow[DTYPE_I8] = avx512_byte_narrow;
+        table->widen[DTYPE_U8] = avx512_u8_widen;
+        table->narrow[DTYPE_U8] = avx512_byte_narrow;
+        table->quantize[DTYPE_I8] = avx512_i8_quantize;
+        table->quantize[DTYPE_U8] = avx512_u8_quantize;
+    }
+    if (features->avx512bf16)
+        table->narrow[DTYPE_BF16] = avx512_bf16_narrow;
+}
+
+#endif // SIMD_HAVE_X86
+
+#ifdef SIMD_HAVE_NEON
+
+static void
+neon_f16_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32((float*)dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16((const uint16_t*)src + i))));
+    scalar_f16_widen((float*)dst + i, (const uint16_t*)src + i, n - i);
+}
+
+static void
+neon_f16_narrow(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1_u16((uint16_t*)dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32((const float*)src + i))));
+    scalar_f16_narrow((uint16_t*)dst + i, (const float*)src + i, n - i);
+}
+
+static void
+neon_bf16_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+        vst1q_u32((uint32_t*)dst + i, vshll_n_u16(vld1_u16((const uint16_t*)src + i), 16));
+    scalar_bf16_widen((float*)dst + i, (const uint16_t*)src + i, n - i);
+}
+
+static void
+neon_i8_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const int16x8_t h = vmovl_s8(vld1_s8((const int8_t*)src + i));
+        vst1q_s32((int32_t*)dst + i, vmovl_s16(vget_low_s16(h)));
+        vst1q_s32((int32_t*)dst + i + 4, vmovl_s16(vget_high_s16(h)));
+    }
+    scalar_i8_widen((int32_t*)dst + i, (const int8_t*)src + i, n - i);
+}
+
+static void
+neon_u8_widen(void* dst, const void* src, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        const uint16x8_t h = vmovl_u8(vld1_u8((const uint8_t*)src + i));
+        vst1q_u32((uint32_t*)dst + i, vmovl_u16(vget_low_u16(h)));
+        vst1q_u32((uint32_t*)dst + i + 4, vmovl_u16(vget_high_u16(h)));
+    }
+    scalar_u8_widen((int32_t*)dst + i, (const uint8_t*)src + i, n - i);
+}
+
+static void
+_register_neon_convert(SimdKernelTable* table)
+{
+    table->widen[DTYPE_F16] = neon_f16_widen;
+    table->narrow[DTYPE_F16] = neon_f16_narrow;
+    table->widen[DTYPE_BF16] = neon_bf16_widen;
+    table->widen[DTYPE_I8] = neon_i8_widen;
+    table->widen[DTYPE_U8] = neon_u8_widen;
+}
+
+#endif // SIMD_HAVE_NEON
+
+static SimdKernelTable _kernels = { .name = "scalar" };
+static pthread_once_t _kernels_once = PTHREAD_ONCE_INIT;
+
+static void
+_select_kernels(void)
+{
+    const CpuFeatures* features = cpu_get_features();
+    (void)features;
+
+    _register_scalar_convert(&_kernels);
+    _register_scalar_math(&_kernels);
+
+#ifdef SIMD_HAVE_X86
+    if (features->avx512f)
+        _register_avx512(&_kernels);
+    else if (features->avx2)
+        _register_avx2(&_kernels);
+    _register_x86_convert(&_kernels, features);
+#endif
+
+#ifdef SIMD_HAVE_NEON
+    if (features->neon)
+    {
+        _register_neon(&_kernels);
+        _register_neon_convert(&_kernels);
+    }
+#endif
+}
+
+const SimdKernelTable*
+simd_get_kernels(void)
+{
+    pthread_once(&_kernels_once, _select_kernels);
+    return &_kernels;
+}
+
+DataType
+simd_compute_dtype(DataType dtype)
+{
+    switch (dtype)
+    {
+        case DTYPE_F16:
+        case DTYPE_BF16: return DTYPE_F32;
+        case DTYPE_I8:
+        case DTYPE_U8: return DTYPE_I32;
+        default: return dtype;
+    }
+}
+
+void
+simd_widen(DataType dtype, void* dst, const void* src, size_t n, size_t stride)
+{
+    const SimdConvertFn widen = simd_get_kernels()->widen[dtype];
+    const size_t item_size = tensor_dtype_size(dtype);
+    if (stride == item_size)
+    {
+        widen(dst, src, n);
+        return;
+    }
+
+    // 非连续：先把窄元素收集到栈上的小块里，再整块转换
+    uint16_t tile[SIMD_CONVERT_TILE];
+    for (size_t done = 0; done < n; done += SIMD_CONVERT_TILE)
+    {
+        const size_t m = (n - done < SIMD_CONVERT_TILE) ? n - done : SIMD_CONVERT_TILE;
+        const char* s = (const char*)src + done * stride;
+        for (size_t i = 0; i < m; i++) memcpy((char*)tile + i * item_size, s + i * stride, item_size);
+        widen((char*)dst + done * 4, tile, m); // 计算类型 F32 / I32 都是 4 字节
+    }
+}
+
+void
+simd_narrow(DataType dtype, void* dst, size_t stride, const void* src, size_t n)
+{
+    const SimdConvertFn narrow = simd_get_kernels()->narrow[dtype];
+    const size_t item_size = tensor_dtype_size(dtype);
+    if (stride == item_size)
+    {
+        narrow(dst, src, n);
+        return;
+    }
+
+    uint16_t tile[SIMD_CONVERT_TILE];
+    for (size_t done = 0; done < n; done += SIMD_CONVERT_TILE)
+    {
+        const size_t m = (n - done < SIMD_CONVERT_TILE) ? n - done : SIMD_CONVERT_TILE;
+        narrow(tile, (const char*)src + done * 4, m);
+        char* d = (char*)dst + done * stride;
+        for (size_t i = 0; i < m; i++) memcpy(d + i * stride, (const char*)tile + i * item_size, item_size);
+    }
+}
@@ -0,0 +1,486 @@
+#include "tensor/_tensor_ops.h"
+#include "tensor/_tensor_iter.h"
+#include "tensor/_tensor_simd.h"
+#include "tensor/_shape.h"
+#include "utils/_malloc.h"
+#include "utils/_parallel.h"
+
+#include <stdatomic.h>
+#include <stdint.h> // for uint32_t, uint64_t
+#include <stdio.h>  // for fprintf()
+#include <stdlib.h> // for free()
+#include <string.h> // for memcpy(), memset()
+
+// argsort：不长于这个值的行直接插入排序
+#define SORT_INSERTION_MAX 32
+// k 不超过 TOPK_HEAP_MAX、或不超过行长的 1/TOPK_HEAP_RATIO 时用堆选择，否则用基数选择：
+// 随机数据上进堆的元素只有约 k * ln(n / k) 个，其余都被向量扫描跳过
+#define TOPK_HEAP_MAX 64
+#define TOPK_HEAP_RATIO 128
+// 列模式一次处理的相邻 lane 个数，和这些 lane 的工作区的上限（字节）
+#define SORT_COLUMN_TILE 16
+#define SORT_COLUMN_BUDGET (1 << 20)
+
+// 每一行先变成计算类型（F32 / I32 / F64）的连续数组，再换成无符号整数键（见
+// simd_sort_key_f32()）：键越大越靠前。升序排序 / 取最小的 k 个时把键按位取反；
+// 键相同的元素按位置先后排
+typedef struct
+{
+    DataType dtype;
+    DataType compute;      // F16/BF16 在 F32 中排序，I8/U8 在 I32 中排序
+    size_t item_size;
+    size_t compute_size;
+    size_t n;              // 排序轴的长度
+    size_t k;              // 输出的个数；argsort 时等于 n
+    bool flip;             // 键取反
+    bool argsort;          // 全排序（基数排序），否则是 topk
+    size_t in_axis;        // 排序轴上的步长（字节）
+    size_t indices_axis;
+    size_t values_axis;
+    TensorIter lanes;      // 操作数: in, indices, values（只有 topk 有）
+    const SimdKernelTable* kernels;
+    atomic_bool failed;    // 工作缓冲区分配失败
+}
+SortTask;
+
+typedef struct
+{
+    uint32_t key;
+    int32_t index;
+}
+SortItem32;
+
+typedef struct
+{
+    uint64_t key;
+    int32_t index;
+}
+SortItem64;
+
+// 行连续且不用转换时直接用输入，否则放进 buf
+static const void*
+_load_row(const SortTask* task, void* buf, const char* src)
+{
+    const size_t n = task->n, stride = task->in_axis;
+    if (task->dtype != task->compute)
+    {
+        simd_widen(task->dtype, buf, src, n, stride);
+        return buf;
+    }
+    if (stride == task->item_size) return src;
+    for (size_t i = 0; i < n; i++) memcpy((char*)buf + i * task->item_size, src + i * stride, task->item_size);
+    return buf;
+}
+
+static inline uint32_t
+_key_at32(const SortTask* task, const void* x, size_t i)
+{
+    const uint32_t key = (task->compute == DTYPE_F32) ? simd_sort_key_f32(((const float*)x)[i])
+                                                      : simd_sort_key_i32(((const int32_t*)x)[i]);
+    return task->flip ? ~key : key;
+}
+
+static inline uint64_t
+_key_at64(const SortTask* task, const void* x, size_t i)
+{
+    const uint64_t key = simd_sort_key_f64(((const double*)x)[i]);
+    return task->flip ? ~key : key;
+}
+
+static void
+_items32(const SortTask* task, SortItem32* items, const void* x)
+{
+    const uint32_t flip = task->flip ? UINT32_MAX : 0;
+    if (task->compute == DTYPE_F32)
+    {
+        const float* p = (const float*)x;
+        for (size_t i = 0; i < task->n; i++) items[i] = (SortItem32){ simd_sort_key_f32(p[i]) ^ flip, (int32_t)i };
+    }
+    else
+    {
+        const int32_t* p = (const int32_t*)x;
+        for (size_t i = 0; i < task->n; i++) items[i] = (SortItem32){ simd_sort_key_i32(p[i]) ^ flip, (int32_t)i };
+    }
+}
+
+static void
+_items64(const SortTask* task, SortItem64* items, const void* x)
+{
+    const uint64_t flip = task->flip ? UINT64_MAX : 0;
+    const double* p = (const double*)x;
+    for (size_t i = 0; i < task->n; i++) items[i] = (SortItem64){ simd_sort_key_f64(p[i]) ^ flip, (int32_t)i };
+}
+
+// 从第 i 个元素起，第一个键大于 threshold 的元素与 i 的距离
+static inline size_t
+_find_above32(const SortTask* task, const void* x, size_t i, uint32_t threshold)
+{
+    const char* p = (const char*)x + i * task->compute_size;
+    return task->kernels->find_above[task->compute](p, task->n - i, threshold, task->flip ? UINT32_MAX : 0);
+}
+
+static inline size_t
+_find_above64(const SortTask* task, const void* x, size_t i, uint64_t threshold)
+{
+    for (size_t j = i; j < task->n; j++)
+        if (_key_at64(task, x, j) > threshold) return j - i;
+    return task->n - i;
+}
+
+// --- 32 / 64 位键共用的排序与选择 ---
+
+#define _SORT_DEFINE(B, K) \
+/* a 排在 b 前面：键更大，或键相同而位置更靠前。这是全序，结果与算法无关 */ \
+static inline bool \
+_before##B(SortItem##B a, SortItem##B b) \
+{ \
+    return a.key > b.key || (a.key == b.key && a.index < b.index); \
+} \
+\
+static void \
+_insertion_sort##B(SortItem##B* a, size_t n) \
+{ \
+    for (size_t i = 1; i < n; i++) \
+    { \
+        const SortItem##B v = a[i]; \
+        size_t j = i; \
+        for (; j > 0 && _before##B(v, a[j - 1]); j--) a[j] = a[j - 1]; \
+        a[j] = v; \
+    } \
+} \
+\
+/* 堆顶是最靠后的元素 */ \
+static void \
+_sift_down##B(SortItem##B* h, size_t n, size_t i) \
+{ \
+    const SortItem##B v = h[i]; \
+    for (;;) \
+    { \
+        size_t c = 2 * i + 1; \
+        if (c >= n) break; \
+        if (c + 1 < n && _before##B(h[c], h[c + 1])) c++; \
+        if (_before##B(h[c], v)) break; \
+        h[i] = h[c]; \
+        i = c; \
+    } \
+    h[i] = v; \
+} \
+\
+static void \
+_heap_sort##B(SortItem##B* a, size_t n) \
+{ \
+    for (size_t i = n / 2; i-- > 0;) _sift_down##B(a, n, i); \
+    for (size_t end = n; end-- > 1;) \
+    { \
+        const SortItem##B top = a[0]; \
+        a[0] = a[end]; \
+        a[end] = top; \
+        _sift_down##B(a, end, 0); \
+    } \
+} \
+\
+/* LSD 基数排序，每个字节一趟，桶从大到小放所以是降序；每一趟都稳定，键相同的 */ \
+/* 元素保持位置顺序。整行在某个字节上都相同时跳过那一趟。返回结果所在的数组 */ \
+static SortItem##B* \
+_radix_sort##B(SortItem##B* a, SortItem##B* tmp, size_t n) \
+{ \
+    size_t counts[sizeof(K)][256]; \
+    memset(counts, 0, sizeof(counts)); \
+    for (size_t i = 0; i < n; i++) \
+        for (size_t d = 0; d < sizeof(K); d++) counts[d][(a[i].key >> (8 * d)) & 0xff]++; \
+    for (size_t d = 0; d < sizeof(K); d++) \
+    { \
+        size_t* c = counts[d]; \
+        if (c[(a[0].key >> (8 * d)) & 0xff] == n) continue; \
+        size_t offset = 0; \
+        for (int v = 255; v >= 0; v--) \
+        { \
+            const size_t m = c[v]; \
+            c[v] = offset; \
+            offset += m; \
+        } \
+        for (size_t i = 0; i < n; i++) tmp[c[(a[i].key >> (8 * d)) & 0xff]++] = a[i]; \
+        SortItem##B* s = a; \
+        a = tmp; \
+        tmp = s; \
+    } \
+    return a; \
+} \
+\
+/* 大 k：逐字节（从高到低）的基数选择。每一轮对候选做直方图，找到第 k 个所在的桶：*/ \
+/* 比它大的桶全部选中，这个桶里的元素留作下一轮的候选（原地压紧，保持位置顺序）。*/ \
+/* 选中的元素里键相同的总是同一轮选中、按位置排列，所以最后稳定的基数排序只按键排 */ \
+static SortItem##B* \
+_radix_select##B(SortItem##B* items, SortItem##B* out, size_t n, size_t k) \
+{ \
+    SortItem##B* cand = items; \
+    size_t m = n, taken = 0, need = k; \
+    for (size_t d = sizeof(K); d-- > 0 && m > need;) \
+    { \
+        size_t counts[256] = { 0 }; \
+        for (size_t i = 0; i < m; i++) counts[(cand[i].key >> (8 * d)) & 0xff]++; \
+        size_t above = 0; \
+        unsigned t = 255; \
+        while (above + counts[t] < need) above += counts[t--]; \
+        if (counts[t] == m) continue; /* 所有候选的这个字节都一样 */ \
+        /* 两边都无条件写、按条件前进，避免难以预测的分支 */ \
+        size_t kept = 0; \
+        for (size_t i = 0; i < m; i++) \
+        { \
+            const SortItem##B c = cand[i]; \
+            const unsigned digit = (unsigned)((c.key >> (8 * d)) & 0xff); \
+            out[taken] = c; \
+            taken += digit > t; \
+            cand[kept] = c; \
+            kept += digit == t; \
+        } \
+        need -= above; \
+        m = kept; \
+    } \
+    memcpy(out + taken, cand, need * sizeof(SortItem##B)); \
+    return _radix_sort##B(out, items, k); \
+} \
+\
+/* 小 k：k 个元素的堆，堆顶是当前最靠后的候选。后面的元素只有键严格大于堆顶时 */ \
+/* 才可能进堆（键相同的位置更靠后），这些元素用向量扫描一段一段地找 */ \
+static void \
+_topk_heap##B(const SortTask* task, const void* x, SortItem##B* heap) \
+{ \
+    const size_t n = task->n, k = task->k; \
+    for (size_t i = 0; i < k; i++) heap[i] = (SortItem##B){ _key_at##B(task, x, i), (int32_t)i }; \
+    for (size_t i = k / 2; i-- > 0;) _sift_down##B(heap, k, i); \
+    for (size_t i = k; i < n; i++) \
+    { \
+        i += _find_above##B(task, x, i, heap[0].key); \
+        if (i >= n) break; \
+        heap[0] = (SortItem##B){ _key_at##B(task, x, i), (int32_t)i }; \
+        _sift_down##B(heap, k, 0); \
+    } \
+    _heap_sort##B(heap, k); \
+} \
+\
+/* 排好的一行：返回从最靠前开始的 k 个 (键, 位置)，在 items 里或它后面的另一半里 */ \
+static const void* \
+_sort_row##B(const SortTask* task, const void* x, SortItem##B* items) \
+{ \
+    const size_t n = task->n, k = task->k; \
+    if (!task->argsort && (k <= TOPK_HEAP_MAX || k <= n / TOPK_HEAP_RATIO)) \
+    { \
+        _topk_heap##B(task, x, items); \
+        return items; \
+    } \
+    _items##B(task, items, x); \
+    if (task->argsort && n <= SORT_INSERTION_MAX) \
+    { \
+        _insertion_sort##B(items, n); \
+    } \
+    else if (task->argsort) \
+    { \
+        return _radix_sort##B(items, items + n, n); \
+    } \
+    else \
+    { \
+        return _radix_select##B(items, items + n, n, k); \
+    } \
+    return items; \
+} \
+\
+/* 写出 w 个相邻 lane 的结果；按输出的行写，列模式下每次写的是一段连续的元素 */ \
+static void \
+_write_rows##B(const SortTask* task, const void* const* best, size_t w, const char* in, size_t in_lane, \
+               char* indices, size_t indices_lane, char* values, size_t values_lane) \
+{ \
+    for (size_t j = 0; j < task->k; j++) \
+    { \
+        for (size_t l = 0; l < w; l++) \
+        { \
+            const int32_t i = ((const SortItem##B*)best[l])[j].index; \
+            *(int32_t*)(indices + l * indices_lane + j * task->indices_axis) = i; \
+            if (values != NULL) \
+                memcpy(values + l * values_lane + j * task->values_axis, in + l * in_lane + (size_t)i * task->in_axis, task->item_size); \
+        } \
+    } \
+}
+
+_SORT_DEFINE(32, uint32_t)
+_SORT_DEFINE(64, uint64_t)
+
+// 列模式：把 w 个相邻 lane 逐行读进各自的行缓冲区（相隔 lane_bytes 字节）
+static void
+_gather_columns(const SortTask* task, char* rows, size_t lane_bytes, const char* in, size_t w)
+{
+    for (size_t r = 0; r < task->n; r++)
+    {
+        const char* src = in + r * task->in_axis;
+        if (task->item_size == sizeof(uint32_t))
+            for (size_t l = 0; l < w; l++) ((uint32_t*)(rows + l * lane_bytes))[r] = ((const uint32_t*)src)[l];
+        else
+            for (size_t l = 0; l < w; l++) ((uint64_t*)(rows + l * lane_bytes))[r] = ((const uint64_t*)src)[l];
+    }
+}
+
+static void
+_sort_worker(size_t begin, size_t end, void* ctx)
+{
+    SortTask* task = (SortTask*)ctx;
+    TensorIter it = task->lanes;
+    const size_t n = task->n;
+
+    // 每个 lane 一块工作区：计算类型的一行，和两倍 n 个 (键, 位置)（基数排序要来回倒）。
+    // 列模式只用于不需要转换的 dtype，且一个 tile 的工作区不太大
+    const bool wide = task->compute == DTYPE_F64;
+    const size_t lane_bytes = n * (task->compute_size + 2 * (wide ? sizeof(SortItem64) : sizeof(SortItem32)));
+    const size_t tile = (task->dtype == task->compute && lane_bytes * SORT_COLUMN_TILE <= SORT_COLUMN_BUDGET) ? SORT_COLUMN_TILE : 1;
+    char* buf = safemalloc(tile * lane_bytes);
+    if (buf == NULL)
+    {
+        atomic_store(&task->failed, true);
+        return;
+    }
+
+    tensor_iter_set_range(&it, begin, end);
+    while (tensor_iter_next(&it))
+    {
+        const size_t in_lane = it.inner_strides[0], indices_lane = it.inner_strides[1];
+        const size_t values_lane = task->argsort ? 0 : it.inner_strides[2];
+        const bool columns = tile > 1 && task->in_axis != task->item_size && in_lane == task->item_size;
+        const size_t step = columns ? tile : 1;
+        for (size_t i = 0; i < it.inner_size; i += step)
+        {
+            const size_t w = (it.inner_size - i < step) ? it.inner_size - i : step;
+            const char* in = it.ptrs[0] + i * in_lane;
+            if (columns) _gather_columns(task, buf, lane_bytes, in, w);
+
+            const void* best[SORT_COLUMN_TILE];
+            for (size_t l = 0; l < w; l++)
+            {
+                char* lane = buf + l * lane_bytes;
+                const void* x = columns ? lane : _load_row(task, lane, in);
+                void* items = lane + n * task->compute_size;
+                best[l] = wide ? _sort_row64(task, x, (SortItem64*)items) : _sort_row32(task, x, (SortItem32*)items);
+            }
+
+            char* indices = it.ptrs[1] + i * indices_lane;
+            char* values = task->argsort ? NULL : it.ptrs[2] + i * values_lane;
+            if (wide) _write_rows64(task, best, w, in, in_lane, indices, indices_lane, values, values_lane);
+            else _write_rows32(task, best, w, in, in_lane, indices, indices_lane, values, values_lane);
+        }
+    }
+    free(buf);
+}
+
+// argsort 时 values 为 NULL；k 是输出在排序轴上的长度（argsort 传 0，表示整个轴）
+static bool
+_sort_along(const Tensor t, size_t k, int axis, bool flip, Tensor* values, Tensor* indices, const char* name)
+{
+    if (t == NULL) return false;
+
+    // 1. 检查参数
+    const int ndim = tensor_get_ndim(t);
+    if (axis < 0 || axis >= ndim)
+    {
+        fprintf(stderr, "Error: axis %d is out of bounds for tensor of dimension %d\n", axis, ndim);
+        return false;
+    }
+    if (ndim > TENSOR_ITER_MAX_DIMS)
+    {
+        fprintf(stderr, "Error: %s supports at most %d dimensions.\n", name, TENSOR_ITER_MAX_DIMS);
+        return false;
+    }
+    const size_t n = (size_t)tensor_get_dim(t, axis);
+    const bool argsort = values == NULL;
+    if (argsort) k = n;
+    if (!argsort && (k < 1 || k > n))
+    {
+        fprintf(stderr, "Error: %s: k must be between 1 and %zu, the size of axis %d.\n", name, n, axis);
+        return false;
+    }
+
+    // 2. 创建输出
+    int dims[TENSOR_ITER_MAX_DIMS];
+    memcpy(dims, shape_get_dims(tensor_get_shape(t)), sizeof(int) * ndim);
+    dims[axis] = (int)k;
+    Shape out_shape = shape_create(dims, ndim);
+    if (out_shape == NULL) return false;
+    const DataType dtype = tensor_get_dtype(t);
+    Tensor idx = tensor_empty(out_shape, DTYPE_I32);
+    Tensor val = (idx != NULL && !argsort) ? tensor_empty(out_shape, dtype) : NULL;
+    shape_free(out_shape);
+    if (idx == NULL || (!argsort && val == NULL))
+    {
+        tensor_free(idx);
+        return false;
+    }
+    if (tensor_get_elements_count(idx) == 0)
+    {
+        *indices = idx;
+        if (!argsort) *values = val;
+        return true;
+    }
+
+    // 3. 建立任务
+    SortTask task;
+    task.dtype = dtype;
+    task.compute = simd_compute_dtype(dtype);
+    task.item_size = tensor_get_item_size(t);
+    task.compute_size = tensor_dtype_size(task.compute);
+    task.n = n;
+    task.k = k;
+    task.flip = flip;
+    task.argsort = argsort;
+    task.in_axis = tensor_get_strides(t)[axis] * task.item_size;
+    task.indices_axis = tensor_get_strides(idx)[axis] * sizeof(int32_t);
+    task.values_axis = argsort ? 0 : tensor_get_strides(val)[axis] * task.item_size;
+    task.kernels = simd_get_kernels();
+    atomic_init(&task.failed, false);
+
+    // 排序轴以外的位置：把排序轴的长度当成 1，迭代器会跳过它
+    int lane_dims[TENSOR_ITER_MAX_DIMS];
+    memcpy(lane_dims, dims, sizeof(int) * ndim);
+    lane_dims[axis] = 1;
+    void* data[3] = { (void*)tensor_get_data_const(t), _tensor_get_data(idx), argsort ? NULL : _tensor_get_data(val) };
+    const size_t* strides[3] = { tensor_get_strides(t), tensor_get_strides(idx), argsort ? NULL : tensor_get_strides(val) };
+    const size_t item_sizes[3] = { task.item_size, sizeof(int32_t), task.item_size };
+    bool ok = tensor_iter_init_strided(&task.lanes, argsort ? 2 : 3, data, strides, item_sizes, lane_dims, ndim);
+
+    if (ok)
+    {
+        parallel_for(0, task.lanes.size, parallel_grain(n * task.item_size + k * (sizeof(int32_t) + task.item_size)), _sort_worker, &task);
+        ok = !atomic_load(&task.failed);
+    }
+    if (!ok)
+    {
+        tensor_free(idx);
+        tensor_free(val);
+        return false;
+    }
+    *indices = idx;
+    if (!argsort) *values = val;
+    return true;
+}
+
+bool
+tensor_topk(const Tensor t, int k, int axis, bool largest, Tensor* values, Tensor* indices)
+{
+    if (k < 1)
+    {
+        fprintf(stderr, "Error: tensor_topk: k must be positive.\n");
+        return false;
+    }
+    Tensor val = NULL, idx = NULL;
+    if (!_sort_along(t, (size_t)k, axis, !largest, &val, &idx, "tensor_topk")) return false;
+
+    if (values != NULL) *values = val;
+    else tensor_free(val);
+    if (indices != NULL) *indices = idx;
+    else tensor_free(idx);
+    return true;
+}
+
+Tensor
+tensor_argsort(const Tensor t, int axis, bool descending)
+{
+    Tensor idx = NULL;
+    if (!_sort_along(t, 0, axis, !descending, NULL, &idx, "tensor_argsort")) return NULL;
+    return idx;
+}
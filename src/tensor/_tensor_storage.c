@@ -0,0 +1,197 @@
+#include "tensor/_tensor_storage.h"
+
+#include "utils/_malloc.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h> // for memcpy()
+
+// 真正持有数据的缓冲区，在写时复制的多个 Storage 之间共享
+typedef struct
+{
+    void* data;
+    size_t nbytes;
+    atomic_size_t refcount;
+    atomic_bool exported;   // 有可写指针交给了调用者：之后的写入不会经过 storage_mutable_data()
+    StorageDeleter deleter; // NULL 表示 data 来自 safe_aligned_*
+    void* deleter_ctx;
+}
+StorageBuffer;
+
+struct _storage
+{
+    _Atomic(StorageBuffer*) buffer;
+    atomic_size_t refcount; // 张量及其所有视图各持有一个引用
+};
+
+static StorageBuffer*
+_buffer_create(size_t nbytes, bool zero)
+{
+    StorageBuffer* buffer = safe_small_alloc(sizeof(StorageBuffer));
+    if (buffer == NULL) return NULL;
+
+    // 没有元素的张量也要有一块有效的数据：分配对齐的最小单位，nbytes 仍记为 0
+    const size_t alloc = (nbytes > 0) ? nbytes : safe_alloc_get_alignment();
+    buffer->data = zero ? safe_aligned_calloc(alloc, 1) : safe_aligned_malloc(alloc);
+    if (buffer->data == NULL)
+    {
+        safe_small_free(buffer);
+        return NULL;
+    }
+    buffer->nbytes = nbytes;
+    atomic_init(&buffer->refcount, 1);
+    atomic_init(&buffer->exported, false);
+    buffer->deleter = NULL;
+    buffer->deleter_ctx = NULL;
+    return buffer;
+}
+
+static void
+_buffer_release(StorageBuffer* buffer)
+{
+    if (atomic_fetch_sub(&buffer->refcount, 1) != 1) return;
+
+    if (buffer->deleter != NULL)
+        buffer->deleter(buffer->data, buffer->deleter_ctx);
+    else
+        safe_aligned_free(buffer->data);
+    safe_small_free(buffer);
+}
+
+// 借用的内存：没有 deleter 时什么也不做
+static void
+_borrowed_deleter(void* data, void* ctx)
+{
+    (void)data;
+    (void)ctx;
+}
+
+static Storage
+_storage_wrap(StorageBuffer* buffer)
+{
+    Storage storage = safe_small_alloc(sizeof(struct _storage));
+    if (storage == NULL) return NULL;
+
+    atomic_init(&storage->buffer, buffer);
+    atomic_init(&storage->refcount, 1);
+    return storage;
+}
+
+Storage
+storage_create(size_t nbytes, bool zero)
+{
+    StorageBuffer* buffer = _buffer_create(nbytes, zero);
+    if (buffer == NULL) return NULL;
+
+    Storage storage = _storage_wrap(buffer);
+    if (storage == NULL) _buffer_release(buffer);
+    return storage;
+}
+
+Storage
+storage_wrap(void* data, size_t nbytes, StorageDeleter deleter, void* ctx)
+{
+    if (data == NULL) return NULL;
+
+    StorageBuffer* buffer = safe_small_alloc(sizeof(StorageBuffer));
+    if (buffer == NULL) return NULL;
+    buffer->data = data;
+    buffer->nbytes = nbytes;
+    atomic_init(&buffer->refcount, 1);
+    atomic_init(&buffer->exported, false);
+    buffer->deleter = (deleter != NULL) ? deleter : _borrowed_deleter;
+    buffer->deleter_ctx = ctx;
+
+    Storage storage = _storage_wrap(buffer);
+    if (storage == NULL) safe_small_free(buffer); // 还没有接管 data，不调用 deleter
+    return storage;
+}
+
+Storage
+storage_retain(Storage storage)
+{
+    if (storage != NULL) atomic_fetch_add(&storage->refcount, 1);
+    return storage;
+}
+
+void
+storage_release(Storage storage)
+{
+    if (storage == NULL) return;
+    if (atomic_fetch_sub(&storage->refcount, 1) != 1) return;
+
+    _buffer_release(atomic_load(&storage->buffer));
+    safe_small_free(storage);
+}
+
+Storage
+storage_share(Storage storage)
+{
+    if (storage == NULL) return NULL;
+
+    StorageBuffer* buffer = atomic_load(&storage->buffer);
+
+    // 缓冲区的可写指针已经交出去了，以后的写入没法在写之前先复制：现在就给新的 Storage 一份自己的数据
+    if (atomic_load(&buffer->exported))
+    {
+        StorageBuffer* copy = _buffer_create(buffer->nbytes, false);
+        if (copy == NULL) return NULL;
+        memcpy(copy->data, buffer->data, buffer->nbytes);
+
+        Storage shared = _storage_wrap(copy);
+        if (shared == NULL) _buffer_release(copy);
+        return shared;
+    }
+
+    atomic_fetch_add(&buffer->refcount, 1);
+    Storage shared = _storage_wrap(buffer);
+    if (shared == NULL) _buffer_release(buffer);
+    return shared;
+}
+
+const void*
+storage_data(const Storage storage)
+{
+    if (storage == NULL) return NULL;
+    return atomic_load(&storage->buffer)->data;
+}
+
+void*
+storage_mutable_data(Storage storage)
+{
+    if (storage == NULL) return NULL;
+
+    StorageBuffer* buffer = atomic_load(&storage->buffer);
+    if (atomic_load(&buffer->refcount) == 1) return buffer->data; // 独占，直接写
+
+    // 缓冲区还被别的 Storage 共享：复制一份私有的，换上去。
+    // 副本（连同它的块头）总是在堆上分配：这个 Storage 可能属于作用域之外创建的张量，
+    // 从当前 arena 里分配的话，safe_arena_reset() 之后它就指向无效的内存了
+    SafeArena* scope = safe_arena_enter(NULL);
+    StorageBuffer* copy = _buffer_create(buffer->nbytes, false);
+    safe_arena_leave(scope);
+    if (copy == NULL) return NULL;
+    memcpy(copy->data, buffer->data, buffer->nbytes);
+
+    if (atomic_compare_exchange_strong(&storage->buffer, &buffer, copy))
+        _buffer_release(buffer);
+    else
+        _buffer_release(copy); // 别的线程已经替这个 Storage 完成了复制
+
+    return atomic_load(&storage->buffer)->data;
+}
+
+void*
+storage_export_data(Storage storage)
+{
+    void* data = storage_mutable_data(storage);
+    if (data != NULL) atomic_store(&atomic_load(&storage->buffer)->exported, true);
+    return data;
+}
+
+size_t
+storage_nbytes(const Storage storage)
+{
+    if (storage == NULL) return 0;
+    return atomic_load(&storage->buffer)->nbytes;
+}
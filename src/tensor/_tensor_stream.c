@@ -0,0 +1,250 @@
+#define _DEFAULT_SOURCE // for madvise()
+
+#include "tensor/_tensor_stream.h"
+#include "tensor/_tensor_view.h"
+#include "tensor/_shape.h"
+
+#include <pthread.h>
+#include <stdint.h> // for uintptr_t
+#include <stdio.h>  // for fprintf()
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h> // for madvise()
+#include <unistd.h>   // for sysconf()
+#define STREAM_HAVE_MADVISE 1
+#endif
+
+// 一段要预读或者已经用完的字节范围
+typedef struct
+{
+    const char* begin;
+    size_t size;
+}
+ByteRange;
+
+// 调用者与后台 I/O 线程之间的交接。每次只布置一件任务：预读一段、写出一个结果
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    bool busy; // 任务已布置但还没做完
+    bool quit;
+    bool failed; // 某次写出失败；之后的结果都不再写
+    ByteRange prefetch;
+    Tensor result; // 要追加到 writer 的结果，写完由 I/O 线程释放
+    TensorWriter writer;
+}
+StreamIO;
+
+static size_t
+_page_size(void)
+{
+#ifdef STREAM_HAVE_MADVISE
+    const long n = sysconf(_SC_PAGESIZE);
+    if (n > 0) return (size_t)n;
+#endif
+    return 4096;
+}
+
+// 把一段数据读进内存并建立页表，这样调用者访问时既不等磁盘也不缺页
+static void
+_prefetch(ByteRange r)
+{
+    if (r.size == 0) return;
+    const size_t page = _page_size();
+#ifdef STREAM_HAVE_MADVISE
+    char* begin = (char*)((uintptr_t)r.begin & ~(uintptr_t)(page - 1));
+    const size_t size = (size_t)(r.begin - begin) + r.size;
+    // 先让内核对整段发起预读，再等它读完并映射进来；等待正好发生在这个线程里
+    madvise(begin, size, MADV_WILLNEED);
+#ifdef MADV_POPULATE_READ
+    if (madvise(begin, size, MADV_POPULATE_READ) == 0) return;
+#endif
+#endif
+    // 没有 MADV_POPULATE_READ（或者内核不支持）：每页读一个字节
+    const volatile char* p = r.begin;
+    for (size_t offset = 0; offset < r.size; offset += page) (void)p[offset];
+}
+
+// 用完的一段：让内核优先回收这些页面。不丢弃内容（私有映射里写过的页面仍然保留），只是提示
+static void
+_release(ByteRange r)
+{
+#if defined(STREAM_HAVE_MADVISE) && defined(MADV_COLD)
+    // 只处理完全落在范围内的页面，首尾和相邻的块共用的页面不动
+    const uintptr_t page = (uintptr_t)_page_size();
+    const uintptr_t begin = ((uintptr_t)r.begin + page - 1) & ~(page - 1);
+    const uintptr_t end = ((uintptr_t)r.begin + r.size) & ~(page - 1);
+    if (r.size > 0 && end > begin) madvise((void*)begin, (size_t)(end - begin), MADV_COLD);
+#else
+    (void)r;
+#endif
+}
+
+// 行 [first, first + count) 在内存里跨过的字节。跨度远大于这些行本身的数据时（比如列主序的
+// .npy 文件，每一行都散布在整个文件里），预读会把整个文件读进来，这时返回空范围
+static ByteRange
+_chunk_range(const Tensor t, size_t first, size_t count)
+{
+    const ByteRange none = { NULL, 0 };
+    const Shape shape = tensor_get_shape(t);
+    const int ndim = shape_get_ndim(shape);
+    const int* dims = shape_get_dims(shape);
+    const size_t* strides = shape_get_strides(shape);
+    const size_t item_size = tensor_get_item_size(t);
+    if (count == 0) return none;
+
+    size_t last = (count - 1) * strides[0]; // 最后一个元素相对第一个元素的位置（元素）
+    size_t row_elements = 1;
+    for (int i = 1; i < ndim; i++)
+    {
+        if (dims[i] == 0) return none;
+        last += (size_t)(dims[i] - 1) * strides[i];
+        row_elements *= (size_t)dims[i];
+    }
+
+    const size_t span = (last + 1) * item_size;
+    if (span > 2 * count * row_elements * item_size) return none;
+    return (ByteRange){ (const char*)tensor_get_data_const(t) + first * strides[0] * item_size, span };
+}
+
+static void*
+_stream_io_main(void* arg)
+{
+    StreamIO* io = (StreamIO*)arg;
+
+    pthread_mutex_lock(&io->lock);
+    for (;;)
+    {
+        while (!io->busy && !io->quit) pthread_cond_wait(&io->cond, &io->lock);
+        if (!io->busy) break;
+
+        const ByteRange prefetch = io->prefetch;
+        Tensor result = io->result;
+        const bool skip_write = io->failed;
+        pthread_mutex_unlock(&io->lock);
+
+        // 先读后写：下一块的数据在关键路径上；写出只是进入页缓存，由内核在后台写回磁盘
+        _prefetch(prefetch);
+        bool ok = true;
+        if (result != NULL)
+        {
+            if (io->writer != NULL && !skip_write) ok = tensor_writer_append(io->writer, result);
+            tensor_free(result);
+        }
+
+        pthread_mutex_lock(&io->lock);
+        if (!ok) io->failed = true;
+        io->busy = false;
+        pthread_cond_broadcast(&io->cond);
+    }
+    pthread_mutex_unlock(&io->lock);
+    return NULL;
+}
+
+// 等 I/O 线程做完手上的任务；返回 false 表示有结果没能写出
+static bool
+_stream_io_wait(StreamIO* io)
+{
+    pthread_mutex_lock(&io->lock);
+    while (io->busy) pthread_cond_wait(&io->cond, &io->lock);
+    const bool ok = !io->failed;
+    pthread_mutex_unlock(&io->lock);
+    return ok;
+}
+
+// 只能在 I/O 线程空闲时调用（先 _stream_io_wait()）
+static void
+_stream_io_submit(StreamIO* io, ByteRange prefetch, Tensor result)
+{
+    pthread_mutex_lock(&io->lock);
+    io->prefetch = prefetch;
+    io->result = result;
+    io->busy = true;
+    pthread_cond_broadcast(&io->cond);
+    pthread_mutex_unlock(&io->lock);
+}
+
+bool
+tensor_stream(const Tensor input, size_t chunk_rows, TensorChunkFn fn, void* ctx, TensorWriter writer)
+{
+    const char* name = "tensor_stream";
+    if (input == NULL || fn == NULL) return false;
+
+    const Shape shape = tensor_get_shape(input);
+    const int ndim = shape_get_ndim(shape);
+    if (ndim < 1)
+    {
+        fprintf(stderr, "Error: %s: the input must have at least one dimension.\n", name);
+        return false;
+    }
+    const int* dims = shape_get_dims(shape);
+    const size_t rows = (size_t)dims[0];
+    if (rows == 0) return true;
+
+    if (chunk_rows == 0)
+    {
+        size_t row_bytes = tensor_get_item_size(input);
+        for (int i = 1; i < ndim; i++) row_bytes *= (size_t)dims[i];
+        chunk_rows = (row_bytes > 0) ? TENSOR_STREAM_CHUNK_BYTES / row_bytes : rows;
+        if (chunk_rows == 0) chunk_rows = 1;
+    }
+    if (chunk_rows > rows) chunk_rows = rows;
+
+    StreamIO io = { .writer = writer };
+    pthread_t thread;
+    pthread_mutex_init(&io.lock, NULL);
+    pthread_cond_init(&io.cond, NULL);
+    if (pthread_create(&thread, NULL, _stream_io_main, &io) != 0)
+    {
+        fprintf(stderr, "Error: %s: cannot start the I/O thread.\n", name);
+        pthread_cond_destroy(&io.cond);
+        pthread_mutex_destroy(&io.lock);
+        return false;
+    }
+
+    // 流水线：处理第 k 块时，I/O 线程预读第 k + 1 块、写出第 k - 1 块的结果
+    _stream_io_submit(&io, _chunk_range(input, 0, chunk_rows), NULL);
+    Tensor pending = NULL; // 刚算完、还没交给 I/O 线程的结果
+    bool ok = true;
+    for (size_t first = 0; ok && first < rows; first += chunk_rows)
+    {
+        const size_t count = (rows - first < chunk_rows) ? rows - first : chunk_rows;
+        const size_t next = first + count;
+        const size_t next_count = (rows - next < chunk_rows) ? rows - next : chunk_rows;
+
+        // 本块的预读和上一个结果的写出都结束了，才布置下一轮
+        ok = _stream_io_wait(&io);
+        if (!ok) break;
+        _stream_io_submit(&io, _chunk_range(input, next, next_count), pending);
+        pending = NULL;
+
+        Tensor chunk = tensor_narrow(input, 0, (int)first, (int)count);
+        ok = chunk != NULL && fn(chunk, first, &pending, ctx);
+        tensor_free(chunk);
+        _release(_chunk_range(input, first, count));
+        if (!ok) fprintf(stderr, "Error: %s: processing the chunk at row %zu failed.\n", name, first);
+    }
+
+    // 最后一个结果
+    if (_stream_io_wait(&io) && ok)
+    {
+        _stream_io_submit(&io, (ByteRange){ NULL, 0 }, pending);
+        pending = NULL;
+        ok = _stream_io_wait(&io);
+    }
+    else
+    {
+        ok = false;
+    }
+    tensor_free(pending);
+
+    pthread_mutex_lock(&io.lock);
+    io.quit = true;
+    pthread_cond_broadcast(&io.cond);
+    pthread_mutex_unlock(&io.lock);
+    pthread_join(thread, NULL);
+    pthread_cond_destroy(&io.cond);
+    pthread_mutex_destroy(&io.lock);
+    return ok;
+}
@@ -1,37 +1,59 @@
 #include "tensor/_tensor_view.h"
+#include "tensor/_strided_copy.h"
+#include "tensor/_tensor_iter.h"
+
+#include "utils/_malloc.h"
+#include "utils/_parallel.h"
+
+#include <limits.h> // for INT_MAX
+#include <stdatomic.h>
+#include <stdint.h> // for SIZE_MAX
 #include <stdio.h>
+#include <stdlib.h> // for free()
+#include <string.h> // for memcpy()
 
 Tensor
-tensor_reshape(const Tensor tensor, const Shape new_shape)
+tensor_reshape_ex(const Tensor tensor, const Shape new_shape, bool* is_view)
 {
+    if (is_view != NULL) *is_view = false;
+    if (tensor == NULL || new_shape == NULL) return NULL;
+
     // --- 1. 获取旧形状信息 ---
     const Shape old_shape = tensor_get_shape(tensor);
 
     // --- 2. 验证 ---
-    // a. 检查元素总数是否匹配
+    // 检查元素总数是否匹配
     if (shape_get_elements_count(old_shape) != shape_get_elements_count(new_shape))
     {
         fprintf(stderr, "Error: cannot reshape, total number of elements must remain the same.\n");
         return NULL;
     }
 
-    // b. Reshape 操作要求原始张量是连续的
-    if (!tensor_is_contiguous(tensor))
+    const int* dims = shape_get_dims(new_shape);
+    const int ndim = shape_get_ndim(new_shape);
+
+    // --- 3. 布局允许时直接返回视图（连续张量总是可以） ---
+    Shape view_shape = shape_reshape(old_shape, dims, ndim);
+    if (view_shape != NULL)
     {
-        fprintf(stderr, "Error: tensor_reshape requires a contiguous tensor. Call tensor_contiguous() first.\n");
-        return NULL;
+        if (is_view != NULL) *is_view = true;
+        return _tensor_create_view(tensor, tensor_get_offset(tensor), view_shape);
     }
 
-    // 创建一个新的 Tensor 结构体，但共享数据
-    // 你可以在 _tensor_core.c 中创建一个内部函数来完成这个操作
-    Tensor view = _tensor_create_view
-    (
-        tensor_get_data(tensor), 
-        new_shape, 
-        tensor_get_dtype(tensor)
-    );
-    
-    return view;
+    // --- 4. 否则复制成连续张量，再在它上面建视图 ---
+    //     视图持有 storage 的引用，所以中间张量可以马上释放
+    Tensor contiguous = tensor_contiguous(tensor);
+    if (contiguous == NULL) return NULL;
+
+    Tensor result = _tensor_create_view(contiguous, tensor_get_offset(contiguous), shape_create(dims, ndim));
+    tensor_free(contiguous);
+    return result;
+}
+
+Tensor
+tensor_reshape(const Tensor tensor, const Shape new_shape)
+{
+    return tensor_reshape_ex(tensor, new_shape, NULL);
 }
 
 bool
@@ -60,12 +82,12 @@ tensor_permute(const Tensor t, const int* axes)
     }
 
     // 3. 使用视图工厂函数创建视图
-    //    新张量借用旧张量的数据，但拥有一个新的 Shape 对象
+    //    新张量共享旧张量的 storage，并接管新的 Shape 对象
     Tensor view = _tensor_create_view
     (
-        tensor_get_data(t),
-        new_permuted_shape,
-        tensor_get_dtype(t)
+        t,
+        tensor_get_offset(t),
+        new_permuted_shape
     );
 
     return view;
@@ -93,14 +115,43 @@ tensor_expand(const Tensor t, const Shape target_shape)
     // 3. 使用视图工厂函数创建视图
     Tensor view = _tensor_create_view
     (
-        tensor_get_data(t),
-        new_expanded_shape,
-        tensor_get_dtype(t)
+        t,
+        tensor_get_offset(t),
+        new_expanded_shape
     );
 
     return view;
 }
 
+typedef struct
+{
+    char* dst;
+    const size_t* dst_strides;
+    const char* src;
+    const size_t* src_strides;
+    const int* dims;
+    int ndim;
+    size_t item_size;
+    int axis;            // 沿这个轴切分
+    atomic_bool failed;
+}
+CopyTask;
+
+// 并行任务：复制 axis 轴上的下标 [begin, end)
+static void
+_copy_worker(size_t begin, size_t end, void* ctx)
+{
+    CopyTask* task = (CopyTask*)ctx;
+    int dims[task->ndim];
+    memcpy(dims, task->dims, sizeof(int) * task->ndim);
+    dims[task->axis] = (int)(end - begin);
+
+    if (!strided_copy(task->dst + begin * task->dst_strides[task->axis] * task->item_size, task->dst_strides,
+                      task->src + begin * task->src_strides[task->axis] * task->item_size, task->src_strides,
+                      dims, task->ndim, task->item_size))
+        atomic_store(&task->failed, true);
+}
+
 /**
  * @brief 返回一个内存连续的张量。
  */
@@ -111,7 +162,7 @@ tensor_contiguous(const Tensor tensor)
 
     // --- 情况1: 张量已经是连续的 ---
     if (tensor_is_contiguous(tensor)) {
-        // 直接返回一个深拷贝，新的张量拥有自己的数据
+        // 返回一个写时复制的拷贝：O(1)，写入任何一方都不会影响另一方
         return tensor_copy(tensor);
     }
 
@@ -119,55 +170,475 @@ tensor_contiguous(const Tensor tensor)
     const Shape shape = tensor_get_shape(tensor);
     const DataType dtype = tensor_get_dtype(tensor);
 
-    // a. 创建一个新的、内存连续的目标张量
-    Tensor contiguous_tensor = tensor_create(shape, dtype);
+    // a. 创建一个新的、内存连续的目标张量（马上会被整体覆盖，不必清零）
+    Tensor contiguous_tensor = tensor_empty(shape, dtype);
     if (contiguous_tensor == NULL) {
         return NULL;
     }
+    // 没有元素时无需复制（下面按轴切分时会除以长度为 0 的维度）
+    if (tensor_get_elements_count(tensor) == 0) {
+        return contiguous_tensor;
+    }
 
-    // b. 逐个元素地将数据从非连续的源(tensor)复制到连续的目标(contiguous_tensor)
-    const int ndim = tensor_get_ndim(tensor);
-    const size_t* strides = tensor_get_strides(tensor);
-    const size_t item_size = tensor_get_item_size(tensor);
-    const size_t num_elements = tensor_get_elements_count(tensor);
+    // b. 交给跨步拷贝引擎：合并可合并的维度，再按块复制。
+    //    沿第一个长度大于 1 的轴切分给线程池，每段各自做一次跨步拷贝
+    const int ndim = shape_get_ndim(shape);
+    const int* dims = shape_get_dims(shape);
+    CopyTask task;
+    task.dst = _tensor_get_data(contiguous_tensor);
+    task.dst_strides = tensor_get_strides(contiguous_tensor);
+    task.src = tensor_get_data_const(tensor);
+    task.src_strides = tensor_get_strides(tensor);
+    task.dims = dims;
+    task.ndim = ndim;
+    task.item_size = tensor_get_item_size(tensor);
+    task.axis = 0;
+    while (task.axis < ndim - 1 && dims[task.axis] == 1) task.axis++;
+    atomic_init(&task.failed, false);
 
-    // 获取裸指针
-    const char* source_data = (const char*)tensor_get_data(tensor);
-    char* dest_data = (char*)tensor_get_data(contiguous_tensor);
+    const size_t slab = tensor_get_elements_count(tensor) / (size_t)dims[task.axis]; // 这个轴上每个下标对应的元素数
+    if (task.dst != NULL)
+        parallel_for(0, (size_t)dims[task.axis], parallel_grain(2 * task.item_size * slab), _copy_worker, &task);
 
-    // 用一个数组来像里程表一样追踪逻辑坐标
-    int* coords = safecalloc(ndim, sizeof(int));
-    if (coords == NULL) {
+    if (task.dst == NULL || atomic_load(&task.failed))
+    {
         tensor_free(contiguous_tensor);
         return NULL;
     }
 
-    for (size_t i = 0; i < num_elements; i++) {
-        // c. 根据坐标和步长，计算源数据在内存中的物理偏移量
-        size_t source_offset = 0;
-        for (int d = 0; d < ndim; d++) {
-            source_offset += coords[d] * strides[d];
+    return contiguous_tensor;
+}
+// 公共检查：张量非空、axis 合法
+static bool
+_check_axis(const Tensor t, int axis, const char* name)
+{
+    if (t == NULL) return false;
+    if (axis < 0 || axis >= tensor_get_ndim(t))
+    {
+        fprintf(stderr, "Error: %s: axis %d is out of bounds for tensor of dimension %d\n", name, axis, tensor_get_ndim(t));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 沿一个轴取 [start, stop) 中每隔 step 个元素的视图。
+ */
+Tensor
+tensor_slice(const Tensor t, int axis, int start, int stop, int step)
+{
+    if (!_check_axis(t, axis, "tensor_slice")) return NULL;
+    if (step <= 0)
+    {
+        fprintf(stderr, "Error: tensor_slice: step must be positive, got %d.\n", step);
+        return NULL;
+    }
+
+    const int dim = tensor_get_dim(t, axis);
+    if (start < 0 || stop < 0)
+    {
+        fprintf(stderr, "Error: tensor_slice: negative indices are not supported (start=%d, stop=%d).\n", start, stop);
+        return NULL;
+    }
+    // 和 Python 的切片一样，越界的端点截断到 [0, dim]
+    if (start > dim) start = dim;
+    if (stop > dim) stop = dim;
+    const int length = (stop > start) ? (stop - start + step - 1) / step : 0;
+
+    // 1. 起点折算进 offset，step 折算进该轴的 stride
+    const int ndim = tensor_get_ndim(t);
+    const size_t* old_strides = tensor_get_strides(t);
+    int dims[ndim > 0 ? ndim : 1];
+    size_t strides[ndim > 0 ? ndim : 1];
+    memcpy(dims, shape_get_dims(tensor_get_shape(t)), sizeof(int) * ndim);
+    memcpy(strides, old_strides, sizeof(size_t) * ndim);
+    dims[axis] = length;
+    strides[axis] = old_strides[axis] * (size_t)step;
+
+    const size_t offset = tensor_get_offset(t) + (size_t)start * old_strides[axis];
+
+    // 2. 共享 storage 的视图
+    return _tensor_create_view(t, offset, shape_create_strided(dims, strides, ndim));
+}
+
+/**
+ * @brief 沿一个轴取 [start, start + length) 的视图。
+ */
+Tensor
+tensor_narrow(const Tensor t, int axis, int start, int length)
+{
+    if (!_check_axis(t, axis, "tensor_narrow")) return NULL;
+
+    const int dim = tensor_get_dim(t, axis);
+    if (start < 0 || length < 0 || start > dim || length > dim - start)
+    {
+        fprintf(stderr, "Error: tensor_narrow: range [%d, %d) is out of bounds for dimension of size %d.\n",
+                start, start + length, dim);
+        return NULL;
+    }
+    return tensor_slice(t, axis, start, start + length, 1);
+}
+
+/**
+ * @brief 取一个轴上第 index 个位置的视图，结果少一维。
+ */
+Tensor
+tensor_select(const Tensor t, int axis, int index)
+{
+    if (!_check_axis(t, axis, "tensor_select")) return NULL;
+
+    const int dim = tensor_get_dim(t, axis);
+    if (index < 0 || index >= dim)
+    {
+        fprintf(stderr, "Error: tensor_select: index %d is out of bounds for dimension of size %d.\n", index, dim);
+        return NULL;
+    }
+
+    // 去掉 axis 这一维，index 折算进 offset
+    const int ndim = tensor_get_ndim(t);
+    const int* old_dims = shape_get_dims(tensor_get_shape(t));
+    const size_t* old_strides = tensor_get_strides(t);
+    int dims[ndim];
+    size_t strides[ndim];
+    for (int i = 0, j = 0; i < ndim; i++)
+    {
+        if (i == axis) continue;
+        dims[j] = old_dims[i];
+        strides[j++] = old_strides[i];
+    }
+
+    const size_t offset = tensor_get_offset(t) + (size_t)index * old_strides[axis];
+    return _tensor_create_view(t, offset, shape_create_strided(dims, strides, ndim - 1));
+}
+
+/**
+ * @brief 用任意的 dims/strides/offset 在原张量的 storage 上建视图（检查越界）。
+ */
+Tensor
+tensor_as_strided(const Tensor t, const int* dims, const size_t* strides, int ndim, size_t offset)
+{
+    if (t == NULL || ndim < 0 || (ndim > 0 && (dims == NULL || strides == NULL))) return NULL;
+
+    // 视图能访问到的最远元素是 offset + sum((dims[i] - 1) * strides[i])，它必须落在 storage 里
+    // 乘法或加法溢出 size_t 时，视图必然越界（否则超大的 stride 可以绕回 storage 之内）
+    size_t last = offset;
+    bool empty = false, overflow = false;
+    for (int i = 0; i < ndim; i++)
+    {
+        if (dims[i] < 0)
+        {
+            fprintf(stderr, "Error: tensor_as_strided: negative dimension %d.\n", dims[i]);
+            return NULL;
+        }
+        if (dims[i] == 0)
+        {
+            empty = true;
+            continue;
+        }
+        const size_t steps = (size_t)(dims[i] - 1);
+        if (steps > 0 && strides[i] > (SIZE_MAX - last) / steps) overflow = true;
+        else last += steps * strides[i];
+    }
+
+    const size_t limit = _tensor_get_storage_elements(t);
+    if (!empty && overflow)
+    {
+        fprintf(stderr, "Error: tensor_as_strided: strides reach past the end of the address space.\n");
+        return NULL;
+    }
+    if (!empty && last >= limit)
+    {
+        fprintf(stderr, "Error: tensor_as_strided: view reaches element %zu, but the storage holds only %zu elements.\n",
+                last, limit);
+        return NULL;
+    }
+
+    return _tensor_create_view(t, offset, shape_create_strided(dims, strides, ndim));
+}
+
+/**
+ * @brief 沿一个轴取所有长度为 size、间隔为 step 的窗口，窗口作为新的最后一维。
+ */
+Tensor
+tensor_unfold(const Tensor t, int axis, int size, int step)
+{
+    if (!_check_axis(t, axis, "tensor_unfold")) return NULL;
+
+    const int dim = tensor_get_dim(t, axis);
+    if (size <= 0 || step <= 0 || size > dim)
+    {
+        fprintf(stderr, "Error: tensor_unfold: invalid window (size=%d, step=%d) for dimension of size %d.\n",
+                size, step, dim);
+        return NULL;
+    }
+
+    // 窗口个数放在原来的轴上（stride 乘以 step），窗口内的下标是新的最后一维（沿用原 stride）
+    const int ndim = tensor_get_ndim(t);
+    const size_t* old_strides = tensor_get_strides(t);
+    int dims[ndim + 1];
+    size_t strides[ndim + 1];
+    memcpy(dims, shape_get_dims(tensor_get_shape(t)), sizeof(int) * ndim);
+    memcpy(strides, old_strides, sizeof(size_t) * ndim);
+    dims[axis] = (dim - size) / step + 1;
+    strides[axis] = old_strides[axis] * (size_t)step;
+    dims[ndim] = size;
+    strides[ndim] = old_strides[axis];
+
+    return _tensor_create_view(t, tensor_get_offset(t), shape_create_strided(dims, strides, ndim + 1));
+}
+
+// --- 拼接与堆叠 ---
+
+// 每个输入都按第一个长度大于 1 的轴切成若干块，块大小接近 PARALLEL_CHUNK_BYTES，
+// 所有输入的块连成一个下标区间交给 parallel_for。
+typedef struct
+{
+    char* dst;              // 这个输入在输出中的起点
+    const char* src;
+    const size_t* src_strides;
+    const int* dims;
+    int ndim;
+    int split_axis;         // 按这个轴切块（ndim 为 0 时不切）
+    size_t rows_per_piece;  // 每块包含 split_axis 上的多少个下标
+    size_t first_piece;     // 第一块在全部块中的下标
+}
+CatPart;
+
+typedef struct
+{
+    CatPart* parts;
+    int nparts;
+    const size_t* dst_strides; // 输入各轴在输出中对应的 stride（stack 时去掉了新轴）
+    size_t item_size;
+    atomic_bool failed;
+}
+CatTask;
+
+static void
+_cat_worker(size_t begin, size_t end, void* ctx)
+{
+    CatTask* task = (CatTask*)ctx;
+
+    // 找到包含 begin 的输入（块的编号随输入递增），之后顺序往后走
+    int lo = 0, hi = task->nparts - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) / 2;
+        if (task->parts[mid].first_piece <= begin) lo = mid; else hi = mid - 1;
+    }
+
+    for (int i = lo; i < task->nparts && task->parts[i].first_piece < end; i++)
+    {
+        const CatPart* part = &task->parts[i];
+        const size_t rows = (part->ndim > 0) ? (size_t)part->dims[part->split_axis] : 1;
+        const size_t pieces = (rows + part->rows_per_piece - 1) / part->rows_per_piece;
+        const size_t p0 = (begin > part->first_piece) ? begin - part->first_piece : 0;
+        const size_t p1 = (end - part->first_piece < pieces) ? end - part->first_piece : pieces;
+        if (p0 >= p1) continue;
+
+        if (part->ndim == 0)
+        {
+            memcpy(part->dst, part->src, task->item_size);
+            continue;
         }
 
-        // d. 复制单个元素的数据
-        //    源地址：基地址 + 物理偏移量 * 单个元素大小
-        //    目标地址：基地址 + 线性索引 * 单个元素大小
-        memcpy(dest_data + i * item_size, 
-               source_data + source_offset * item_size,
-               item_size);
-        
-        // e. 更新里程表（逻辑坐标）
-        int current_dim = ndim - 1;
-        while (current_dim >= 0) {
-            coords[current_dim]++;
-            if (coords[current_dim] < tensor_get_dim(tensor, current_dim)) {
-                break; // 当前维度未溢出，停止进位
+        const size_t r0 = p0 * part->rows_per_piece;
+        const size_t r1 = (p1 * part->rows_per_piece < rows) ? p1 * part->rows_per_piece : rows;
+        int dims[part->ndim];
+        memcpy(dims, part->dims, sizeof(int) * part->ndim);
+        dims[part->split_axis] = (int)(r1 - r0);
+
+        const int a = part->split_axis;
+        if (!strided_copy(part->dst + r0 * task->dst_strides[a] * task->item_size, task->dst_strides,
+                          part->src + r0 * part->src_strides[a] * task->item_size, part->src_strides,
+                          dims, part->ndim, task->item_size))
+            atomic_store(&task->failed, true);
+    }
+}
+
+// 检查输入并算出结果的形状。stack 时 axis 是新轴的位置
+static bool
+_cat_result_dims(const Tensor* tensors, int n, int axis, bool stack, int* out_dims, int* out_ndim, const char* name)
+{
+    if (tensors == NULL || n < 1)
+    {
+        fprintf(stderr, "Error: %s: expected at least one tensor.\n", name);
+        return false;
+    }
+    for (int i = 0; i < n; i++)
+        if (tensors[i] == NULL) return false;
+
+    const Tensor first = tensors[0];
+    const int ndim = tensor_get_ndim(first);
+    const int result_ndim = stack ? ndim + 1 : ndim;
+    if (axis < 0 || axis >= result_ndim || result_ndim > TENSOR_ITER_MAX_DIMS)
+    {
+        fprintf(stderr, "Error: %s: axis %d is out of bounds for a result of dimension %d\n", name, axis, result_ndim);
+        return false;
+    }
+
+    const int* dims = shape_get_dims(tensor_get_shape(first));
+    long long total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        const Tensor t = tensors[i];
+        if (tensor_get_dtype(t) != tensor_get_dtype(first) || tensor_get_ndim(t) != ndim)
+        {
+            fprintf(stderr, "Error: %s: tensor %d has a different dtype or number of dimensions.\n", name, i);
+            return false;
+        }
+        for (int d = 0; d < ndim; d++)
+        {
+            if (tensor_get_dim(t, d) != dims[d] && (stack || d != axis))
+            {
+                fprintf(stderr, "Error: %s: tensor %d has size %d in dimension %d, expected %d.\n",
+                        name, i, tensor_get_dim(t, d), d, dims[d]);
+                return false;
             }
-            coords[current_dim] = 0; // 当前维度溢出，归零并向前一位进位
-            current_dim--;
         }
+        if (!stack) total += tensor_get_dim(t, axis);
     }
-    
-    free(coords);
-    return contiguous_tensor;
-}
\ No newline at end of file
+    if (stack) total = n;
+    if (total > INT_MAX)
+    {
+        fprintf(stderr, "Error: %s: the result is too large.\n", name);
+        return false;
+    }
+
+    // 结果的维度：cat 时 axis 上是各输入之和；stack 时在 axis 处插入长度为 n 的新轴
+    for (int d = 0, j = 0; d < result_ndim; d++)
+        out_dims[d] = (stack && d == axis) ? n : dims[j++];
+    if (!stack) out_dims[axis] = (int)total;
+    *out_ndim = result_ndim;
+    return true;
+}
+
+static bool
+_cat_into(Tensor out, const Tensor* tensors, int n, int axis, bool stack, const char* name)
+{
+    // 先拿可写指针（可能触发写时复制），再检查输出是否与输入重叠
+    char* out_data = _tensor_get_data(out);
+    if (out_data == NULL) return false;
+    for (int i = 0; i < n; i++)
+    {
+        if (tensor_may_share_memory(out, tensors[i]))
+        {
+            fprintf(stderr, "Error: %s: the output overlaps input %d.\n", name, i);
+            return false;
+        }
+    }
+
+    const size_t item_size = tensor_get_item_size(out);
+    const size_t* out_strides = tensor_get_strides(out);
+    const int ndim = tensor_get_ndim(tensors[0]);
+
+    // 输入的第 d 轴在输出中的 stride：stack 时跳过新轴
+    size_t dst_strides[TENSOR_ITER_MAX_DIMS];
+    for (int d = 0, j = 0; d < ndim; d++, j++)
+    {
+        if (stack && j == axis) j++;
+        dst_strides[d] = out_strides[j];
+    }
+
+    CatPart* parts = safemalloc(sizeof(CatPart) * (size_t)n);
+    if (parts == NULL) return false;
+
+    size_t pieces = 0, bytes = 0, position = 0; // position: 当前输入在输出 axis 上的起点
+    for (int i = 0; i < n; i++)
+    {
+        const Tensor t = tensors[i];
+        CatPart* part = &parts[i];
+        part->dst = out_data + position * out_strides[axis] * item_size;
+        part->src = tensor_get_data_const(t);
+        part->src_strides = tensor_get_strides(t);
+        part->dims = shape_get_dims(tensor_get_shape(t));
+        part->ndim = ndim;
+        part->first_piece = pieces;
+        position += stack ? 1 : (size_t)tensor_get_dim(t, axis);
+
+        const size_t count = tensor_get_elements_count(t);
+        part->split_axis = 0;
+        while (part->split_axis < ndim - 1 && part->dims[part->split_axis] == 1) part->split_axis++;
+        part->rows_per_piece = 1;
+        if (count == 0) continue; // 空输入不产生任何块
+
+        size_t rows = 1;
+        if (ndim > 0)
+        {
+            rows = (size_t)part->dims[part->split_axis];
+            const size_t row_bytes = count / rows * item_size;
+            part->rows_per_piece = (row_bytes < PARALLEL_CHUNK_BYTES) ? PARALLEL_CHUNK_BYTES / row_bytes : 1;
+        }
+        pieces += (rows + part->rows_per_piece - 1) / part->rows_per_piece;
+        bytes += count * item_size;
+    }
+
+    CatTask task;
+    task.parts = parts;
+    task.nparts = n;
+    task.dst_strides = dst_strides;
+    task.item_size = item_size;
+    atomic_init(&task.failed, false);
+
+    // 小输入的块远小于 PARALLEL_CHUNK_BYTES，按平均块大小放大 grain
+    const size_t average = (pieces > 0) ? bytes / pieces : 0;
+    parallel_for(0, pieces, parallel_grain(2 * average), _cat_worker, &task);
+
+    free(parts);
+    return !atomic_load(&task.failed);
+}
+
+static Tensor
+_cat(const Tensor* tensors, int n, int axis, bool stack, const char* name)
+{
+    int dims[TENSOR_ITER_MAX_DIMS];
+    int ndim = 0;
+    if (!_cat_result_dims(tensors, n, axis, stack, dims, &ndim, name)) return NULL;
+
+    Shape shape = shape_create(dims, ndim);
+    if (shape == NULL) return NULL;
+    Tensor out = tensor_empty(shape, tensor_get_dtype(tensors[0])); // 每个元素都会被写入
+    shape_free(shape);
+    if (out == NULL) return NULL;
+
+    if (!_cat_into(out, tensors, n, axis, stack, name))
+    {
+        tensor_free(out);
+        return NULL;
+    }
+    return out;
+}
+
+static bool
+_cat_out(Tensor out, const Tensor* tensors, int n, int axis, bool stack, const char* name)
+{
+    int dims[TENSOR_ITER_MAX_DIMS];
+    int ndim = 0;
+    return out != NULL && _cat_result_dims(tensors, n, axis, stack, dims, &ndim, name) &&
+           _tensor_check_out(out, dims, ndim, tensor_get_dtype(tensors[0]), name) &&
+           _cat_into(out, tensors, n, axis, stack, name);
+}
+
+Tensor
+tensor_cat(const Tensor* tensors, int n, int axis)
+{
+    return _cat(tensors, n, axis, false, "tensor_cat");
+}
+
+bool
+tensor_cat_out(Tensor out, const Tensor* tensors, int n, int axis)
+{
+    return _cat_out(out, tensors, n, axis, false, "tensor_cat_out");
+}
+
+Tensor
+tensor_stack(const Tensor* tensors, int n, int axis)
+{
+    return _cat(tensors, n, axis, true, "tensor_stack");
+}
+
+bool
+tensor_stack_out(Tensor out, const Tensor* tensors, int n, int axis)
+{
+    return _cat_out(out, tensors, n, axis, true, "tensor_stack_out");
+}
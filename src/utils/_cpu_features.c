@@ -0,0 +1,50 @@
+#include "_cpu_features.h"
+
+#include <pthread.h> // for pthread_once()
+#include <stdlib.h>  // for getenv()
+#include <string.h>  // for strcmp()
+
+static CpuFeatures _features;
+static pthread_once_t _features_once = PTHREAD_ONCE_INIT;
+
+static void
+_detect_features(void)
+{
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    _features.avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    _features.avx512f = __builtin_cpu_supports("avx512f");
+    _features.f16c = __builtin_cpu_supports("f16c") && _features.avx2;
+    _features.avx512bf16 = __builtin_cpu_supports("avx512bf16") && _features.avx512f;
+#endif
+
+#if defined(__aarch64__)
+    _features.neon = true;
+#endif
+
+    // 允许通过环境变量把可用的指令集“降级”，方便对比测试
+    const char* cap = getenv("SNAKE_SIMD");
+    if (cap != NULL)
+    {
+        if (strcmp(cap, "scalar") == 0)
+        {
+            _features.avx2 = false;
+            _features.avx512f = false;
+            _features.f16c = false;
+            _features.avx512bf16 = false;
+            _features.neon = false;
+        }
+        else if (strcmp(cap, "avx2") == 0)
+        {
+            _features.avx512f = false;
+            _features.avx512bf16 = false;
+        }
+    }
+}
+
+const CpuFeatures*
+cpu_get_features(void)
+{
+    pthread_once(&_features_once, _detect_features);
+    return &_features;
+}
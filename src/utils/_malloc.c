@@ -1,9 +1,286 @@
+#define _DEFAULT_SOURCE // for MAP_ANONYMOUS, madvise()
+
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>    // for uintptr_t, SIZE_MAX
+#include <string.h>    // for memset()
+#include <stdatomic.h>
+#include <pthread.h>   // for pthread_once(), pthread_key_create()
 #include "_malloc.h"
 
-void* 
-_safe_malloc_internal(size_t size, const char* file, int line) 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>  // for mmap(), munmap(), madvise()
+#include <unistd.h>    // for sysconf()
+#define SAFE_HAVE_MMAP 1
+#endif
+
+// --- Allocation tracing ---
+
+#define SAFE_TRACE_SITES 1024 // 调用点表的容量（2 的幂）；满了以后新的调用点归到最后一格
+
+typedef struct
+{
+    _Atomic(const char*) file; // NULL 表示空位；写入 line 之后才发布
+    int line;
+    SafeAllocCategory category;
+    atomic_size_t allocs;
+    atomic_size_t bytes;
+    atomic_size_t live;
+    atomic_size_t peak;
+}
+TraceSite;
+
+static atomic_int _trace_on = -1; // -1：还没读过环境变量
+static TraceSite _trace_sites[SAFE_TRACE_SITES];
+static pthread_mutex_t _trace_insert_lock = PTHREAD_MUTEX_INITIALIZER;
+static atomic_size_t _trace_allocs[SAFE_ALLOC_CATEGORY_COUNT];
+static atomic_size_t _trace_live[SAFE_ALLOC_CATEGORY_COUNT];
+static atomic_size_t _trace_peak[SAFE_ALLOC_CATEGORY_COUNT];
+static atomic_size_t _trace_total_live;
+static atomic_size_t _trace_total_peak;
+static SafeAllocHook _trace_hook = NULL;
+static void* _trace_hook_ctx = NULL;
+
+static void _read_env(void);
+static pthread_once_t _env_once = PTHREAD_ONCE_INIT;
+
+static bool
+_tracing(void)
+{
+    int on = atomic_load_explicit(&_trace_on, memory_order_relaxed);
+    if (on < 0)
+    {
+        pthread_once(&_env_once, _read_env);
+        on = atomic_load_explicit(&_trace_on, memory_order_relaxed);
+    }
+    return on > 0;
+}
+
+static void
+_atomic_max(atomic_size_t* target, size_t value)
+{
+    size_t current = atomic_load_explicit(target, memory_order_relaxed);
+    while (value > current &&
+           !atomic_compare_exchange_weak_explicit(target, &current, value, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+}
+
+// 找到（或登记）file:line 对应的调用点，返回它在表中的下标
+static size_t
+_trace_site(const char* file, int line, SafeAllocCategory category)
+{
+    const size_t mask = SAFE_TRACE_SITES - 1;
+    const size_t start = ((uintptr_t)file ^ ((size_t)(unsigned)line * 2654435761u)) & mask;
+
+    // 调用点只增不删，所以无锁查找；只有登记新调用点时才加锁
+    for (size_t i = 0; i < SAFE_TRACE_SITES - 1; i++)
+    {
+        TraceSite* site = &_trace_sites[(start + i) & mask];
+        const char* f = atomic_load_explicit(&site->file, memory_order_acquire);
+        if (f == NULL) break;
+        if (f == file && site->line == line) return (start + i) & mask;
+    }
+
+    pthread_mutex_lock(&_trace_insert_lock);
+    size_t found = SAFE_TRACE_SITES - 1;
+    for (size_t i = 0; i < SAFE_TRACE_SITES - 1; i++)
+    {
+        const size_t index = (start + i) & mask;
+        if (index == SAFE_TRACE_SITES - 1) continue; // 最后一格留给溢出的调用点
+        TraceSite* site = &_trace_sites[index];
+        const char* f = atomic_load_explicit(&site->file, memory_order_relaxed);
+        if (f == file && site->line == line) { found = index; break; }
+        if (f == NULL)
+        {
+            site->line = line;
+            site->category = category;
+            atomic_store_explicit(&site->file, file, memory_order_release);
+            found = index;
+            break;
+        }
+    }
+    if (found == SAFE_TRACE_SITES - 1 && atomic_load_explicit(&_trace_sites[found].file, memory_order_relaxed) == NULL)
+    {
+        _trace_sites[found].line = 0;
+        _trace_sites[found].category = category;
+        atomic_store_explicit(&_trace_sites[found].file, "(other sites)", memory_order_release);
+    }
+    pthread_mutex_unlock(&_trace_insert_lock);
+    return found;
+}
+
+static void
+_trace_notify(bool is_free, SafeAllocCategory category, size_t bytes, const TraceSite* site)
+{
+    SafeAllocHook hook = _trace_hook;
+    if (hook == NULL) return;
+
+    SafeAllocEvent event;
+    event.is_free = is_free;
+    event.category = category;
+    event.bytes = bytes;
+    event.file = atomic_load_explicit(&site->file, memory_order_relaxed);
+    event.line = site->line;
+    event.live_bytes = atomic_load_explicit(&_trace_total_live, memory_order_relaxed);
+    hook(&event, _trace_hook_ctx);
+}
+
+// 记录一次分配。live 为 true 时这块内存计入存活字节，返回值（调用点下标 + 1）
+// 要记在块头里，释放时交给 _trace_free()；0 表示这块内存没有被跟踪。
+static uint32_t
+_trace_alloc(SafeAllocCategory category, size_t bytes, bool live, const char* file, int line)
+{
+    if (!_tracing()) return 0;
+
+    const size_t index = _trace_site(file, line, category);
+    TraceSite* site = &_trace_sites[index];
+    atomic_fetch_add_explicit(&site->allocs, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&site->bytes, bytes, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_trace_allocs[category], 1, memory_order_relaxed);
+    if (live)
+    {
+        _atomic_max(&site->peak, atomic_fetch_add_explicit(&site->live, bytes, memory_order_relaxed) + bytes);
+        _atomic_max(&_trace_peak[category], atomic_fetch_add_explicit(&_trace_live[category], bytes, memory_order_relaxed) + bytes);
+        _atomic_max(&_trace_total_peak, atomic_fetch_add_explicit(&_trace_total_live, bytes, memory_order_relaxed) + bytes);
+    }
+    _trace_notify(false, category, bytes, site);
+    return live ? (uint32_t)index + 1 : 0;
+}
+
+static void
+_trace_free(uint32_t id, size_t bytes)
+{
+    if (id == 0) return;
+
+    TraceSite* site = &_trace_sites[id - 1];
+    const SafeAllocCategory category = site->category;
+    atomic_fetch_sub_explicit(&site->live, bytes, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&_trace_live[category], bytes, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&_trace_total_live, bytes, memory_order_relaxed);
+    _trace_notify(true, category, bytes, site);
+}
+
+void
+safe_alloc_trace_enable(bool enable)
+{
+    pthread_once(&_env_once, _read_env); // 之后就不会再被环境变量覆盖
+    atomic_store(&_trace_on, enable ? 1 : 0);
+}
+
+bool
+safe_alloc_trace_enabled(void)
+{
+    return _tracing();
+}
+
+void
+safe_alloc_trace_set_hook(SafeAllocHook hook, void* ctx)
+{
+    _trace_hook_ctx = ctx;
+    _trace_hook = hook;
+}
+
+void
+safe_alloc_trace_stats(SafeAllocStats* stats)
+{
+    if (stats == NULL) return;
+    for (int c = 0; c < SAFE_ALLOC_CATEGORY_COUNT; c++)
+    {
+        stats->allocs[c] = atomic_load_explicit(&_trace_allocs[c], memory_order_relaxed);
+        stats->live[c] = atomic_load_explicit(&_trace_live[c], memory_order_relaxed);
+        stats->peak[c] = atomic_load_explicit(&_trace_peak[c], memory_order_relaxed);
+    }
+    stats->live_bytes = atomic_load_explicit(&_trace_total_live, memory_order_relaxed);
+    stats->peak_bytes = atomic_load_explicit(&_trace_total_peak, memory_order_relaxed);
+}
+
+static int
+_compare_sites(const void* a, const void* b)
+{
+    const SafeAllocSite* x = a;
+    const SafeAllocSite* y = b;
+    if (x->peak_bytes != y->peak_bytes) return (x->peak_bytes < y->peak_bytes) ? 1 : -1;
+    if (x->bytes != y->bytes) return (x->bytes < y->bytes) ? 1 : -1;
+    return 0;
+}
+
+// 把已登记的调用点抄进 out（SAFE_TRACE_SITES 项），按峰值从高到低排序，返回个数
+static size_t
+_collect_sites(SafeAllocSite* out)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < SAFE_TRACE_SITES; i++)
+    {
+        TraceSite* site = &_trace_sites[i];
+        const char* file = atomic_load_explicit(&site->file, memory_order_acquire);
+        if (file == NULL) continue;
+
+        SafeAllocSite* s = &out[count++];
+        s->file = file;
+        s->line = site->line;
+        s->category = site->category;
+        s->allocs = atomic_load_explicit(&site->allocs, memory_order_relaxed);
+        s->bytes = atomic_load_explicit(&site->bytes, memory_order_relaxed);
+        s->live_bytes = atomic_load_explicit(&site->live, memory_order_relaxed);
+        s->peak_bytes = atomic_load_explicit(&site->peak, memory_order_relaxed);
+    }
+    qsort(out, count, sizeof(SafeAllocSite), _compare_sites);
+    return count;
+}
+
+size_t
+safe_alloc_trace_sites(SafeAllocSite* sites, size_t max)
+{
+    // 这里不能用 safemalloc()：那样会把查询本身也记进去
+    SafeAllocSite* all = malloc(SAFE_TRACE_SITES * sizeof(SafeAllocSite));
+    if (all == NULL) return 0;
+
+    const size_t count = _collect_sites(all);
+    if (sites != NULL) memcpy(sites, all, ((count < max) ? count : max) * sizeof(SafeAllocSite));
+    free(all);
+    return count;
+}
+
+void
+safe_alloc_trace_reset_peak(void)
+{
+    for (size_t i = 0; i < SAFE_TRACE_SITES; i++)
+        atomic_store_explicit(&_trace_sites[i].peak, atomic_load_explicit(&_trace_sites[i].live, memory_order_relaxed), memory_order_relaxed);
+    for (int c = 0; c < SAFE_ALLOC_CATEGORY_COUNT; c++)
+        atomic_store_explicit(&_trace_peak[c], atomic_load_explicit(&_trace_live[c], memory_order_relaxed), memory_order_relaxed);
+    atomic_store_explicit(&_trace_total_peak, atomic_load_explicit(&_trace_total_live, memory_order_relaxed), memory_order_relaxed);
+}
+
+void
+safe_alloc_trace_dump(FILE* out)
+{
+    static const char* const names[SAFE_ALLOC_CATEGORY_COUNT] = { "general", "data", "small", "arena" };
+    if (out == NULL) return;
+
+    SafeAllocStats stats;
+    safe_alloc_trace_stats(&stats);
+    fprintf(out, "allocation trace: live %zu bytes, peak %zu bytes%s\n",
+            stats.live_bytes, stats.peak_bytes, _tracing() ? "" : " (tracing is off)");
+    for (int c = 0; c < SAFE_ALLOC_CATEGORY_COUNT; c++)
+        fprintf(out, "  %-8s %12zu allocs %14zu live %14zu peak\n", names[c], stats.allocs[c], stats.live[c], stats.peak[c]);
+
+    SafeAllocSite* sites = malloc(SAFE_TRACE_SITES * sizeof(SafeAllocSite));
+    if (sites == NULL) return;
+    const size_t count = _collect_sites(sites);
+    fprintf(out, "  %14s %14s %12s %16s  %-8s site\n", "peak", "live", "allocs", "bytes", "kind");
+    for (size_t i = 0; i < count; i++)
+        fprintf(out, "  %14zu %14zu %12zu %16zu  %-8s %s:%d\n", sites[i].peak_bytes, sites[i].live_bytes,
+                sites[i].allocs, sites[i].bytes, names[sites[i].category], sites[i].file, sites[i].line);
+    free(sites);
+}
+
+// --- General allocation ---
+
+// malloc 加上错误报告，不做跟踪（供本文件内部的分配使用）
+static void*
+_malloc_raw(size_t size, const char* file, int line)
 {
     if (size == 0)
     {
@@ -20,10 +297,18 @@ _safe_malloc_internal(size_t size, const char* file, int line)
     return ptr;
 }
 
-void* 
-_safe_calloc_internal(size_t num, size_t size, const char* file, int line) 
+void*
+_safe_malloc_internal(size_t size, const char* file, int line)
 {
-    if (num == 0 || size == 0) 
+    void* ptr = _malloc_raw(size, file, line);
+    if (ptr != NULL) _trace_alloc(SAFE_ALLOC_GENERAL, size, false, file, line);
+    return ptr;
+}
+
+void*
+_safe_calloc_internal(size_t num, size_t size, const char* file, int line)
+{
+    if (num == 0 || size == 0)
     {
         fprintf(stderr, "WARN: calloc(num=0 or size=0) called at %s:%d\n", file, line);
         return NULL;
@@ -35,5 +320,511 @@ _safe_calloc_internal(size_t num, size_t size, const char* file, int line)
         fprintf(stderr, "FATAL: calloc(%zu, %zu bytes) failed at %s:%d\n", num, size, file, line);
         return NULL;
     }
+    _trace_alloc(SAFE_ALLOC_GENERAL, num * size, false, file, line);
     return ptr;
 }
+
+// --- Aligned allocation ---
+
+#define SAFE_HUGEPAGE_SIZE ((size_t)2 << 20)
+#define SAFE_MMAP_THRESHOLD ((size_t)128 << 10) // 与 glibc 默认的 mmap 阈值相同
+
+typedef enum
+{
+    ALLOC_KIND_HEAP,  // malloc 得到，free(base) 释放
+    ALLOC_KIND_MMAP,  // 匿名映射，munmap(base, length) 释放
+    ALLOC_KIND_ARENA  // 来自 arena，随 safe_arena_reset() 一起释放
+}
+AllocKind;
+
+// 紧挨在返回指针前面的块头，记录如何释放这块内存
+typedef struct
+{
+    void* base;
+    size_t length;
+    size_t bytes;   // 请求的字节数
+    AllocKind kind;
+    uint32_t trace; // _trace_alloc() 的返回值
+}
+AllocHeader;
+
+static void* _arena_data_alloc(size_t bytes, size_t alignment);
+
+static atomic_size_t _alignment = SAFE_DEFAULT_ALIGNMENT;
+static atomic_size_t _hugepage_threshold = 0; // 0 表示关闭
+
+static void
+_read_env(void)
+{
+    const char* env = getenv("SNAKE_HUGEPAGE_THRESHOLD");
+    if (env != NULL)
+        atomic_store(&_hugepage_threshold, (size_t)strtoull(env, NULL, 10));
+
+    env = getenv("SNAKE_ALLOC_TRACE");
+    int expected = -1;
+    atomic_compare_exchange_strong(&_trace_on, &expected, (env != NULL && strtol(env, NULL, 10) != 0) ? 1 : 0);
+}
+
+int
+safe_alloc_set_alignment(size_t alignment)
+{
+    if (alignment < sizeof(void*) || alignment > SAFE_HUGEPAGE_SIZE || (alignment & (alignment - 1)) != 0)
+    {
+        fprintf(stderr, "Error: invalid allocation alignment %zu (must be a power of two in [%zu, %zu]).\n",
+                alignment, sizeof(void*), SAFE_HUGEPAGE_SIZE);
+        return -1;
+    }
+    atomic_store(&_alignment, alignment);
+    return 0;
+}
+
+size_t
+safe_alloc_get_alignment(void)
+{
+    return atomic_load(&_alignment);
+}
+
+void
+safe_alloc_set_hugepage_threshold(size_t bytes)
+{
+    pthread_once(&_env_once, _read_env); // 之后就不会再被环境变量覆盖
+    atomic_store(&_hugepage_threshold, bytes);
+}
+
+size_t
+safe_alloc_get_hugepage_threshold(void)
+{
+    pthread_once(&_env_once, _read_env);
+    return atomic_load(&_hugepage_threshold);
+}
+
+// 块头所占的空间：向上取整到对齐值，保证返回的指针仍然对齐
+static size_t
+_header_space(size_t alignment)
+{
+    return (sizeof(AllocHeader) + alignment - 1) & ~(alignment - 1);
+}
+
+#ifdef SAFE_HAVE_MMAP
+// 映射 length 字节，起始地址按 align 对齐（多映射 align 字节，再裁掉首尾多余的部分）。
+// 匿名映射本身就是全 0 的，不需要再清零。
+static char*
+_map_aligned(size_t length, size_t align, bool huge)
+{
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t slack = (align > page) ? align : 0;
+    char* map = mmap(NULL, length + slack, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) return NULL;
+
+    char* aligned = map;
+    if (slack > 0)
+    {
+        aligned = (char*)(((uintptr_t)map + align - 1) & ~(uintptr_t)(align - 1));
+        const size_t head = (size_t)(aligned - map);
+        if (head > 0) munmap(map, head);
+        if (slack - head > 0) munmap(aligned + length, slack - head);
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (huge) madvise(aligned, length, MADV_HUGEPAGE); // 只是建议，失败了也照常使用
+#else
+    (void)huge;
+#endif
+    return aligned;
+}
+#endif
+
+void*
+_safe_aligned_alloc_internal(size_t num, size_t size, int zero, const char* file, int line)
+{
+    if (num == 0 || size == 0)
+    {
+        fprintf(stderr, "WARN: aligned alloc of 0 bytes called at %s:%d\n", file, line);
+        return NULL;
+    }
+    if (num > SIZE_MAX / size)
+    {
+        fprintf(stderr, "FATAL: aligned alloc of %zu x %zu bytes overflows at %s:%d\n", num, size, file, line);
+        return NULL;
+    }
+
+    const size_t bytes = num * size;
+    const size_t alignment = atomic_load(&_alignment);
+    const size_t header = _header_space(alignment);
+    if (bytes > SIZE_MAX - header - alignment - SAFE_HUGEPAGE_SIZE)
+    {
+        fprintf(stderr, "FATAL: aligned alloc of %zu bytes is too large at %s:%d\n", bytes, file, line);
+        return NULL;
+    }
+
+    char* ptr = NULL;
+    AllocHeader h;
+
+    // 当前 arena 接管数据缓冲区时，直接从 arena 里切一块
+    char* scoped = _arena_data_alloc(header + bytes, alignment);
+    if (scoped != NULL)
+    {
+        h.base = scoped;
+        h.length = header + bytes;
+        h.kind = ALLOC_KIND_ARENA;
+        ptr = scoped + header;
+        if (zero) memset(ptr, 0, bytes);
+    }
+
+#ifdef SAFE_HAVE_MMAP
+    // 大页（用户开启时），或者较大的清零分配：直接映射匿名页。
+    // 后者和 calloc 一样由内核按需提供零页，省掉一遍 memset。
+    const size_t threshold = safe_alloc_get_hugepage_threshold();
+    const bool huge = threshold > 0 && bytes >= threshold;
+    if (ptr == NULL && (huge || (zero && bytes >= SAFE_MMAP_THRESHOLD)))
+    {
+        // 块头放在映射的开头，所以数据从 base + header 开始
+        const size_t granule = huge ? SAFE_HUGEPAGE_SIZE : (size_t)sysconf(_SC_PAGESIZE);
+        const size_t length = (header + bytes + granule - 1) & ~(granule - 1);
+        char* base = _map_aligned(length, huge ? SAFE_HUGEPAGE_SIZE : alignment, huge);
+        if (base != NULL)
+        {
+            h.base = base;
+            h.length = length;
+            h.kind = ALLOC_KIND_MMAP;
+            ptr = base + header;
+        }
+        // 映射失败时退回普通堆分配
+    }
+#endif
+
+    if (ptr == NULL)
+    {
+        // 多申请 alignment 字节，在其中找到对齐后还能放下块头的位置
+        char* base = malloc(header + bytes + alignment);
+        if (base == NULL)
+        {
+            perror(NULL);
+            fprintf(stderr, "FATAL: aligned alloc(%zu bytes) failed at %s:%d\n", bytes, file, line);
+            return NULL;
+        }
+        h.base = base;
+        h.length = header + bytes + alignment;
+        h.kind = ALLOC_KIND_HEAP;
+        ptr = (char*)(((uintptr_t)base + header + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        if (zero) memset(ptr, 0, bytes);
+    }
+
+    // arena 里的数据不单独计入存活字节：它们已经算在 arena 的块里了
+    h.bytes = bytes;
+    h.trace = _trace_alloc(SAFE_ALLOC_DATA, bytes, h.kind != ALLOC_KIND_ARENA, file, line);
+    memcpy(ptr - sizeof(AllocHeader), &h, sizeof(AllocHeader));
+    return ptr;
+}
+
+void
+safe_aligned_free(void* ptr)
+{
+    if (ptr == NULL) return;
+
+    AllocHeader h;
+    memcpy(&h, (char*)ptr - sizeof(AllocHeader), sizeof(AllocHeader));
+    if (h.kind == ALLOC_KIND_ARENA) return;
+    _trace_free(h.trace, h.bytes);
+
+#ifdef SAFE_HAVE_MMAP
+    if (h.kind == ALLOC_KIND_MMAP)
+    {
+        munmap(h.base, h.length);
+        return;
+    }
+#endif
+    free(h.base);
+}
+
+// --- Arenas ---
+
+#define SAFE_ARENA_DEFAULT_BLOCK ((size_t)64 << 10)
+
+typedef struct _arena_block
+{
+    struct _arena_block* next; // 更早分配的块
+    size_t size;               // data 的字节数
+    uint32_t trace;
+    char data[];
+}
+ArenaBlock;
+
+struct _safe_arena
+{
+    ArenaBlock* blocks; // 最新的块在前，最后一个是 reset 后保留的第一块
+    char* cursor;       // 当前块里下一个空闲字节
+    char* limit;        // 当前块的末尾
+    size_t block_size;
+    size_t used;
+    int flags;
+};
+
+static _Thread_local SafeArena* _current_arena = NULL;
+
+static bool
+_arena_grow(SafeArena* arena, size_t min_size)
+{
+    const size_t size = (min_size > arena->block_size) ? min_size : arena->block_size;
+    if (size > SIZE_MAX - sizeof(ArenaBlock)) return false;
+
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + size);
+    if (block == NULL) return false;
+    block->next = arena->blocks;
+    block->size = size;
+    block->trace = _trace_alloc(SAFE_ALLOC_ARENA, size, true, __FILE__, __LINE__);
+    arena->blocks = block;
+    arena->cursor = block->data;
+    arena->limit = block->data + size;
+    return true;
+}
+
+// 从 arena 中按 align 对齐切出 size 字节
+static void*
+_arena_bump(SafeArena* arena, size_t size, size_t align)
+{
+    uintptr_t p = ((uintptr_t)arena->cursor + align - 1) & ~(uintptr_t)(align - 1);
+    if (arena->cursor == NULL || p > (uintptr_t)arena->limit || size > (uintptr_t)arena->limit - p)
+    {
+        // 当前块放不下：开一个新块，保证对齐之后仍然放得下
+        if (size > SIZE_MAX - align || !_arena_grow(arena, size + align)) return NULL;
+        p = ((uintptr_t)arena->cursor + align - 1) & ~(uintptr_t)(align - 1);
+    }
+
+    arena->used += (size_t)(p - (uintptr_t)arena->cursor) + size;
+    arena->cursor = (char*)(p + size);
+    return (void*)p;
+}
+
+static void*
+_arena_data_alloc(size_t bytes, size_t alignment)
+{
+    SafeArena* arena = _current_arena;
+    if (arena == NULL || !(arena->flags & SAFE_ARENA_DATA)) return NULL;
+    return _arena_bump(arena, bytes, alignment); // 失败时退回堆分配
+}
+
+SafeArena*
+safe_arena_create(size_t block_size, int flags)
+{
+    SafeArena* arena = safemalloc(sizeof(SafeArena));
+    if (arena == NULL) return NULL;
+
+    arena->blocks = NULL;
+    arena->cursor = NULL;
+    arena->limit = NULL;
+    arena->block_size = (block_size > 0) ? block_size : SAFE_ARENA_DEFAULT_BLOCK;
+    arena->used = 0;
+    arena->flags = flags;
+    if (!_arena_grow(arena, arena->block_size))
+    {
+        free(arena);
+        return NULL;
+    }
+    return arena;
+}
+
+void
+safe_arena_destroy(SafeArena* arena)
+{
+    if (arena == NULL) return;
+    if (_current_arena == arena) _current_arena = NULL;
+
+    ArenaBlock* block = arena->blocks;
+    while (block != NULL)
+    {
+        ArenaBlock* next = block->next;
+        _trace_free(block->trace, block->size);
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+void
+safe_arena_reset(SafeArena* arena)
+{
+    if (arena == NULL || arena->blocks == NULL) return;
+
+    // 只保留最早的一块
+    while (arena->blocks->next != NULL)
+    {
+        ArenaBlock* next = arena->blocks->next;
+        _trace_free(arena->blocks->trace, arena->blocks->size);
+        free(arena->blocks);
+        arena->blocks = next;
+    }
+    arena->cursor = arena->blocks->data;
+    arena->limit = arena->blocks->data + arena->blocks->size;
+    arena->used = 0;
+}
+
+size_t
+safe_arena_used(const SafeArena* arena)
+{
+    return (arena != NULL) ? arena->used : 0;
+}
+
+SafeArena*
+safe_arena_enter(SafeArena* arena)
+{
+    SafeArena* previous = _current_arena;
+    _current_arena = arena;
+    return previous;
+}
+
+void
+safe_arena_leave(SafeArena* previous)
+{
+    _current_arena = previous;
+}
+
+SafeArena*
+safe_arena_current(void)
+{
+    return _current_arena;
+}
+
+// --- Small objects ---
+
+// 每块前面有一个 16 字节的小块头，记录它从哪里来；用户数据因此保持 16 字节对齐
+#define SAFE_SMALL_HEADER 16
+#define SAFE_SMALL_CLASSES 4           // 64, 128, 256, 512 字节
+#define SAFE_SMALL_MAX ((size_t)512)
+#define SAFE_SMALL_CACHE 256           // 每个线程每个尺寸最多缓存的空闲块数
+
+#define SMALL_KIND_LARGE ((uint32_t)0xFE) // 超过最大尺寸，直接 malloc/free
+#define SMALL_KIND_ARENA ((uint32_t)0xFF)
+
+// 小块头：来源、跟踪信息和请求的字节数
+typedef struct
+{
+    uint32_t kind;  // 尺寸类别，或 SMALL_KIND_LARGE / SMALL_KIND_ARENA
+    uint32_t trace; // _trace_alloc() 的返回值
+    size_t size;
+}
+SmallHeader;
+
+_Static_assert(sizeof(SmallHeader) <= SAFE_SMALL_HEADER, "small block header does not fit");
+
+typedef struct _small_free
+{
+    struct _small_free* next;
+}
+SmallFree;
+
+typedef struct
+{
+    SmallFree* head[SAFE_SMALL_CLASSES];
+    size_t count[SAFE_SMALL_CLASSES];
+}
+SmallCache;
+
+static _Thread_local SmallCache _small_cache;
+static pthread_key_t _small_key;
+static pthread_once_t _small_once = PTHREAD_ONCE_INIT;
+
+// 线程退出时把它缓存的空闲块还给堆
+static void
+_small_cache_destroy(void* arg)
+{
+    SmallCache* cache = (SmallCache*)arg;
+    for (int c = 0; c < SAFE_SMALL_CLASSES; c++)
+    {
+        SmallFree* node = cache->head[c];
+        while (node != NULL)
+        {
+            SmallFree* next = node->next;
+            free((char*)node - SAFE_SMALL_HEADER);
+            node = next;
+        }
+        cache->head[c] = NULL;
+        cache->count[c] = 0;
+    }
+}
+
+static void
+_small_key_create(void)
+{
+    pthread_key_create(&_small_key, _small_cache_destroy);
+}
+
+static int
+_small_class(size_t size)
+{
+    int c = 0;
+    for (size_t cap = 64; cap < size; cap <<= 1) c++;
+    return c;
+}
+
+void*
+_safe_small_alloc_internal(size_t size, const char* file, int line)
+{
+    if (size == 0)
+    {
+        fprintf(stderr, "WARN: small alloc of 0 bytes called at %s:%d\n", file, line);
+        return NULL;
+    }
+
+    char* block;
+    SmallHeader h;
+    h.size = size;
+    SafeArena* arena = _current_arena;
+    if (arena != NULL && size <= SIZE_MAX - SAFE_SMALL_HEADER &&
+        (block = _arena_bump(arena, SAFE_SMALL_HEADER + size, SAFE_SMALL_HEADER)) != NULL)
+    {
+        h.kind = SMALL_KIND_ARENA;
+    }
+    else if (size <= SAFE_SMALL_MAX)
+    {
+        const int c = _small_class(size);
+        h.kind = (uint32_t)c;
+        SmallFree* node = _small_cache.head[c];
+        if (node != NULL)
+        {
+            _small_cache.head[c] = node->next;
+            _small_cache.count[c]--;
+            block = (char*)node - SAFE_SMALL_HEADER;
+        }
+        else
+        {
+            block = _malloc_raw(SAFE_SMALL_HEADER + ((size_t)64 << c), file, line);
+        }
+    }
+    else
+    {
+        h.kind = SMALL_KIND_LARGE;
+        block = (size <= SIZE_MAX - SAFE_SMALL_HEADER) ? _malloc_raw(SAFE_SMALL_HEADER + size, file, line) : NULL;
+    }
+    if (block == NULL) return NULL;
+
+    h.trace = _trace_alloc(SAFE_ALLOC_SMALL, size, h.kind != SMALL_KIND_ARENA, file, line);
+    memcpy(block, &h, sizeof(h));
+    return block + SAFE_SMALL_HEADER;
+}
+
+void
+safe_small_free(void* ptr)
+{
+    if (ptr == NULL) return;
+
+    char* block = (char*)ptr - SAFE_SMALL_HEADER;
+    SmallHeader h;
+    memcpy(&h, block, sizeof(h));
+    if (h.kind == SMALL_KIND_ARENA) return;
+    _trace_free(h.trace, h.size);
+    if (h.kind == SMALL_KIND_LARGE || _small_cache.count[h.kind] >= SAFE_SMALL_CACHE)
+    {
+        free(block);
+        return;
+    }
+
+    // 放进当前线程的缓存；第一次缓存时登记线程退出时的清理
+    pthread_once(&_small_once, _small_key_create);
+    if (pthread_getspecific(_small_key) == NULL) pthread_setspecific(_small_key, &_small_cache);
+
+    SmallFree* node = (SmallFree*)ptr;
+    node->next = _small_cache.head[h.kind];
+    _small_cache.head[h.kind] = node;
+    _small_cache.count[h.kind]++;
+}
@@ -0,0 +1,218 @@
+#define _POSIX_C_SOURCE 200809L // for sysconf(_SC_NPROCESSORS_ONLN)
+
+#include "_parallel.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <stdlib.h> // for getenv(), atoi()
+#include <unistd.h> // for sysconf()
+
+// 每个参与者先处理自己的一段，再去偷别人剩下的块；每个参与者大约分到这么多块
+#define PARALLEL_BLOCKS_PER_THREAD 8
+
+static atomic_int _num_threads = 0;            // 0 表示尚未初始化
+static _Thread_local int _thread_limit = 0;    // 当前线程的上限，0 表示不限
+
+// 一个参与者的初始区间（以块为单位）。各自占一条缓存行，避免伪共享
+typedef struct
+{
+    _Alignas(64) atomic_size_t next; // 下一个未被领取的块
+    size_t end;
+}
+ParallelSlice;
+
+// 一次 parallel_for 调用。放在调用者的栈上，调用返回前一直挂在线程池的任务表里
+typedef struct _parallel_job
+{
+    ParallelForFn fn;
+    void* ctx;
+    size_t begin;
+    size_t end;
+    size_t block;               // 每块的下标数
+    ParallelSlice* slices;
+    int nparts;                 // 参与者个数（包括调用者）
+    int thread_limit;           // 调用者的 _thread_limit，工作线程执行这个任务时沿用
+
+    // 以下字段由 _pool_lock 保护
+    int joined;                 // 已分配的参与者编号
+    int active;                 // 正在执行这个任务的工作线程数
+    pthread_cond_t idle;        // active 降为 0 时通知调用者
+    struct _parallel_job* next;
+}
+ParallelJob;
+
+static pthread_mutex_t _pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _pool_wake = PTHREAD_COND_INITIALIZER;
+static ParallelJob* _pool_jobs = NULL; // 还在进行中的任务
+static int _pool_workers = 0;          // 已启动的工作线程数
+
+// 参与者 id 从自己的区间开始领块，做完后依次去偷其他参与者的
+static void
+_job_run(ParallelJob* job, int id)
+{
+    for (int k = 0; k < job->nparts; k++)
+    {
+        ParallelSlice* slice = &job->slices[(id + k) % job->nparts];
+        for (;;)
+        {
+            const size_t b = atomic_fetch_add(&slice->next, 1);
+            if (b >= slice->end) break;
+
+            const size_t lo = job->begin + b * job->block;
+            const size_t hi = (job->end - lo > job->block) ? lo + job->block : job->end;
+            job->fn(lo, hi, job->ctx);
+        }
+    }
+}
+
+static void*
+_pool_worker(void* arg)
+{
+    (void)arg;
+    pthread_mutex_lock(&_pool_lock);
+    for (;;)
+    {
+        ParallelJob* job = _pool_jobs;
+        while (job != NULL && job->joined >= job->nparts) job = job->next;
+        if (job == NULL)
+        {
+            pthread_cond_wait(&_pool_wake, &_pool_lock);
+            continue;
+        }
+
+        const int id = job->joined++;
+        job->active++;
+        pthread_mutex_unlock(&_pool_lock);
+
+        // 任务里嵌套的 parallel_for 要受调用者的上限约束，而不是这个工作线程自己的
+        const int own_limit = _thread_limit;
+        _thread_limit = job->thread_limit;
+        _job_run(job, id);
+        _thread_limit = own_limit;
+
+        pthread_mutex_lock(&_pool_lock);
+        if (--job->active == 0) pthread_cond_signal(&job->idle);
+    }
+    return NULL;
+}
+
+// 保证至少有 n 个工作线程（调用时持有 _pool_lock）。创建失败时少几个也能正常工作
+static void
+_pool_reserve(int n)
+{
+    while (_pool_workers < n)
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, _pool_worker, NULL) != 0) return;
+        pthread_detach(thread);
+        _pool_workers++;
+    }
+}
+
+int
+parallel_get_num_threads(void)
+{
+    int n = atomic_load(&_num_threads);
+    if (n > 0) return n;
+
+    const char* env = getenv("SNAKE_NUM_THREADS");
+    n = (env != NULL) ? atoi(env) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1) n = 1;
+    atomic_store(&_num_threads, n);
+    return n;
+}
+
+void
+parallel_set_num_threads(int num_threads)
+{
+    atomic_store(&_num_threads, num_threads < 1 ? 1 : num_threads);
+}
+
+int
+parallel_set_thread_limit(int max_threads)
+{
+    const int previous = _thread_limit;
+    _thread_limit = max_threads < 0 ? 0 : max_threads;
+    return previous;
+}
+
+size_t
+parallel_grain(size_t bytes_per_index)
+{
+    if (bytes_per_index == 0 || bytes_per_index >= PARALLEL_CHUNK_BYTES) return 1;
+    return PARALLEL_CHUNK_BYTES / bytes_per_index;
+}
+
+void
+parallel_for_ex(size_t begin, size_t end, size_t grain, int max_threads, ParallelForFn fn, void* ctx)
+{
+    if (fn == NULL || begin >= end) return;
+    if (grain == 0) grain = 1;
+
+    // 1. 参与者个数：全局设置、当前线程的上限和这次调用的上限取最小
+    size_t limit = (size_t)parallel_get_num_threads();
+    if (_thread_limit > 0 && (size_t)_thread_limit < limit) limit = (size_t)_thread_limit;
+    if (max_threads > 0 && (size_t)max_threads < limit) limit = (size_t)max_threads;
+
+    const size_t total = end - begin;
+    size_t nparts = total / grain;
+    if (nparts > limit) nparts = limit;
+    if (nparts <= 1)
+    {
+        fn(begin, end, ctx);
+        return;
+    }
+
+    // 2. 切块：每块至少 grain 个下标，每个参与者分到若干块，方便互相偷取
+    const size_t target = nparts * PARALLEL_BLOCKS_PER_THREAD;
+    size_t block = (total + target - 1) / target;
+    if (block < grain) block = grain;
+    const size_t nblocks = (total + block - 1) / block;
+
+    ParallelSlice slices[nparts];
+    for (size_t p = 0; p < nparts; p++)
+    {
+        atomic_init(&slices[p].next, nblocks * p / nparts);
+        slices[p].end = nblocks * (p + 1) / nparts;
+    }
+
+    ParallelJob job;
+    job.fn = fn;
+    job.ctx = ctx;
+    job.begin = begin;
+    job.end = end;
+    job.block = block;
+    job.slices = slices;
+    job.nparts = (int)nparts;
+    job.thread_limit = _thread_limit;
+    job.joined = 1; // 0 号参与者是调用者自己
+    job.active = 0;
+    pthread_cond_init(&job.idle, NULL);
+
+    // 3. 挂到任务表上，叫醒工作线程，然后自己也参与进来
+    pthread_mutex_lock(&_pool_lock);
+    _pool_reserve((int)nparts - 1);
+    job.next = _pool_jobs;
+    _pool_jobs = &job;
+    pthread_cond_broadcast(&_pool_wake);
+    pthread_mutex_unlock(&_pool_lock);
+
+    _job_run(&job, 0);
+
+    // 4. 所有块都已被领取：摘下任务，等还在执行的工作线程做完
+    pthread_mutex_lock(&_pool_lock);
+    ParallelJob** link = &_pool_jobs;
+    while (*link != &job) link = &(*link)->next;
+    *link = job.next;
+    while (job.active > 0) pthread_cond_wait(&job.idle, &_pool_lock);
+    pthread_mutex_unlock(&_pool_lock);
+
+    pthread_cond_destroy(&job.idle);
+}
+
+void
+parallel_for(size_t begin, size_t end, size_t grain, ParallelForFn fn, void* ctx)
+{
+    parallel_for_ex(begin, end, grain, 0, fn, ctx);
+}
@@ -0,0 +1,99 @@
+#define _POSIX_C_SOURCE 200809L // for getpid()
+
+#include "_test.h"
+
+#include <math.h>   // for fabs(), isnan()
+#include <stdint.h> // for uint64_t
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h> // for getpid()
+
+static int _cases = 0;
+static int _failed_cases = 0;
+static bool _current_failed = false;
+static uint64_t _rng_state = 0x853c49e6748fea9bull;
+
+void
+test_fail(const char* file, int line, const char* what)
+{
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+    _current_failed = true;
+}
+
+void
+test_check_close(const char* file, int line, const char* what, double actual, double expected, double tol)
+{
+    const double scale = fabs(expected) > 1.0 ? fabs(expected) : 1.0;
+    const bool ok = (isnan(actual) || isnan(expected)) ? (isnan(actual) && isnan(expected))
+                                                      : fabs(actual - expected) <= tol * scale;
+    if (ok) return;
+    fprintf(stderr, "%s:%d: check failed: %s is %.17g, expected %.17g\n", file, line, what, actual, expected);
+    _current_failed = true;
+}
+
+void
+test_run(const char* name, void (*fn)(void))
+{
+    _current_failed = false;
+    fn();
+    _cases++;
+    if (_current_failed) _failed_cases++;
+    printf("%s %s\n", _current_failed ? "FAIL" : "ok  ", name);
+}
+
+int
+test_finish(void)
+{
+    printf("%d of %d cases passed\n", _cases - _failed_cases, _cases);
+    return _failed_cases == 0 ? 0 : 1;
+}
+
+Tensor
+test_tensor(const void* values, const int* dims, int ndim, DataType dtype)
+{
+    Shape shape = shape_create(dims, ndim);
+    Tensor t = (shape != NULL) ? tensor_from_data(values, shape, dtype) : NULL;
+    shape_free(shape);
+    if (t == NULL)
+    {
+        fprintf(stderr, "Error: test: cannot create an input tensor\n");
+        exit(1);
+    }
+    return t;
+}
+
+double
+test_get(const Tensor t, size_t i)
+{
+    const void* data = tensor_get_data_const(t);
+    switch (tensor_get_dtype(t))
+    {
+        case DTYPE_I32: return ((const int32_t*)data)[i];
+        case DTYPE_F32: return ((const float*)data)[i];
+        case DTYPE_F64: return ((const double*)data)[i];
+        case DTYPE_F16: return f16_to_f32(((const uint16_t*)data)[i]);
+        case DTYPE_BF16: return bf16_to_f32(((const uint16_t*)data)[i]);
+        case DTYPE_I8: return ((const int8_t*)data)[i];
+        case DTYPE_U8: return ((const uint8_t*)data)[i];
+        default: return NAN;
+    }
+}
+
+double
+test_random(void)
+{
+    // xorshift64*，与 snake_bench 的输入生成器相同
+    _rng_state ^= _rng_state >> 12;
+    _rng_state ^= _rng_state << 25;
+    _rng_state ^= _rng_state >> 27;
+    return (double)((_rng_state * 0x2545f4914f6cdd1dull) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+const char*
+test_tmp_path(char* buffer, size_t size, const char* name)
+{
+    const char* dir = getenv("TMPDIR");
+    if (dir == NULL || dir[0] == '\0') dir = "/tmp";
+    snprintf(buffer, size, "%s/snake_test_%ld_%s", dir, (long)getpid(), name);
+    return buffer;
+}
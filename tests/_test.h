@@ -0,0 +1,69 @@
+#ifndef _TEST_H
+#define _TEST_H
+
+#include "tensor/tensor.h"
+
+#include <stdbool.h>
+#include <stddef.h> // For size_t
+
+// --- Minimal harness for the CTest unit tests ---
+//
+// Every file under tests/ builds into one executable whose main() runs its cases with
+// TEST_RUN() and returns test_finish(). A failing check prints its location and the
+// failed condition, marks the case as failed and goes on, so one run reports every
+// broken check. Allocation failures in the helpers exit right away.
+
+/**
+ * @brief Checks `cond`; on failure reports it and fails the current case.
+ */
+#define TEST_CHECK(cond) \
+    do { if (!(cond)) test_fail(__FILE__, __LINE__, #cond); } while (0)
+
+/**
+ * @brief Checks that `actual` is within `tol` of `expected` (relative to max(1, |expected|)).
+ * NaN only matches NaN.
+ */
+#define TEST_CHECK_CLOSE(actual, expected, tol) \
+    test_check_close(__FILE__, __LINE__, #actual, (actual), (expected), (tol))
+
+/**
+ * @brief Runs one case, a `void fn(void)`, and reports its result.
+ */
+#define TEST_RUN(fn) test_run(#fn, fn)
+
+void test_fail(const char* file, int line, const char* what);
+void test_check_close(const char* file, int line, const char* what, double actual, double expected, double tol);
+void test_run(const char* name, void (*fn)(void));
+
+/**
+ * @brief Prints the summary.
+ * @return The exit status for main(): 0 if every case passed.
+ */
+int test_finish(void);
+
+// --- Input helpers ---
+
+/**
+ * @brief Creates a contiguous tensor holding a copy of `values`. Exits on failure.
+ */
+Tensor test_tensor(const void* values, const int* dims, int ndim, DataType dtype);
+
+/**
+ * @brief Reads element `i` of a contiguous tensor of any dtype as a double.
+ */
+double test_get(const Tensor t, size_t i);
+
+/**
+ * @brief Uniform pseudo-random numbers in [0, 1) from a fixed-seed generator, so every
+ * run checks the same inputs.
+ */
+double test_random(void);
+
+/**
+ * @brief Writes a path for a temporary file named after `name` into `buffer`, in
+ * $TMPDIR (or /tmp) and unique to this process.
+ * @return `buffer`.
+ */
+const char* test_tmp_path(char* buffer, size_t size, const char* name);
+
+#endif // _TEST_H
@@ -0,0 +1,193 @@
+#include "_test.h"
+
+#include "tensor/_tensor_access.h"
+
+static Tensor
+_iota(const int* dims, int ndim, DataType dtype, double offset)
+{
+    Shape s = shape_create(dims, ndim);
+    Tensor t = tensor_empty(s, DTYPE_F64);
+    shape_free(s);
+    double* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = offset + (double)i;
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+TENSOR_DEFINE_UNARY_KERNEL(_square_f32, float, float, x * x)
+TENSOR_DEFINE_UNARY_KERNEL(_to_f64, double, int32_t, (double)x / 2)
+TENSOR_DEFINE_BINARY_KERNEL(_axpy_f32, float, float, float, 2.0f * x + y)
+
+static void
+test_accessor_views(void)
+{
+    // 置换、切片、广播的视图：按下标读到的值与连续副本相同
+    const int dims[3] = { 3, 4, 10 };
+    Tensor base = _iota(dims, 3, DTYPE_F32, 0);
+    const int axes[3] = { 2, 0, 1 };
+    Tensor p = tensor_permute(base, axes); // [10, 3, 4]
+    Tensor v = tensor_slice(p, 0, 1, 10, 3); // [3, 3, 4]
+    TensorAccessor a;
+    TEST_CHECK(tensor_accessor_init_const(&a, v, DTYPE_F32));
+    TEST_CHECK(a.ndim == 3 && a.dims[0] == 3 && a.strides[0] == 3 * sizeof(float) && a.strides[2] == 10 * sizeof(float));
+    int wrong = 0;
+    TENSOR_FOR_3D(a, i, j, k)
+        wrong += TENSOR_AT_F32(a, i, j, k) != (float)((j * 4 + k) * 10 + 1 + 3 * i);
+    TEST_CHECK(wrong == 0);
+
+    const int row_dims[2] = { 1, 4 };
+    Tensor row = _iota(row_dims, 2, DTYPE_I32, 7);
+    const int expanded[2] = { 5, 4 };
+    Shape es = shape_create(expanded, 2);
+    Tensor e = tensor_expand(row, es);
+    TensorAccessor b;
+    TEST_CHECK(tensor_accessor_init_const(&b, e, DTYPE_I32));
+    TEST_CHECK(b.strides[0] == 0 && TENSOR_AT_I32(b, 4, 3) == 10);
+    TEST_CHECK(TENSOR_PTR(b, 4, 3) == TENSOR_PTR(b, 0, 3));
+
+    // 0 维：data 指向唯一的元素
+    const double value = 1.25;
+    Tensor scalar = test_tensor(&value, NULL, 0, DTYPE_F64);
+    TensorAccessor s;
+    TEST_CHECK(tensor_accessor_init_const(&s, scalar, DTYPE_F64));
+    TEST_CHECK(s.ndim == 0 && *(const double*)(const void*)s.data == 1.25);
+
+    tensor_free(scalar);
+    tensor_free(e);
+    shape_free(es);
+    tensor_free(row);
+    tensor_free(v);
+    tensor_free(p);
+    tensor_free(base);
+}
+
+static void
+test_accessor_write_and_reject(void)
+{
+    // 可写的 accessor 写进视图所在的 storage；只读的 accessor 不拆开共享
+    const int dims[2] = { 4, 6 };
+    Tensor base = _iota(dims, 2, DTYPE_F32, 0);
+    Tensor copy = tensor_copy(base);
+    TensorAccessor r;
+    TEST_CHECK(tensor_accessor_init_const(&r, base, DTYPE_F32));
+    TEST_CHECK(tensor_get_data_const(base) == tensor_get_data_const(copy));
+
+    Tensor v = tensor_narrow(base, 1, 2, 3);
+    TensorAccessor w;
+    TEST_CHECK(tensor_accessor_init(&w, v, DTYPE_F32));
+    TENSOR_FOR_2D(w, i, j)
+        TENSOR_AT_F32(w, i, j) = -1.0f;
+    TEST_CHECK(test_get(base, 2) == -1.0 && test_get(base, 22) == -1.0 && test_get(base, 23) == 23.0);
+    TEST_CHECK(test_get(copy, 2) == 2.0);
+
+    // dtype 不对、维数太多、NULL
+    TensorAccessor x;
+    TEST_CHECK(!tensor_accessor_init(&x, base, DTYPE_F64));
+    TEST_CHECK(!tensor_accessor_init_const(&x, base, DTYPE_I32));
+    TEST_CHECK(!tensor_accessor_init_const(&x, NULL, DTYPE_F32));
+    const int five[5] = { 1, 2, 1, 2, 1 };
+    Tensor deep = _iota(five, 5, DTYPE_F32, 0);
+    TEST_CHECK(!tensor_accessor_init_const(&x, deep, DTYPE_F32));
+
+    tensor_free(deep);
+    tensor_free(v);
+    tensor_free(copy);
+    tensor_free(base);
+}
+
+static void
+test_kernel_templates(void)
+{
+    // 连续的行：长度不是块大小的整数倍，走分块和收尾两段
+    const int dims[2] = { 3, 37 };
+    Tensor x = _iota(dims, 2, DTYPE_F32, -50);
+    Shape s = shape_create(dims, 2);
+    Tensor out = tensor_empty(s, DTYPE_F32);
+    TensorAccessor ao, ax;
+    TEST_CHECK(tensor_accessor_init(&ao, out, DTYPE_F32) && tensor_accessor_init_const(&ax, x, DTYPE_F32));
+    _square_f32(&ao, &ax);
+    int wrong = 0;
+    for (int i = 0; i < 3 * 37; i++) wrong += test_get(out, i) != (double)(i - 50) * (i - 50);
+    TEST_CHECK(wrong == 0);
+
+    // 转置的输入走逐元素的路径；类型转换
+    const int flipped[2] = { 37, 3 };
+    Tensor yt = _iota(flipped, 2, DTYPE_I32, 0);
+    const int axes[2] = { 1, 0 };
+    Tensor y = tensor_permute(yt, axes); // [3, 37]
+    Tensor out64 = tensor_empty(s, DTYPE_F64);
+    TensorAccessor a64, ay;
+    TEST_CHECK(tensor_accessor_init(&a64, out64, DTYPE_F64) && tensor_accessor_init_const(&ay, y, DTYPE_I32));
+    _to_f64(&a64, &ay);
+    wrong = 0;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 37; j++) wrong += test_get(out64, i * 37 + j) != (j * 3 + i) / 2.0;
+    TEST_CHECK(wrong == 0);
+
+    // 二元：按列广播的右操作数在行内 stride 为 0（走快速路径），按行广播的在外层 stride 为 0
+    const int col_dims[2] = { 3, 1 };
+    Tensor col = _iota(col_dims, 2, DTYPE_F32, 100);
+    Tensor bcol = tensor_expand(col, s);
+    TensorAccessor ac;
+    TEST_CHECK(tensor_accessor_init_const(&ac, bcol, DTYPE_F32));
+    _axpy_f32(&ao, &ax, &ac);
+    wrong = 0;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 37; j++) wrong += test_get(out, i * 37 + j) != 2.0 * (i * 37 + j - 50) + 100 + i;
+    TEST_CHECK(wrong == 0);
+
+    const int row_dims[2] = { 1, 37 };
+    Tensor row = _iota(row_dims, 2, DTYPE_F32, 0);
+    Tensor brow = tensor_expand(row, s);
+    TensorAccessor ar;
+    TEST_CHECK(tensor_accessor_init_const(&ar, brow, DTYPE_F32));
+    _axpy_f32(&ao, &ax, &ar);
+    wrong = 0;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 37; j++) wrong += test_get(out, i * 37 + j) != 2.0 * (i * 37 + j - 50) + j;
+    TEST_CHECK(wrong == 0);
+
+    // 4 维；有一维为 0 时不访问任何元素
+    const int four[4] = { 2, 3, 2, 5 };
+    Tensor x4 = _iota(four, 4, DTYPE_F32, 0);
+    Shape s4 = shape_create(four, 4);
+    Tensor o4 = tensor_zeros(s4, DTYPE_F32);
+    TensorAccessor a4, b4;
+    TEST_CHECK(tensor_accessor_init(&a4, o4, DTYPE_F32) && tensor_accessor_init_const(&b4, x4, DTYPE_F32));
+    _square_f32(&a4, &b4);
+    TEST_CHECK(test_get(o4, 59) == 59.0 * 59.0 && test_get(o4, 31) == 31.0 * 31.0);
+
+    Tensor none_in = tensor_narrow(x4, 2, 0, 0);
+    Tensor none_out = tensor_narrow(o4, 2, 0, 0);
+    TensorAccessor an, bn;
+    TEST_CHECK(tensor_accessor_init(&an, none_out, DTYPE_F32) && tensor_accessor_init_const(&bn, none_in, DTYPE_F32));
+    TEST_CHECK(an.dims[2] == 0);
+    _square_f32(&an, &bn);
+
+    tensor_free(none_out);
+    tensor_free(none_in);
+    tensor_free(o4);
+    shape_free(s4);
+    tensor_free(x4);
+    tensor_free(brow);
+    tensor_free(row);
+    tensor_free(bcol);
+    tensor_free(col);
+    tensor_free(out64);
+    tensor_free(y);
+    tensor_free(yt);
+    tensor_free(out);
+    shape_free(s);
+    tensor_free(x);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_accessor_views);
+    TEST_RUN(test_accessor_write_and_reject);
+    TEST_RUN(test_kernel_templates);
+    return test_finish();
+}
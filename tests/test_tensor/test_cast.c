@@ -0,0 +1,131 @@
+#include "_test.h"
+
+#include <limits.h> // for INT_MAX, INT_MIN
+#include <math.h>   // for NAN, INFINITY, isnan()
+#include <stdint.h> // for INT8_MIN, INT8_MAX, UINT8_MAX
+
+// 浮点到整数：向零截断，超出范围时取边界，NaN 变成 0
+static const double _inputs[] = { NAN, INFINITY, -INFINITY, 1e20, -1e20, 2147483647.5, -2147483648.5,
+                                  300.0, -300.0, 127.9, -128.9, 255.5, -0.9, 2.7, -2.7, 0.0, -0.0 };
+#define NINPUTS ((int)(sizeof(_inputs) / sizeof(_inputs[0])))
+
+static double
+_saturate(double v, double lo, double hi)
+{
+    if (isnan(v)) return 0;
+    if (v <= lo) return lo;
+    if (v >= hi) return hi;
+    return (double)(long long)v;
+}
+
+static void
+_check_saturation(DataType from)
+{
+    // 重复几遍，长度超过一个向量，SIMD 内核和尾部都会用到
+    enum { REPEAT = 5 };
+    double values[NINPUTS * REPEAT];
+    for (int i = 0; i < NINPUTS * REPEAT; i++) values[i] = _inputs[i % NINPUTS];
+    const int dims[1] = { NINPUTS * REPEAT };
+    Tensor t64 = test_tensor(values, dims, 1, DTYPE_F64);
+    Tensor t = (from == DTYPE_F64) ? tensor_copy(t64) : tensor_to_dtype(t64, from);
+
+    const DataType targets[3] = { DTYPE_I32, DTYPE_I8, DTYPE_U8 };
+    const double lo[3] = { INT_MIN, INT8_MIN, 0 };
+    const double hi[3] = { INT_MAX, INT8_MAX, UINT8_MAX };
+    for (int k = 0; k < 3; k++)
+    {
+        Tensor c = tensor_to_dtype(t, targets[k]);
+        TEST_CHECK(c != NULL && tensor_get_dtype(c) == targets[k]);
+        for (int i = 0; c != NULL && i < NINPUTS * REPEAT; i++)
+            TEST_CHECK_CLOSE(test_get(c, i), _saturate(test_get(t, i), lo[k], hi[k]), 0);
+
+        // tensor_full() 转换填充值的方式相同
+        for (int i = 0; i < NINPUTS; i++)
+        {
+            const int one[1] = { 70 };
+            Shape s = shape_create(one, 1);
+            Tensor f = tensor_full(s, targets[k], test_get(t, i));
+            shape_free(s);
+            TEST_CHECK_CLOSE(test_get(f, 69), _saturate(test_get(t, i), lo[k], hi[k]), 0);
+            tensor_free(f);
+        }
+        tensor_free(c);
+    }
+    tensor_free(t);
+    tensor_free(t64);
+}
+
+static void
+test_f64_to_int_saturates(void)
+{
+    _check_saturation(DTYPE_F64);
+}
+
+static void
+test_f32_to_int_saturates(void)
+{
+    _check_saturation(DTYPE_F32);
+}
+
+static void
+test_int_to_int_wraps(void)
+{
+    const int32_t values[6] = { 127, 128, 255, 256, -1, -129 };
+    const int dims[1] = { 6 };
+    Tensor t = test_tensor(values, dims, 1, DTYPE_I32);
+    Tensor i8 = tensor_to_dtype(t, DTYPE_I8);
+    Tensor u8 = tensor_to_dtype(t, DTYPE_U8);
+    const double expected_i8[6] = { 127, -128, -1, 0, -1, 127 };
+    const double expected_u8[6] = { 127, 128, 255, 0, 255, 127 };
+    for (int i = 0; i < 6; i++)
+    {
+        TEST_CHECK(test_get(i8, i) == expected_i8[i]);
+        TEST_CHECK(test_get(u8, i) == expected_u8[i]);
+    }
+    tensor_free(u8);
+    tensor_free(i8);
+    tensor_free(t);
+}
+
+static void
+test_half_round_trip(void)
+{
+    // F16 能精确表示的值经过一次往返不变；其他值舍入到最近的偶数
+    const float f16_exact[6] = { 0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 6.103515625e-05f };
+    const float bf16_exact[6] = { 0.0f, -0.0f, 1.0f, -2.5f, 65536.0f, 0x1p-126f };
+    for (int i = 0; i < 6; i++)
+    {
+        TEST_CHECK(f16_to_f32(f32_to_f16(f16_exact[i])) == f16_exact[i]);
+        TEST_CHECK(bf16_to_f32(f32_to_bf16(bf16_exact[i])) == bf16_exact[i]);
+    }
+    TEST_CHECK(f16_to_f32(f32_to_f16(1.0f + 1.0f / 2048)) == 1.0f); // 平局取偶
+    TEST_CHECK(f16_to_f32(f32_to_f16(1.0f + 3.0f / 2048)) == 1.0f + 1.0f / 512);
+    TEST_CHECK(isinf(f16_to_f32(f32_to_f16(1e6f))));
+    TEST_CHECK(isnan(f16_to_f32(f32_to_f16(NAN))));
+
+    // 整个张量的转换与逐个转换一致
+    float values[37];
+    for (int i = 0; i < 37; i++) values[i] = (float)(test_random() * 200 - 100);
+    const int dims[1] = { 37 };
+    Tensor t = test_tensor(values, dims, 1, DTYPE_F32);
+    Tensor h = tensor_to_dtype(t, DTYPE_F16);
+    Tensor b = tensor_to_dtype(t, DTYPE_BF16);
+    for (int i = 0; i < 37; i++)
+    {
+        TEST_CHECK(test_get(h, i) == f16_to_f32(f32_to_f16(values[i])));
+        TEST_CHECK(test_get(b, i) == bf16_to_f32(f32_to_bf16(values[i])));
+    }
+    tensor_free(b);
+    tensor_free(h);
+    tensor_free(t);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_f64_to_int_saturates);
+    TEST_RUN(test_f32_to_int_saturates);
+    TEST_RUN(test_int_to_int_wraps);
+    TEST_RUN(test_half_round_trip);
+    return test_finish();
+}
@@ -0,0 +1,268 @@
+#include "_test.h"
+
+static Tensor
+_iota(const int* dims, int ndim, DataType dtype, double offset)
+{
+    Shape s = shape_create(dims, ndim);
+    Tensor t = tensor_empty(s, DTYPE_F64);
+    shape_free(s);
+    double* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = offset + (double)i;
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+// 与逐元素的下标换算比较：3-D 输入（任意布局）沿 axis 拼接
+static void
+_check_cat3(const Tensor out, const Tensor* tensors, int n, int axis)
+{
+    TEST_CHECK(out != NULL && tensor_get_ndim(out) == 3 && tensor_is_contiguous(out));
+    if (out == NULL) return;
+    int wrong = 0, position = 0;
+    for (int t = 0; t < n; t++)
+    {
+        Tensor c = tensor_contiguous(tensors[t]);
+        const int d0 = tensor_get_dim(c, 0), d1 = tensor_get_dim(c, 1), d2 = tensor_get_dim(c, 2);
+        const int o1 = tensor_get_dim(out, 1), o2 = tensor_get_dim(out, 2);
+        for (int i = 0; i < d0; i++)
+            for (int j = 0; j < d1; j++)
+                for (int k = 0; k < d2; k++)
+                {
+                    const int oi = i + (axis == 0) * position, oj = j + (axis == 1) * position, ok = k + (axis == 2) * position;
+                    const size_t o = ((size_t)oi * o1 + oj) * o2 + ok;
+                    wrong += test_get(out, o) != test_get(c, ((size_t)i * d1 + j) * d2 + k);
+                }
+        position += tensor_get_dim(c, axis);
+        tensor_free(c);
+    }
+    TEST_CHECK(position == tensor_get_dim(out, axis));
+    TEST_CHECK(wrong == 0);
+}
+
+static void
+test_cat_axes(void)
+{
+    // 每个轴上：一个连续的、一个置换的、一个切片的、一个在 axis 上为 0 的输入
+    const DataType dtypes[3] = { DTYPE_F32, DTYPE_I32, DTYPE_F64 };
+    for (int d = 0; d < 3; d++)
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            int dims_a[3] = { 2, 3, 4 };
+            const int dims_b[3] = { 4, 3, 2 }; // 置换成 [2, 3, 4]
+            int dims_c[3] = { 2, 3, 4 };
+            int dims_e[3] = { 2, 3, 4 };
+            dims_a[axis] = 1;
+            dims_c[axis] = 10; // 步长为 2 的切片得到 5
+            dims_e[axis] = 0;
+
+            Tensor a = _iota(dims_a, 3, dtypes[d], 0);
+            Tensor b_base = _iota(dims_b, 3, dtypes[d], 1000);
+            const int axes[3] = { 2, 1, 0 };
+            Tensor b = tensor_permute(b_base, axes);
+            Tensor c_base = _iota(dims_c, 3, dtypes[d], 2000);
+            Tensor c = tensor_slice(c_base, axis, 1, 10, 2);
+            Tensor e = _iota(dims_e, 3, dtypes[d], 0);
+
+            const Tensor parts[4] = { a, b, e, c };
+            Tensor out = tensor_cat(parts, 4, axis);
+            TEST_CHECK(out != NULL && tensor_get_dtype(out) == dtypes[d]);
+            _check_cat3(out, parts, 4, axis);
+
+            tensor_free(out);
+            tensor_free(e);
+            tensor_free(c);
+            tensor_free(c_base);
+            tensor_free(b);
+            tensor_free(b_base);
+            tensor_free(a);
+        }
+    }
+}
+
+static void
+test_cat_many_and_large(void)
+{
+    // 许多小输入：每个输入不到一块，块被合并后再分给线程
+    enum { N = 300 };
+    Tensor small[N];
+    const int row[3] = { 1, 1, 7 };
+    for (int i = 0; i < N; i++) small[i] = _iota(row, 3, DTYPE_F32, i * 7);
+    Tensor out = tensor_cat(small, N, 0);
+    TEST_CHECK(out != NULL && tensor_get_dim(out, 0) == N);
+    int wrong = 0;
+    for (size_t i = 0; out != NULL && i < (size_t)N * 7; i++) wrong += test_get(out, i) != (double)i;
+    TEST_CHECK(wrong == 0);
+    tensor_free(out);
+    for (int i = 0; i < N; i++) tensor_free(small[i]);
+
+    // 少数大输入：一个输入被切成许多块，包括转置过的
+    const int big[3] = { 3, 500, 300 };
+    Tensor x = _iota(big, 3, DTYPE_F32, 0);
+    const int axes[3] = { 0, 2, 1 };
+    Tensor xt_base = _iota(big, 3, DTYPE_F32, -1e6);
+    Tensor xt = tensor_permute(xt_base, axes); // [3, 300, 500]
+    Tensor x_t = tensor_permute(x, axes);
+    const Tensor parts[2] = { x_t, xt };
+    Tensor wide = tensor_cat(parts, 2, 2); // [3, 300, 1000]
+    _check_cat3(wide, parts, 2, 2);
+
+    tensor_free(wide);
+    tensor_free(x_t);
+    tensor_free(xt);
+    tensor_free(xt_base);
+    tensor_free(x);
+}
+
+static void
+test_stack(void)
+{
+    const int dims[2] = { 2, 3 };
+    Tensor a = _iota(dims, 2, DTYPE_F32, 0);
+    Tensor b = _iota(dims, 2, DTYPE_F32, 100);
+    const int flipped[2] = { 3, 2 };
+    Tensor c_base = _iota(flipped, 2, DTYPE_F32, 200);
+    const int axes[2] = { 1, 0 };
+    Tensor c = tensor_permute(c_base, axes); // [2, 3]，不连续
+    const Tensor parts[3] = { a, b, c };
+
+    // 新轴插在 0、1、2 处：out[.., t, ..] 是第 t 个输入
+    for (int axis = 0; axis <= 2; axis++)
+    {
+        Tensor out = tensor_stack(parts, 3, axis);
+        TEST_CHECK(out != NULL && tensor_get_ndim(out) == 3 && tensor_get_dim(out, axis) == 3);
+        if (out == NULL) continue;
+        int wrong = 0;
+        for (int t = 0; t < 3; t++)
+        {
+            Tensor in = tensor_contiguous(parts[t]);
+            Tensor view = tensor_select(out, axis, t);
+            Tensor got = tensor_contiguous(view);
+            for (int i = 0; i < 6; i++) wrong += test_get(got, i) != test_get(in, i);
+            tensor_free(got);
+            tensor_free(view);
+            tensor_free(in);
+        }
+        TEST_CHECK(wrong == 0);
+        tensor_free(out);
+    }
+
+    // 0 维的输入堆成 1 维；空输入堆成空结果
+    const float one = 1.0f, two = 2.0f;
+    Tensor s1 = test_tensor(&one, NULL, 0, DTYPE_F32);
+    Tensor s2 = test_tensor(&two, NULL, 0, DTYPE_F32);
+    const Tensor scalars[2] = { s1, s2 };
+    Tensor pair = tensor_stack(scalars, 2, 0);
+    TEST_CHECK(pair != NULL && tensor_get_ndim(pair) == 1 && test_get(pair, 1) == 2.0);
+
+    Tensor none = tensor_slice(c, 1, 1, 1, 1); // [2, 0]，不连续
+    const Tensor empties[2] = { none, none };
+    Tensor stacked = tensor_stack(empties, 2, 1);
+    TEST_CHECK(stacked != NULL && tensor_get_dim(stacked, 1) == 2 && tensor_get_elements_count(stacked) == 0);
+
+    tensor_free(stacked);
+    tensor_free(none);
+    tensor_free(pair);
+    tensor_free(s2);
+    tensor_free(s1);
+    tensor_free(c);
+    tensor_free(c_base);
+    tensor_free(b);
+    tensor_free(a);
+}
+
+static void
+test_cat_out(void)
+{
+    // 写进一个更大缓冲区的切片：切片以外的元素不变
+    const int buffer_dims[2] = { 6, 4 };
+    Shape bs = shape_create(buffer_dims, 2);
+    Tensor buffer = tensor_full(bs, DTYPE_F32, -1.0);
+    Tensor window = tensor_narrow(buffer, 0, 1, 4); // [4, 4]
+    const int dims[2] = { 2, 4 };
+    Tensor a = _iota(dims, 2, DTYPE_F32, 0);
+    Tensor b = _iota(dims, 2, DTYPE_F32, 8);
+    const Tensor parts[2] = { a, b };
+    TEST_CHECK(tensor_cat_out(window, parts, 2, 0));
+    int wrong = 0;
+    for (int i = 0; i < 24; i++)
+    {
+        const double expected = (i < 4 || i >= 20) ? -1.0 : (double)(i - 4);
+        wrong += test_get(buffer, i) != expected;
+    }
+    TEST_CHECK(wrong == 0);
+
+    // 按列写进一个转置的输出
+    const int axes[2] = { 1, 0 };
+    const int out_dims[2] = { 4, 4 };
+    Shape os = shape_create(out_dims, 2);
+    Tensor base = tensor_zeros(os, DTYPE_F32);
+    Tensor transposed = tensor_permute(base, axes);
+    TEST_CHECK(!tensor_stack_out(transposed, parts, 2, 0)); // 形状应为 [2, 2, 4]
+    TEST_CHECK(tensor_cat_out(transposed, parts, 2, 0));
+    TEST_CHECK(test_get(base, 1) == 4.0 && test_get(base, 4) == 1.0);
+
+    // 输出的形状或 dtype 不对、与输入重叠，都失败
+    Tensor i32 = _iota(dims, 2, DTYPE_I32, 0);
+    const Tensor mixed[2] = { a, i32 };
+    TEST_CHECK(!tensor_cat_out(window, mixed, 2, 0));
+    TEST_CHECK(!tensor_cat_out(buffer, parts, 2, 0));
+    Tensor head = tensor_narrow(buffer, 0, 0, 2);
+    const Tensor overlapping[2] = { head, b };
+    TEST_CHECK(!tensor_cat_out(window, overlapping, 2, 0));
+
+    tensor_free(head);
+    tensor_free(i32);
+    tensor_free(transposed);
+    tensor_free(base);
+    shape_free(os);
+    tensor_free(b);
+    tensor_free(a);
+    tensor_free(window);
+    tensor_free(buffer);
+    shape_free(bs);
+}
+
+static void
+test_cat_errors(void)
+{
+    const int dims[2] = { 2, 3 };
+    const int other_dims[2] = { 2, 4 };
+    const int flat[1] = { 6 };
+    Tensor a = _iota(dims, 2, DTYPE_F32, 0);
+    Tensor b = _iota(other_dims, 2, DTYPE_F32, 0);
+    Tensor f = _iota(flat, 1, DTYPE_F32, 0);
+    Tensor i32 = _iota(dims, 2, DTYPE_I32, 0);
+
+    const Tensor ab[2] = { a, b };
+    const Tensor af[2] = { a, f };
+    const Tensor ai[2] = { a, i32 };
+    Tensor ok = tensor_cat(ab, 2, 1); // 只有 axis 上的大小可以不同
+    TEST_CHECK(ok != NULL && tensor_get_dim(ok, 1) == 7);
+    TEST_CHECK(tensor_cat(ab, 2, 0) == NULL);
+    TEST_CHECK(tensor_stack(ab, 2, 0) == NULL);
+    TEST_CHECK(tensor_cat(af, 2, 0) == NULL);
+    TEST_CHECK(tensor_cat(ai, 2, 0) == NULL);
+    TEST_CHECK(tensor_cat(ab, 0, 0) == NULL);
+    TEST_CHECK(tensor_cat(ab, 2, 2) == NULL);
+    TEST_CHECK(tensor_stack(ab, 1, 3) == NULL);
+
+    tensor_free(ok);
+    tensor_free(i32);
+    tensor_free(f);
+    tensor_free(b);
+    tensor_free(a);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_cat_axes);
+    TEST_RUN(test_cat_many_and_large);
+    TEST_RUN(test_stack);
+    TEST_RUN(test_cat_out);
+    TEST_RUN(test_cat_errors);
+    return test_finish();
+}
@@ -0,0 +1,306 @@
+#include "_test.h"
+
+#include "tensor/_tensor_index.h"
+
+#include <stdlib.h> // for malloc(), free()
+
+static Tensor
+_iota(const int* dims, int ndim, DataType dtype, double offset)
+{
+    Shape s = shape_create(dims, ndim);
+    Tensor t = tensor_empty(s, DTYPE_F64);
+    shape_free(s);
+    double* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = offset + (double)i;
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+// 每个位置上 [0, limit) 里的伪随机下标
+static Tensor
+_random_indices(const int* dims, int ndim, int limit)
+{
+    Shape s = shape_create(dims, ndim);
+    Tensor t = tensor_empty(s, DTYPE_I32);
+    shape_free(s);
+    int* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = (int)(test_random() * limit);
+    return t;
+}
+
+static void
+test_index_select(void)
+{
+    // 源张量是置换的视图；选 axis 0 和 axis 1，下标可以重复、乱序
+    const int dims[2] = { 6, 5 };
+    Tensor base = _iota(dims, 2, DTYPE_F32, 0);
+    const int axes[2] = { 1, 0 };
+    Tensor t = tensor_permute(base, axes); // [5, 6]，t[i][j] = 5 * j + i
+    const int chosen[4] = { 4, 0, 4, 2 };
+    const int k_dims[1] = { 4 };
+    Tensor idx = test_tensor(chosen, k_dims, 1, DTYPE_I32);
+
+    Tensor rows = tensor_index_select(t, 0, idx);
+    TEST_CHECK(rows != NULL && tensor_get_dim(rows, 0) == 4 && tensor_get_dim(rows, 1) == 6);
+    int wrong = 0;
+    for (int r = 0; rows != NULL && r < 4; r++)
+        for (int j = 0; j < 6; j++) wrong += test_get(rows, r * 6 + j) != 5.0 * j + chosen[r];
+    TEST_CHECK(wrong == 0);
+
+    Tensor cols = tensor_index_select(t, 1, idx);
+    TEST_CHECK(cols != NULL && tensor_get_dim(cols, 0) == 5 && tensor_get_dim(cols, 1) == 4);
+    wrong = 0;
+    for (int i = 0; cols != NULL && i < 5; i++)
+        for (int c = 0; c < 4; c++) wrong += test_get(cols, i * 4 + c) != 5.0 * chosen[c] + i;
+    TEST_CHECK(wrong == 0);
+
+    // 连续的行（整行 memcpy）：embedding 查表
+    const int table_dims[2] = { 50, 33 };
+    Tensor table = _iota(table_dims, 2, DTYPE_I32, 0);
+    const int many[1] = { 2000 };
+    Tensor lookup = _random_indices(many, 1, 50);
+    Tensor embedded = tensor_index_select(table, 0, lookup);
+    TEST_CHECK(embedded != NULL && tensor_get_dim(embedded, 0) == 2000);
+    wrong = 0;
+    for (int r = 0; embedded != NULL && r < 2000; r++)
+    {
+        const int row = (int)test_get(lookup, r);
+        for (int j = 0; j < 33; j++) wrong += test_get(embedded, (size_t)r * 33 + j) != (double)(row * 33 + j);
+    }
+    TEST_CHECK(wrong == 0);
+
+    // 没有下标：结果在 axis 上为 0；越界和不是 I32 的下标被拒绝
+    Tensor no_index = tensor_slice(idx, 0, 1, 1, 1);
+    Tensor none = tensor_index_select(t, 0, no_index);
+    TEST_CHECK(none != NULL && tensor_get_dim(none, 0) == 0 && tensor_get_dim(none, 1) == 6);
+    const int bad[2] = { 1, 5 };
+    const int two[1] = { 2 };
+    Tensor out_of_range = test_tensor(bad, two, 1, DTYPE_I32);
+    Tensor f32_index = tensor_to_dtype(idx, DTYPE_F32);
+    TEST_CHECK(tensor_index_select(t, 0, out_of_range) == NULL);
+    TEST_CHECK(tensor_index_select(t, 0, f32_index) == NULL);
+    TEST_CHECK(tensor_index_select(t, 2, idx) == NULL);
+    TEST_CHECK(tensor_index_select(t, 0, table) == NULL); // 不是 1-D
+
+    tensor_free(f32_index);
+    tensor_free(out_of_range);
+    tensor_free(none);
+    tensor_free(no_index);
+    tensor_free(embedded);
+    tensor_free(lookup);
+    tensor_free(table);
+    tensor_free(cols);
+    tensor_free(rows);
+    tensor_free(idx);
+    tensor_free(t);
+    tensor_free(base);
+}
+
+static void
+test_gather(void)
+{
+    // out[i][j][k] = t[i][idx[i][j][k]][k]，t 是切片；indices 在其它维度上比 t 小
+    const int dims[3] = { 4, 9, 10 };
+    Tensor base = _iota(dims, 3, DTYPE_F64, 0);
+    Tensor t = tensor_slice(base, 2, 0, 10, 2); // [4, 9, 5]
+    const int idx_dims[3] = { 3, 12, 5 };
+    Tensor idx = _random_indices(idx_dims, 3, 9);
+    Tensor out = tensor_gather(t, 1, idx);
+    TEST_CHECK(out != NULL && tensor_get_dim(out, 0) == 3 && tensor_get_dim(out, 1) == 12);
+    int wrong = 0;
+    for (int i = 0; out != NULL && i < 3; i++)
+        for (int j = 0; j < 12; j++)
+            for (int k = 0; k < 5; k++)
+            {
+                const size_t o = ((size_t)i * 12 + j) * 5 + k;
+                const int r = (int)test_get(idx, o);
+                wrong += test_get(out, o) != (double)((i * 9 + r) * 10 + 2 * k);
+            }
+    TEST_CHECK(wrong == 0);
+
+    // 置换后的 indices 与它的连续副本结果相同
+    const int axes[3] = { 0, 2, 1 };
+    const int pdims[3] = { 3, 5, 4 };
+    Tensor idx_base = _random_indices(pdims, 3, 4);
+    Tensor idx_p = tensor_permute(idx_base, axes); // [3, 4, 5]
+    Tensor idx_c = tensor_contiguous(idx_p);
+    Tensor g1 = tensor_gather(t, 0, idx_p);
+    Tensor g2 = tensor_gather(t, 0, idx_c);
+    TEST_CHECK(g1 != NULL && g2 != NULL);
+    wrong = 0;
+    for (size_t i = 0; g1 != NULL && g2 != NULL && i < 60; i++) wrong += test_get(g1, i) != test_get(g2, i);
+    TEST_CHECK(wrong == 0);
+
+    // 空的 indices；维数不同、比 t 大、越界的 indices
+    const int empty_dims[3] = { 3, 0, 5 };
+    Tensor empty = _random_indices(empty_dims, 3, 9);
+    Tensor ge = tensor_gather(t, 1, empty);
+    TEST_CHECK(ge != NULL && tensor_get_elements_count(ge) == 0);
+    const int big_dims[3] = { 5, 1, 1 };
+    Tensor big = _random_indices(big_dims, 3, 9);
+    const int flat_dims[1] = { 3 * 12 * 5 };
+    Shape fs = shape_create(flat_dims, 1);
+    Tensor flat = tensor_reshape(idx, fs);
+    TEST_CHECK(tensor_gather(t, 1, big) == NULL);
+    TEST_CHECK(tensor_gather(t, 1, flat) == NULL);
+    Tensor over = _random_indices(idx_dims, 3, 20);
+    TEST_CHECK(tensor_gather(t, 1, over) == NULL);
+
+    tensor_free(over);
+    tensor_free(flat);
+    shape_free(fs);
+    tensor_free(big);
+    tensor_free(ge);
+    tensor_free(empty);
+    tensor_free(g2);
+    tensor_free(g1);
+    tensor_free(idx_c);
+    tensor_free(idx_p);
+    tensor_free(idx_base);
+    tensor_free(out);
+    tensor_free(idx);
+    tensor_free(t);
+    tensor_free(base);
+}
+
+// 朴素的 scatter-add 参考：2-D，axis 1
+static double*
+_scatter_reference(const Tensor t, const Tensor idx, const Tensor src)
+{
+    Tensor c = tensor_contiguous(t);
+    const int rows = tensor_get_dim(t, 0), cols = tensor_get_dim(t, 1);
+    double* expected = malloc(sizeof(double) * (size_t)rows * cols);
+    for (int i = 0; i < rows * cols; i++) expected[i] = test_get(c, i);
+    Tensor ic = tensor_contiguous(idx);
+    Tensor sc = tensor_contiguous(src);
+    const int ir = tensor_get_dim(idx, 0), icols = tensor_get_dim(idx, 1), scols = tensor_get_dim(src, 1);
+    for (int i = 0; i < ir; i++)
+        for (int j = 0; j < icols; j++)
+            expected[i * cols + (int)test_get(ic, i * icols + j)] += test_get(sc, i * scols + j);
+    tensor_free(sc);
+    tensor_free(ic);
+    tensor_free(c);
+    return expected;
+}
+
+static void
+test_scatter_add(void)
+{
+    // 重复的下标累加；src 比 indices 大（只读被覆盖的部分）；I32 / F32 / F64
+    const DataType dtypes[3] = { DTYPE_I32, DTYPE_F32, DTYPE_F64 };
+    const int t_dims[2] = { 40, 7 };
+    const int idx_dims[2] = { 30, 50 };
+    const int src_dims[2] = { 35, 60 };
+    for (int d = 0; d < 3; d++)
+    {
+        Tensor t = _iota(t_dims, 2, dtypes[d], 0);
+        Tensor idx = _random_indices(idx_dims, 2, 7);
+        Tensor src = _iota(src_dims, 2, dtypes[d], 1);
+        double* expected = _scatter_reference(t, idx, src);
+
+        Tensor out = tensor_scatter_add(t, 1, idx, src, false);
+        TEST_CHECK(out != NULL && tensor_get_dtype(out) == dtypes[d]);
+        int wrong = 0;
+        for (int i = 0; out != NULL && i < 280; i++) wrong += test_get(out, i) != expected[i];
+        TEST_CHECK(wrong == 0);
+        TEST_CHECK(test_get(t, 279) == 279.0); // 非原地版本不改 t
+
+        free(expected);
+        tensor_free(out);
+        tensor_free(src);
+        tensor_free(idx);
+        tensor_free(t);
+    }
+
+    // 原地写进转置的视图；indices 和 src 也不连续
+    const int axes[2] = { 1, 0 };
+    const int flipped[2] = { 7, 40 };
+    Tensor base = _iota(flipped, 2, DTYPE_F32, 0);
+    Tensor t = tensor_permute(base, axes); // [40, 7]
+    const int idx_flipped[2] = { 5, 40 };
+    Tensor idx_base = _random_indices(idx_flipped, 2, 7);
+    Tensor idx = tensor_permute(idx_base, axes); // [40, 5]
+    const int src_wide[2] = { 40, 10 };
+    Tensor src_base = _iota(src_wide, 2, DTYPE_F32, 0);
+    Tensor src = tensor_slice(src_base, 1, 0, 10, 2); // [40, 5]
+    double* expected = _scatter_reference(t, idx, src);
+    TEST_CHECK(tensor_scatter_add_(t, 1, idx, src, false));
+    Tensor c = tensor_contiguous(t);
+    int wrong = 0;
+    for (int i = 0; i < 280; i++) wrong += test_get(c, i) != expected[i];
+    TEST_CHECK(wrong == 0);
+
+    tensor_free(c);
+    free(expected);
+    tensor_free(src);
+    tensor_free(src_base);
+    tensor_free(idx);
+    tensor_free(idx_base);
+    tensor_free(t);
+    tensor_free(base);
+}
+
+static void
+test_scatter_unique_and_errors(void)
+{
+    // 置换作下标：unique_indices 的结果与默认相同
+    const int dims[2] = { 64, 100 };
+    Tensor t = _iota(dims, 2, DTYPE_F64, 0);
+    Tensor src = _iota(dims, 2, DTYPE_F64, 0.5);
+    Shape s = shape_create(dims, 2);
+    Tensor perm = tensor_empty(s, DTYPE_I32);
+    shape_free(s);
+    int* p = tensor_get_data(perm);
+    for (int i = 0; i < 64; i++)
+        for (int j = 0; j < 100; j++) p[i * 100 + j] = (j * 37 + i) % 100;
+    Tensor a = tensor_scatter_add(t, 1, perm, src, false);
+    Tensor b = tensor_scatter_add(t, 1, perm, src, true);
+    TEST_CHECK(a != NULL && b != NULL);
+    int wrong = 0;
+    for (size_t i = 0; a != NULL && b != NULL && i < 6400; i++) wrong += test_get(a, i) != test_get(b, i);
+    TEST_CHECK(wrong == 0);
+
+    // 空的 indices 什么也不做
+    Tensor none = tensor_slice(perm, 1, 0, 0, 1); // [64, 0]，不连续
+    TEST_CHECK(tensor_scatter_add_(t, 1, none, src, false));
+    TEST_CHECK(test_get(t, 6399) == 6399.0);
+
+    // 最后一个下标越界：全部下标先检查，t 保持不变
+    p[6399] = 100;
+    TEST_CHECK(!tensor_scatter_add_(t, 1, perm, src, false));
+    TEST_CHECK(!tensor_scatter_add_(t, 1, perm, src, true));
+    wrong = 0;
+    for (size_t i = 0; i < 6400; i++) wrong += test_get(t, i) != (double)i;
+    TEST_CHECK(wrong == 0);
+    p[6399] = 0;
+
+    // dtype：src 与 t 不同，或 t 是不支持累加的 dtype；src 与 t 重叠
+    Tensor src_f32 = tensor_to_dtype(src, DTYPE_F32);
+    Tensor t_i8 = tensor_to_dtype(t, DTYPE_I8);
+    Tensor src_i8 = tensor_to_dtype(src, DTYPE_I8);
+    TEST_CHECK(!tensor_scatter_add_(t, 1, perm, src_f32, false));
+    TEST_CHECK(tensor_scatter_add(t_i8, 1, perm, src_i8, false) == NULL);
+    TEST_CHECK(!tensor_scatter_add_(t, 1, perm, t, false));
+
+    tensor_free(src_i8);
+    tensor_free(t_i8);
+    tensor_free(src_f32);
+    tensor_free(none);
+    tensor_free(b);
+    tensor_free(a);
+    tensor_free(perm);
+    tensor_free(src);
+    tensor_free(t);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_index_select);
+    TEST_RUN(test_gather);
+    TEST_RUN(test_scatter_add);
+    TEST_RUN(test_scatter_unique_and_errors);
+    return test_finish();
+}
@@ -0,0 +1,209 @@
+#include "_test.h"
+
+#include <stdio.h>  // for remove()
+#include <string.h> // for memcmp()
+
+typedef bool (*SaveFn)(const Tensor t, const char* path);
+typedef Tensor (*LoadFn)(const char* path);
+
+// dims、dtype 和每个元素的字节都相同
+static bool
+_same_tensor(const Tensor a, const Tensor b)
+{
+    if (a == NULL || b == NULL) return false;
+    if (tensor_get_dtype(a) != tensor_get_dtype(b) || tensor_get_ndim(a) != tensor_get_ndim(b)) return false;
+    for (int i = 0; i < tensor_get_ndim(a); i++)
+        if (tensor_get_dim(a, i) != tensor_get_dim(b, i)) return false;
+
+    Tensor ca = tensor_contiguous(a);
+    Tensor cb = tensor_contiguous(b);
+    const size_t bytes = tensor_get_elements_count(a) * tensor_get_item_size(a);
+    const bool same = ca != NULL && cb != NULL && memcmp(tensor_get_data_const(ca), tensor_get_data_const(cb), bytes) == 0;
+    tensor_free(cb);
+    tensor_free(ca);
+    return same;
+}
+
+static Tensor
+_random_tensor(const int* dims, int ndim, DataType dtype)
+{
+    Shape s = shape_create(dims, ndim);
+    Tensor t = tensor_empty(s, DTYPE_F64);
+    shape_free(s);
+    double* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = (double)(int)(test_random() * 200) - 100;
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+static void
+_check_round_trip(SaveFn save, LoadFn load, const DataType* dtypes, int ndtypes, const char* name)
+{
+    char path[256];
+    test_tmp_path(path, sizeof(path), name);
+
+    for (int k = 0; k < ndtypes; k++)
+    {
+        const int dims[3] = { 3, 5, 7 };
+        Tensor t = _random_tensor(dims, 3, dtypes[k]);
+
+        TEST_CHECK(save(t, path));
+        Tensor l = load(path);
+        TEST_CHECK(_same_tensor(t, l));
+        tensor_free(l);
+
+        // 视图按 stride 直接写出
+        const int axes[3] = { 2, 0, 1 };
+        Tensor p = tensor_permute(t, axes);
+        Tensor v = tensor_slice(p, 0, 1, 7, 3);
+        TEST_CHECK(save(v, path));
+        l = load(path);
+        TEST_CHECK(_same_tensor(v, l));
+        tensor_free(l);
+
+        // 标量和空张量
+        Tensor plane = tensor_select(t, 0, 2);
+        Tensor row = tensor_select(plane, 0, 4);
+        Tensor scalar = tensor_select(row, 0, 6);
+        TEST_CHECK(save(scalar, path));
+        l = load(path);
+        TEST_CHECK(_same_tensor(scalar, l));
+        tensor_free(l);
+
+        Tensor empty = tensor_narrow(t, 1, 2, 0);
+        TEST_CHECK(save(empty, path));
+        l = load(path);
+        TEST_CHECK(l != NULL && tensor_get_elements_count(l) == 0 && _same_tensor(empty, l));
+        tensor_free(l);
+
+        tensor_free(empty);
+        tensor_free(scalar);
+        tensor_free(row);
+        tensor_free(plane);
+        tensor_free(v);
+        tensor_free(p);
+        tensor_free(t);
+    }
+    remove(path);
+}
+
+static void
+test_npy_round_trip(void)
+{
+    const DataType dtypes[6] = { DTYPE_I32, DTYPE_F32, DTYPE_F64, DTYPE_F16, DTYPE_I8, DTYPE_U8 };
+    _check_round_trip(tensor_save_npy, tensor_load_npy, dtypes, 6, "round_trip.npy");
+}
+
+static void
+test_raw_round_trip(void)
+{
+    const DataType dtypes[7] = { DTYPE_I32, DTYPE_F32, DTYPE_F64, DTYPE_F16, DTYPE_BF16, DTYPE_I8, DTYPE_U8 };
+    _check_round_trip(tensor_save_raw, tensor_load_raw, dtypes, 7, "round_trip.snake");
+}
+
+static void
+test_loaded_tensor_is_private(void)
+{
+    char path[256];
+    test_tmp_path(path, sizeof(path), "private.npy");
+    const int dims[1] = { 16 };
+    Tensor t = _random_tensor(dims, 1, DTYPE_F32);
+    TEST_CHECK(tensor_save_npy(t, path));
+
+    // 写入加载的张量只改变本进程的页面，不改变文件
+    Tensor l = tensor_load_npy(path);
+    float* p = tensor_get_data(l);
+    p[0] = 1234.0f;
+    Tensor again = tensor_load_npy(path);
+    TEST_CHECK(test_get(again, 0) == test_get(t, 0));
+
+    tensor_free(again);
+    tensor_free(l);
+    tensor_free(t);
+    remove(path);
+}
+
+static void
+test_rejects_bad_files(void)
+{
+    char path[256];
+    test_tmp_path(path, sizeof(path), "bad.npy");
+    const int dims[1] = { 4 };
+    Tensor b = _random_tensor(dims, 1, DTYPE_BF16);
+    TEST_CHECK(!tensor_save_npy(b, path)); // .npy 没有 BF16
+
+    FILE* f = fopen(path, "wb");
+    TEST_CHECK(f != NULL);
+    if (f != NULL)
+    {
+        fputs("not a tensor file", f);
+        fclose(f);
+    }
+    TEST_CHECK(tensor_load_npy(path) == NULL);
+    TEST_CHECK(tensor_load_raw(path) == NULL);
+    remove(path);
+    TEST_CHECK(tensor_load_npy(path) == NULL);
+    tensor_free(b);
+}
+
+static void
+test_writer_concatenates(void)
+{
+    char path[256];
+    const int dims[2] = { 10, 6 };
+    Tensor whole = _random_tensor(dims, 2, DTYPE_F32);
+    const bool npy[2] = { true, false };
+
+    for (int k = 0; k < 2; k++)
+    {
+        test_tmp_path(path, sizeof(path), npy[k] ? "writer.npy" : "writer.snake");
+        TensorWriter w = npy[k] ? tensor_writer_open_npy(path) : tensor_writer_open_raw(path);
+        TEST_CHECK(w != NULL);
+        if (w == NULL) continue;
+
+        // 大小不同的几块：两个视图和一个连续的副本
+        Tensor a = tensor_narrow(whole, 0, 0, 3);
+        Tensor b = tensor_narrow(whole, 0, 3, 1);
+        Tensor c = tensor_narrow(whole, 0, 4, 6);
+        Tensor ct = tensor_contiguous(c);
+        TEST_CHECK(tensor_writer_append(w, a));
+        TEST_CHECK(tensor_writer_append(w, b));
+
+        // 行的形状不同的一块被拒绝，文件不变
+        Tensor bad = tensor_narrow(whole, 1, 0, 5);
+        TEST_CHECK(!tensor_writer_append(w, bad));
+        TEST_CHECK(tensor_writer_append(w, ct));
+        TEST_CHECK(tensor_writer_close(w));
+
+        Tensor l = npy[k] ? tensor_load_npy(path) : tensor_load_raw(path);
+        TEST_CHECK(_same_tensor(whole, l));
+
+        tensor_free(l);
+        tensor_free(bad);
+        tensor_free(ct);
+        tensor_free(c);
+        tensor_free(b);
+        tensor_free(a);
+        remove(path);
+    }
+
+    // 什么也没写就关闭
+    test_tmp_path(path, sizeof(path), "writer_empty.npy");
+    TensorWriter w = tensor_writer_open_npy(path);
+    TEST_CHECK(w != NULL && !tensor_writer_close(w));
+    remove(path);
+    tensor_free(whole);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_npy_round_trip);
+    TEST_RUN(test_raw_round_trip);
+    TEST_RUN(test_loaded_tensor_is_private);
+    TEST_RUN(test_rejects_bad_files);
+    TEST_RUN(test_writer_concatenates);
+    return test_finish();
+}
@@ -0,0 +1,206 @@
+#include "_test.h"
+
+#include <string.h> // for memset()
+
+static Tensor
+_iota_f32(const int* dims, int ndim)
+{
+    Shape s = shape_create(dims, ndim);
+    Tensor t = tensor_empty(s, DTYPE_F32);
+    shape_free(s);
+    float* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = (float)i;
+    return t;
+}
+
+// 按遍历顺序记下输入操作数（ptrs[1]）的值，返回记下的个数
+static size_t
+_walk(TensorIter* it, float* seen, size_t max)
+{
+    size_t k = 0;
+    while (tensor_iter_next(it))
+        for (size_t i = 0; i < it->inner_size && k < max; i++)
+            seen[k++] = *(const float*)(it->ptrs[1] + i * it->inner_strides[1]);
+    return k;
+}
+
+static void
+test_merges_dimensions(void)
+{
+    const int dims[4] = { 2, 1, 3, 4 };
+    Tensor a = _iota_f32(dims, 4);
+    Tensor b = _iota_f32(dims, 4);
+    const Tensor operands[2] = { a, b };
+
+    // 连续的操作数合并成一个 run，长度为 1 的维度被丢掉
+    TensorIter it;
+    TEST_CHECK(tensor_iter_init(&it, operands, 2));
+    TEST_CHECK(it.ndim == 1 && it.size == 24 && it.num_runs == 1);
+
+    // 置换后的输入只能合并彼此相邻的维度
+    const int axes[4] = { 0, 1, 3, 2 };
+    Tensor p = tensor_permute(a, axes); // [2, 1, 4, 3]
+    Tensor out = tensor_zeros(tensor_get_shape(p), DTYPE_F32);
+    const Tensor mixed[2] = { out, p };
+    TEST_CHECK(tensor_iter_init(&it, mixed, 2));
+    TEST_CHECK(it.size == 24 && it.ndim == 3 && it.num_runs == 8 && it.inner_size == 3);
+
+    float seen[24];
+    TEST_CHECK(_walk(&it, seen, 24) == 24);
+    int wrong = 0;
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 4; j++)
+            for (int k = 0; k < 3; k++) wrong += seen[(i * 4 + j) * 3 + k] != (float)(i * 12 + k * 4 + j);
+    TEST_CHECK(wrong == 0);
+
+    // 形状不同、操作数太多都被拒绝
+    const Tensor different[2] = { a, p };
+    TEST_CHECK(!tensor_iter_init(&it, different, 2));
+    TEST_CHECK(!tensor_iter_init(&it, operands, TENSOR_ITER_MAX_OPERANDS + 1));
+
+    tensor_free(out);
+    tensor_free(p);
+    tensor_free(b);
+    tensor_free(a);
+}
+
+static void
+test_broadcast_operand(void)
+{
+    // 广播出来的操作数步长为 0，指针不前进
+    const int row_dims[2] = { 1, 5 };
+    Tensor row = _iota_f32(row_dims, 2);
+    const int dims[2] = { 3, 5 };
+    Shape s = shape_create(dims, 2);
+    Tensor e = tensor_expand(row, s);
+    Tensor out = tensor_zeros(s, DTYPE_F32);
+    shape_free(s);
+
+    const Tensor operands[2] = { out, e };
+    TensorIter it;
+    TEST_CHECK(tensor_iter_init(&it, operands, 2));
+    TEST_CHECK(it.ndim == 2 && it.strides[1][0] == 0);
+
+    float seen[15];
+    TEST_CHECK(_walk(&it, seen, 15) == 15);
+    int wrong = 0;
+    for (int i = 0; i < 15; i++) wrong += seen[i] != (float)(i % 5);
+    TEST_CHECK(wrong == 0);
+
+    tensor_free(out);
+    tensor_free(e);
+    tensor_free(row);
+}
+
+static void
+test_ranges_and_seek(void)
+{
+    // 任意一段 [begin, end) 得到的元素与整段遍历的对应部分相同，首尾可以是不完整的 run
+    const int dims[3] = { 3, 4, 5 };
+    Tensor base = _iota_f32(dims, 3);
+    const int axes[3] = { 2, 0, 1 };
+    Tensor p = tensor_permute(base, axes); // [5, 3, 4]
+    Tensor out = tensor_zeros(tensor_get_shape(p), DTYPE_F32);
+    const Tensor operands[2] = { out, p };
+
+    TensorIter it;
+    TEST_CHECK(tensor_iter_init(&it, operands, 2));
+    float all[60];
+    TEST_CHECK(_walk(&it, all, 60) == 60);
+
+    const size_t ranges[5][2] = { { 0, 60 }, { 7, 8 }, { 3, 29 }, { 12, 24 }, { 59, 100 } };
+    for (int r = 0; r < 5; r++)
+    {
+        TEST_CHECK(tensor_iter_init(&it, operands, 2));
+        tensor_iter_set_range(&it, ranges[r][0], ranges[r][1]);
+        float part[60];
+        const size_t end = ranges[r][1] < 60 ? ranges[r][1] : 60;
+        TEST_CHECK(_walk(&it, part, 60) == end - ranges[r][0]);
+        int wrong = 0;
+        for (size_t i = 0; i < end - ranges[r][0]; i++) wrong += part[i] != all[ranges[r][0] + i];
+        TEST_CHECK(wrong == 0);
+    }
+
+    // seek 到第 k 个 run：后两维合并成长度 12 的 run
+    TEST_CHECK(tensor_iter_init(&it, operands, 2));
+    TEST_CHECK(it.ndim == 2 && it.num_runs == 5);
+    tensor_iter_seek(&it, 2);
+    TEST_CHECK(tensor_iter_next(&it) && it.inner_size == 12);
+    TEST_CHECK(*(const float*)it.ptrs[1] == all[24]);
+
+    // reset 换一组同布局的指针，从头开始
+    void* data[2] = { tensor_get_data(out), (void*)tensor_get_data_const(p) };
+    tensor_iter_reset(&it, data);
+    TEST_CHECK(tensor_iter_next(&it) && *(const float*)it.ptrs[1] == all[0]);
+
+    tensor_free(out);
+    tensor_free(p);
+    tensor_free(base);
+}
+
+static void
+test_remove_axis(void)
+{
+    // 拿走外层的一维交给调用者，剩下的遍历少一维
+    const int dims[3] = { 3, 4, 5 };
+    Tensor a = _iota_f32(dims, 3);
+    const int axes[3] = { 1, 0, 2 };
+    Tensor p = tensor_permute(a, axes); // [4, 3, 5]，前两维不能合并
+    Tensor out = tensor_zeros(tensor_get_shape(p), DTYPE_F32);
+    const Tensor operands[2] = { out, p };
+
+    TensorIter it;
+    TEST_CHECK(tensor_iter_init(&it, operands, 2));
+    TEST_CHECK(it.ndim == 3);
+    size_t size = 0, strides[2] = { 0, 0 };
+    TEST_CHECK(tensor_iter_remove_axis(&it, 0, &size, strides));
+    TEST_CHECK(size == 4 && strides[0] == 15 * sizeof(float) && strides[1] == 5 * sizeof(float));
+    TEST_CHECK(it.size == 15 && it.num_runs == 3);
+    TEST_CHECK(!tensor_iter_remove_axis(&it, it.ndim - 1, NULL, NULL)); // run 所在的轴不能拿走
+
+    tensor_free(out);
+    tensor_free(p);
+    tensor_free(a);
+}
+
+static void
+test_empty_and_scalar(void)
+{
+    // 没有元素的遍历一个 run 也不产生，不连续也一样
+    const int dims[2] = { 4, 0 };
+    Shape s = shape_create(dims, 2);
+    Tensor e = tensor_zeros(s, DTYPE_F32);
+    shape_free(s);
+    const int axes[2] = { 1, 0 };
+    Tensor p = tensor_permute(e, axes);
+    const Tensor operands[1] = { p };
+    TensorIter it;
+    TEST_CHECK(tensor_iter_init(&it, operands, 1));
+    TEST_CHECK(it.size == 0 && it.num_runs == 0 && !tensor_iter_next(&it));
+    tensor_iter_set_range(&it, 0, 10);
+    TEST_CHECK(!tensor_iter_next(&it));
+
+    // 0 维：一个元素、一个 run
+    float value = 3.0f;
+    const size_t item_size = sizeof(float);
+    void* data[1] = { &value };
+    const size_t* strides[1] = { NULL };
+    memset(&it, 0, sizeof(it));
+    TEST_CHECK(tensor_iter_init_strided(&it, 1, data, strides, &item_size, NULL, 0));
+    TEST_CHECK(tensor_iter_next(&it) && it.inner_size == 1 && *(float*)it.ptrs[0] == 3.0f);
+    TEST_CHECK(!tensor_iter_next(&it));
+
+    tensor_free(p);
+    tensor_free(e);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_merges_dimensions);
+    TEST_RUN(test_broadcast_operand);
+    TEST_RUN(test_ranges_and_seek);
+    TEST_RUN(test_remove_axis);
+    TEST_RUN(test_empty_and_scalar);
+    return test_finish();
+}
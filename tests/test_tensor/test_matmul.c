@@ -0,0 +1,216 @@
+#include "_test.h"
+
+#include <stdlib.h> // for malloc(), free()
+
+static Tensor
+_random_matrix(int rows, int cols, DataType dtype)
+{
+    const int dims[2] = { rows, cols };
+    Shape s = shape_create(dims, 2);
+    Tensor t = tensor_empty(s, DTYPE_F64);
+    shape_free(s);
+    double* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = test_random() * 2 - 1;
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+// 读 2-D 张量（任意布局）的元素：先变成连续的再读
+static double*
+_elements(const Tensor t)
+{
+    Tensor c = tensor_contiguous(t);
+    const size_t n = tensor_get_elements_count(c);
+    double* x = malloc(sizeof(double) * (n > 0 ? n : 1));
+    for (size_t i = 0; i < n; i++) x[i] = test_get(c, i);
+    tensor_free(c);
+    return x;
+}
+
+// 与朴素的三重循环比较
+static void
+_check_product(const Tensor a, const Tensor b, const Tensor c, double tol)
+{
+    TEST_CHECK(c != NULL);
+    if (c == NULL) return;
+    const int m = tensor_get_dim(a, 0), k = tensor_get_dim(a, 1), n = tensor_get_dim(b, 1);
+    TEST_CHECK(tensor_get_dim(c, 0) == m && tensor_get_dim(c, 1) == n && tensor_is_contiguous(c));
+    double* x = _elements(a);
+    double* y = _elements(b);
+    int wrong = 0;
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++)
+        {
+            double expected = 0;
+            for (int p = 0; p < k; p++) expected += x[i * k + p] * y[p * n + j];
+            const double got = test_get(c, (size_t)i * n + j);
+            wrong += !(got - expected <= tol * (1 + k) && expected - got <= tol * (1 + k));
+        }
+    TEST_CHECK(wrong == 0);
+    free(y);
+    free(x);
+}
+
+static void
+test_matmul_sizes(void)
+{
+    // 不是微内核分块整数倍的尺寸，以及大到要分块打包的尺寸
+    const int sizes[5][3] = { { 1, 1, 1 }, { 7, 5, 3 }, { 37, 53, 29 }, { 6, 300, 16 }, { 130, 270, 75 } };
+    const DataType dtypes[2] = { DTYPE_F32, DTYPE_F64 };
+    for (int d = 0; d < 2; d++)
+    {
+        const double tol = (dtypes[d] == DTYPE_F32) ? 1e-6 : 1e-14;
+        for (int s = 0; s < 5; s++)
+        {
+            Tensor a = _random_matrix(sizes[s][0], sizes[s][1], dtypes[d]);
+            Tensor b = _random_matrix(sizes[s][1], sizes[s][2], dtypes[d]);
+            Tensor c = tensor_matmul(a, b);
+            _check_product(a, b, c, tol);
+            TEST_CHECK(c == NULL || tensor_get_dtype(c) == dtypes[d]);
+            tensor_free(c);
+            tensor_free(b);
+            tensor_free(a);
+        }
+    }
+}
+
+static void
+test_matmul_views(void)
+{
+    // 转置和切片的视图按 stride 读取，结果与连续的副本相同
+    const int axes[2] = { 1, 0 };
+    Tensor at = _random_matrix(40, 33, DTYPE_F32);
+    Tensor a = tensor_permute(at, axes);        // [33, 40]
+    Tensor wide = _random_matrix(40, 60, DTYPE_F32);
+    Tensor b = tensor_slice(wide, 1, 1, 60, 2); // [40, 30]，列的步长为 2
+    Tensor c = tensor_matmul(a, b);
+    _check_product(a, b, c, 1e-6);
+
+    // 广播出来的行：stride 为 0
+    Tensor row = _random_matrix(1, 40, DTYPE_F32);
+    const int expanded[2] = { 9, 40 };
+    Shape s = shape_create(expanded, 2);
+    Tensor e = tensor_expand(row, s);
+    Tensor ce = tensor_matmul(e, b);
+    _check_product(e, b, ce, 1e-6);
+
+    tensor_free(ce);
+    tensor_free(e);
+    shape_free(s);
+    tensor_free(row);
+    tensor_free(c);
+    tensor_free(b);
+    tensor_free(wide);
+    tensor_free(a);
+    tensor_free(at);
+}
+
+static void
+test_matmul_empty_and_errors(void)
+{
+    // K == 0 时结果全为 0；M 或 N 为 0 时结果没有元素
+    Tensor a = _random_matrix(4, 0, DTYPE_F64);
+    Tensor b = _random_matrix(0, 3, DTYPE_F64);
+    Tensor c = tensor_matmul(a, b);
+    TEST_CHECK(c != NULL && tensor_get_elements_count(c) == 12);
+    for (int i = 0; c != NULL && i < 12; i++) TEST_CHECK(test_get(c, i) == 0.0);
+
+    Tensor rows = _random_matrix(0, 5, DTYPE_F64);
+    Tensor cols = _random_matrix(5, 3, DTYPE_F64);
+    Tensor none = tensor_matmul(rows, cols);
+    TEST_CHECK(none != NULL && tensor_get_dim(none, 0) == 0 && tensor_get_dim(none, 1) == 3);
+
+    // 不连续的空矩阵
+    const int axes[2] = { 1, 0 };
+    Tensor empty = _random_matrix(5, 0, DTYPE_F64);
+    Tensor rows_t = tensor_permute(empty, axes);
+    Tensor none_t = tensor_matmul(rows_t, cols);
+    TEST_CHECK(none_t != NULL && tensor_get_elements_count(none_t) == 0);
+
+    // 内维不匹配、dtype 不同、整数 dtype
+    Tensor f32 = _random_matrix(5, 3, DTYPE_F32);
+    Tensor i32 = _random_matrix(3, 3, DTYPE_I32);
+    TEST_CHECK(tensor_matmul(cols, cols) == NULL);
+    TEST_CHECK(tensor_matmul(rows, f32) == NULL);
+    TEST_CHECK(tensor_matmul(i32, i32) == NULL);
+
+    tensor_free(i32);
+    tensor_free(f32);
+    tensor_free(none_t);
+    tensor_free(rows_t);
+    tensor_free(empty);
+    tensor_free(none);
+    tensor_free(cols);
+    tensor_free(rows);
+    tensor_free(c);
+    tensor_free(b);
+    tensor_free(a);
+}
+
+static void
+test_bmm_broadcast(void)
+{
+    // [3, 1, M, K] x [1, 2, K, N]：批维度广播成 [3, 2]
+    const int m = 9, k = 17, n = 11;
+    Tensor a_flat = _random_matrix(3 * m, k, DTYPE_F32);
+    Tensor b_flat = _random_matrix(2 * k, n, DTYPE_F32);
+    const int a_dims[4] = { 3, 1, m, k };
+    const int b_dims[4] = { 1, 2, k, n };
+    Shape as = shape_create(a_dims, 4);
+    Shape bs = shape_create(b_dims, 4);
+    Tensor a = tensor_reshape(a_flat, as);
+    Tensor b = tensor_reshape(b_flat, bs);
+    Tensor c = tensor_bmm(a, b);
+    TEST_CHECK(c != NULL && tensor_get_ndim(c) == 4 && tensor_get_dim(c, 0) == 3 && tensor_get_dim(c, 1) == 2);
+
+    for (int i = 0; c != NULL && i < 3; i++)
+    {
+        for (int j = 0; j < 2; j++)
+        {
+            Tensor ai = tensor_narrow(a_flat, 0, i * m, m);
+            Tensor bj = tensor_narrow(b_flat, 0, j * k, k);
+            Tensor ci = tensor_select(c, 0, i);
+            Tensor cij = tensor_select(ci, 0, j);
+            Tensor cc = tensor_contiguous(cij);
+            _check_product(ai, bj, cc, 1e-6);
+            tensor_free(cc);
+            tensor_free(cij);
+            tensor_free(ci);
+            tensor_free(bj);
+            tensor_free(ai);
+        }
+    }
+
+    // 批维度不能广播
+    const int bad_dims[3] = { 2, k, n };
+    const int a3_dims[3] = { 3, m, k };
+    Shape bad = shape_create(bad_dims, 3);
+    Tensor b_bad = tensor_reshape(b_flat, bad);
+    Shape as3 = shape_create(a3_dims, 3);
+    Tensor a3 = tensor_reshape(a_flat, as3);
+    TEST_CHECK(tensor_bmm(a3, b_bad) == NULL);
+
+    tensor_free(a3);
+    shape_free(as3);
+    tensor_free(b_bad);
+    shape_free(bad);
+    tensor_free(c);
+    tensor_free(b);
+    tensor_free(a);
+    shape_free(bs);
+    shape_free(as);
+    tensor_free(b_flat);
+    tensor_free(a_flat);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_matmul_sizes);
+    TEST_RUN(test_matmul_views);
+    TEST_RUN(test_matmul_empty_and_errors);
+    TEST_RUN(test_bmm_broadcast);
+    return test_finish();
+}
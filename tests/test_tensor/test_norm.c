@@ -0,0 +1,173 @@
+#include "_test.h"
+
+#include <math.h> // for exp(), sqrt()
+
+#define ROWS 7
+#define COLS 133 // 不是向量宽度的倍数，尾部也会被检查
+
+static double _input[ROWS * COLS];
+
+static void
+_init_input(void)
+{
+    for (int i = 0; i < ROWS * COLS; i++) _input[i] = test_random() * 20.0 - 10.0;
+    _input[5] = 80.0; // 一行里的最大值远大于其余元素
+}
+
+static Tensor
+_input_tensor(DataType dtype)
+{
+    const int dims[2] = { ROWS, COLS };
+    Tensor t = test_tensor(_input, dims, 2, DTYPE_F64);
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+// 参考实现：在 double 里逐行计算，x 按 (row, col) 下标读取
+static void
+_softmax_reference(double* out, const double* x, int rows, int cols, size_t row_stride, size_t col_stride)
+{
+    for (int r = 0; r < rows; r++)
+    {
+        double max = x[r * row_stride];
+        for (int c = 1; c < cols; c++)
+            if (x[r * row_stride + c * col_stride] > max) max = x[r * row_stride + c * col_stride];
+        double sum = 0.0;
+        for (int c = 0; c < cols; c++) sum += exp(x[r * row_stride + c * col_stride] - max);
+        for (int c = 0; c < cols; c++) out[r * cols + c] = exp(x[r * row_stride + c * col_stride] - max) / sum;
+    }
+}
+
+static void
+test_softmax_last_axis(void)
+{
+    static double expected[ROWS * COLS];
+    _softmax_reference(expected, _input, ROWS, COLS, COLS, 1);
+
+    const DataType dtypes[2] = { DTYPE_F32, DTYPE_F64 };
+    const double tols[2] = { 1e-5, 1e-12 };
+    for (int k = 0; k < 2; k++)
+    {
+        Tensor t = _input_tensor(dtypes[k]);
+        Tensor s = tensor_softmax(t, 1);
+        TEST_CHECK(s != NULL && tensor_get_dtype(s) == dtypes[k]);
+        for (int i = 0; s != NULL && i < ROWS * COLS; i++) TEST_CHECK_CLOSE(test_get(s, i), expected[i], tols[k]);
+
+        Tensor l = tensor_log_softmax(t, 1);
+        TEST_CHECK(l != NULL);
+        for (int i = 0; l != NULL && i < ROWS * COLS; i++)
+            if (expected[i] > 1e-30) TEST_CHECK_CLOSE(test_get(l, i), log(expected[i]), tols[k] * 10);
+
+        tensor_free(l);
+        tensor_free(s);
+        tensor_free(t);
+    }
+}
+
+static void
+test_softmax_strided_axis(void)
+{
+    // 沿第 0 轴：每一“行”在内存里跨 COLS 个元素
+    static double expected[COLS * ROWS];
+    _softmax_reference(expected, _input, COLS, ROWS, 1, COLS);
+
+    Tensor t = _input_tensor(DTYPE_F64);
+    Tensor s = tensor_softmax(t, 0);
+    TEST_CHECK(s != NULL);
+    for (int r = 0; s != NULL && r < ROWS; r++)
+        for (int c = 0; c < COLS; c++) TEST_CHECK_CLOSE(test_get(s, (size_t)r * COLS + c), expected[c * ROWS + r], 1e-12);
+
+    // 转置视图上沿最后一轴，结果与上面转置后相同
+    const int axes[2] = { 1, 0 };
+    Tensor p = tensor_permute(t, axes);
+    Tensor sp = tensor_softmax(p, 1);
+    TEST_CHECK(sp != NULL);
+    for (int i = 0; sp != NULL && i < ROWS * COLS; i++) TEST_CHECK_CLOSE(test_get(sp, i), expected[i], 1e-12);
+
+    tensor_free(sp);
+    tensor_free(p);
+    tensor_free(s);
+    tensor_free(t);
+}
+
+static void
+test_layer_norm(void)
+{
+    double weight[COLS], bias[COLS];
+    for (int c = 0; c < COLS; c++)
+    {
+        weight[c] = 0.5 + test_random();
+        bias[c] = test_random() - 0.5;
+    }
+    const double eps = 1e-5;
+
+    static double expected[ROWS * COLS];
+    for (int r = 0; r < ROWS; r++)
+    {
+        const double* x = _input + r * COLS;
+        double mean = 0.0, var = 0.0;
+        for (int c = 0; c < COLS; c++) mean += x[c];
+        mean /= COLS;
+        for (int c = 0; c < COLS; c++) var += (x[c] - mean) * (x[c] - mean);
+        var /= COLS;
+        for (int c = 0; c < COLS; c++) expected[r * COLS + c] = (x[c] - mean) / sqrt(var + eps) * weight[c] + bias[c];
+    }
+
+    const DataType dtypes[2] = { DTYPE_F32, DTYPE_F64 };
+    const double tols[2] = { 1e-5, 1e-12 };
+    const int wdims[1] = { COLS };
+    for (int k = 0; k < 2; k++)
+    {
+        Tensor t = _input_tensor(dtypes[k]);
+        Tensor w64 = test_tensor(weight, wdims, 1, DTYPE_F64);
+        Tensor b64 = test_tensor(bias, wdims, 1, DTYPE_F64);
+        Tensor w = tensor_to_dtype(w64, dtypes[k]);
+        Tensor b = tensor_to_dtype(b64, dtypes[k]);
+
+        Tensor n = tensor_layer_norm(t, 1, w, b, eps);
+        TEST_CHECK(n != NULL);
+        for (int i = 0; n != NULL && i < ROWS * COLS; i++)
+        {
+            // F32 的 weight、bias 本身有舍入误差，参考值取同样舍入后的参数
+            const int c = i % COLS;
+            const double wc = test_get(w, c), bc = test_get(b, c);
+            const double ref = (expected[i] - bias[c]) / weight[c] * wc + bc;
+            TEST_CHECK_CLOSE(test_get(n, i), ref, tols[k]);
+        }
+
+        // 原地
+        TEST_CHECK(tensor_layer_norm_out(t, t, 1, w, b, eps));
+        for (int i = 0; n != NULL && i < ROWS * COLS; i++) TEST_CHECK(test_get(t, i) == test_get(n, i));
+
+        Tensor all[] = { n, b, w, b64, w64, t };
+        for (int i = 0; i < 6; i++) tensor_free(all[i]);
+    }
+}
+
+static void
+test_rejects_bad_arguments(void)
+{
+    Tensor t = _input_tensor(DTYPE_F32);
+    TEST_CHECK(tensor_softmax(t, 2) == NULL);
+    TEST_CHECK(tensor_layer_norm(t, 1, NULL, NULL, -1.0) == NULL);
+
+    const int dims[1] = { 3 };
+    const int values[3] = { 1, 2, 3 };
+    Tensor i = test_tensor(values, dims, 1, DTYPE_I32);
+    TEST_CHECK(tensor_softmax(i, 0) == NULL);
+    tensor_free(i);
+    tensor_free(t);
+}
+
+int
+main(void)
+{
+    _init_input();
+    TEST_RUN(test_softmax_last_axis);
+    TEST_RUN(test_softmax_strided_axis);
+    TEST_RUN(test_layer_norm);
+    TEST_RUN(test_rejects_bad_arguments);
+    return test_finish();
+}
@@ -0,0 +1,196 @@
+#include "_test.h"
+
+#include <limits.h> // for INT_MAX, INT_MIN
+#include <math.h>   // for NAN, signbit()
+
+// 长度覆盖 SIMD 的整段、两段展开和尾部
+#define MAX_LENGTH 40
+
+static Tensor
+_full(int n, DataType dtype, double value)
+{
+    const int dims[1] = { n };
+    Shape s = shape_create(dims, 1);
+    Tensor t = tensor_full(s, dtype, value);
+    shape_free(s);
+    return t;
+}
+
+static void
+test_int32_wraps(void)
+{
+    for (int n = 1; n <= MAX_LENGTH; n++)
+    {
+        Tensor max = _full(n, DTYPE_I32, INT_MAX);
+        Tensor min = _full(n, DTYPE_I32, INT_MIN);
+        Tensor one = _full(n, DTYPE_I32, 1);
+        Tensor minus_one = _full(1, DTYPE_I32, -1);
+
+        Tensor sum = tensor_add(max, one);
+        Tensor diff = tensor_sub(min, one);
+        Tensor prod = tensor_mul(max, max);
+        Tensor neg = tensor_div(min, minus_one); // 广播的标量除数
+        for (int i = 0; i < n; i++)
+        {
+            TEST_CHECK(test_get(sum, i) == INT_MIN);
+            TEST_CHECK(test_get(diff, i) == INT_MAX);
+            TEST_CHECK(test_get(prod, i) == 1);
+            TEST_CHECK(test_get(neg, i) == INT_MIN);
+        }
+
+        // 跨步的输入走通用内核
+        if (n >= 2)
+        {
+            Tensor even = tensor_slice(max, 0, 0, n, 2);
+            Tensor step = tensor_slice(one, 0, 0, n, 2);
+            Tensor s = tensor_add(even, step);
+            for (size_t i = 0; i < tensor_get_elements_count(s); i++) TEST_CHECK(test_get(s, i) == INT_MIN);
+            tensor_free(s);
+            tensor_free(step);
+            tensor_free(even);
+        }
+
+        Tensor all[] = { max, min, one, minus_one, sum, diff, prod, neg };
+        for (int i = 0; i < 8; i++) tensor_free(all[i]);
+    }
+}
+
+static void
+test_maximum_with_nan(void)
+{
+    // 所有路径（向量部分、尾部、标量内核）都按 (l > r ? l : r) 处理 NaN：比较不成立时取 r
+    float a[MAX_LENGTH], b[MAX_LENGTH];
+    for (int i = 0; i < MAX_LENGTH; i++)
+    {
+        a[i] = (i % 3 == 0) ? NAN : (float)i;
+        b[i] = (i % 4 == 0) ? NAN : (float)(MAX_LENGTH - i);
+    }
+
+    for (int n = 1; n <= MAX_LENGTH; n++)
+    {
+        const int dims[1] = { n };
+        Tensor ta = test_tensor(a, dims, 1, DTYPE_F32);
+        Tensor tb = test_tensor(b, dims, 1, DTYPE_F32);
+        Tensor hi = tensor_maximum(ta, tb);
+        Tensor lo = tensor_minimum(ta, tb);
+        for (int i = 0; i < n; i++)
+        {
+            const float l = a[i], r = b[i];
+            TEST_CHECK_CLOSE(test_get(hi, i), (l > r ? l : r), 0);
+            TEST_CHECK_CLOSE(test_get(lo, i), (l < r ? l : r), 0);
+        }
+        tensor_free(lo);
+        tensor_free(hi);
+        tensor_free(tb);
+        tensor_free(ta);
+    }
+}
+
+static void
+test_full_keeps_negative_zero(void)
+{
+    Tensor f = _full(100, DTYPE_F32, -0.0);
+    Tensor d = _full(100, DTYPE_F64, -0.0);
+    Tensor z = _full(100, DTYPE_F64, 0.0);
+    TEST_CHECK(signbit(test_get(f, 0)) && signbit(test_get(f, 99)));
+    TEST_CHECK(signbit(test_get(d, 50)));
+    TEST_CHECK(!signbit(test_get(z, 50)));
+    tensor_free(z);
+    tensor_free(d);
+    tensor_free(f);
+}
+
+// 12 层 lazy_add(lazy_scalar(1), ...)：一趟放不下，只有标量的子树要先单独求值
+static LazyExpr
+_deep_scalar_chain(int depth)
+{
+    LazyExpr e = lazy_scalar(1);
+    for (int i = 0; i < depth; i++)
+    {
+        LazyExpr one = lazy_scalar(1);
+        LazyExpr next = lazy_add(one, e);
+        lazy_free(one);
+        lazy_free(e);
+        e = next;
+    }
+    return e;
+}
+
+static void
+test_lazy_deep_scalar_subtree(void)
+{
+    const DataType dtypes[3] = { DTYPE_I32, DTYPE_F32, DTYPE_F64 };
+    for (int k = 0; k < 3; k++)
+    {
+        Tensor x = _full(5, dtypes[k], 2);
+        LazyExpr lx = lazy_tensor(x);
+        LazyExpr deep = _deep_scalar_chain(12);
+        LazyExpr e = lazy_add(lx, deep);
+        TEST_CHECK(e != NULL);
+
+        Tensor r = (e != NULL) ? lazy_eval(e) : NULL;
+        TEST_CHECK(r != NULL);
+        if (r != NULL)
+        {
+            TEST_CHECK(tensor_get_dtype(r) == dtypes[k]);
+            for (int i = 0; i < 5; i++) TEST_CHECK(test_get(r, i) == 15);
+        }
+
+        // 单独求值只由标量构成的表达式得到 F64
+        Tensor s = lazy_eval(deep);
+        TEST_CHECK(s != NULL && tensor_get_dtype(s) == DTYPE_F64 && test_get(s, 0) == 13);
+
+        tensor_free(s);
+        tensor_free(r);
+        lazy_free(e);
+        lazy_free(deep);
+        lazy_free(lx);
+        tensor_free(x);
+    }
+}
+
+static void
+test_lazy_matches_eager(void)
+{
+    float a[MAX_LENGTH], b[MAX_LENGTH];
+    for (int i = 0; i < MAX_LENGTH; i++)
+    {
+        a[i] = (float)(test_random() * 4 - 2);
+        b[i] = (float)(test_random() * 4 - 2);
+    }
+    const int dims[1] = { MAX_LENGTH };
+    Tensor ta = test_tensor(a, dims, 1, DTYPE_F32);
+    Tensor tb = test_tensor(b, dims, 1, DTYPE_F32);
+
+    // relu(a * b + a)
+    LazyExpr la = lazy_tensor(ta), lb = lazy_tensor(tb);
+    LazyExpr m = lazy_mul(la, lb);
+    LazyExpr s = lazy_add(m, la);
+    LazyExpr e = lazy_relu(s);
+    Tensor fused = lazy_eval(e);
+
+    Tensor m2 = tensor_mul(ta, tb);
+    Tensor s2 = tensor_add(m2, ta);
+    Tensor zero = _full(1, DTYPE_F32, 0);
+    Tensor eager = tensor_maximum(s2, zero);
+
+    TEST_CHECK(fused != NULL && eager != NULL);
+    for (int i = 0; fused != NULL && eager != NULL && i < MAX_LENGTH; i++)
+        TEST_CHECK(test_get(fused, i) == test_get(eager, i)); // 逐位相同
+
+    Tensor tensors[] = { ta, tb, fused, m2, s2, zero, eager };
+    for (int i = 0; i < 7; i++) tensor_free(tensors[i]);
+    LazyExpr exprs[] = { la, lb, m, s, e };
+    for (int i = 0; i < 5; i++) lazy_free(exprs[i]);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_int32_wraps);
+    TEST_RUN(test_maximum_with_nan);
+    TEST_RUN(test_full_keeps_negative_zero);
+    TEST_RUN(test_lazy_deep_scalar_subtree);
+    TEST_RUN(test_lazy_matches_eager);
+    return test_finish();
+}
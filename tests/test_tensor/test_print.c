@@ -0,0 +1,202 @@
+#include "_test.h"
+
+#include "tensor/_tensor_print.h"
+
+#include <stdio.h> // for FILE, fopen(), fread(), remove()
+#include <stdlib.h> // for malloc(), free()
+#include <string.h> // for strcmp(), strncmp(), strstr(), strlen()
+#include <stdint.h> // for SIZE_MAX
+
+static Tensor
+_iota_f32(const int* dims, int ndim)
+{
+    Shape s = shape_create(dims, ndim);
+    Tensor t = tensor_empty(s, DTYPE_F32);
+    shape_free(s);
+    float* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = (float)i;
+    return t;
+}
+
+static void
+test_print_small(void)
+{
+    char buffer[256];
+    const float values[6] = { 1, 2, 3, 4, 5, 6.5f };
+    const int dims[2] = { 2, 3 };
+    Tensor a = test_tensor(values, dims, 2, DTYPE_F32);
+    const char* expected = "[[1.0000, 2.0000, 3.0000],\n"
+                           " [4.0000, 5.0000, 6.5000]]\n"
+                           "[Tensor of shape: Shape[2, 3]]\n";
+    TEST_CHECK(tensor_sprint(buffer, sizeof(buffer), a) == strlen(expected));
+    TEST_CHECK(strcmp(buffer, expected) == 0);
+
+    // 整数按最宽的数对齐
+    const int ints[4] = { 1, -20, 300, 4 };
+    const int square[2] = { 2, 2 };
+    Tensor b = test_tensor(ints, square, 2, DTYPE_I32);
+    tensor_sprint(buffer, sizeof(buffer), b);
+    TEST_CHECK(strcmp(buffer, "[[   1,  -20],\n [ 300,    4]]\n[Tensor of shape: Shape[2, 2]]\n") == 0);
+
+    // 置换后的视图与它的连续副本打印结果相同
+    const int axes[2] = { 1, 0 };
+    Tensor p = tensor_permute(a, axes);
+    Tensor c = tensor_contiguous(p);
+    char other[256];
+    tensor_sprint(buffer, sizeof(buffer), p);
+    tensor_sprint(other, sizeof(other), c);
+    TEST_CHECK(strcmp(buffer, other) == 0);
+    TEST_CHECK(strncmp(buffer, "[[1.0000, 4.0000],", 18) == 0);
+
+    tensor_free(c);
+    tensor_free(p);
+    tensor_free(b);
+    tensor_free(a);
+}
+
+static void
+test_print_summarized(void)
+{
+    char buffer[4096];
+
+    // 超过阈值：每个轴只打印首尾各 TENSOR_PRINT_EDGE_ITEMS 个
+    const int dims[1] = { 2000 };
+    Tensor t = _iota_f32(dims, 1);
+    tensor_sprint(buffer, sizeof(buffer), t);
+    TEST_CHECK(strcmp(buffer, "[    0,     1,     2, ...,  1997,  1998,  1999]\n[Tensor of shape: Shape[2000]]\n") == 0);
+
+    // 输出的长度只取决于打印出来的元素：7 x 7 x 7 个位置，不是 24000 个元素
+    const int big[3] = { 20, 30, 40 };
+    Tensor z = _iota_f32(big, 3);
+    const size_t length = tensor_sprint(buffer, sizeof(buffer), z);
+    TEST_CHECK(length < sizeof(buffer) && length == strlen(buffer));
+    TEST_CHECK(strstr(buffer, "23999") != NULL && strstr(buffer, "1000") == NULL);
+    TEST_CHECK(strstr(buffer, " ...,\n") != NULL);
+
+    // 不连续的大张量按视图的顺序取首尾
+    const int axes[3] = { 2, 1, 0 };
+    Tensor p = tensor_permute(z, axes); // [40, 30, 20]
+    tensor_sprint(buffer, sizeof(buffer), p);
+    TEST_CHECK(strncmp(buffer, "[[[     0,   1200,   2400, ...,  20400,  21600,  22800],", 56) == 0);
+
+    tensor_free(p);
+    tensor_free(z);
+    tensor_free(t);
+}
+
+static void
+test_print_options(void)
+{
+    char buffer[256];
+    size_t threshold = 0;
+    int edge_items = 0;
+    tensor_print_get_options(&threshold, &edge_items);
+    TEST_CHECK(threshold == TENSOR_PRINT_THRESHOLD && edge_items == TENSOR_PRINT_EDGE_ITEMS);
+
+    const float values[6] = { 1, 2, 3, 4, 5, 6.5f };
+    const int dims[2] = { 2, 3 };
+    Tensor a = test_tensor(values, dims, 2, DTYPE_F32);
+    tensor_print_set_options(4, 1);
+    tensor_sprint(buffer, sizeof(buffer), a);
+    TEST_CHECK(strcmp(buffer, "[[1.0000, ..., 3.0000],\n [4.0000, ..., 6.5000]]\n[Tensor of shape: Shape[2, 3]]\n") == 0);
+
+    // 负数的 edge_items 当作 0；SIZE_MAX 关闭省略
+    tensor_print_set_options(4, -1);
+    tensor_print_get_options(NULL, &edge_items);
+    TEST_CHECK(edge_items == 0);
+    tensor_sprint(buffer, sizeof(buffer), a);
+    TEST_CHECK(strcmp(buffer, "[...]\n[Tensor of shape: Shape[2, 3]]\n") == 0);
+
+    tensor_print_set_options(SIZE_MAX, 1);
+    const int long_dims[1] = { 5000 };
+    Tensor t = _iota_f32(long_dims, 1);
+    const size_t full = tensor_sprint(NULL, 0, t);
+    TEST_CHECK(full > 5000 * 6);
+
+    tensor_print_set_options(TENSOR_PRINT_THRESHOLD, TENSOR_PRINT_EDGE_ITEMS);
+    tensor_free(t);
+    tensor_free(a);
+}
+
+static void
+test_print_empty_and_scalar(void)
+{
+    char buffer[256];
+
+    // 没有元素的张量（包括不连续的）只打印 "[]"
+    const int dims[2] = { 3, 0 };
+    Shape s = shape_create(dims, 2);
+    Tensor e = tensor_zeros(s, DTYPE_F32);
+    shape_free(s);
+    const int axes[2] = { 1, 0 };
+    Tensor p = tensor_permute(e, axes);
+    tensor_sprint(buffer, sizeof(buffer), p);
+    TEST_CHECK(strcmp(buffer, "[]\n[Tensor of shape: Shape[0, 3]]\n") == 0);
+
+    Tensor wide = _iota_f32(dims, 1); // [3]
+    Tensor none = tensor_slice(wide, 0, 2, 2, 1);
+    tensor_sprint(buffer, sizeof(buffer), none);
+    TEST_CHECK(strcmp(buffer, "[]\n[Tensor of shape: Shape[0]]\n") == 0);
+
+    // 0 维
+    const float value = 2.5f;
+    Tensor scalar = test_tensor(&value, NULL, 0, DTYPE_F32);
+    tensor_sprint(buffer, sizeof(buffer), scalar);
+    TEST_CHECK(strcmp(buffer, "2.5000\n[Tensor of shape: Shape[]]\n") == 0);
+
+    tensor_sprint(buffer, sizeof(buffer), NULL);
+    TEST_CHECK(strcmp(buffer, "[ Tensor (NULL) ]\n") == 0);
+
+    tensor_free(scalar);
+    tensor_free(none);
+    tensor_free(wide);
+    tensor_free(p);
+    tensor_free(e);
+}
+
+static void
+test_print_truncated_and_stream(void)
+{
+    // snprintf 语义：截断时仍以 NUL 结尾，返回完整的长度
+    const int dims[2] = { 30, 30 };
+    Tensor t = _iota_f32(dims, 2);
+    const size_t full = tensor_sprint(NULL, 0, t);
+    char* expected = malloc(full + 1);
+    TEST_CHECK(tensor_sprint(expected, full + 1, t) == full && strlen(expected) == full);
+
+    char small[10];
+    TEST_CHECK(tensor_sprint(small, sizeof(small), t) == full);
+    TEST_CHECK(strlen(small) == 9 && strncmp(small, expected, 9) == 0);
+
+    // 写文件的输出比缓冲区长（900 个元素不省略），分块写出后与字符串相同
+    char path[256];
+    test_tmp_path(path, sizeof(path), "print.txt");
+    FILE* f = fopen(path, "w");
+    TEST_CHECK(f != NULL);
+    tensor_fprint(f, t);
+    fclose(f);
+    TEST_CHECK(full > 4096);
+
+    char* written = malloc(full + 2);
+    f = fopen(path, "r");
+    const size_t n = fread(written, 1, full + 1, f);
+    fclose(f);
+    remove(path);
+    written[n] = '\0';
+    TEST_CHECK(n == full && strcmp(written, expected) == 0);
+
+    free(written);
+    free(expected);
+    tensor_free(t);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_print_small);
+    TEST_RUN(test_print_summarized);
+    TEST_RUN(test_print_options);
+    TEST_RUN(test_print_empty_and_scalar);
+    TEST_RUN(test_print_truncated_and_stream);
+    return test_finish();
+}
@@ -0,0 +1,298 @@
+#include "_test.h"
+
+#include "utils/_parallel.h"
+
+#include <math.h>   // for NAN, INFINITY, isnan()
+#include <stdlib.h> // for malloc(), free()
+
+// [2, 3, 4] 的 F64 随机张量，取整数值，各种 dtype 的求和都是精确的
+static Tensor
+_random_234(DataType dtype)
+{
+    double values[24];
+    for (int i = 0; i < 24; i++) values[i] = (double)(int)(test_random() * 20) - 10;
+    const int dims[3] = { 2, 3, 4 };
+    Tensor t = test_tensor(values, dims, 3, DTYPE_F64);
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+// 对 [2, 3, 4] 按 mask 里标记的轴求参考结果：0 = sum，1 = max，2 = min
+static void
+_reference(const Tensor t, const bool* mask, int kind, double* out)
+{
+    const int dims[3] = { 2, 3, 4 };
+    int out_dims[3];
+    for (int d = 0; d < 3; d++) out_dims[d] = mask[d] ? 1 : dims[d];
+    const int n = out_dims[0] * out_dims[1] * out_dims[2];
+    for (int i = 0; i < n; i++) out[i] = (kind == 0) ? 0 : (kind == 1) ? -INFINITY : INFINITY;
+
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 3; j++)
+            for (int k = 0; k < 4; k++)
+            {
+                const int o = ((mask[0] ? 0 : i) * out_dims[1] + (mask[1] ? 0 : j)) * out_dims[2] + (mask[2] ? 0 : k);
+                const double x = test_get(t, (size_t)(i * 12 + j * 4 + k));
+                if (kind == 0) out[o] += x;
+                else if (kind == 1) out[o] = (x > out[o]) ? x : out[o];
+                else out[o] = (x < out[o]) ? x : out[o];
+            }
+}
+
+static void
+test_reduce_axes(void)
+{
+    const DataType dtypes[4] = { DTYPE_F32, DTYPE_F64, DTYPE_I32, DTYPE_I8 };
+    // 每一种轴的组合，包括全部轴
+    const int axis_sets[7][3] = { { 0 }, { 1 }, { 2 }, { 0, 1 }, { 0, 2 }, { 1, 2 }, { 0, 1, 2 } };
+    const int naxes[7] = { 1, 1, 1, 2, 2, 2, 3 };
+
+    for (int d = 0; d < 4; d++)
+    {
+        Tensor t = _random_234(dtypes[d]);
+        for (int a = 0; a < 7; a++)
+        {
+            bool mask[3] = { false, false, false };
+            for (int i = 0; i < naxes[a]; i++) mask[axis_sets[a][i]] = true;
+            const int reduced = (mask[0] ? 2 : 1) * (mask[1] ? 3 : 1) * (mask[2] ? 4 : 1);
+
+            double expected[24];
+            for (int kind = 0; kind < 3; kind++)
+            {
+                _reference(t, mask, kind, expected);
+                Tensor r = (kind == 0) ? tensor_sum(t, axis_sets[a], naxes[a], true)
+                         : (kind == 1) ? tensor_max(t, axis_sets[a], naxes[a], true)
+                         : tensor_min(t, axis_sets[a], naxes[a], true);
+                TEST_CHECK(r != NULL && tensor_get_ndim(r) == 3);
+                for (size_t i = 0; r != NULL && i < tensor_get_elements_count(r); i++)
+                    TEST_CHECK_CLOSE(test_get(r, i), expected[i], 0);
+                tensor_free(r);
+
+                if (kind != 0) continue;
+                Tensor m = tensor_mean(t, axis_sets[a], naxes[a], false);
+                TEST_CHECK(m != NULL && tensor_get_ndim(m) == 3 - naxes[a]);
+                for (size_t i = 0; m != NULL && i < tensor_get_elements_count(m); i++)
+                    TEST_CHECK_CLOSE(test_get(m, i), expected[i] / reduced, 1e-6);
+                tensor_free(m);
+            }
+        }
+        tensor_free(t);
+    }
+
+    // 越界和重复的轴
+    Tensor t = _random_234(DTYPE_F32);
+    const int bad[2] = { 3, 0 };
+    const int dup[2] = { 1, 1 };
+    TEST_CHECK(tensor_sum(t, bad, 1, false) == NULL);
+    TEST_CHECK(tensor_sum(t, dup, 2, false) == NULL);
+    tensor_free(t);
+}
+
+static void
+test_reduce_views(void)
+{
+    // 置换后的视图：规约轴不连续时走纵向或跨步路径，结果与连续的副本相同
+    Tensor t = _random_234(DTYPE_F32);
+    const int axes[3] = { 2, 0, 1 };
+    Tensor p = tensor_permute(t, axes); // [4, 2, 3]
+    Tensor pc = tensor_contiguous(p);
+    for (int axis = 0; axis < 3; axis++)
+    {
+        Tensor a = tensor_sum(p, &axis, 1, false);
+        Tensor b = tensor_sum(pc, &axis, 1, false);
+        Tensor am = tensor_argmax(p, axis, false);
+        Tensor bm = tensor_argmax(pc, axis, false);
+        TEST_CHECK(a != NULL && b != NULL && am != NULL && bm != NULL);
+        for (size_t i = 0; a != NULL && b != NULL && i < tensor_get_elements_count(b); i++)
+            TEST_CHECK(test_get(a, i) == test_get(b, i));
+        for (size_t i = 0; am != NULL && bm != NULL && i < tensor_get_elements_count(bm); i++)
+            TEST_CHECK(test_get(am, i) == test_get(bm, i));
+        tensor_free(bm);
+        tensor_free(am);
+        tensor_free(b);
+        tensor_free(a);
+    }
+
+    // 广播出来的维度：每个值被计数多次
+    const float v[3] = { 1.0f, 2.0f, 4.0f };
+    const int dims[2] = { 1, 3 };
+    Tensor row = test_tensor(v, dims, 2, DTYPE_F32);
+    const int wide[2] = { 1000, 3 };
+    Shape ws = shape_create(wide, 2);
+    Tensor e = tensor_expand(row, ws);
+    Tensor s = tensor_sum(e, NULL, 0, false);
+    TEST_CHECK(s != NULL && test_get(s, 0) == 7000.0);
+    const int zero = 0;
+    Tensor mx = tensor_max(e, &zero, 1, false);
+    TEST_CHECK(mx != NULL && test_get(mx, 2) == 4.0);
+
+    tensor_free(mx);
+    tensor_free(s);
+    tensor_free(e);
+    shape_free(ws);
+    tensor_free(row);
+    tensor_free(pc);
+    tensor_free(p);
+    tensor_free(t);
+}
+
+static void
+test_reduce_empty(void)
+{
+    // 规约长度为 0：和为 0，max/min/argmax 报错；输入不连续也一样
+    const int dims[2] = { 3, 0 };
+    Shape s = shape_create(dims, 2);
+    Tensor e = tensor_zeros(s, DTYPE_F32);
+    const int perm[2] = { 1, 0 };
+    Tensor p = tensor_permute(e, perm); // [0, 3]
+    const int one = 1, zero = 0;
+
+    Tensor sum = tensor_sum(e, &one, 1, false);
+    TEST_CHECK(sum != NULL && tensor_get_elements_count(sum) == 3 && test_get(sum, 2) == 0.0);
+    Tensor psum = tensor_sum(p, &zero, 1, false);
+    TEST_CHECK(psum != NULL && tensor_get_elements_count(psum) == 3 && test_get(psum, 0) == 0.0);
+    Tensor none = tensor_sum(p, &one, 1, true); // 没有输出元素
+    TEST_CHECK(none != NULL && tensor_get_elements_count(none) == 0);
+    TEST_CHECK(tensor_max(e, &one, 1, false) == NULL);
+    TEST_CHECK(tensor_argmax(p, 0, false) == NULL);
+
+    tensor_free(none);
+    tensor_free(psum);
+    tensor_free(sum);
+    tensor_free(p);
+    tensor_free(e);
+    shape_free(s);
+}
+
+static Tensor
+_vector(const double* values, int n, DataType dtype)
+{
+    const int dims[1] = { n };
+    Tensor t = test_tensor(values, dims, 1, DTYPE_F64);
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+static void
+test_nan_propagates(void)
+{
+    // NaN 落在向量主循环、lane 收拢、尾部和切块边界的不同位置，结果都一样
+    enum { N = 600000 };
+    const size_t positions[7] = { 0, 1, 17, 4095, 4096, (1 << 18), N - 1 };
+    const int lengths[3] = { 37, 1000, N }; // 只有尾部、向量加尾部、切块并行
+    const DataType dtypes[3] = { DTYPE_F32, DTYPE_F64, DTYPE_F16 };
+    double* values = malloc(sizeof(double) * N);
+
+    for (int d = 0; d < 3; d++)
+    {
+        for (int l = 0; l < 3; l++)
+        {
+            const int n = lengths[l];
+            for (int p = 0; p < 7; p++)
+            {
+                if (positions[p] >= (size_t)n) continue;
+                for (int i = 0; i < n; i++) values[i] = (double)(i % 1000) - 500;
+                values[positions[p]] = NAN;
+                if (positions[p] + 3 < (size_t)n) values[positions[p] + 3] = NAN;
+
+                Tensor t = _vector(values, n, dtypes[d]);
+                Tensor mx = tensor_max(t, NULL, 0, false);
+                Tensor mn = tensor_min(t, NULL, 0, false);
+                Tensor am = tensor_argmax(t, 0, false);
+                TEST_CHECK(mx != NULL && isnan(test_get(mx, 0)));
+                TEST_CHECK(mn != NULL && isnan(test_get(mn, 0)));
+                TEST_CHECK(am != NULL && test_get(am, 0) == (double)positions[p]);
+                tensor_free(am);
+                tensor_free(mn);
+                tensor_free(mx);
+                tensor_free(t);
+            }
+        }
+    }
+
+    // 纵向规约（沿第 0 轴）和跨步规约（沿转置后的第 1 轴）：只有含 NaN 的那一列是 NaN
+    const int rows = 300, cols = 5;
+    for (int i = 0; i < rows * cols; i++) values[i] = (double)(int)(test_random() * 100);
+    values[123 * cols + 2] = NAN;
+    values[200 * cols + 2] = NAN;
+    const int dims[2] = { rows, cols };
+    Tensor t = test_tensor(values, dims, 2, DTYPE_F64);
+    const int zero = 0, one = 1;
+    const int perm[2] = { 1, 0 };
+    Tensor tt = tensor_permute(t, perm);
+    Tensor vertical = tensor_max(t, &zero, 1, false);
+    Tensor strided = tensor_min(tt, &one, 1, false);
+    Tensor am = tensor_argmax(t, 0, false);
+    TEST_CHECK(vertical != NULL && strided != NULL && am != NULL);
+    for (int c = 0; vertical != NULL && strided != NULL && am != NULL && c < cols; c++)
+    {
+        TEST_CHECK(isnan(test_get(vertical, c)) == (c == 2));
+        TEST_CHECK(isnan(test_get(strided, c)) == (c == 2));
+        if (c == 2) TEST_CHECK(test_get(am, c) == 123);
+    }
+
+    tensor_free(am);
+    tensor_free(strided);
+    tensor_free(vertical);
+    tensor_free(tt);
+    tensor_free(t);
+    free(values);
+}
+
+static void
+test_sum_ignores_thread_count(void)
+{
+    // 长到会切块并行的规约：1 个线程和多个线程的结果逐位相同。
+    // 开头是很大的值、后面是很小的值，部分和的先后顺序一变，舍入就不一样
+    enum { N = 700000 };
+    double* values = malloc(sizeof(double) * N * 2);
+    for (int i = 0; i < N * 2; i++) values[i] = test_random() * ((i % N < 1000) ? 1e12 : 1.0);
+    const int dims[2] = { 2, N };
+    Tensor t = test_tensor(values, dims, 2, DTYPE_F64);
+    Tensor flat = tensor_narrow(t, 0, 0, 1);
+    const int one = 1;
+
+    const int threads = parallel_get_num_threads();
+    parallel_set_num_threads(1);
+    Tensor rows_1 = tensor_sum(t, &one, 1, false);
+    Tensor all_1 = tensor_mean(flat, NULL, 0, false);
+    parallel_set_num_threads(4);
+    Tensor rows_4 = tensor_sum(t, &one, 1, false);
+    Tensor all_4 = tensor_mean(flat, NULL, 0, false);
+    parallel_set_num_threads(threads);
+
+    TEST_CHECK(rows_1 != NULL && rows_4 != NULL && all_1 != NULL && all_4 != NULL);
+    if (rows_1 != NULL && rows_4 != NULL && all_1 != NULL && all_4 != NULL)
+    {
+        TEST_CHECK(test_get(rows_1, 0) == test_get(rows_4, 0));
+        TEST_CHECK(test_get(rows_1, 1) == test_get(rows_4, 1));
+        TEST_CHECK(test_get(all_1, 0) == test_get(all_4, 0));
+
+        double reference = 0;
+        for (int i = 0; i < N; i++) reference += values[i];
+        TEST_CHECK_CLOSE(test_get(rows_1, 0), reference, 1e-12);
+    }
+
+    tensor_free(all_4);
+    tensor_free(rows_4);
+    tensor_free(all_1);
+    tensor_free(rows_1);
+    tensor_free(flat);
+    tensor_free(t);
+    free(values);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_reduce_axes);
+    TEST_RUN(test_reduce_views);
+    TEST_RUN(test_reduce_empty);
+    TEST_RUN(test_nan_propagates);
+    TEST_RUN(test_sum_ignores_thread_count);
+    return test_finish();
+}
@@ -0,0 +1,152 @@
+#include "_test.h"
+
+#include <stdint.h> // for SIZE_MAX
+
+static void
+test_create_contiguous(void)
+{
+    const int dims[3] = { 2, 3, 4 };
+    Shape s = shape_create(dims, 3);
+    TEST_CHECK(s != NULL);
+    TEST_CHECK(shape_get_ndim(s) == 3);
+    TEST_CHECK(shape_get_dim(s, 1) == 3);
+    TEST_CHECK(shape_get_elements_count(s) == 24);
+
+    const size_t* strides = shape_get_strides(s);
+    TEST_CHECK(strides[0] == 12 && strides[1] == 4 && strides[2] == 1);
+    TEST_CHECK(shape_is_contiguous(s));
+    TEST_CHECK(shape_is_non_overlapping(s));
+
+    Shape c = shape_copy(s);
+    TEST_CHECK(c != NULL && shape_equals(s, c));
+    shape_free(c);
+    shape_free(s);
+}
+
+static void
+test_scalar_and_empty(void)
+{
+    Shape scalar = shape_create(NULL, 0);
+    TEST_CHECK(scalar != NULL);
+    TEST_CHECK(shape_get_ndim(scalar) == 0);
+    TEST_CHECK(shape_get_elements_count(scalar) == 1);
+    shape_free(scalar);
+
+    const int dims[2] = { 0, 5 };
+    Shape empty = shape_create(dims, 2);
+    TEST_CHECK(empty != NULL);
+    TEST_CHECK(shape_get_elements_count(empty) == 0);
+    TEST_CHECK(shape_is_non_overlapping(empty));
+
+    // 没有元素时步长无关紧要
+    const size_t strides[2] = { SIZE_MAX, SIZE_MAX };
+    Shape odd = shape_create_strided(dims, strides, 2);
+    TEST_CHECK(odd != NULL && shape_is_non_overlapping(odd));
+    shape_free(odd);
+    shape_free(empty);
+}
+
+static void
+test_overlap(void)
+{
+    const int dims[2] = { 3, 4 };
+    const size_t broadcast[2] = { 0, 1 };
+    Shape b = shape_create_strided(dims, broadcast, 2);
+    TEST_CHECK(!shape_is_non_overlapping(b));
+    TEST_CHECK(!shape_is_contiguous(b));
+    shape_free(b);
+
+    const size_t transposed[2] = { 1, 3 };
+    Shape t = shape_create_strided(dims, transposed, 2);
+    TEST_CHECK(shape_is_non_overlapping(t));
+    TEST_CHECK(!shape_is_contiguous(t));
+    shape_free(t);
+}
+
+static void
+test_broadcast(void)
+{
+    const int a_dims[3] = { 4, 1, 3 };
+    const int b_dims[2] = { 5, 1 };
+    Shape a = shape_create(a_dims, 3);
+    Shape b = shape_create(b_dims, 2);
+    Shape r = shape_broadcast(a, b);
+    TEST_CHECK(r != NULL);
+    if (r != NULL)
+    {
+        TEST_CHECK(shape_get_ndim(r) == 3);
+        TEST_CHECK(shape_get_dim(r, 0) == 4 && shape_get_dim(r, 1) == 5 && shape_get_dim(r, 2) == 3);
+    }
+    shape_free(r);
+
+    const int c_dims[1] = { 2 };
+    Shape c = shape_create(c_dims, 1);
+    TEST_CHECK(shape_broadcast(a, c) == NULL);
+    shape_free(c);
+    shape_free(b);
+    shape_free(a);
+}
+
+static void
+test_permute_and_reshape(void)
+{
+    const int dims[3] = { 2, 3, 4 };
+    Shape s = shape_create(dims, 3);
+    const int axes[3] = { 2, 0, 1 };
+    Shape p = shape_permute(s, axes);
+    TEST_CHECK(p != NULL);
+    if (p != NULL)
+    {
+        const size_t* strides = shape_get_strides(p);
+        TEST_CHECK(shape_get_dim(p, 0) == 4 && shape_get_dim(p, 1) == 2 && shape_get_dim(p, 2) == 3);
+        TEST_CHECK(strides[0] == 1 && strides[1] == 12 && strides[2] == 4);
+
+        // 转置后的数据合并维度需要复制，拆分一个维度则不需要
+        const int flat[1] = { 24 };
+        TEST_CHECK(shape_reshape(p, flat, 1) == NULL);
+        const int split[4] = { 2, 2, 2, 3 };
+        Shape q = shape_reshape(p, split, 4);
+        TEST_CHECK(q != NULL && shape_get_strides(q)[1] == 1 && shape_get_strides(q)[2] == 12);
+        shape_free(q);
+    }
+
+    const int flat[2] = { 6, 4 };
+    Shape f = shape_reshape(s, flat, 2);
+    TEST_CHECK(f != NULL && shape_is_contiguous(f));
+    shape_free(f);
+
+    const int wrong[1] = { 25 };
+    TEST_CHECK(shape_reshape(s, wrong, 1) == NULL);
+    shape_free(p);
+    shape_free(s);
+}
+
+static void
+test_cache(void)
+{
+    const bool was_enabled = shape_cache_is_enabled();
+    shape_cache_set_enabled(true);
+
+    const int dims[2] = { 7, 9 };
+    Shape a = shape_create(dims, 2);
+    Shape b = shape_create(dims, 2);
+    TEST_CHECK(a != NULL && a == b);
+    TEST_CHECK(shape_equals(a, b));
+    shape_free(a);
+    shape_free(b);
+
+    shape_cache_set_enabled(was_enabled);
+    shape_cache_trim();
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_create_contiguous);
+    TEST_RUN(test_scalar_and_empty);
+    TEST_RUN(test_overlap);
+    TEST_RUN(test_broadcast);
+    TEST_RUN(test_permute_and_reshape);
+    TEST_RUN(test_cache);
+    return test_finish();
+}
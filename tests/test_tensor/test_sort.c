@@ -0,0 +1,222 @@
+#include "_test.h"
+
+#include <math.h>   // for NAN, INFINITY, isnan(), isinf(), signbit()
+#include <stdlib.h> // for qsort()
+
+// 取值只有少数几种，重复很多；包括 NaN、±Inf 和 ±0
+static const double _pool[] = { NAN, INFINITY, -INFINITY, 0.0, -0.0, 1.5, -1.5, 3.0, -7.0, 1e30 };
+#define POOL_SIZE (sizeof(_pool) / sizeof(_pool[0]))
+
+typedef struct
+{
+    double value;
+    int index;
+}
+Entry;
+
+static bool _descending;
+
+// 文档规定的顺序：-0.0 等于 0.0，NaN 比所有数都大；相等时按位置，两个方向都一样
+static int
+_compare(const void* pa, const void* pb)
+{
+    const Entry* a = pa;
+    const Entry* b = pb;
+    const bool an = isnan(a->value), bn = isnan(b->value);
+    int c = 0;
+    if (an || bn) c = an - bn;
+    else c = (a->value > b->value) - (a->value < b->value);
+    if (_descending) c = -c;
+    return (c != 0) ? c : a->index - b->index;
+}
+
+// rows 行、每行 cols 个元素，沿第 1 轴排序时每行的参考顺序
+static void
+_reference_order(int* order, const double* x, int rows, int cols, bool descending)
+{
+    Entry* entries = malloc(sizeof(Entry) * (size_t)cols);
+    _descending = descending;
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++) entries[c] = (Entry){ x[r * cols + c], c };
+        qsort(entries, (size_t)cols, sizeof(Entry), _compare);
+        for (int c = 0; c < cols; c++) order[r * cols + c] = entries[c].index;
+    }
+    free(entries);
+}
+
+static double*
+_random_rows(int rows, int cols, DataType dtype)
+{
+    double* x = malloc(sizeof(double) * (size_t)rows * (size_t)cols);
+    for (int i = 0; i < rows * cols; i++)
+    {
+        double v = _pool[(size_t)(test_random() * POOL_SIZE)];
+        if (dtype == DTYPE_I32 && (isnan(v) || isinf(v) || fabs(v) > 1e9)) v = (double)(int)(test_random() * 9) - 4;
+        else if (dtype == DTYPE_I32) v = (double)(int)v;
+        x[i] = v;
+    }
+    return x;
+}
+
+static Tensor
+_as_tensor(const double* x, int rows, int cols, DataType dtype)
+{
+    const int dims[2] = { rows, cols };
+    Tensor t = test_tensor(x, dims, 2, DTYPE_F64);
+    if (dtype == DTYPE_F64) return t;
+    Tensor c = tensor_to_dtype(t, dtype);
+    tensor_free(t);
+    return c;
+}
+
+static bool
+_same_value(double a, double b)
+{
+    return (isnan(a) && isnan(b)) || (a == b && signbit(a) == signbit(b));
+}
+
+static const DataType _dtypes[3] = { DTYPE_F32, DTYPE_F64, DTYPE_I32 };
+static const int _lengths[3] = { 10, 60, 1000 }; // 插入排序、两种长度的基数排序
+
+static void
+test_argsort_order(void)
+{
+    const int rows = 3;
+    for (int d = 0; d < 3; d++)
+    {
+        for (int l = 0; l < 3; l++)
+        {
+            const int cols = _lengths[l];
+            double* x = _random_rows(rows, cols, _dtypes[d]);
+            Tensor t = _as_tensor(x, rows, cols, _dtypes[d]);
+            int* order = malloc(sizeof(int) * (size_t)rows * (size_t)cols);
+
+            for (int descending = 0; descending < 2; descending++)
+            {
+                _reference_order(order, x, rows, cols, descending);
+                Tensor idx = tensor_argsort(t, 1, descending);
+                TEST_CHECK(idx != NULL && tensor_get_dtype(idx) == DTYPE_I32);
+                int mismatches = 0;
+                for (int i = 0; idx != NULL && i < rows * cols; i++) mismatches += test_get(idx, i) != order[i];
+                TEST_CHECK(mismatches == 0);
+                tensor_free(idx);
+            }
+
+            free(order);
+            tensor_free(t);
+            free(x);
+        }
+    }
+}
+
+static void
+test_argsort_strided_axis(void)
+{
+    // 沿第 0 轴排序转置的输入，等于沿第 1 轴排序原来的数据
+    const int rows = 4, cols = 300;
+    double* x = _random_rows(rows, cols, DTYPE_F32);
+    Tensor t = _as_tensor(x, rows, cols, DTYPE_F32);
+    const int axes[2] = { 1, 0 };
+    Tensor p = tensor_permute(t, axes);
+    int* order = malloc(sizeof(int) * (size_t)rows * (size_t)cols);
+    _reference_order(order, x, rows, cols, false);
+
+    Tensor idx = tensor_argsort(p, 0, false);
+    TEST_CHECK(idx != NULL);
+    int mismatches = 0;
+    for (int r = 0; idx != NULL && r < rows; r++)
+        for (int c = 0; c < cols; c++) mismatches += test_get(idx, (size_t)c * rows + r) != order[r * cols + c];
+    TEST_CHECK(mismatches == 0);
+
+    tensor_free(idx);
+    free(order);
+    tensor_free(p);
+    tensor_free(t);
+    free(x);
+}
+
+static void
+test_topk_order(void)
+{
+    const int rows = 3, cols = 1000;
+    const int ks[3] = { 1, 5, 500 }; // 堆和基数选择两条路径
+    for (int d = 0; d < 3; d++)
+    {
+        double* x = _random_rows(rows, cols, _dtypes[d]);
+        Tensor t = _as_tensor(x, rows, cols, _dtypes[d]);
+        int* order = malloc(sizeof(int) * (size_t)rows * (size_t)cols);
+
+        for (int largest = 0; largest < 2; largest++)
+        {
+            _reference_order(order, x, rows, cols, largest);
+            for (int j = 0; j < 3; j++)
+            {
+                const int k = ks[j];
+                Tensor values = NULL, indices = NULL;
+                TEST_CHECK(tensor_topk(t, k, 1, largest, &values, &indices));
+                if (values == NULL || indices == NULL) continue;
+                TEST_CHECK(tensor_get_dim(values, 1) == k);
+
+                int mismatches = 0;
+                for (int r = 0; r < rows; r++)
+                {
+                    for (int i = 0; i < k; i++)
+                    {
+                        const int expected = order[r * cols + i];
+                        mismatches += test_get(indices, (size_t)r * k + i) != expected;
+                        mismatches += !_same_value(test_get(values, (size_t)r * k + i), test_get(t, (size_t)r * cols + expected));
+                    }
+                }
+                TEST_CHECK(mismatches == 0);
+                tensor_free(indices);
+                tensor_free(values);
+            }
+        }
+
+        free(order);
+        tensor_free(t);
+        free(x);
+    }
+}
+
+static void
+test_small_cases(void)
+{
+    // NaN 排在最后（升序），-0.0 与 0.0 相等，保持原来的先后
+    const float v[6] = { 0.0f, NAN, -0.0f, -1.0f, 0.0f, INFINITY };
+    const int dims[1] = { 6 };
+    Tensor t = test_tensor(v, dims, 1, DTYPE_F32);
+
+    Tensor up = tensor_argsort(t, 0, false);
+    const int up_expected[6] = { 3, 0, 2, 4, 5, 1 };
+    for (int i = 0; up != NULL && i < 6; i++) TEST_CHECK(test_get(up, i) == up_expected[i]);
+
+    Tensor down = tensor_argsort(t, 0, true);
+    const int down_expected[6] = { 1, 5, 0, 2, 4, 3 };
+    for (int i = 0; down != NULL && i < 6; i++) TEST_CHECK(test_get(down, i) == down_expected[i]);
+
+    Tensor values = NULL, indices = NULL;
+    TEST_CHECK(tensor_topk(t, 2, 0, true, &values, &indices));
+    TEST_CHECK(indices != NULL && test_get(indices, 0) == 1 && test_get(indices, 1) == 5);
+    TEST_CHECK(values != NULL && isnan(test_get(values, 0)));
+
+    TEST_CHECK(!tensor_topk(t, 7, 0, true, NULL, NULL));
+    TEST_CHECK(!tensor_topk(t, 0, 0, true, NULL, NULL));
+
+    tensor_free(indices);
+    tensor_free(values);
+    tensor_free(down);
+    tensor_free(up);
+    tensor_free(t);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_argsort_order);
+    TEST_RUN(test_argsort_strided_axis);
+    TEST_RUN(test_topk_order);
+    TEST_RUN(test_small_cases);
+    return test_finish();
+}
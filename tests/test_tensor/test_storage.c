@@ -0,0 +1,215 @@
+#include "_test.h"
+
+#include "utils/_malloc.h"
+
+#include <stdint.h> // for SIZE_MAX
+
+static Tensor
+_full_f32(int n, double value)
+{
+    const int dims[1] = { n };
+    Shape s = shape_create(dims, 1);
+    Tensor t = tensor_full(s, DTYPE_F32, value);
+    shape_free(s);
+    return t;
+}
+
+static void
+test_copy_on_write(void)
+{
+    Tensor a = _full_f32(64, 1.0);
+    Tensor b = tensor_copy(a);
+    TEST_CHECK(b != NULL);
+    TEST_CHECK(tensor_get_data_const(a) == tensor_get_data_const(b)); // O(1) 复制
+
+    // 写入一方时它得到自己的副本，另一方不受影响
+    TEST_CHECK(tensor_add_(b, a));
+    TEST_CHECK(tensor_get_data_const(a) != tensor_get_data_const(b));
+    TEST_CHECK(test_get(a, 3) == 1.0);
+    TEST_CHECK(test_get(b, 3) == 2.0);
+
+    // 视图与原张量共享 storage，写入不会分开它们
+    Tensor v = tensor_narrow(a, 0, 8, 8);
+    float* pv = tensor_get_data(v);
+    pv[0] = 5.0f;
+    TEST_CHECK(test_get(a, 8) == 5.0);
+
+    tensor_free(v);
+    tensor_free(b);
+    tensor_free(a);
+}
+
+static void
+test_exported_pointer(void)
+{
+    // 可写指针先交出去，之后的复制不能与它共享
+    Tensor a = _full_f32(16, 0.0);
+    float* pa = tensor_get_data(a);
+    Tensor b = tensor_copy(a);
+    pa[0] = 100.0f;
+    TEST_CHECK(test_get(a, 0) == 100.0);
+    TEST_CHECK(test_get(b, 0) == 0.0);
+
+    // 可写的 accessor 同样
+    Tensor c = _full_f32(16, 0.0);
+    TensorAccessor ac;
+    TEST_CHECK(tensor_accessor_init(&ac, c, DTYPE_F32));
+    Tensor d = tensor_copy(c);
+    TENSOR_AT_F32(ac, 1) = 5.0f;
+    TEST_CHECK(test_get(d, 1) == 0.0);
+
+    // 只读访问和算子内部的写入不影响 O(1) 复制
+    Tensor e = _full_f32(16, 2.0);
+    (void)tensor_get_data_const(e);
+    Tensor f = tensor_copy(e);
+    TEST_CHECK(tensor_get_data_const(e) == tensor_get_data_const(f));
+    Tensor g = tensor_add(e, f);
+    Tensor h = tensor_copy(g);
+    TEST_CHECK(tensor_get_data_const(g) == tensor_get_data_const(h));
+
+    Tensor all[] = { a, b, c, d, e, f, g, h };
+    for (int i = 0; i < 8; i++) tensor_free(all[i]);
+}
+
+static void
+test_iter_shares_inputs(void)
+{
+    // tensor_iter_init() 只对输出（第一个操作数）取可写指针
+    Tensor out = _full_f32(40, 0.0);
+    Tensor out_copy = tensor_copy(out);
+    Tensor in = _full_f32(40, 3.0);
+
+    const Tensor operands[2] = { out, in };
+    TensorIter it;
+    TEST_CHECK(tensor_iter_init(&it, operands, 2));
+    while (tensor_iter_next(&it))
+        for (size_t i = 0; i < it.inner_size; i++)
+            *(float*)(it.ptrs[0] + i * it.inner_strides[0]) += *(const float*)(it.ptrs[1] + i * it.inner_strides[1]);
+
+    TEST_CHECK(test_get(out, 39) == 3.0);
+    TEST_CHECK(test_get(out_copy, 39) == 0.0); // 输出在写入前与副本分开了
+
+    Tensor in_copy = tensor_copy(in);
+    TEST_CHECK(tensor_get_data_const(in) == tensor_get_data_const(in_copy));
+
+    tensor_free(in_copy);
+    tensor_free(in);
+    tensor_free(out_copy);
+    tensor_free(out);
+}
+
+static void
+test_unshare_inside_arena(void)
+{
+    Tensor a = _full_f32(64, 1.0);
+    Tensor b = tensor_copy(a);
+
+    // 在 arena 作用域里写入共享的张量：私有副本必须来自堆，arena 重置后仍然有效
+    SafeArena* arena = safe_arena_create(0, SAFE_ARENA_DATA);
+    TEST_CHECK(arena != NULL);
+    SafeArena* previous = safe_arena_enter(arena);
+    float* pa = tensor_get_data(a);
+    pa[1] = 2.0f;
+    Tensor scratch = _full_f32(64, -95.0);
+    tensor_free(scratch);
+    safe_arena_leave(previous);
+    safe_arena_reset(arena);
+
+    // 重置后再从 arena 分配，覆盖它以前发出去的内存
+    previous = safe_arena_enter(arena);
+    scratch = _full_f32(64, -95.0);
+    tensor_free(scratch);
+    safe_arena_leave(previous);
+
+    TEST_CHECK(test_get(a, 0) == 1.0);
+    TEST_CHECK(test_get(a, 1) == 2.0);
+    TEST_CHECK(test_get(b, 1) == 1.0);
+
+    safe_arena_destroy(arena);
+    tensor_free(b);
+    tensor_free(a);
+}
+
+static void
+_count_deleter(void* data, void* ctx)
+{
+    (void)data;
+    (*(int*)ctx)++;
+}
+
+static void
+test_from_buffer(void)
+{
+    float buffer[4] = { 0, 1, 2, 3 };
+    const int dims[1] = { 4 };
+    Shape s = shape_create(dims, 1);
+    int deleted = 0;
+
+    Tensor t = tensor_from_buffer(buffer, s, DTYPE_F32, _count_deleter, &deleted);
+    TEST_CHECK(t != NULL);
+    TEST_CHECK(tensor_get_data_const(t) == buffer);
+
+    // 复制立即拷贝，写入总是落到调用者的缓冲区
+    Tensor c = tensor_contiguous(t);
+    Tensor k = tensor_copy(t);
+    float* p = tensor_get_data(t);
+    TEST_CHECK(p == buffer);
+    p[0] = 42.0f;
+    buffer[1] = 7.0f;
+    TEST_CHECK(test_get(t, 1) == 7.0);
+    TEST_CHECK(test_get(c, 0) == 0.0 && test_get(k, 0) == 0.0);
+    TEST_CHECK(test_get(k, 1) == 1.0);
+
+    // 算子写进借来的缓冲区
+    TEST_CHECK(tensor_add_(t, k));
+    TEST_CHECK(buffer[3] == 6.0f);
+
+    Tensor v = tensor_narrow(t, 0, 1, 2);
+    tensor_free(t);
+    TEST_CHECK(deleted == 0); // 视图还在
+    tensor_free(v);
+    TEST_CHECK(deleted == 1);
+    tensor_free(c);
+    tensor_free(k);
+    TEST_CHECK(deleted == 1);
+    shape_free(s);
+}
+
+static void
+test_from_buffer_rejects(void)
+{
+    float buffer[4] = { 0 };
+    const int dims[1] = { 4 };
+    Shape s = shape_create(dims, 1);
+    TEST_CHECK(tensor_from_buffer(buffer, s, (DataType)99, NULL, NULL) == NULL);
+    TEST_CHECK(tensor_from_buffer((char*)buffer + 1, s, DTYPE_F32, NULL, NULL) == NULL); // 未对齐
+
+    const int big[2] = { 2, 2 };
+    const size_t wrap[2] = { 1000, SIZE_MAX - 999 };
+    Shape bad = shape_create_strided(big, wrap, 2);
+    TEST_CHECK(tensor_from_buffer(buffer, bad, DTYPE_F32, NULL, NULL) == NULL);
+
+    // 没有元素时步长不参与计算
+    const int none[2] = { 0, 2 };
+    const size_t any[2] = { SIZE_MAX, SIZE_MAX };
+    Shape empty = shape_create_strided(none, any, 2);
+    Tensor e = tensor_from_buffer(buffer, empty, DTYPE_F32, NULL, NULL);
+    TEST_CHECK(e != NULL);
+    tensor_free(e);
+
+    shape_free(empty);
+    shape_free(bad);
+    shape_free(s);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_copy_on_write);
+    TEST_RUN(test_exported_pointer);
+    TEST_RUN(test_iter_shares_inputs);
+    TEST_RUN(test_unshare_inside_arena);
+    TEST_RUN(test_from_buffer);
+    TEST_RUN(test_from_buffer_rejects);
+    return test_finish();
+}
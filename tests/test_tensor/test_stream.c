@@ -0,0 +1,159 @@
+#include "_test.h"
+
+#include <stdio.h> // for remove()
+
+#define ROWS 1000
+#define COLS 24
+
+typedef struct
+{
+    size_t next_row; // 下一块应该从哪一行开始
+    size_t chunks;
+    size_t fail_at;  // 处理到这一行时返回 false；(size_t)-1 表示不失败
+    Tensor scale;
+}
+StreamCtx;
+
+// 每块乘以 scale；检查块按顺序、不重不漏地到来
+static bool
+_scale_chunk(const Tensor chunk, size_t first_row, Tensor* result, void* ctx)
+{
+    StreamCtx* c = ctx;
+    TEST_CHECK(first_row == c->next_row);
+    TEST_CHECK(tensor_get_dim(chunk, 1) == COLS);
+    c->next_row = first_row + (size_t)tensor_get_dim(chunk, 0);
+    c->chunks++;
+    if (first_row == c->fail_at) return false;
+
+    *result = tensor_mul(chunk, c->scale);
+    return *result != NULL;
+}
+
+static Tensor
+_input(void)
+{
+    float values[ROWS * COLS];
+    for (int i = 0; i < ROWS * COLS; i++) values[i] = (float)(test_random() * 10 - 5);
+    const int dims[2] = { ROWS, COLS };
+    return test_tensor(values, dims, 2, DTYPE_F32);
+}
+
+static Tensor
+_scalar(float value)
+{
+    const int dims[1] = { 1 };
+    return test_tensor(&value, dims, 1, DTYPE_F32);
+}
+
+static void
+_check_scaled(const Tensor input, const Tensor output, float scale)
+{
+    TEST_CHECK(output != NULL);
+    if (output == NULL) return;
+    TEST_CHECK(tensor_get_dim(output, 0) == tensor_get_dim(input, 0));
+    Tensor c = tensor_contiguous(input);
+    int mismatches = 0;
+    for (size_t i = 0; i < tensor_get_elements_count(c); i++) mismatches += test_get(output, i) != (float)test_get(c, i) * scale;
+    TEST_CHECK(mismatches == 0);
+    tensor_free(c);
+}
+
+static void
+test_pipeline_from_mapped_file(void)
+{
+    char in_path[256], out_path[256];
+    test_tmp_path(in_path, sizeof(in_path), "stream_in.npy");
+    test_tmp_path(out_path, sizeof(out_path), "stream_out.npy");
+
+    Tensor source = _input();
+    TEST_CHECK(tensor_save_npy(source, in_path));
+    Tensor mapped = tensor_load_npy(in_path);
+    TEST_CHECK(mapped != NULL);
+
+    // 块的行数整除、不整除总行数，以及自动选择
+    const size_t chunk_rows[4] = { 100, 64, 1, 0 };
+    for (int k = 0; mapped != NULL && k < 4; k++)
+    {
+        StreamCtx ctx = { 0, 0, (size_t)-1, _scalar(2.0f) };
+        TensorWriter w = tensor_writer_open_npy(out_path);
+        TEST_CHECK(tensor_stream(mapped, chunk_rows[k], _scale_chunk, &ctx, w));
+        TEST_CHECK(tensor_writer_close(w));
+        TEST_CHECK(ctx.next_row == ROWS);
+        if (chunk_rows[k] != 0) TEST_CHECK(ctx.chunks == (ROWS + chunk_rows[k] - 1) / chunk_rows[k]);
+
+        Tensor out = tensor_load_npy(out_path);
+        _check_scaled(source, out, 2.0f);
+        tensor_free(out);
+        tensor_free(ctx.scale);
+    }
+
+    tensor_free(mapped);
+    tensor_free(source);
+    remove(out_path);
+    remove(in_path);
+}
+
+static void
+test_pipeline_over_view(void)
+{
+    // 输入不必连续：每一行在内存里跨过整个数组
+    char out_path[256];
+    test_tmp_path(out_path, sizeof(out_path), "stream_view.snake");
+    Tensor source = _input();
+    const int dims[2] = { COLS, ROWS };
+    Shape s = shape_create(dims, 2);
+    Tensor wide = tensor_from_data(tensor_get_data_const(source), s, DTYPE_F32);
+    shape_free(s);
+    const int axes[2] = { 1, 0 };
+    Tensor view = tensor_permute(wide, axes); // ROWS x COLS，列主序
+
+    StreamCtx ctx = { 0, 0, (size_t)-1, _scalar(-1.0f) };
+    TensorWriter w = tensor_writer_open_raw(out_path);
+    TEST_CHECK(tensor_stream(view, 37, _scale_chunk, &ctx, w));
+    TEST_CHECK(tensor_writer_close(w));
+
+    Tensor out = tensor_load_raw(out_path);
+    _check_scaled(view, out, -1.0f);
+
+    tensor_free(out);
+    tensor_free(ctx.scale);
+    tensor_free(view);
+    tensor_free(wide);
+    tensor_free(source);
+    remove(out_path);
+}
+
+static void
+test_failure_stops_pipeline(void)
+{
+    Tensor source = _input();
+    StreamCtx ctx = { 0, 0, 300, _scalar(1.0f) };
+    TEST_CHECK(!tensor_stream(source, 100, _scale_chunk, &ctx, NULL));
+    TEST_CHECK(ctx.chunks == 4); // 第 300 行所在的块之后不再调用
+
+    // 没有 writer 时结果直接释放
+    ctx = (StreamCtx){ 0, 0, (size_t)-1, ctx.scale };
+    TEST_CHECK(tensor_stream(source, 128, _scale_chunk, &ctx, NULL));
+    TEST_CHECK(ctx.next_row == ROWS);
+
+    const int dims[1] = { 0 };
+    Shape s = shape_create(dims, 1);
+    Tensor empty = tensor_empty(s, DTYPE_F32);
+    shape_free(s);
+    ctx = (StreamCtx){ 0, 0, (size_t)-1, ctx.scale };
+    TEST_CHECK(tensor_stream(empty, 10, _scale_chunk, &ctx, NULL));
+    TEST_CHECK(ctx.chunks == 0);
+
+    tensor_free(empty);
+    tensor_free(ctx.scale);
+    tensor_free(source);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_pipeline_from_mapped_file);
+    TEST_RUN(test_pipeline_over_view);
+    TEST_RUN(test_failure_stops_pipeline);
+    return test_finish();
+}
@@ -0,0 +1,216 @@
+#include "_test.h"
+
+#include <stdint.h> // for SIZE_MAX, int32_t
+
+static Tensor
+_iota_f32(const int* dims, int ndim)
+{
+    Shape s = shape_create(dims, ndim);
+    Tensor t = tensor_empty(s, DTYPE_F32);
+    shape_free(s);
+    float* p = tensor_get_data(t);
+    for (size_t i = 0; i < tensor_get_elements_count(t); i++) p[i] = (float)i;
+    return t;
+}
+
+static void
+test_as_strided_in_bounds(void)
+{
+    const int n[1] = { 14 };
+    Tensor t = _iota_f32(n, 1);
+
+    // 滑动窗口：相邻行重叠
+    const int dims[2] = { 5, 4 };
+    const size_t strides[2] = { 2, 1 };
+    Tensor w = tensor_as_strided(t, dims, strides, 2, 2);
+    TEST_CHECK(w != NULL);
+    if (w != NULL)
+    {
+        Tensor c = tensor_contiguous(w);
+        TEST_CHECK(test_get(c, 0) == 2 && test_get(c, 4) == 4 && test_get(c, 19) == 13);
+        tensor_free(c);
+    }
+    tensor_free(w);
+
+    // 正好用到最后一个元素
+    const size_t last[2] = { 2, 1 };
+    const int fit[2] = { 6, 2 };
+    Tensor f = tensor_as_strided(t, fit, last, 2, 2);
+    TEST_CHECK(f != NULL);
+    tensor_free(f);
+
+    // 广播：stride 0
+    const int bdims[2] = { 1000, 3 };
+    const size_t bstrides[2] = { 0, 1 };
+    Tensor b = tensor_as_strided(t, bdims, bstrides, 2, 9);
+    TEST_CHECK(b != NULL && tensor_get_elements_count(b) == 3000);
+    tensor_free(b);
+    tensor_free(t);
+}
+
+static void
+test_as_strided_out_of_bounds(void)
+{
+    const int n[1] = { 4 };
+    Tensor t = _iota_f32(n, 1);
+
+    const int dims[2] = { 2, 2 };
+    const size_t past_end[2] = { 3, 1 };
+    TEST_CHECK(tensor_as_strided(t, dims, past_end, 2, 0) == NULL);
+    const size_t ok[2] = { 2, 1 };
+    TEST_CHECK(tensor_as_strided(t, dims, ok, 2, 1) == NULL); // 偏移后越界
+
+    const int one[1] = { 1 };
+    const size_t unit[1] = { 1 };
+    TEST_CHECK(tensor_as_strided(t, one, unit, 1, 4) == NULL);
+
+    // 最后一个元素的位置在 size_t 里回绕，不能被当成 storage 里的小下标
+    const size_t wrap[2] = { 1000, SIZE_MAX - 999 };
+    TEST_CHECK(tensor_as_strided(t, dims, wrap, 2, 0) == NULL);
+    const size_t huge[2] = { SIZE_MAX / 2 + 1, 1 };
+    TEST_CHECK(tensor_as_strided(t, dims, huge, 2, 0) == NULL);
+
+    // 长度为 1 的维度不会走到它的步长上，步长再大也可以
+    const int row[2] = { 1, 4 };
+    const size_t any[2] = { SIZE_MAX, 1 };
+    Tensor r = tensor_as_strided(t, row, any, 2, 0);
+    TEST_CHECK(r != NULL);
+    tensor_free(r);
+
+    const int none[2] = { 0, 3 };
+    Tensor e = tensor_as_strided(t, none, any, 2, 0);
+    TEST_CHECK(e != NULL && tensor_get_elements_count(e) == 0);
+    tensor_free(e);
+    tensor_free(t);
+}
+
+static void
+test_slice_narrow_permute(void)
+{
+    const int dims[2] = { 4, 6 };
+    Tensor t = _iota_f32(dims, 2);
+
+    Tensor s = tensor_slice(t, 1, 1, 6, 2); // 列 1, 3, 5
+    TEST_CHECK(s != NULL && tensor_get_dim(s, 1) == 3);
+    Tensor n = tensor_narrow(s, 0, 2, 2);   // 行 2, 3
+    TEST_CHECK(n != NULL);
+    Tensor c = tensor_contiguous(n);
+    TEST_CHECK(c != NULL);
+    if (c != NULL)
+    {
+        const double expected[6] = { 13, 15, 17, 19, 21, 23 };
+        for (int i = 0; i < 6; i++) TEST_CHECK(test_get(c, i) == expected[i]);
+    }
+    TEST_CHECK(tensor_may_share_memory(t, n));
+    TEST_CHECK(!tensor_may_share_memory(t, c));
+
+    const int axes[2] = { 1, 0 };
+    Tensor p = tensor_permute(t, axes);
+    Tensor pc = tensor_contiguous(p);
+    TEST_CHECK(pc != NULL && test_get(pc, 1) == 6 && test_get(pc, 4) == 1);
+
+    tensor_free(pc);
+    tensor_free(p);
+    tensor_free(c);
+    tensor_free(n);
+    tensor_free(s);
+    tensor_free(t);
+}
+
+static void
+test_empty_tensors(void)
+{
+    const int dims[2] = { 0, 3 };
+    Shape s = shape_create(dims, 2);
+    Tensor e = tensor_empty(s, DTYPE_F32);
+    Tensor z = tensor_zeros(s, DTYPE_I32);
+    TEST_CHECK(e != NULL && z != NULL);
+    TEST_CHECK(tensor_get_data_const(e) != NULL);
+
+    const int flipped[2] = { 3, 0 };
+    Shape fs = shape_create(flipped, 2);
+    Tensor r = tensor_reshape(e, fs);
+    TEST_CHECK(r != NULL && tensor_get_elements_count(r) == 0);
+
+    // 拼接：空张量不贡献任何行
+    const int rows[2] = { 2, 3 };
+    Tensor full = _iota_f32(rows, 2);
+    const Tensor parts[3] = { e, full, e };
+    Tensor cat = tensor_cat(parts, 3, 0);
+    TEST_CHECK(cat != NULL);
+    if (cat != NULL)
+    {
+        TEST_CHECK(tensor_get_dim(cat, 0) == 2);
+        TEST_CHECK(test_get(cat, 5) == 5);
+    }
+    const Tensor only_empty[2] = { e, e };
+    Tensor cat_empty = tensor_cat(only_empty, 2, 0);
+    TEST_CHECK(cat_empty != NULL && tensor_get_elements_count(cat_empty) == 0);
+
+    Tensor copy = tensor_copy(e);
+    TEST_CHECK(copy != NULL);
+
+    // 不连续的空张量：置换后的 [0, 3]（原来是 [3, 0]）与切成长度 0 的置换视图
+    Tensor base = tensor_zeros(fs, DTYPE_F32);
+    const int axes[2] = { 1, 0 };
+    Tensor permuted = tensor_permute(base, axes);
+    Tensor pc = tensor_contiguous(permuted);
+    TEST_CHECK(pc != NULL && tensor_get_elements_count(pc) == 0 && tensor_get_dim(pc, 1) == 3);
+
+    Tensor wide = tensor_permute(full, axes);       // [3, 2]，不连续
+    Tensor sliced = tensor_slice(wide, 1, 1, 1, 1); // [3, 0]
+    Tensor sc = tensor_contiguous(sliced);
+    TEST_CHECK(sc != NULL && tensor_get_elements_count(sc) == 0 && tensor_get_dim(sc, 0) == 3);
+
+    // 经过 tensor_contiguous() 的其他入口
+    const int flat[1] = { 0 };
+    Shape flat_shape = shape_create(flat, 1);
+    bool is_view = true;
+    Tensor flattened = tensor_reshape_ex(sliced, flat_shape, &is_view);
+    TEST_CHECK(flattened != NULL && tensor_get_elements_count(flattened) == 0);
+
+    const int32_t idx[2] = { 2, 0 };
+    const int idx_dims[1] = { 2 };
+    Tensor indices = test_tensor(idx, idx_dims, 1, DTYPE_I32);
+    Tensor selected = tensor_index_select(sliced, 0, indices);
+    TEST_CHECK(selected != NULL && tensor_get_dim(selected, 0) == 2 && tensor_get_dim(selected, 1) == 0);
+
+    const int none_dims[2] = { 3, 0 };
+    Shape none_shape = shape_create(none_dims, 2);
+    Tensor none = tensor_zeros(none_shape, DTYPE_I32);
+    Tensor scattered = tensor_scatter_add(sliced, 1, none, sliced, false);
+    TEST_CHECK(scattered != NULL && tensor_get_elements_count(scattered) == 0);
+
+    tensor_free(scattered);
+    tensor_free(none);
+    shape_free(none_shape);
+    tensor_free(selected);
+    tensor_free(indices);
+    tensor_free(flattened);
+    shape_free(flat_shape);
+    tensor_free(sc);
+    tensor_free(sliced);
+    tensor_free(wide);
+    tensor_free(pc);
+    tensor_free(permuted);
+    tensor_free(base);
+    tensor_free(copy);
+    tensor_free(cat_empty);
+    tensor_free(cat);
+    tensor_free(full);
+    tensor_free(r);
+    shape_free(fs);
+    tensor_free(z);
+    tensor_free(e);
+    shape_free(s);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_as_strided_in_bounds);
+    TEST_RUN(test_as_strided_out_of_bounds);
+    TEST_RUN(test_slice_narrow_permute);
+    TEST_RUN(test_empty_tensors);
+    return test_finish();
+}
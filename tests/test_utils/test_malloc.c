@@ -0,0 +1,107 @@
+#include "_test.h"
+
+#include "utils/_malloc.h"
+
+#include <stdint.h> // for uintptr_t
+#include <string.h> // for strcmp()
+
+typedef struct
+{
+    int allocs;
+    int frees;
+    size_t last_bytes;
+}
+HookCounts;
+
+static void
+_count_events(const SafeAllocEvent* event, void* ctx)
+{
+    HookCounts* c = ctx;
+    if (event->is_free) c->frees++;
+    else c->allocs++;
+    c->last_bytes = event->bytes;
+}
+
+static void
+test_trace_counters(void)
+{
+    safe_alloc_trace_enable(true);
+    TEST_CHECK(safe_alloc_trace_enabled());
+
+    SafeAllocStats before, during, after;
+    safe_alloc_trace_stats(&before);
+
+    // 直接分配：记在本文件的这一行上
+    void* block = safe_aligned_malloc(1 << 20);
+    const int block_line = __LINE__ - 1;
+    TEST_CHECK(block != NULL && (uintptr_t)block % safe_alloc_get_alignment() == 0);
+
+    // 张量的数据记为 DATA，头部记为 SMALL
+    const int dims[1] = { 4096 };
+    Shape s = shape_create(dims, 1);
+    Tensor t = tensor_zeros(s, DTYPE_F64);
+    shape_free(s);
+
+    safe_alloc_trace_stats(&during);
+    TEST_CHECK(during.live[SAFE_ALLOC_DATA] >= before.live[SAFE_ALLOC_DATA] + (1 << 20) + 4096 * sizeof(double));
+    TEST_CHECK(during.allocs[SAFE_ALLOC_DATA] >= before.allocs[SAFE_ALLOC_DATA] + 2);
+    TEST_CHECK(during.allocs[SAFE_ALLOC_SMALL] > before.allocs[SAFE_ALLOC_SMALL]);
+    TEST_CHECK(during.live_bytes >= before.live_bytes + (1 << 20));
+    TEST_CHECK(during.peak_bytes >= during.live_bytes);
+
+    SafeAllocSite sites[64];
+    const size_t nsites = safe_alloc_trace_sites(sites, 64);
+    TEST_CHECK(nsites >= 2);
+    bool found = false;
+    for (size_t i = 0; i < nsites && i < 64; i++)
+    {
+        if (sites[i].line != block_line || strcmp(sites[i].file, __FILE__) != 0) continue;
+        found = true;
+        TEST_CHECK(sites[i].category == SAFE_ALLOC_DATA);
+        TEST_CHECK(sites[i].allocs == 1 && sites[i].bytes == (1 << 20) && sites[i].live_bytes == (1 << 20));
+    }
+    TEST_CHECK(found);
+    for (size_t i = 1; i < nsites && i < 64; i++) TEST_CHECK(sites[i - 1].peak_bytes >= sites[i].peak_bytes);
+
+    // 释放后活跃字节回到原来的水平，峰值保留，直到重置
+    safe_aligned_free(block);
+    tensor_free(t);
+    safe_alloc_trace_stats(&after);
+    TEST_CHECK(after.live[SAFE_ALLOC_DATA] == before.live[SAFE_ALLOC_DATA]);
+    TEST_CHECK(after.peak_bytes >= during.live_bytes);
+    safe_alloc_trace_reset_peak();
+    safe_alloc_trace_stats(&after);
+    TEST_CHECK(after.peak_bytes == after.live_bytes);
+
+    safe_alloc_trace_enable(false);
+}
+
+static void
+test_trace_hook_and_toggle(void)
+{
+    HookCounts counts = { 0, 0, 0 };
+    safe_alloc_trace_enable(true);
+    safe_alloc_trace_set_hook(_count_events, &counts);
+
+    void* a = safe_aligned_malloc(1000);
+    TEST_CHECK(counts.allocs == 1 && counts.last_bytes == 1000);
+
+    // 关掉之后新的分配不计；在开着时分配的块释放时仍然计入
+    safe_alloc_trace_enable(false);
+    void* b = safe_aligned_malloc(2000);
+    TEST_CHECK(counts.allocs == 1);
+    safe_aligned_free(a);
+    TEST_CHECK(counts.frees == 1 && counts.last_bytes == 1000);
+    safe_aligned_free(b);
+    TEST_CHECK(counts.frees == 1);
+
+    safe_alloc_trace_set_hook(NULL, NULL);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_trace_counters);
+    TEST_RUN(test_trace_hook_and_toggle);
+    return test_finish();
+}
@@ -0,0 +1,101 @@
+#include "_test.h"
+
+#include "utils/_parallel.h"
+
+#include <stdatomic.h>
+
+#define N 100000
+
+static atomic_int _hits[N];
+
+static void
+_count(size_t begin, size_t end, void* ctx)
+{
+    TEST_CHECK(begin < end && end <= N);
+    for (size_t i = begin; i < end; i++) atomic_fetch_add(&_hits[i], 1);
+}
+
+static void
+test_covers_every_index_once(void)
+{
+    const size_t grains[4] = { 1, 7, 4096, N * 2 };
+    for (int g = 0; g < 4; g++)
+    {
+        for (int i = 0; i < N; i++) atomic_store(&_hits[i], 0);
+        parallel_for(0, N, grains[g], _count, NULL);
+        int wrong = 0;
+        for (int i = 0; i < N; i++) wrong += atomic_load(&_hits[i]) != 1;
+        TEST_CHECK(wrong == 0);
+    }
+
+    // 子区间和空区间
+    for (int i = 0; i < N; i++) atomic_store(&_hits[i], 0);
+    parallel_for(100, 200, 1, _count, NULL);
+    parallel_for(300, 300, 1, _count, NULL);
+    int wrong = 0;
+    for (int i = 0; i < N; i++) wrong += atomic_load(&_hits[i]) != (i >= 100 && i < 200);
+    TEST_CHECK(wrong == 0);
+}
+
+// 同时执行循环体的线程数的峰值
+static atomic_int _live;
+static atomic_int _peak;
+
+static void
+_busy(size_t begin, size_t end, void* ctx)
+{
+    const int live = atomic_fetch_add(&_live, 1) + 1;
+    int peak = atomic_load(&_peak);
+    while (live > peak && !atomic_compare_exchange_weak(&_peak, &peak, live)) {}
+    for (volatile int i = 0; i < 20000; i++) {}
+    atomic_fetch_sub(&_live, 1);
+}
+
+// 外层循环的每一段再嵌套一个 parallel_for
+static void
+_nested(size_t begin, size_t end, void* ctx)
+{
+    for (size_t i = begin; i < end; i++) parallel_for(0, 256, 1, _busy, NULL);
+}
+
+static void
+test_thread_limit(void)
+{
+    const int threads = parallel_get_num_threads();
+    parallel_set_num_threads(8);
+
+    TEST_CHECK(parallel_set_thread_limit(2) == 0);
+    atomic_store(&_peak, 0);
+    parallel_for(0, 512, 1, _busy, NULL);
+    TEST_CHECK(atomic_load(&_peak) <= 2);
+
+    // 嵌套的调用在线程池的工作线程上执行，也要受调用者的上限约束
+    atomic_store(&_peak, 0);
+    parallel_for(0, 8, 1, _nested, NULL);
+    TEST_CHECK(atomic_load(&_peak) <= 2 * 2);
+
+    TEST_CHECK(parallel_set_thread_limit(0) == 2);
+
+    atomic_store(&_peak, 0);
+    parallel_for_ex(0, 512, 1, 3, _busy, NULL);
+    TEST_CHECK(atomic_load(&_peak) <= 3);
+
+    parallel_set_num_threads(threads);
+}
+
+static void
+test_grain(void)
+{
+    TEST_CHECK(parallel_grain(0) == 1);
+    TEST_CHECK(parallel_grain(PARALLEL_CHUNK_BYTES) == 1);
+    TEST_CHECK(parallel_grain(4) == PARALLEL_CHUNK_BYTES / 4);
+}
+
+int
+main(void)
+{
+    TEST_RUN(test_covers_every_index_once);
+    TEST_RUN(test_thread_limit);
+    TEST_RUN(test_grain);
+    return test_finish();
+}